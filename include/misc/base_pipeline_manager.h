@@ -42,14 +42,22 @@
 #include "misc/debug.h"
 #include "misc/mt_safety.h"
 #include "misc/types.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
 #include <vector>
 
 namespace Anvil
 {
     enum BasePipelineManagerCallbackID
     {
-        /* Call-back issued whenever a new pipeline is created.
+        /* Call-back issued whenever a new pipeline is created. The call-back is issued without the manager's
+         * mutex held, after add_pipeline() or add_pipeline_async() has stored the pipeline.
          *
          * NOTE: Only base pipeline-level properties are available for querying at the time of the call-back!
          *
@@ -57,6 +65,24 @@ namespace Anvil
          */
         BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_NEW_PIPELINE_CREATED,
 
+        /* Call-back issued from the manager's background thread whenever a pipeline scheduled for asynchronous
+         * baking has been processed. The call-back is issued without the manager's mutex or the call-back mutex
+         * held, after the pipeline's future has been made ready.
+         *
+         * Handlers may call any of the manager's functions, including add_pipeline(), add_pipeline_async(),
+         * bake_async() and delete_pipeline(), with the following exceptions, which would make the background
+         * thread wait for itself:
+         *
+         * - get_pipeline(), get_shader_info() and get_shader_statistics() must not be called for pipelines
+         *   which are still being baked asynchronously and have no fallback pipeline. Use is_pipeline_ready()
+         *   to check first. Violating this results in an assertion failure, and the functions fail.
+         * - futures returned by get_pipeline_future() must not be waited on.
+         * - the manager must not be destroyed.
+         *
+         * callback_arg: OnAsyncPipelineBakeFinishedCallbackData instance.
+         */
+        BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_ASYNC_PIPELINE_BAKE_FINISHED,
+
         /* Always last */
         BASE_PIPELINE_MANAGER_CALLBACK_ID_COUNT
     };
@@ -74,8 +100,54 @@ namespace Anvil
         bool add_pipeline(Anvil::BasePipelineCreateInfoUniquePtr in_pipeline_create_info_ptr,
                           PipelineID*                            out_pipeline_id_ptr);
 
-       /** TODO */
-       virtual bool bake() = 0;
+       /** Adds a new pipeline and schedules it for asynchronous baking. The function returns immediately.
+        *
+        *  While the pipeline is being baked, get_pipeline() returns the Vulkan handle of the fallback pipeline,
+        *  if one has been specified. Otherwise, get_pipeline() blocks until the bake finishes.
+        *
+        *  Requires the manager and its pipeline cache, if any, to be MT-safe. Not supported if Anvil has been built
+        *  with ANVIL_MT_SAFETY_LOCK_NONE.
+        *
+        *  @param in_pipeline_create_info_ptr Create info of the pipeline to add. Must not describe a proxy pipeline.
+        *  @param in_opt_fallback_pipeline_id ID of a non-proxy pipeline to use while the new pipeline is being baked,
+        *                                     or UINT32_MAX if get_pipeline() should block instead.
+        *  @param out_pipeline_id_ptr         Deref will be set to the ID of the new pipeline. Must not be nullptr.
+        *
+        *  NOTE: Only the new pipeline is scheduled. Other outstanding pipelines are left for bake() or bake_async().
+        *        If the new pipeline derives from an outstanding pipeline, it is created without a base pipeline.
+        *
+        *  @return true if successful, false otherwise. If the function fails, the pipeline is not added.
+        **/
+       bool add_pipeline_async(Anvil::BasePipelineCreateInfoUniquePtr in_pipeline_create_info_ptr,
+                               PipelineID                             in_opt_fallback_pipeline_id,
+                               PipelineID*                            out_pipeline_id_ptr);
+
+       /** Generates a VkPipeline instance for each outstanding pipeline object. Pipelines which are
+        *  being baked asynchronously are not affected.
+        *
+        *  @return true if successful, false otherwise.
+        **/
+       virtual bool bake();
+
+       /** Schedules all outstanding pipelines for asynchronous baking and returns immediately.
+        *
+        *  Scheduled pipelines are baked on a background thread owned by the manager, in submission order.
+        *  Completion can be tracked with is_pipeline_ready(), get_pipeline_future() or with the
+        *  BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_ASYNC_PIPELINE_BAKE_FINISHED call-back.
+        *
+        *  Each pipeline reports its own result. A pipeline which fails to compile is moved back to the outstanding
+        *  pipelines, without affecting the other pipelines scheduled along with it.
+        *
+        *  If a derivative pipeline is baked while its base pipeline is still being baked asynchronously,
+        *  the derivative is created without a base pipeline. Base pipelines must not be deleted while
+        *  their derivatives are being baked.
+        *
+        *  Requires the manager and its pipeline cache, if any, to be MT-safe. Not supported if Anvil has been built
+        *  with ANVIL_MT_SAFETY_LOCK_NONE.
+        *
+        *  @return true if successful, false otherwise.
+        **/
+       bool bake_async();
 
        /** Deletes an existing pipeline.
         *
@@ -90,6 +162,9 @@ namespace Anvil
         *  The function will bake a pipeline object (and, possibly, a pipeline layout object, too) if
         *  the specified pipeline is marked as dirty.
         *
+        *  If the pipeline is being baked asynchronously, the fallback pipeline's handle is returned instead.
+        *  If no fallback pipeline has been specified, the function blocks until the bake finishes.
+        *
         *  @param in_pipeline_id ID of the pipeline to return the raw Vulkan pipeline handle for. Must not
         *                        describe a proxy pipeline.
         *
@@ -99,6 +174,20 @@ namespace Anvil
 
        const Anvil::BasePipelineCreateInfo* get_pipeline_create_info(PipelineID in_pipeline_id) const;
 
+       /** Returns a future which becomes ready once the specified pipeline has been baked.
+        *
+        *  If the pipeline is outstanding, it is scheduled for asynchronous baking first. If the pipeline has
+        *  already been baked, the returned future is ready immediately.
+        *
+        *  Waiting on the future must not happen from within a BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_ASYNC_PIPELINE_BAKE_FINISHED
+        *  call-back handler.
+        *
+        *  @param in_pipeline_id ID of the pipeline to return the future for.
+        *
+        *  @return Future which holds true if the pipeline has been baked successfully, false otherwise.
+        **/
+       std::shared_future<bool> get_pipeline_future(PipelineID in_pipeline_id);
+
        /** Retrieves a PipelineLayout instance associated with the specified pipeline ID.
         *
         *  The function will bake a pipeline object (and, possibly, a pipeline layout object, too) if
@@ -146,6 +235,35 @@ namespace Anvil
                                   Anvil::ShaderStage         in_shader_stage,
                                   VkShaderStatisticsInfoAMD* out_shader_statistics_ptr);
 
+       /** Tells whether a baked Vulkan pipeline object is available for the specified pipeline.
+        *
+        *  @param in_pipeline_id ID of the pipeline to use.
+        *
+        *  @return true if get_pipeline() can return the pipeline's handle without baking or blocking, false otherwise.
+        **/
+       bool is_pipeline_ready(PipelineID in_pipeline_id) const;
+
+       /** Configures the number of threads bake() should spread pipeline compilation across.
+        *
+        *  By default, all outstanding pipelines are compiled with a single vkCreate*Pipelines() call issued
+        *  from the thread which called bake(). When more than one thread is requested, outstanding pipelines
+        *  are split into groups which are compiled by a thread pool owned by the manager. A derivative pipeline
+        *  always ends up in the same group as its base pipeline, if both are baked at the same time.
+        *
+        *  Each worker thread compiles pipelines using its own pipeline cache. The worker caches are created by this
+        *  function and seeded with what the manager's cache holds at the time of the call. After each bake, caches
+        *  of the workers which have compiled any pipelines are merged into the manager's cache.
+        *
+        *  Since the merges may race with other managers sharing the cache, the manager's pipeline cache, if any,
+        *  must be MT-safe. Otherwise, the function asserts and parallel baking stays disabled.
+        *
+        *  Must not be called while asynchronous bakes are in flight.
+        *
+        *  @param in_n_worker_threads Number of threads to use. 1 restores the default single-threaded behavior.
+        *                             0 uses as many threads as there are hardware threads available.
+        **/
+       void set_n_bake_worker_threads(uint32_t in_n_worker_threads);
+
     protected:
        /* Protected type declarations */
 
@@ -154,6 +272,7 @@ namespace Anvil
        {
            VkPipeline                             baked_pipeline;
            const BaseDevice*                      device_ptr;
+           PipelineID                             fallback_pipeline_id;
            Anvil::PipelineLayoutUniquePtr         layout_ptr;
            Anvil::BasePipelineCreateInfoUniquePtr pipeline_create_info_ptr;
 
@@ -164,6 +283,7 @@ namespace Anvil
            {
                baked_pipeline           = VK_NULL_HANDLE;
                device_ptr               = in_device_ptr;
+               fallback_pipeline_id     = UINT32_MAX;
                pipeline_create_info_ptr = std::move(in_pipeline_create_info_ptr);
            }
 
@@ -182,6 +302,71 @@ namespace Anvil
 
        typedef std::map<PipelineID, std::unique_ptr<Pipeline> > Pipelines;
 
+       /** Describes a single outstanding pipeline which is about to be baked */
+       typedef struct BakeItem
+       {
+           VkPipeline base_pipeline_handle;
+           int32_t    base_pipeline_index;
+           PipelineID pipeline_id;
+           Pipeline*  pipeline_ptr;
+
+           BakeItem(PipelineID in_pipeline_id,
+                    Pipeline*  in_pipeline_ptr,
+                    int32_t    in_base_pipeline_index,
+                    VkPipeline in_base_pipeline_handle)
+           {
+               base_pipeline_handle = in_base_pipeline_handle;
+               base_pipeline_index  = in_base_pipeline_index;
+               pipeline_id          = in_pipeline_id;
+               pipeline_ptr         = in_pipeline_ptr;
+           }
+       } BakeItem;
+
+       /** Describes a contiguous range of bake items, which can be compiled independently of all other items */
+       typedef struct BakeGroup
+       {
+           uint32_t n_first_bake_item;
+           uint32_t n_bake_items;
+
+           BakeGroup(uint32_t in_n_first_bake_item,
+                     uint32_t in_n_bake_items)
+           {
+               n_first_bake_item = in_n_first_bake_item;
+               n_bake_items      = in_n_bake_items;
+           }
+       } BakeGroup;
+
+       /** Prototype of a function which creates Vulkan pipeline objects for a single bake group.
+        *
+        *  @param in_bake_group     Bake group to create pipeline objects for.
+        *  @param in_pipeline_cache Pipeline cache to pass to the vkCreate*Pipelines() call. The function must not
+        *                           assume it is the same cache instance for all bake groups.
+        *
+        *  @return Result of the vkCreate*Pipelines() call.
+        **/
+       typedef std::function<VkResult(const BakeGroup& in_bake_group,
+                                      VkPipelineCache  in_pipeline_cache)> CreatePipelinesFunction;
+
+       /** Outcome of an asynchronous bake of a single pipeline */
+       typedef struct AsyncBakeResult
+       {
+           std::promise<bool>       promise;
+           std::shared_future<bool> future;
+
+           AsyncBakeResult()
+           {
+               future = promise.get_future().share();
+           }
+       } AsyncBakeResult;
+
+       /** Describes a batch of pipelines scheduled for asynchronous baking. Owns the pipelines until they are baked. */
+       typedef struct AsyncBakeJob
+       {
+           std::set<PipelineID>                  deleted_pipeline_ids;
+           Pipelines                             pipelines;
+           std::map<PipelineID, AsyncBakeResult> results;
+       } AsyncBakeJob;
+
        /* Protected functions */
 
        /** Constructor. Initializes base layer of a pipeline manager.
@@ -190,9 +375,10 @@ namespace Anvil
         *  @param in_mt_safe                     True if more than one thread at a time is going to be issuing calls against the pipeline manager.
         *  @param in_use_pipeline_cache          true if a pipeline cache should be used to spawn new pipeline objects.
         *                                        What pipeline cache ends up being used depends on @param in_pipeline_cache_to_reuse_ptr -
-        *                                        if a nullptr object is passed via this argument, a new pipeline cache instance will
-        *                                        be created, and later released by the destructor. If a non-nullptr object is passed,
-        *                                        it will be used instead.
+        *                                        if a nullptr object is passed via this argument, the device's pipeline cache will
+        *                                        be used if it is persistent. Otherwise, a new pipeline cache instance will be created,
+        *                                        and later released by the destructor. If a non-nullptr object is passed, it will be
+        *                                        used instead.
         *  @param in_pipeline_cache_to_reuse_ptr Please see above.
         **/
        explicit BasePipelineManager(const Anvil::BaseDevice* in_device_ptr,
@@ -215,12 +401,78 @@ namespace Anvil
                                         std::vector<VkSpecializationMapEntry>* out_specialization_map_entry_vk_vector,
                                         VkSpecializationInfo*                  out_specialization_info_ptr) const;
 
+       /** Creates Vulkan pipeline objects for the specified bake items.
+        *
+        *  Implementations must not access the manager's pipeline maps, as the function may be called from
+        *  the manager's background thread without the manager's mutex held.
+        *
+        *  @param in_bake_items      Bake items, as returned by get_bake_items().
+        *  @param in_bake_groups     Bake groups, as returned by get_bake_items().
+        *  @param out_pipelines_ptr  Deref will be resized and filled with Vulkan pipeline handles, in the same
+        *                            order as @param in_bake_items. Must not be nullptr. If the function fails,
+        *                            handles which have been created regardless are left in place, so that
+        *                            the caller can release them.
+        *
+        *  @return true if successful, false otherwise.
+        **/
+       virtual bool compile_pipelines(const std::vector<BakeItem>&  in_bake_items,
+                                      const std::vector<BakeGroup>& in_bake_groups,
+                                      std::vector<VkPipeline>*      out_pipelines_ptr) = 0;
+
+       /** Calls @param in_create_pipelines_func for each bake group. If parallel baking has been enabled with
+        *  set_n_bake_worker_threads(), the calls are distributed across the manager's thread pool, each worker
+        *  using a separate pipeline cache. Otherwise, all calls are made from the calling thread, with the
+        *  manager's pipeline cache locked.
+        *
+        *  Does not access the manager's pipeline maps, so it can be called without the manager's mutex held.
+        *
+        *  @param in_bake_groups           Bake groups to create pipeline objects for.
+        *  @param in_create_pipelines_func Function to use. Must be safe to call from multiple threads at a time.
+        *
+        *  @return true if all pipeline objects were created successfully, false otherwise.
+        **/
+       bool create_pipelines(const std::vector<BakeGroup>&  in_bake_groups,
+                             const CreatePipelinesFunction& in_create_pipelines_func);
+
+       /** Assigns a pipeline layout to each pipeline in @param in_pipelines and lays the pipelines out in the
+        *  order they should be passed to vkCreate*Pipelines().
+        *
+        *  If parallel baking is disabled, a single bake group is returned. Otherwise, each pipeline is given its
+        *  own bake group, unless it derives from another pipeline in @param in_pipelines, in which case it is moved
+        *  to the base pipeline's group.
+        *
+        *  Base pipeline indices stored in the bake items are relative to the first item of the owning bake group.
+        *  If a pipeline does not derive from another pipeline in @param in_pipelines, its base pipeline index is set
+        *  to UINT32_MAX, and its base pipeline handle is set to the handle of the already baked base pipeline, or
+        *  VK_NULL_HANDLE if there is none.
+        *
+        *  Must be called with the manager's mutex locked.
+        *
+        *  @param in_pipelines        Pipelines to bake.
+        *  @param out_bake_items_ptr  Deref will be filled with bake items. Must not be nullptr.
+        *  @param out_bake_groups_ptr Deref will be filled with bake groups. Must not be nullptr.
+        **/
+       void get_bake_items(const Pipelines&        in_pipelines,
+                           std::vector<BakeItem>*  out_bake_items_ptr,
+                           std::vector<BakeGroup>* out_bake_groups_ptr);
+
+       /** Blocks until all pipelines scheduled for asynchronous baking are processed and terminates the manager's
+        *  background thread, if one has been spawned.
+        *
+        *  Must be called by derived classes' destructors before any pipeline maps are released, and without
+        *  the manager's mutex held.
+        **/
+       void stop_async_bake_thread();
+
        /* Protected members */
        const Anvil::BaseDevice* m_device_ptr;
        std::atomic<uint32_t>    m_pipeline_counter;
 
-       Pipelines                             m_baked_pipelines;
-       Pipelines                             m_outstanding_pipelines;
+       std::deque<std::unique_ptr<AsyncBakeJob> > m_async_bake_jobs;
+       Anvil::ThreadPoolUniquePtr                 m_bake_thread_pool_ptr;
+       std::vector<Anvil::PipelineCacheUniquePtr> m_bake_worker_pipeline_cache_ptrs;
+       Pipelines                                  m_baked_pipelines;
+       Pipelines                                  m_outstanding_pipelines;
 
        Anvil::PipelineCache*  m_pipeline_cache_ptr;
        PipelineCacheUniquePtr m_pipeline_cache_owned_ptr;
@@ -231,6 +483,24 @@ private:
        /* Private functions */
        BasePipelineManager& operator=(const BasePipelineManager&);
        BasePipelineManager           (const BasePipelineManager&);
+
+       bool          add_pipeline_internal             (Anvil::BasePipelineCreateInfoUniquePtr  in_pipeline_create_info_ptr,
+                                                        PipelineID*                             out_pipeline_id_ptr);
+       void          async_bake_thread_entrypoint      ();
+       void          fire_new_pipeline_created_callback(PipelineID                              in_pipeline_id);
+       AsyncBakeJob* get_async_bake_job                (PipelineID                              in_pipeline_id) const;
+       bool          is_pipeline_cache_mt_safe         () const;
+       void          release_compiled_pipelines        (std::vector<VkPipeline>*                inout_pipelines_ptr) const;
+       bool          schedule_async_bake_job           (const std::vector<PipelineID>&          in_pipeline_ids);
+       void          wait_for_async_bake               (PipelineID                              in_pipeline_id,
+                                                        std::unique_lock<Anvil::MTSafetyMutex>* inout_mutex_lock_ptr);
+
+       /* Private members */
+       std::condition_variable m_async_bake_job_available_cv;
+       std::mutex              m_async_bake_mutex;
+       std::thread             m_async_bake_thread;
+       bool                    m_async_bake_thread_should_terminate;
+       uint32_t                m_n_pending_async_bake_jobs;
     };
 }; /* Vulkan namespace */
 
@@ -0,0 +1,230 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a bindless descriptor table, built on top of VK_EXT_descriptor_indexing.
+ *
+ *  The table owns one large descriptor set per resource type. Each set holds a single binding at index 0, created with
+ *  UPDATE_AFTER_BIND, PARTIALLY_BOUND and UPDATE_UNUSED_WHILE_PENDING flags. Resources are identified by slot indices,
+ *  which shaders use to index the binding's descriptor array. The sets themselves never change, so they only need to
+ *  be bound once per command buffer. Draws which use different resources can then be batched together.
+ *
+ *  Slots are handed out by a free-list allocator. A released slot may still be accessed by command buffers which are
+ *  in flight, so it is only returned to the free list once the GPU has finished executing the frame it was released in.
+ *  The frame protocol is the same as the one used by FrameCommandAllocator:
+ *
+ *  1. Call begin_frame() at the beginning of each frame, passing the fence which is going to be signalled when the GPU
+ *     finishes executing the frame's command buffers.
+ *  2. Allocate slots with alloc_slot(), assign resources to them with set_slot(), and return them with release_slot().
+ *  3. Call update() before submitting command buffers which access newly assigned slots. Since the bindings use
+ *     UPDATE_AFTER_BIND, this is also valid after the sets have been bound.
+ *
+ *  Requires VK_EXT_descriptor_indexing, with support for partially bound bindings, updating unused descriptors while
+ *  pending and update-after-bind for all resource types the table is created for.
+ **/
+#ifndef MISC_BINDLESS_DESCRIPTOR_TABLE_H
+#define MISC_BINDLESS_DESCRIPTOR_TABLE_H
+
+#include "misc/frame_ring.h"
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include "wrappers/descriptor_set.h"
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class BindlessDescriptorTable : public MTSafetySupportProvider
+    {
+    public:
+        /* Public functions */
+
+        /** Destructor. Releases the descriptor sets, layouts and the pool owned by the table. */
+        ~BindlessDescriptorTable();
+
+        /** Allocates a slot for a resource of type @param in_descriptor_type.
+         *
+         *  @return Index of the allocated slot, or UINT32_MAX if the table has no free slots left for the type.
+         **/
+        uint32_t alloc_slot(Anvil::DescriptorType in_descriptor_type);
+
+        /** Moves to the next frame.
+         *
+         *  If a fence has been associated with the frame slot being reused, the function blocks until the fence is
+         *  signalled. The fence is NOT reset. Resource slots released during that frame are then returned to the free
+         *  lists.
+         *
+         *  @param in_opt_frame_fence_ptr Fence which is going to be signalled when the GPU finishes executing
+         *                                command buffers recorded for the new frame. Must stay alive until the
+         *                                frame slot is reused. May be nullptr, in which case the application must
+         *                                ensure that resource slots released during the frame are no longer
+         *                                accessed by the GPU by the time the frame slot is reused.
+         *
+         *  @return true if successful, false otherwise. If the function fails, the current slot is not changed
+         *          and the call may be retried.
+         **/
+        bool begin_frame(Anvil::Fence* in_opt_frame_fence_ptr);
+
+        /** Creates a new bindless descriptor table.
+         *
+         *  @param in_device_ptr         Device to use. Must not be nullptr.
+         *  @param in_n_resource_types   Number of resource types the table should hold. Must be at least 1.
+         *  @param in_resource_types_ptr Array of @param in_n_resource_types distinct descriptor types. Dynamic buffer,
+         *                               input attachment and inline uniform block descriptors are not supported.
+         *  @param in_n_slots_ptr        Array of @param in_n_resource_types slot counts, one for each descriptor type.
+         *  @param in_stage_flags        Shader stages which are going to access the table.
+         *  @param in_n_frames_in_flight Number of frames which may be executed by the GPU at the same time. Determines
+         *                               how long released slots are kept from reuse. Must be at least 1.
+         *  @param in_mt_safety          MT safety setting to use for the table.
+         *
+         *  @return New table instance, or nullptr if the device does not support the required functionality.
+         **/
+        static Anvil::BindlessDescriptorTableUniquePtr create(const Anvil::BaseDevice*     in_device_ptr,
+                                                              uint32_t                     in_n_resource_types,
+                                                              const Anvil::DescriptorType* in_resource_types_ptr,
+                                                              const uint32_t*              in_n_slots_ptr,
+                                                              Anvil::ShaderStageFlags      in_stage_flags,
+                                                              uint32_t                     in_n_frames_in_flight,
+                                                              MTSafety                     in_mt_safety = Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE);
+
+        /** Returns the descriptor set holding resources of type @param in_descriptor_type, or nullptr if the table has not
+         *  been created for the type. The set should be bound with the layout returned by get_descriptor_set_create_info().
+         **/
+        Anvil::DescriptorSet* get_descriptor_set(Anvil::DescriptorType in_descriptor_type) const;
+
+        /** Returns create info of the layout of the descriptor set holding resources of type @param in_descriptor_type, or
+         *  nullptr if the table has not been created for the type. Pass it to BasePipelineCreateInfo::set_descriptor_set_create_info()
+         *  to build pipeline layouts which can access the table.
+         **/
+        const Anvil::DescriptorSetCreateInfo* get_descriptor_set_create_info(Anvil::DescriptorType in_descriptor_type) const;
+
+        /** Returns the number of slots available for allocation for resource type @param in_descriptor_type. Slots which
+         *  are waiting for their frame's fence are not included.
+         **/
+        uint32_t get_n_free_slots(Anvil::DescriptorType in_descriptor_type) const;
+
+        /** Releases a slot. The slot is returned to the free list n_frames_in_flight begin_frame() calls later, so that
+         *  command buffers which may still access the slot's descriptor are given time to finish executing.
+         *
+         *  @param in_descriptor_type Type of the resource the slot has been allocated for.
+         *  @param in_n_slot          Index of the slot, as returned by alloc_slot().
+         **/
+        void release_slot(Anvil::DescriptorType in_descriptor_type,
+                          uint32_t              in_n_slot);
+
+        /** Assigns a resource to an allocated slot. The descriptor type is deduced from the element type.
+         *
+         *  The change takes effect when update() is called next time.
+         *
+         *  @param in_n_slot  Index of the slot, as returned by alloc_slot(). Must not be accessed by any pending command
+         *                    buffers.
+         *  @param in_element Resource to assign. Please see DescriptorSet::set_binding_array_items() for the list of
+         *                    supported element types.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        template<typename BindingElementType>
+        bool set_slot(uint32_t                  in_n_slot,
+                      const BindingElementType& in_element)
+        {
+            std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+            auto                                   mutex_ptr      = get_mutex();
+            TableData*                             table_data_ptr = get_table_data(in_element.get_type() );
+
+            if (mutex_ptr != nullptr)
+            {
+                mutex_lock = std::move(
+                    std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+                );
+            }
+
+            if (table_data_ptr == nullptr)
+            {
+                anvil_assert(table_data_ptr != nullptr);
+
+                return false;
+            }
+
+            anvil_assert(in_n_slot < table_data_ptr->n_slots);
+            anvil_assert(table_data_ptr->slot_allocated.at(in_n_slot) );
+
+            return table_data_ptr->ds_ptr->set_binding_array_items(0, /* in_binding_index */
+                                                                   BindingElementArrayRange(in_n_slot,
+                                                                                            1),  /* NumberOfBindingElements */
+                                                                  &in_element);
+        }
+
+        /** Writes descriptors of all slots which have been assigned new resources since the last call.
+         *
+         *  Only modified ranges of the descriptor arrays are written.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool update();
+
+    private:
+        /* Private type definitions */
+        typedef struct TableData
+        {
+            Anvil::DescriptorSetUniquePtr       ds_ptr;
+            std::vector<uint32_t>               free_slots;
+            Anvil::DescriptorSetLayoutUniquePtr layout_ptr;
+            uint32_t                            n_slots;
+            std::vector<bool>                   slot_allocated;
+
+            TableData()
+                :n_slots(0)
+            {
+                /* Stub */
+            }
+        } TableData;
+
+        typedef struct FrameData
+        {
+            std::vector<std::pair<Anvil::DescriptorType, uint32_t> > released_slots;
+        } FrameData;
+
+        typedef std::unordered_map<Anvil::DescriptorType, std::unique_ptr<TableData>, Anvil::EnumClassHasher<Anvil::DescriptorType> > DescriptorTypeToTableDataMap;
+
+        /* Private functions */
+        explicit BindlessDescriptorTable(const Anvil::BaseDevice* in_device_ptr,
+                                         uint32_t                 in_n_frames_in_flight,
+                                         bool                     in_mt_safe);
+
+        TableData* get_table_data(Anvil::DescriptorType        in_descriptor_type) const;
+        bool       init          (uint32_t                     in_n_resource_types,
+                                  const Anvil::DescriptorType* in_resource_types_ptr,
+                                  const uint32_t*              in_n_slots_ptr,
+                                  Anvil::ShaderStageFlags      in_stage_flags);
+
+        /* Private variables */
+        const Anvil::BaseDevice*       m_device_ptr;
+        Anvil::FrameRing               m_frame_ring;
+        std::vector<FrameData>         m_frames;
+        Anvil::DescriptorPoolUniquePtr m_pool_ptr;
+        DescriptorTypeToTableDataMap   m_tables;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(BindlessDescriptorTable);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(BindlessDescriptorTable);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_BINDLESS_DESCRIPTOR_TABLE_H */
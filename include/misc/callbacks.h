@@ -33,6 +33,7 @@
 
 #include "misc/debug.h"
 #include "misc/io.h"
+#include "misc/mt_safety.h"
 #include "misc/types.h"
 
 #ifndef _WIN32
@@ -100,6 +101,19 @@ namespace Anvil
         bool                result;
     } IsImageMemoryAllocPendingQueryCallbackArgument;
 
+    typedef struct OnAsyncPipelineBakeFinishedCallbackData : public Anvil::CallbackArgument
+    {
+        PipelineID pipeline_id;
+        bool       result;
+
+        explicit OnAsyncPipelineBakeFinishedCallbackData(PipelineID in_pipeline_id,
+                                                         bool       in_result)
+        {
+            pipeline_id = in_pipeline_id;
+            result      = in_result;
+        }
+    } OnAsyncPipelineBakeFinishedCallbackData;
+
     typedef struct OnDescriptorPoolResetCallbackArgument : public Anvil::CallbackArgument
     {
         const DescriptorPool* descriptor_pool_ptr;
@@ -322,7 +336,7 @@ namespace Anvil
                                     CallbackFunction in_callback_function,
                                     void*            in_callback_function_owner_ptr) const
         {
-            std::unique_lock<std::recursive_mutex> mutex_lock(m_mutex);
+            std::unique_lock<Anvil::MTSafetyMutex> mutex_lock(m_mutex);
 
             anvil_assert(in_callback_id < m_callback_id_count);
 
@@ -350,7 +364,7 @@ namespace Anvil
                                     CallbackFunction in_callback_function,
                                     void*            in_callback_owner_ptr)
         {
-            std::unique_lock<std::recursive_mutex> mutex_lock(m_mutex);
+            std::unique_lock<Anvil::MTSafetyMutex> mutex_lock(m_mutex);
 
             anvil_assert(in_callback_id        <  m_callback_id_count);
             anvil_assert(in_callback_function  != nullptr);
@@ -388,7 +402,7 @@ namespace Anvil
                                        CallbackFunction in_callback_function,
                                        void*            in_callback_function_owner_ptr)
         {
-            std::unique_lock<std::recursive_mutex> mutex_lock(m_mutex);
+            std::unique_lock<Anvil::MTSafetyMutex> mutex_lock(m_mutex);
 
             anvil_assert(in_callback_id       <  m_callback_id_count);
             anvil_assert(in_callback_function != nullptr);
@@ -423,7 +437,7 @@ namespace Anvil
         void callback(CallbackID        in_callback_id,
                       CallbackArgument* in_callback_arg_ptr) const
         {
-            std::unique_lock<std::recursive_mutex> mutex_lock(m_mutex);
+            std::unique_lock<Anvil::MTSafetyMutex> mutex_lock(m_mutex);
 
             anvil_assert(in_callback_id < m_callback_id_count);
             anvil_assert(!m_callbacks_locked);
@@ -442,6 +456,39 @@ namespace Anvil
             m_callbacks_locked = false;
         }
 
+        /** Calls back all subscribers which have signed up for the specified callback slot.
+         *
+         *  The clients are called one after another from the thread, in which the call has
+         *  been invoked.
+         *
+         *  Unlike callback(), this implementation takes a copy of the subscriber list and does NOT hold
+         *  the provider's mutex while the subscribers execute. The invoked functions may therefore fire
+         *  other call-backs of this provider, and may take locks which other threads hold while firing
+         *  call-backs. A subscriber which unregisters from another thread may still be called once, if
+         *  the copy has been taken before it unregistered.
+         *
+         *  @param in_callback_id      ID of the call-back slot to use.
+         *  @param in_callback_arg_ptr Call-back argument to use.
+         **/
+        void callback_unlocked(CallbackID        in_callback_id,
+                               CallbackArgument* in_callback_arg_ptr) const
+        {
+            Callbacks cached_callbacks;
+
+            anvil_assert(in_callback_id < m_callback_id_count);
+
+            {
+                std::unique_lock<Anvil::MTSafetyMutex> mutex_lock(m_mutex);
+
+                cached_callbacks = m_callbacks[in_callback_id];
+            }
+
+            for (const auto& current_callback : cached_callbacks)
+            {
+                current_callback.function(in_callback_arg_ptr);
+            }
+        }
+
         /** Calls back all subscribers which have signed up for the specified callback slot.
          *
          *  The clients are called one after another from the thread, in which the call has
@@ -463,7 +510,7 @@ namespace Anvil
         void callback_safe(CallbackID        in_callback_id,
                            CallbackArgument* in_callback_arg_ptr)
         {
-            std::unique_lock<std::recursive_mutex> mutex_lock(m_mutex);
+            std::unique_lock<Anvil::MTSafetyMutex> mutex_lock(m_mutex);
 
             anvil_assert(in_callback_id < m_callback_id_count);
             anvil_assert(!m_callbacks_locked);
@@ -513,7 +560,7 @@ namespace Anvil
 
             if (in_callback_id < m_callback_id_count)
             {
-                std::unique_lock<std::recursive_mutex> mutex_lock(m_mutex);
+                std::unique_lock<Anvil::MTSafetyMutex> mutex_lock(m_mutex);
 
                 result = static_cast<uint32_t>(m_callbacks[in_callback_id].size() );
             }
@@ -555,7 +602,7 @@ namespace Anvil
         CallbackID                   m_callback_id_count;
         Callbacks*                   m_callbacks;
         mutable volatile bool        m_callbacks_locked;
-        mutable std::recursive_mutex m_mutex;
+        mutable Anvil::MTSafetyMutex m_mutex;
     };
 } /* namespace Anvil */
 
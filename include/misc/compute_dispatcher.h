@@ -0,0 +1,208 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a dispatcher which spreads independent compute jobs across all compute queues exposed
+ *  by a device.
+ *
+ *  Each job is recorded into a command buffer owned by the dispatcher and submitted to the queue with
+ *  the smallest number of outstanding submissions. Jobs may depend on previously dispatched jobs:
+ *
+ *  - If VK_KHR_timeline_semaphore is enabled, each queue owns a timeline semaphore, which is signalled
+ *    with a monotonically increasing value by every job submitted to the queue. Dependencies are
+ *    resolved GPU-side by waiting on the timeline semaphores of the queues the dependencies were
+ *    submitted to. The wait happens at the pipeline stages requested by the caller, which default
+ *    to all commands.
+ *  - Otherwise, dependencies which have not finished executing by the time the dependent job is
+ *    dispatched are waited upon CPU-side, using the per-job fences. Other threads can keep using
+ *    the dispatcher while the wait is in progress.
+ *
+ *  If the device exposes no compute-only queues, universal queues are used instead.
+ *
+ *  The dispatcher is thread-safe. Recording functions are called without the dispatcher-wide lock held,
+ *  so jobs targeting different queues can be recorded in parallel. Since command buffers allocated from
+ *  the same command pool must not be recorded concurrently, recording is serialized per queue.
+ **/
+#ifndef MISC_COMPUTE_DISPATCHER_H
+#define MISC_COMPUTE_DISPATCHER_H
+
+#include "misc/types.h"
+#include <deque>
+#include <memory>
+#include <mutex>
+
+
+namespace Anvil
+{
+    class ComputeDispatcher
+    {
+    public:
+        /* Public type definitions */
+
+        /** Identifies a dispatched job. A default-constructed handle does not refer to any job. */
+        typedef struct JobHandle
+        {
+            uint32_t n_queue;
+            uint64_t value;
+
+            JobHandle()
+                :n_queue(UINT32_MAX),
+                 value  (0)
+            {
+                /* Stub */
+            }
+
+            JobHandle(uint32_t in_n_queue,
+                      uint64_t in_value)
+                :n_queue(in_n_queue),
+                 value  (in_value)
+            {
+                /* Stub */
+            }
+        } JobHandle;
+
+        /** Prototype of a function which records a job's commands.
+         *
+         *  The command buffer is already in the recording state when the function is called, and is
+         *  closed by the dispatcher after the function returns.
+         **/
+        typedef std::function<void(Anvil::PrimaryCommandBuffer* in_cmd_buffer_ptr)> RecordingFunction;
+
+        /* Public functions */
+
+        /** Destructor.
+         *
+         *  Waits until all dispatched jobs finish executing before releasing the command buffers.
+         *  No dispatch() calls may be in progress at destruction time.
+         **/
+        ~ComputeDispatcher();
+
+        /** Creates a new dispatcher instance.
+         *
+         *  @param in_device_ptr Device to use. Must not be nullptr.
+         *
+         *  @return New dispatcher instance, or nullptr if the device exposes no compute-capable queues.
+         **/
+        static Anvil::ComputeDispatcherUniquePtr create(Anvil::BaseDevice* in_device_ptr);
+
+        /** Records and submits a new job.
+         *
+         *  @param in_recording_function   Function to record the job's commands with. Must not be nullptr.
+         *  @param in_n_dependencies       Number of jobs under @param in_opt_dependencies_ptr, which must finish
+         *                                 executing before the new job starts executing.
+         *  @param in_opt_dependencies_ptr Jobs the new job depends on. May be nullptr if @param in_n_dependencies is 0.
+         *                                 Handles which do not refer to any job are ignored.
+         *  @param in_wait_stage_mask      Pipeline stages of the new job, which must not start executing before the
+         *                                 dependencies finish. Only used if VK_KHR_timeline_semaphore is enabled.
+         *                                 Narrowing the mask down to the stages which actually consume the results
+         *                                 of the dependencies, e.g. the compute shader stage, lets the remaining
+         *                                 stages overlap with the dependencies.
+         *
+         *  @return Handle of the new job. Does not refer to any job if the function failed.
+         **/
+        JobHandle dispatch(const RecordingFunction&  in_recording_function,
+                           uint32_t                  in_n_dependencies       = 0,
+                           const JobHandle*          in_opt_dependencies_ptr = nullptr,
+                           Anvil::PipelineStageFlags in_wait_stage_mask      = Anvil::PipelineStageFlagBits::ALL_COMMANDS_BIT);
+
+        /** Returns the number of queues jobs are distributed across. */
+        uint32_t get_n_queues() const
+        {
+            return static_cast<uint32_t>(m_queues.size() );
+        }
+
+        /** Returns the number of jobs submitted to queue @param in_n_queue, which have not been confirmed
+         *  to have finished executing yet.
+         **/
+        uint32_t get_n_outstanding_jobs(uint32_t in_n_queue);
+
+        /** Returns the queue at index @param in_n_queue. */
+        Anvil::Queue* get_queue(uint32_t in_n_queue) const
+        {
+            return m_queues.at(in_n_queue).queue_ptr;
+        }
+
+        /** Tells whether job @param in_job has finished executing. */
+        bool is_job_finished(const JobHandle& in_job);
+
+        /** Blocks until job @param in_job finishes executing.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool wait_for_job(const JobHandle& in_job);
+
+        /** Blocks until all dispatched jobs finish executing.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool wait_idle();
+
+    private:
+        /* Private type definitions */
+        typedef struct InFlightJob
+        {
+            Anvil::PrimaryCommandBufferUniquePtr cmd_buffer_ptr;
+            std::shared_ptr<Anvil::Fence>        fence_ptr; /* shared with threads which wait on the fence */
+            uint64_t                             value;
+        } InFlightJob;
+
+        typedef struct QueueData
+        {
+            Anvil::CommandPoolUniquePtr                       command_pool_ptr;
+            std::vector<Anvil::PrimaryCommandBufferUniquePtr> free_cmd_buffer_ptrs;
+            std::deque<InFlightJob>                           in_flight_jobs;
+            uint64_t                                          last_completed_value;
+            uint64_t                                          last_submitted_value;
+            uint32_t                                          n_jobs_being_recorded;
+            Anvil::Queue*                                     queue_ptr;
+            std::unique_ptr<std::mutex>                       recording_mutex_ptr;
+            Anvil::SemaphoreUniquePtr                         timeline_semaphore_ptr;
+
+            QueueData()
+                :last_completed_value (0),
+                 last_submitted_value (0),
+                 n_jobs_being_recorded(0),
+                 queue_ptr            (nullptr)
+            {
+                /* Stub */
+            }
+        } QueueData;
+
+        /* Private functions */
+        explicit ComputeDispatcher(Anvil::BaseDevice* in_device_ptr);
+
+        bool     init                  ();
+        uint32_t pick_queue            ();
+        void     retire_completed_jobs (QueueData* in_queue_data_ptr);
+
+        /* Private variables */
+        Anvil::BaseDevice*     m_device_ptr;
+        std::mutex             m_mutex;
+        uint32_t               m_n_next_queue;
+        std::vector<QueueData> m_queues;
+        bool                   m_use_timeline_semaphores;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ComputeDispatcher);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(ComputeDispatcher);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_COMPUTE_DISPATCHER_H */
@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements an auto-growing descriptor pool allocator.
+ *
+ *  Instead of sizing a single descriptor pool up front, the allocator owns a list of pools. Sets are
+ *  allocated from the current pool. When it runs out of space (VK_ERROR_OUT_OF_POOL_MEMORY or
+ *  VK_ERROR_FRAGMENTED_POOL), the allocator moves on to a recycled pool or creates a new one.
+ *
+ *  New pools are sized from the observed usage. The allocator tracks how many descriptors of each type
+ *  the sets allocated so far have needed on average. Each new pool gets room for n_sets_per_pool sets
+ *  of that average composition.
+ *
+ *  Sets are handed out as raw pointers and stay owned by the allocator. Once the application no longer
+ *  needs a set and the GPU no longer uses it, the set should be returned with retire_descriptor_sets().
+ *  When every set allocated from a pool other than the current one has been retired, the pool is
+ *  recycled as a whole with a single DescriptorPool::reset() call.
+ *
+ *  If the pools are created with FREE_DESCRIPTOR_SET_BIT, each retired set is instead freed right away
+ *  with DescriptorPool::free_descriptor_sets(), and any pool other than the current one which gained free
+ *  space becomes available for reuse. This suits users which retire sets one by one in no particular
+ *  order, where waiting for a whole pool to drain would pin it indefinitely.
+ *
+ *  Pools available for reuse are kept until trim() is called, even if they turn out to be too small for
+ *  the current requests, so that the allocator does not thrash pools when requests of different sizes
+ *  are interleaved.
+ *
+ *  Inline uniform block bindings are not supported.
+ **/
+#ifndef MISC_DESCRIPTOR_POOL_ALLOCATOR_H
+#define MISC_DESCRIPTOR_POOL_ALLOCATOR_H
+
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class DescriptorPoolAllocator : public MTSafetySupportProvider
+    {
+    public:
+        /* Public type definitions */
+        typedef std::unordered_map<Anvil::DescriptorType, uint32_t, Anvil::EnumClassHasher<Anvil::DescriptorType> > DescriptorTypeToCountMap;
+        typedef std::unordered_map<Anvil::DescriptorType, uint64_t, Anvil::EnumClassHasher<Anvil::DescriptorType> > DescriptorTypeToTotalCountMap;
+
+        /* Public functions */
+
+        /** Destructor. Releases all descriptor sets and pools owned by the allocator. */
+        ~DescriptorPoolAllocator();
+
+        /** Allocates descriptor sets. All sets requested by a single call are allocated from the same pool.
+         *
+         *  @param in_n_sets               Number of sets to allocate. Must be at least 1.
+         *  @param in_ds_allocations_ptr   Array of @param in_n_sets allocation descriptors. Must not be nullptr.
+         *  @param out_descriptor_sets_ptr Deref will be set to @param in_n_sets descriptor sets, owned by the
+         *                                 allocator. Must not be nullptr.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool alloc_descriptor_sets(uint32_t                       in_n_sets,
+                                   const DescriptorSetAllocation* in_ds_allocations_ptr,
+                                   Anvil::DescriptorSet**         out_descriptor_sets_ptr);
+
+        /** Creates a new allocator instance.
+         *
+         *  @param in_device_ptr        Device to use. Must not be nullptr.
+         *  @param in_n_sets_per_pool   Number of sets each pool should be able to hold. Must be at least 1.
+         *  @param in_pool_create_flags Flags to create the pools with. If FREE_DESCRIPTOR_SET_BIT is included, retired
+         *                              sets are freed individually.
+         *  @param in_mt_safety         MT safety setting to use for the allocator.
+         *
+         *  @return New allocator instance.
+         **/
+        static Anvil::DescriptorPoolAllocatorUniquePtr create(const Anvil::BaseDevice*         in_device_ptr,
+                                                              uint32_t                         in_n_sets_per_pool   = 64,
+                                                              Anvil::DescriptorPoolCreateFlags in_pool_create_flags = Anvil::DescriptorPoolCreateFlagBits::NONE,
+                                                              MTSafety                         in_mt_safety         = Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE);
+
+        /** Counts descriptors of each type needed to allocate the specified sets.
+         *
+         *  @param in_n_sets                        Number of sets to take into account.
+         *  @param in_ds_allocations_ptr            Array of @param in_n_sets allocation descriptors. Must not be nullptr.
+         *  @param out_n_descriptors_needed_map_ptr Descriptor counts will be added to deref. Must not be nullptr.
+         *
+         *  @return true if successful, false if any of the layouts uses an inline uniform block binding.
+         **/
+        static bool get_n_descriptors_needed(uint32_t                       in_n_sets,
+                                             const DescriptorSetAllocation* in_ds_allocations_ptr,
+                                             DescriptorTypeToCountMap*      out_n_descriptors_needed_map_ptr);
+
+        /** Sets per-type descriptor counts of a new pool, so that the pool can hold @param in_n_max_sets sets of the
+         *  average composition observed so far.
+         *
+         *  @param in_n_max_sets               Number of sets the pool is going to be created for.
+         *  @param in_n_sets_allocated         Number of sets allocated so far. Must be at least 1.
+         *  @param in_n_descriptors_allocated  Number of descriptors of each type allocated so far.
+         *  @param in_n_descriptors_needed_map Number of descriptors of each type the pool must be able to hold, at minimum.
+         *  @param in_dp_create_info_ptr       Create info of the pool to configure. Must not be nullptr.
+         **/
+        static void set_pool_descriptor_counts(uint32_t                             in_n_max_sets,
+                                               uint64_t                             in_n_sets_allocated,
+                                               const DescriptorTypeToTotalCountMap& in_n_descriptors_allocated,
+                                               const DescriptorTypeToCountMap&      in_n_descriptors_needed_map,
+                                               Anvil::DescriptorPoolCreateInfo*     in_dp_create_info_ptr);
+
+        /** Returns the number of pools which are ready for reuse. Unless the pools are created with
+         *  FREE_DESCRIPTOR_SET_BIT, these hold no live descriptor sets.
+         **/
+        uint32_t get_n_free_pools() const
+        {
+            return static_cast<uint32_t>(m_free_pool_data_ptrs.size() );
+        }
+
+        /** Returns the total number of pools owned by the allocator. */
+        uint32_t get_n_pools() const
+        {
+            return static_cast<uint32_t>(m_pool_data_ptrs.size() );
+        }
+
+        /** Returns descriptor sets to the allocator.
+         *
+         *  The sets must not be accessed afterward. They must no longer be referenced by any pending
+         *  command buffers.
+         *
+         *  @param in_n_sets              Number of sets to retire.
+         *  @param in_descriptor_sets_ptr Array of @param in_n_sets descriptor sets, obtained from
+         *                                alloc_descriptor_sets(). Must not be nullptr.
+         **/
+        void retire_descriptor_sets(uint32_t                     in_n_sets,
+                                    Anvil::DescriptorSet* const* in_descriptor_sets_ptr);
+
+        /** Releases pools which hold no live descriptor sets, starting with the ones recycled the longest
+         *  time ago. Pools which are in use are never released.
+         *
+         *  @param in_n_free_pools_to_keep Number of pools to keep for reuse.
+         *
+         *  @return Number of released pools.
+         **/
+        uint32_t trim(uint32_t in_n_free_pools_to_keep = 0);
+
+    private:
+        /* Private type definitions */
+        typedef struct PoolData
+        {
+            std::vector<Anvil::DescriptorSetUniquePtr> ds_ptrs;
+            bool                                       is_free;
+            uint32_t                                   n_sets_alive;
+            Anvil::DescriptorPoolUniquePtr             pool_ptr;
+
+            PoolData()
+                :is_free     (false),
+                 n_sets_alive(0)
+            {
+                /* Stub */
+            }
+        } PoolData;
+
+        /* Private functions */
+        explicit DescriptorPoolAllocator(const Anvil::BaseDevice*         in_device_ptr,
+                                         uint32_t                         in_n_sets_per_pool,
+                                         Anvil::DescriptorPoolCreateFlags in_pool_create_flags,
+                                         bool                             in_mt_safe);
+
+        bool      alloc_from_pool(PoolData*                       in_pool_data_ptr,
+                                  uint32_t                        in_n_sets,
+                                  const DescriptorSetAllocation*  in_ds_allocations_ptr,
+                                  Anvil::DescriptorSet**          out_descriptor_sets_ptr,
+                                  VkResult*                       out_result_vk_ptr);
+        PoolData* create_pool    (uint32_t                        in_n_sets,
+                                  const DescriptorTypeToCountMap& in_n_descriptors_needed_map);
+        void      free_set       (PoolData*                       in_pool_data_ptr,
+                                  Anvil::DescriptorSet*           in_ds_ptr);
+        void      make_pool_free (PoolData*                       in_pool_data_ptr);
+        void      recycle_pool   (PoolData*                       in_pool_data_ptr);
+
+        /* Private variables */
+        PoolData*                                            m_current_pool_data_ptr;
+        const Anvil::BaseDevice*                             m_device_ptr;
+        std::unordered_map<Anvil::DescriptorSet*, PoolData*> m_ds_to_pool_data_map;
+        std::vector<PoolData*>                               m_free_pool_data_ptrs;
+        DescriptorTypeToTotalCountMap                        m_n_descriptors_allocated;
+        uint64_t                                             m_n_sets_allocated;
+        const uint32_t                                       m_n_sets_per_pool;
+        const Anvil::DescriptorPoolCreateFlags               m_pool_create_flags;
+        std::vector<std::unique_ptr<PoolData> >              m_pool_data_ptrs;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(DescriptorPoolAllocator);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(DescriptorPoolAllocator);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_DESCRIPTOR_POOL_ALLOCATOR_H */
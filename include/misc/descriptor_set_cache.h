@@ -0,0 +1,313 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a cache of fully written descriptor sets.
+ *
+ *  Sets are looked up by the layout they use and by the resources bound to them. Requesting a set whose
+ *  layout and bindings match a set returned earlier gives back the same, already written DescriptorSet
+ *  instance. Neither vkAllocateDescriptorSets() nor vkUpdateDescriptorSets() are called in that case.
+ *  On a miss, a new set is allocated from a DescriptorPoolAllocator owned by the cache, the bindings are
+ *  assigned and the set is updated before being returned.
+ *
+ *  Cached sets are evicted by frame age. begin_frame() should be called once per frame. Sets which have
+ *  not been requested for more than n_max_unused_frames frames are retired to the pool allocator at that
+ *  point. The allocator's pools are created with FREE_DESCRIPTOR_SET_BIT, so each evicted set is freed right
+ *  away and its space becomes reusable, even if other sets from the same pool stay cached for a long time.
+ *  The value must be at least the number of frames the application keeps in flight, so that sets are never
+ *  retired while pending command buffers still reference them.
+ *
+ *  Usage:
+ *
+ *  1. Describe the bindings with a DescriptorSetCache::Bindings instance. Its setters mirror
+ *     DescriptorSet::set_binding_item() and set_binding_array_items().
+ *  2. Call get_descriptor_set() with the layout and the bindings description.
+ *  3. Bind the returned set as usual. The set is owned by the cache and must not be modified.
+ *
+ *  Layouts should be obtained from the device's descriptor set layout manager (as DescriptorSetGroup
+ *  does). The cache holds a reference to each layout it has seen, so that the layouts outlive the
+ *  cached sets. Inline uniform block bindings are not supported.
+ *
+ *  Sets are keyed by wrapper instance addresses. When a buffer, buffer view, image view or sampler
+ *  bound to any cached set is released, all sets which refer to it are evicted immediately, so that a
+ *  new object allocated at the same address cannot be matched against them.
+ **/
+#ifndef MISC_DESCRIPTOR_SET_CACHE_H
+#define MISC_DESCRIPTOR_SET_CACHE_H
+
+#include "misc/callbacks.h"
+#include "misc/mt_safety.h"
+#include "misc/types.h"
+#include "wrappers/descriptor_set.h"
+#include <list>
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class DescriptorSetCache : public MTSafetySupportProvider
+    {
+    public:
+        /* Public type definitions */
+
+        /** Describes resources bound to a descriptor set. Used as the cache key. */
+        class Bindings
+        {
+        public:
+            /* Public functions */
+
+            /** Constructor. Creates an empty description. */
+            Bindings();
+
+            /** Removes all binding items from the description. */
+            void clear();
+
+            /** Returns a hash of all binding items added to the description so far. */
+            size_t get_hash() const
+            {
+                return m_hash;
+            }
+
+            /** Adds binding items to the description. Please see DescriptorSet::set_binding_array_items()
+             *  for argument discussion.
+             *
+             *  Two descriptions are only considered equal if their items have been added in the same order.
+             **/
+            template<typename BindingElementType>
+            void set_binding_array_items(BindingIndex              in_binding_index,
+                                         BindingElementArrayRange  in_element_range,
+                                         const BindingElementType* in_elements_ptr)
+            {
+                anvil_assert(in_elements_ptr != nullptr);
+
+                for (uint32_t n_element = 0;
+                              n_element < in_element_range.second;
+                            ++n_element)
+                {
+                    add_item(in_binding_index,
+                             in_element_range.first + n_element,
+                             in_elements_ptr[n_element].get_type(),
+                             in_elements_ptr[n_element]);
+                }
+            }
+
+            /** Adds a binding item for the zeroth element of the specified binding. */
+            template<typename BindingElementType>
+            void set_binding_item(BindingIndex              in_binding_index,
+                                  const BindingElementType& in_element)
+            {
+                set_binding_array_items(in_binding_index,
+                                        BindingElementArrayRange(0,  /* StartBindingElementIndex */
+                                                                 1), /* NumberOfBindingElements  */
+                                       &in_element);
+            }
+
+            bool operator==(const Bindings& in_bindings) const;
+
+        private:
+            /* Private type definitions */
+            typedef struct Item
+            {
+                BindingIndex          binding_index;
+                BindingElementIndex   element_index;
+                Anvil::DescriptorType descriptor_type;
+                Anvil::ImageLayout    image_layout;
+                void*                 object_ptr;
+                Anvil::Sampler*       sampler_ptr;
+                VkDeviceSize          size;
+                VkDeviceSize          start_offset;
+
+                bool operator==(const Item& in_item) const
+                {
+                    return (binding_index   == in_item.binding_index   &&
+                            element_index   == in_item.element_index   &&
+                            descriptor_type == in_item.descriptor_type &&
+                            image_layout    == in_item.image_layout    &&
+                            object_ptr      == in_item.object_ptr      &&
+                            sampler_ptr     == in_item.sampler_ptr     &&
+                            size            == in_item.size            &&
+                            start_offset    == in_item.start_offset);
+                }
+            } Item;
+
+            /* Private functions */
+            void add_item(BindingIndex                                                    in_binding_index,
+                          BindingElementIndex                                             in_element_index,
+                          Anvil::DescriptorType                                           in_descriptor_type,
+                          const Anvil::DescriptorSet::BufferBindingElement&               in_element);
+            void add_item(BindingIndex                                                    in_binding_index,
+                          BindingElementIndex                                             in_element_index,
+                          Anvil::DescriptorType                                           in_descriptor_type,
+                          const Anvil::DescriptorSet::CombinedImageSamplerBindingElement& in_element);
+            void add_item(BindingIndex                                                    in_binding_index,
+                          BindingElementIndex                                             in_element_index,
+                          Anvil::DescriptorType                                           in_descriptor_type,
+                          const Anvil::DescriptorSet::ImageBindingElement&                in_element);
+            void add_item(BindingIndex                                                    in_binding_index,
+                          BindingElementIndex                                             in_element_index,
+                          Anvil::DescriptorType                                           in_descriptor_type,
+                          const Anvil::DescriptorSet::SamplerBindingElement&              in_element);
+            void add_item(BindingIndex                                                    in_binding_index,
+                          BindingElementIndex                                             in_element_index,
+                          Anvil::DescriptorType                                           in_descriptor_type,
+                          const Anvil::DescriptorSet::TexelBufferBindingElement&          in_element);
+            void add_item(const Item&                                                     in_item);
+
+            /* Private variables */
+            size_t            m_hash;
+            std::vector<Item> m_items;
+
+            friend class DescriptorSetCache;
+        };
+
+        /* Public functions */
+
+        /** Destructor. Releases all cached descriptor sets and the pools they were allocated from. */
+        ~DescriptorSetCache();
+
+        /** Moves to the next frame and evicts sets which have not been requested for more than
+         *  n_max_unused_frames frames.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool begin_frame();
+
+        /** Creates a new cache instance.
+         *
+         *  @param in_device_ptr          Device to use. Must not be nullptr.
+         *  @param in_n_max_unused_frames Number of begin_frame() calls a set can stay unused for before it
+         *                                is evicted. Must not be smaller than the number of frames in flight.
+         *  @param in_n_sets_per_pool     Number of sets each internally created descriptor pool should be
+         *                                able to hold. Please see DescriptorPoolAllocator::create() for
+         *                                more details. Must be at least 1.
+         *  @param in_mt_safety           MT safety setting to use for the cache.
+         *
+         *  @return New cache instance.
+         **/
+        static Anvil::DescriptorSetCacheUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                         uint32_t                 in_n_max_unused_frames,
+                                                         uint32_t                 in_n_sets_per_pool = 64,
+                                                         MTSafety                 in_mt_safety       = Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE);
+
+        /** Returns a descriptor set which uses layout @param in_layout_ptr and has @param in_bindings assigned.
+         *
+         *  If such a set has been requested before and has not been evicted since, the cached instance is
+         *  returned. Otherwise, a new set is allocated and written.
+         *
+         *  The returned set is owned by the cache. It stays valid until it is evicted by begin_frame(), or
+         *  until the cache is released.
+         *
+         *  @param in_layout_ptr Layout to use for the set. Must not be nullptr. Must not have been created with
+         *                       PUSH_DESCRIPTOR_BIT_KHR create flag.
+         *  @param in_bindings   Resources to bind to the set.
+         *
+         *  @return Requested descriptor set or nullptr, if the function failed.
+         **/
+        Anvil::DescriptorSet* get_descriptor_set(const Anvil::DescriptorSetLayout* in_layout_ptr,
+                                                 const Bindings&                   in_bindings);
+
+        /** Returns the number of descriptor sets held by the cache. */
+        uint32_t get_n_cached_sets() const
+        {
+            return static_cast<uint32_t>(m_sets.size() );
+        }
+
+        /** Returns the number of get_descriptor_set() calls which returned a cached set. */
+        uint64_t get_n_hits() const
+        {
+            return m_n_hits;
+        }
+
+        /** Returns the number of get_descriptor_set() calls which had to allocate and write a new set. */
+        uint64_t get_n_misses() const
+        {
+            return m_n_misses;
+        }
+
+    private:
+        /* Private type definitions */
+        typedef struct LayoutData
+        {
+            Anvil::DescriptorPoolAllocator*     allocator_ptr;
+            Anvil::DescriptorSetLayoutUniquePtr layout_reference_ptr;
+            uint32_t                            n_variable_descriptor_count_binding_size;
+
+            LayoutData()
+                :allocator_ptr                           (nullptr),
+                 n_variable_descriptor_count_binding_size(0)
+            {
+                /* Stub */
+            }
+        } LayoutData;
+
+        typedef struct CachedSet
+        {
+            Anvil::DescriptorPoolAllocator*   allocator_ptr;
+            Bindings                          bindings;
+            Anvil::DescriptorSet*             ds_ptr;
+            size_t                            hash;
+            uint64_t                          last_used_frame;
+            const Anvil::DescriptorSetLayout* layout_ptr;
+        } CachedSet;
+
+        typedef std::list<CachedSet> CachedSets;
+
+        /* Private functions */
+        explicit DescriptorSetCache(const Anvil::BaseDevice* in_device_ptr,
+                                    uint32_t                 in_n_max_unused_frames,
+                                    uint32_t                 in_n_sets_per_pool,
+                                    bool                     in_mt_safe);
+
+        bool        assign_bindings                   (const Bindings&                   in_bindings,
+                                                       Anvil::DescriptorSet*             in_ds_ptr) const;
+        void        evict                             (CachedSets::iterator              in_set_iterator);
+        LayoutData* get_layout_data                   (const Anvil::DescriptorSetLayout* in_layout_ptr);
+        void        on_object_about_to_be_unregistered(CallbackArgument*                 in_callback_arg_ptr);
+        void        update_object_reference_counts    (const Bindings&                   in_bindings,
+                                                       bool                              in_should_increment);
+        void        update_subscriptions              (bool                              in_should_init);
+
+        /* Private variables */
+        Anvil::DescriptorPoolAllocatorUniquePtr m_allocator_ptr;
+        const Anvil::BaseDevice*                m_device_ptr;
+        uint64_t                                m_n_current_frame;
+        uint64_t                                m_n_hits;
+        const uint32_t                          m_n_max_unused_frames;
+        uint64_t                                m_n_misses;
+        const uint32_t                          m_n_sets_per_pool;
+        Anvil::DescriptorPoolAllocatorUniquePtr m_update_after_bind_allocator_ptr;
+
+        std::unordered_map<const Anvil::DescriptorSetLayout*, std::unique_ptr<LayoutData> > m_layouts;
+
+        /* Cached sets, most recently used first. m_set_iterators maps set hashes to items of m_sets. */
+        CachedSets                                            m_sets;
+        std::unordered_multimap<size_t, CachedSets::iterator> m_set_iterators;
+
+        /* Number of binding items of cached sets which refer to a given wrapper instance. Used to skip the
+         * eviction scan for released objects which are not referenced by any cached set. */
+        std::unordered_map<const void*, uint32_t>             m_n_object_references;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(DescriptorSetCache);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(DescriptorSetCache);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_DESCRIPTOR_SET_CACHE_H */
@@ -103,7 +103,13 @@ namespace Anvil
             return (m_n_variable_descriptor_count_binding != UINT32_MAX);
         }
 
-        static DescriptorSetCreateInfoUniquePtr create();
+        /** Creates a new DescriptorSetCreateInfo instance.
+         *
+         *  @param in_create_flags Layout create flags. If PUSH_DESCRIPTOR_BIT_KHR is specified, the layout can only be used
+         *                         for descriptor sets recorded with CommandBufferBase::record_push_descriptor_set(), and
+         *                         dynamic buffer bindings cannot be added. Requires VK_KHR_push_descriptor in that case.
+         **/
+        static DescriptorSetCreateInfoUniquePtr create(const Anvil::DescriptorSetLayoutCreateFlags& in_create_flags = Anvil::DescriptorSetLayoutCreateFlagBits::NONE);
 
         /* Fills & returns a VkDescriptorSetLayoutCreateInfo structure holding all information necessary to spawn
          * a new descriptor set layout instance.
@@ -164,6 +170,12 @@ namespace Anvil
                                                     bool*                          out_opt_immutable_samplers_enabled_ptr = nullptr,
                                                     Anvil::DescriptorBindingFlags* out_opt_flags_ptr                      = nullptr) const;
 
+        /** Returns layout create flags, as specified at creation time. */
+        const Anvil::DescriptorSetLayoutCreateFlags& get_create_flags() const
+        {
+            return m_create_flags;
+        }
+
         /** Returns the number of bindings defined for the layout. */
         uint32_t get_n_bindings() const
         {
@@ -185,6 +197,7 @@ namespace Anvil
         /** Describes a single descriptor set layout binding */
         typedef struct Binding
         {
+            BindingIndex                       binding_index;
             uint32_t                           descriptor_array_size;
             Anvil::DescriptorType              descriptor_type;
             Anvil::DescriptorBindingFlags      flags;
@@ -195,6 +208,7 @@ namespace Anvil
             /** Dummy constructor. Do not use. */
             Binding()
             {
+                binding_index         = UINT32_MAX;
                 descriptor_array_size = 0;
                 descriptor_type       = Anvil::DescriptorType::UNKNOWN;
             }
@@ -203,12 +217,14 @@ namespace Anvil
              *
              *  For argument discussion, please see Anvil::DescriptorSetLayout::add_binding() documentation.
              **/
-            Binding(uint32_t                      in_descriptor_array_size,
+            Binding(BindingIndex                  in_binding_index,
+                    uint32_t                      in_descriptor_array_size,
                     Anvil::DescriptorType         in_descriptor_type,
                     Anvil::ShaderStageFlags       in_stage_flags,
                     const Anvil::Sampler* const*  in_immutable_sampler_ptrs,
                     Anvil::DescriptorBindingFlags in_flags)
             {
+                binding_index         = in_binding_index;
                 descriptor_array_size = in_descriptor_array_size;
                 descriptor_type       = in_descriptor_type;
                 flags                 = in_flags;
@@ -227,7 +243,8 @@ namespace Anvil
 
             bool operator==(const Binding& in_binding) const
             {
-                return (descriptor_array_size == in_binding.descriptor_array_size) &&
+                return (binding_index         == in_binding.binding_index)         &&
+                       (descriptor_array_size == in_binding.descriptor_array_size) &&
                        (descriptor_type       == in_binding.descriptor_type)       &&
                        (flags                 == in_binding.flags)                 &&
                        (immutable_samplers    == in_binding.immutable_samplers)    &&
@@ -235,18 +252,23 @@ namespace Anvil
             }
         } Binding;
 
-        typedef std::map<BindingIndex, Binding> BindingIndexToBindingMap;
-
         /* Private functions */
 
         /* Please see create() documentation for more details */
-        DescriptorSetCreateInfo();
+        DescriptorSetCreateInfo(const Anvil::DescriptorSetLayoutCreateFlags& in_create_flags);
+
+        const Binding* get_binding(BindingIndex in_binding_index) const;
 
         /* Private variables */
-        BindingIndexToBindingMap m_bindings;
 
-        uint32_t                 m_n_variable_descriptor_count_binding;
-        uint32_t                 m_variable_descriptor_count_binding_size;
+        /* Bindings are stored contiguously, sorted by binding index. Index numbers used by get_binding_properties_by_index_number()
+         * map directly to vector indices.
+         */
+        std::vector<Binding> m_bindings;
+
+        Anvil::DescriptorSetLayoutCreateFlags m_create_flags;
+        uint32_t                              m_n_variable_descriptor_count_binding;
+        uint32_t                              m_variable_descriptor_count_binding_size;
 
         ANVIL_DISABLE_ASSIGNMENT_OPERATOR(DescriptorSetCreateInfo);
     };
@@ -40,7 +40,8 @@ namespace Anvil
          *
          * NOTE: By default, an empty pipeline cache will be created for pipeline manager usage. You can adjust this behavior, allowing for
          *       pipeline cache reuse across executions, by calling set_pipeline_cache_ptr() and retrieving pipeline cache data and caching it
-         *       at later time.
+         *       at later time. Alternatively, call set_persistent_pipeline_cache_directory() to have Anvil load & store pipeline cache
+         *       data on your behalf.
          *
          * NOTE: If VK_EXT_global_queue_priority is supported, all queues are associated MEDIUM_EXT global priority by default.
          *       This can be changed on a per-queue basis by calling set_queue_global_priority() prior to passing the structure
@@ -103,6 +104,11 @@ namespace Anvil
             return m_physical_device_ptrs;
         }
 
+        const std::string& get_persistent_pipeline_cache_directory() const
+        {
+            return m_persistent_pipeline_cache_directory;
+        }
+
         Anvil::PipelineCache* get_pipeline_cache_ptr() const
         {
             return m_pipeline_cache_ptr.get();
@@ -192,6 +198,22 @@ namespace Anvil
             m_queue_properties[in_queue_family_index][in_queue_index].global_priority = in_queue_global_priority;
         }
 
+        /* Requests a persistent pipeline cache, backed by a file stored under @param in_directory, to be created
+         * for pipeline manager usage. See Anvil::PipelineCache::create_persistent() for more details.
+         *
+         * The pipeline cache is loaded at device creation time, and written back to disk when the device is destroyed.
+         * Apps can also save it at any time by calling save() or save_async() on Anvil::BaseDevice::get_pipeline_cache().
+         *
+         * Ignored if a pipeline cache has been specified with set_pipeline_cache_ptr().
+         *
+         * @param in_directory Directory to store the pipeline cache file in. The directory must exist.
+         *                     Pass an empty string to disable the persistent pipeline cache (default).
+         */
+        void set_persistent_pipeline_cache_directory(const std::string& in_directory)
+        {
+            m_persistent_pipeline_cache_directory = in_directory;
+        }
+
         /* Caches user-specified pipeline cache for usage with pipeline managers. */
         void set_pipeline_cache_ptr(Anvil::PipelineCacheUniquePtr in_pipeline_cache_ptr)
         {
@@ -275,6 +297,7 @@ namespace Anvil
         std::vector<std::string>                                                     m_layers_to_enable;
         Anvil::MemoryOverallocationBehavior                                          m_memory_overallocation_behavior;
         bool                                                                         m_mt_safe;
+        std::string                                                                  m_persistent_pipeline_cache_directory;
         std::vector<const Anvil::PhysicalDevice*>                                    m_physical_device_ptrs;
         Anvil::PipelineCacheUniquePtr                                                m_pipeline_cache_ptr;
         std::unordered_map<uint32_t, std::unordered_map<uint32_t, QueueProperties> > m_queue_properties;
@@ -0,0 +1,174 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a CPU-side multi-draw-indirect packer.
+ *
+ *  Applications which issue many small draw calls sharing the same pipeline and bindings can pass them to
+ *  the batcher instead of recording them directly. The batcher writes the draw parameters to a persistently
+ *  mapped indirect buffer and, when flush() is called, replaces each run of consecutive draws of the same
+ *  kind with a single indirect draw call.
+ *
+ *  If VK_KHR_draw_indirect_count has been enabled for the device, the batcher also writes the number of draws
+ *  of each run to the buffer and uses the vkCmdDraw*IndirectCountKHR() entrypoints. This lets GPU-side culling
+ *  passes shrink the batches in place. If the multiDrawIndirect feature is not supported, each batched draw is
+ *  emitted as a separate indirect draw call.
+ *
+ *  Usage:
+ *
+ *  1. Call begin_frame() at the beginning of each frame.
+ *  2. Call add_draw() and add_draw_indexed() for all draws sharing the currently bound state.
+ *  3. Call flush() before the bound state is changed, and before the render pass ends.
+ *
+ *  The indirect buffer is split into one region per frame in flight. Draws added after a begin_frame() call
+ *  overwrite the region used n_frames_in_flight frames earlier, so the application must ensure the GPU has
+ *  finished executing command buffers which consumed that region.
+ **/
+#ifndef MISC_DRAW_BATCHER_H
+#define MISC_DRAW_BATCHER_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class DrawBatcher
+    {
+    public:
+        /* Public functions */
+
+        /** Destructor. Unmaps and releases the indirect buffer. */
+        ~DrawBatcher();
+
+        /** Queues a non-indexed draw.
+         *
+         *  Argument meaning is as per vkCmdDraw() specification.
+         *
+         *  @return true if successful, false if the per-frame draw limit has been reached.
+         **/
+        bool add_draw(uint32_t in_vertex_count,
+                      uint32_t in_instance_count,
+                      uint32_t in_first_vertex,
+                      uint32_t in_first_instance);
+
+        /** Queues an indexed draw.
+         *
+         *  Argument meaning is as per vkCmdDrawIndexed() specification.
+         *
+         *  @return true if successful, false if the per-frame draw limit has been reached.
+         **/
+        bool add_draw_indexed(uint32_t in_index_count,
+                              uint32_t in_instance_count,
+                              uint32_t in_first_index,
+                              int32_t  in_vertex_offset,
+                              uint32_t in_first_instance);
+
+        /** Moves to the next region of the indirect buffer.
+         *
+         *  Must not be called while there are draws which have not been flushed. Also see the usage notes above.
+         **/
+        void begin_frame();
+
+        /** Creates a new draw batcher instance.
+         *
+         *  @param in_device_ptr          Device to use. Must not be nullptr.
+         *  @param in_max_n_draws         Maximum number of draws which can be queued per frame.
+         *  @param in_n_frames_in_flight  Number of indirect buffer regions to cycle through. Must be at least 1.
+         *
+         *  @return New batcher instance, or nullptr if the indirect buffer could not be created or mapped.
+         **/
+        static Anvil::DrawBatcherUniquePtr create(Anvil::BaseDevice* in_device_ptr,
+                                                  uint32_t           in_max_n_draws,
+                                                  uint32_t           in_n_frames_in_flight = 1);
+
+        /** Records indirect draw calls for all draws queued since the last flush() call.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the draw calls into. Must be recording render pass
+         *                           commands. Must not be nullptr.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool flush(Anvil::CommandBufferBase* in_cmd_buffer_ptr);
+
+        /** Returns the indirect buffer instance. */
+        Anvil::Buffer* get_buffer() const
+        {
+            return m_buffer_ptr.get();
+        }
+
+        /** Returns the number of draws queued in the current frame, including ones which have already been flushed. */
+        uint32_t get_n_draws() const
+        {
+            return m_n_draws;
+        }
+
+    private:
+        /* Private type definitions */
+
+        /* Describes a run of consecutive draws of the same kind, stored back-to-back in the indirect buffer. */
+        typedef struct Batch
+        {
+            bool         indexed;
+            uint32_t     n_draws;
+            VkDeviceSize start_offset;
+
+            Batch(bool         in_indexed,
+                  VkDeviceSize in_start_offset)
+                :indexed     (in_indexed),
+                 n_draws     (0),
+                 start_offset(in_start_offset)
+            {
+                /* Stub */
+            }
+        } Batch;
+
+        /* Private functions */
+        explicit DrawBatcher(Anvil::BaseDevice* in_device_ptr,
+                             uint32_t           in_max_n_draws,
+                             uint32_t           in_n_frames_in_flight);
+
+        bool add_draw_data(bool        in_indexed,
+                           const void* in_data_ptr,
+                           uint32_t    in_data_size);
+        bool init         ();
+
+        /* Private variables */
+        std::vector<Batch>     m_batches;
+        Anvil::BufferUniquePtr m_buffer_ptr;
+        VkDeviceSize           m_counts_region_offset;
+        Anvil::BaseDevice*     m_device_ptr;
+        VkDeviceSize           m_frame_region_size;
+        uint8_t*               m_mapped_data_ptr;
+        uint32_t               m_max_n_draws;
+        uint32_t               m_max_n_draws_per_call;
+        uint32_t               m_n_current_frame;
+        uint32_t               m_n_draws;
+        uint32_t               m_n_frames_in_flight;
+        uint32_t               m_n_used_counts;
+        VkDeviceSize           m_next_draw_offset;
+        bool                   m_use_count_entrypoints;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(DrawBatcher);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(DrawBatcher);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_DRAW_BATCHER_H */
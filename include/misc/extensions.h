@@ -106,6 +106,7 @@ namespace Anvil
             ValueType khr_maintenance2;
             ValueType khr_maintenance3;
             ValueType khr_multiview;
+            ValueType khr_push_descriptor;
             ValueType khr_relaxed_block_layout;
             ValueType khr_sampler_mirror_clamp_to_edge;
             ValueType khr_sampler_ycbcr_conversion;
@@ -116,6 +117,7 @@ namespace Anvil
             ValueType khr_storage_buffer_storage_class;
             ValueType khr_swapchain;
             ValueType khr_swapchain_mutable_format;
+            ValueType khr_timeline_semaphore;
             ValueType khr_variable_pointers;
             ValueType khr_vulkan_memory_model;
 
@@ -216,6 +218,7 @@ namespace Anvil
                     {ExtensionData(VK_KHR_MAINTENANCE2_EXTENSION_NAME,                     &khr_maintenance2)},
                     {ExtensionData(VK_KHR_MAINTENANCE3_EXTENSION_NAME,                     &khr_maintenance3)},
                     {ExtensionData(VK_KHR_MULTIVIEW_EXTENSION_NAME,                        &khr_multiview)},
+                    {ExtensionData(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME,                  &khr_push_descriptor)},
                     {ExtensionData(VK_KHR_RELAXED_BLOCK_LAYOUT_EXTENSION_NAME,             &khr_relaxed_block_layout)},
                     {ExtensionData(VK_KHR_SAMPLER_MIRROR_CLAMP_TO_EDGE_EXTENSION_NAME,     &khr_sampler_mirror_clamp_to_edge)},
                     {ExtensionData(VK_KHR_SAMPLER_YCBCR_CONVERSION_EXTENSION_NAME,         &khr_sampler_ycbcr_conversion)},
@@ -226,6 +229,7 @@ namespace Anvil
                     {ExtensionData(VK_KHR_STORAGE_BUFFER_STORAGE_CLASS_EXTENSION_NAME,     &khr_storage_buffer_storage_class)},
                     {ExtensionData(VK_KHR_SWAPCHAIN_EXTENSION_NAME,                        &khr_swapchain)},
                     {ExtensionData(VK_KHR_SWAPCHAIN_MUTABLE_FORMAT_EXTENSION_NAME,         &khr_swapchain_mutable_format)},
+                    {ExtensionData(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME,               &khr_timeline_semaphore)},
                     {ExtensionData(VK_KHR_VARIABLE_POINTERS_EXTENSION_NAME,                &khr_variable_pointers)},
                     {ExtensionData(VK_KHR_VULKAN_MEMORY_MODEL_EXTENSION_NAME,              &khr_vulkan_memory_model)},
 
@@ -418,6 +422,7 @@ namespace Anvil
         virtual ValueType khr_maintenance2                    () const = 0;
         virtual ValueType khr_maintenance3                    () const = 0;
         virtual ValueType khr_multiview                       () const = 0;
+        virtual ValueType khr_push_descriptor                 () const = 0;
         virtual ValueType khr_relaxed_block_layout            () const = 0;
         virtual ValueType khr_sampler_mirror_clamp_to_edge    () const = 0;
         virtual ValueType khr_sampler_ycbcr_conversion        () const = 0;
@@ -428,6 +433,7 @@ namespace Anvil
         virtual ValueType khr_storage_buffer_storage_class    () const = 0;
         virtual ValueType khr_swapchain                       () const = 0;
         virtual ValueType khr_swapchain_mutable_format        () const = 0;
+        virtual ValueType khr_timeline_semaphore              () const = 0;
         virtual ValueType khr_variable_pointers               () const = 0;
         virtual ValueType khr_vulkan_memory_model             () const = 0;
 
@@ -1038,6 +1044,13 @@ namespace Anvil
             return m_device_extensions_ptr->khr_multiview;
         }
 
+        ValueType khr_push_descriptor() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->khr_push_descriptor;
+        }
+
         ValueType khr_relaxed_block_layout() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -1108,6 +1121,13 @@ namespace Anvil
             return m_device_extensions_ptr->khr_swapchain_mutable_format;
         }
 
+        ValueType khr_timeline_semaphore() const final
+        {
+            anvil_assert(m_expose_device_extensions);
+
+            return m_device_extensions_ptr->khr_timeline_semaphore;
+        }
+
         ValueType khr_variable_pointers() const final
         {
             anvil_assert(m_expose_device_extensions);
@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a fence completion reactor.
+ *
+ *  The reactor owns a single background thread, which waits on batches of outstanding fences with
+ *  vkWaitForFences(waitAll = VK_FALSE) and dispatches callbacks associated with the fences as soon as
+ *  they become signalled. This lets applications and Anvil helpers react to GPU work completion
+ *  (eg. recycle staging buffers or release objects which can only be destroyed once the GPU is done
+ *  with them) without blocking the submitting thread or polling.
+ *
+ *  The thread blocks in vkWaitForFences() without a timeout. When a callback is registered while the thread
+ *  is blocked, the reactor wakes it up by signalling an internal wake fence with an empty submission to one of
+ *  the device's queues. If MT safety is disabled for that queue, the application must not submit to the first
+ *  transfer queue (or, if there is none, the first compute or universal queue) while registering callbacks
+ *  from another thread.
+ *
+ *  If waiting on the fences fails (eg. because the device has been lost), the reactor stops waiting and
+ *  dispatches all pending callbacks right away, as the fences may never become signalled. Callbacks
+ *  registered afterward are dispatched from the registering thread.
+ *
+ *  Callbacks are invoked from the reactor thread, in no particular order. They must not call back
+ *  into the reactor.
+ **/
+#ifndef MISC_FENCE_REACTOR_H
+#define MISC_FENCE_REACTOR_H
+
+#include "misc/types.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+namespace Anvil
+{
+    class FenceReactor
+    {
+    public:
+        /* Public type definitions */
+
+        /** Prototype of a function called when a fence becomes signalled. */
+        typedef std::function<void()> CompletionCallbackFunction;
+
+        /* Public functions */
+
+        /** Destructor.
+         *
+         *  Stops the reactor thread. Callbacks of fences, which are signalled at destruction time, are
+         *  dispatched from the calling thread. All other callbacks are dropped without being called.
+         **/
+        ~FenceReactor();
+
+        /** Creates a new fence reactor instance and spawns its thread.
+         *
+         *  @param in_device_ptr Device which all fences passed to the reactor are going to be created
+         *                       for. Must not be nullptr.
+         *
+         *  @return New reactor instance.
+         **/
+        static Anvil::FenceReactorUniquePtr create(const Anvil::BaseDevice* in_device_ptr);
+
+        /** Registers a callback, which is going to be called once @param in_fence_ptr becomes signalled.
+         *
+         *  The fence must stay alive and must not be reset until the callback is dispatched. If the fence
+         *  is never submitted, the callback is never called.
+         *
+         *  @param in_fence_ptr         Fence to wait on. Must not be nullptr.
+         *  @param in_callback_function Function to call. Must not be nullptr.
+         **/
+        void add_callback(Anvil::Fence*              in_fence_ptr,
+                          CompletionCallbackFunction in_callback_function);
+
+        /** Same as the above function, except that the reactor takes ownership of the fence and releases
+         *  it right after the callback is dispatched.
+         *
+         *  This is the preferred way of using fences retrieved with BaseDevice::get_fence_from_pool(), as
+         *  it returns the fence to the pool as soon as it is no longer needed.
+         **/
+        void add_callback(Anvil::FenceUniquePtr      in_fence_ptr,
+                          CompletionCallbackFunction in_callback_function);
+
+        /** Postpones release of @param in_object until @param in_fence_ptr becomes signalled.
+         *
+         *  Useful for releasing objects (eg. staging buffers or descriptor sets), which may only be
+         *  destroyed once the GPU has finished using them. The object is released from the reactor thread.
+         *
+         *  @param in_fence_ptr Fence to wait on. Please see add_callback() for requirements.
+         *  @param in_object    Object to release. Typically an auto pointer.
+         **/
+        template<class ObjectType>
+        void defer_release(Anvil::Fence* in_fence_ptr,
+                           ObjectType    in_object)
+        {
+            auto object_ptr = std::make_shared<ObjectType>(std::move(in_object) );
+
+            add_callback(in_fence_ptr,
+                         [object_ptr]() mutable
+                         {
+                             object_ptr.reset();
+                         });
+        }
+
+        /** Returns the number of callbacks, which have not been dispatched yet. */
+        uint32_t get_n_pending_callbacks() const;
+
+        /** Blocks until all callbacks registered prior to the call are dispatched.
+         *
+         *  All fences associated with pending callbacks must have been submitted, or the function will
+         *  never return.
+         **/
+        void wait_idle();
+
+    private:
+        /* Private type definitions */
+        enum
+        {
+            /* Maximum number of fences passed to a single vkWaitForFences() call, including the wake fence */
+            N_MAX_FENCES_PER_WAIT = 64
+        };
+
+        typedef struct PendingCallback
+        {
+            CompletionCallbackFunction callback_function;
+            Anvil::Fence*              fence_ptr;
+            Anvil::FenceUniquePtr      owned_fence_ptr;
+
+            PendingCallback(Anvil::Fence*               in_fence_ptr,
+                            Anvil::FenceUniquePtr       in_owned_fence_ptr,
+                            CompletionCallbackFunction  in_callback_function)
+                :callback_function(std::move(in_callback_function) ),
+                 fence_ptr        (in_fence_ptr),
+                 owned_fence_ptr  (std::move(in_owned_fence_ptr) )
+            {
+                /* Stub */
+            }
+        } PendingCallback;
+
+        /* Private functions */
+        explicit FenceReactor(const Anvil::BaseDevice* in_device_ptr);
+
+        void add_pending_callback      (PendingCallback in_callback);
+        void dispatch_callbacks        (uint32_t        in_n_callbacks_to_check,
+                                        bool            in_should_check_fences);
+        void reactor_thread_entrypoint ();
+        bool should_wake_reactor_thread();
+        void wake_reactor_thread       ();
+
+        /* Private variables */
+        std::vector<PendingCallback> m_completed_callbacks;
+        const Anvil::BaseDevice*     m_device_ptr;
+        bool                         m_has_failed;
+        std::condition_variable      m_idle_cv;
+        bool                         m_is_dispatching;
+        bool                         m_is_wake_pending;
+        bool                         m_is_wake_submitted;
+        bool                         m_is_waiting;
+        mutable std::mutex           m_mutex;
+        std::vector<PendingCallback> m_pending_callbacks;
+        std::condition_variable      m_pending_callbacks_cv;
+        std::thread                  m_reactor_thread;
+        bool                         m_should_terminate;
+        Anvil::FenceUniquePtr        m_wake_fence_ptr;
+        Anvil::Queue*                m_wake_queue_ptr;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(FenceReactor);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(FenceReactor);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_FENCE_REACTOR_H */
@@ -0,0 +1,172 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a per-frame command buffer allocator.
+ *
+ *  The allocator owns a ring of frame slots, one for each frame in flight. Each slot holds one command
+ *  pool per recording thread. Command buffers are handed out linearly from the pool owned by the
+ *  current slot and the calling thread. When a slot is reused, the allocator waits for the fence the
+ *  application associated with it, and recycles all command buffers allocated from the slot with a
+ *  single CommandPool::reset() call per pool. This is much cheaper than resetting each command buffer
+ *  separately.
+ *
+ *  Usage:
+ *
+ *  1. Call begin_frame() at the beginning of each frame, passing the fence which is going to be signalled
+ *     when the GPU finishes executing the frame's command buffers.
+ *  2. Retrieve command buffers with get_primary_command_buffer() and get_secondary_command_buffer().
+ *     Threads must use distinct thread indices. The command buffers are owned by the allocator and stay
+ *     valid until the slot is reused, n_frames_in_flight begin_frame() calls later.
+ *
+ *  begin_frame() must not be called while any of the threads is retrieving or recording command buffers.
+ **/
+#ifndef MISC_FRAME_COMMAND_ALLOCATOR_H
+#define MISC_FRAME_COMMAND_ALLOCATOR_H
+
+#include "misc/frame_ring.h"
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class FrameCommandAllocator
+    {
+    public:
+        /* Public functions */
+
+        /** Destructor. Releases all command buffers and command pools owned by the allocator. */
+        ~FrameCommandAllocator();
+
+        /** Moves to the next frame slot.
+         *
+         *  If a fence has been associated with the slot when it was last used, the function blocks until
+         *  the fence is signalled. The fence is NOT reset. All command pools of the slot are then reset, which
+         *  makes the command buffers allocated from them available again.
+         *
+         *  @param in_opt_frame_fence_ptr Fence which is going to be signalled when the GPU finishes executing
+         *                                command buffers recorded for the new frame. Must stay alive until the
+         *                                slot is reused. May be nullptr, in which case the application must
+         *                                ensure the slot's command buffers are no longer in use by the time
+         *                                the slot is reused.
+         *
+         *  @return true if successful, false otherwise. If the function fails, the current slot is not changed
+         *          and the call may be retried.
+         **/
+        bool begin_frame(Anvil::Fence* in_opt_frame_fence_ptr);
+
+        /** Creates a new allocator instance.
+         *
+         *  @param in_device_ptr          Device to use. Must not be nullptr.
+         *  @param in_queue_family_index  Index of the Vulkan queue family the command buffers are going to be
+         *                                submitted to.
+         *  @param in_n_frames_in_flight  Number of frame slots to use. Must be at least 1.
+         *  @param in_n_threads           Number of threads which are going to retrieve command buffers from
+         *                                the allocator. Must be at least 1.
+         *
+         *  @return New allocator instance.
+         **/
+        static Anvil::FrameCommandAllocatorUniquePtr create(Anvil::BaseDevice* in_device_ptr,
+                                                            uint32_t           in_queue_family_index,
+                                                            uint32_t           in_n_frames_in_flight,
+                                                            uint32_t           in_n_threads = 1);
+
+        /** Returns index of the current frame slot. */
+        uint32_t get_current_frame_index() const
+        {
+            return m_frame_ring.get_current_frame_index();
+        }
+
+        /** Returns the number of frame slots used by the allocator. */
+        uint32_t get_n_frames_in_flight() const
+        {
+            return static_cast<uint32_t>(m_frames.size() );
+        }
+
+        /** Returns the number of threads the allocator has been created for. */
+        uint32_t get_n_threads() const
+        {
+            return m_n_threads;
+        }
+
+        /** Returns a primary command buffer, allocated from the current frame slot's command pool owned by
+         *  thread @param in_n_thread.
+         *
+         *  The command buffer is in the initial state. It must not be released by the caller.
+         *
+         *  @param in_n_thread Index of the calling thread. Must be smaller than get_n_threads().
+         *
+         *  @return As per description.
+         **/
+        Anvil::PrimaryCommandBuffer* get_primary_command_buffer(uint32_t in_n_thread = 0);
+
+        /** Returns a secondary command buffer, allocated from the current frame slot's command pool owned by
+         *  thread @param in_n_thread.
+         *
+         *  The command buffer is in the initial state. It must not be released by the caller.
+         *
+         *  @param in_n_thread Index of the calling thread. Must be smaller than get_n_threads().
+         *
+         *  @return As per description.
+         **/
+        Anvil::SecondaryCommandBuffer* get_secondary_command_buffer(uint32_t in_n_thread = 0);
+
+    private:
+        /* Private type definitions */
+        typedef struct ThreadData
+        {
+            Anvil::CommandPoolUniquePtr                         command_pool_ptr;
+            uint32_t                                            n_primary_cmd_buffers_used;
+            uint32_t                                            n_secondary_cmd_buffers_used;
+            std::vector<Anvil::PrimaryCommandBufferUniquePtr>   primary_cmd_buffer_ptrs;
+            std::vector<Anvil::SecondaryCommandBufferUniquePtr> secondary_cmd_buffer_ptrs;
+
+            ThreadData()
+                :n_primary_cmd_buffers_used  (0),
+                 n_secondary_cmd_buffers_used(0)
+            {
+                /* Stub */
+            }
+        } ThreadData;
+
+        typedef struct FrameData
+        {
+            std::vector<ThreadData> thread_data;
+        } FrameData;
+
+        /* Private functions */
+        explicit FrameCommandAllocator(Anvil::BaseDevice* in_device_ptr,
+                                       uint32_t           in_queue_family_index,
+                                       uint32_t           in_n_frames_in_flight,
+                                       uint32_t           in_n_threads);
+
+        /* Private variables */
+        Anvil::BaseDevice*     m_device_ptr;
+        Anvil::FrameRing       m_frame_ring;
+        std::vector<FrameData> m_frames;
+        uint32_t               m_n_threads;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(FrameCommandAllocator);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(FrameCommandAllocator);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_FRAME_COMMAND_ALLOCATOR_H */
@@ -0,0 +1,228 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a per-frame linear descriptor set allocator.
+ *
+ *  Meant for transient descriptor sets, which are only used by the frame they were allocated for. Examples are
+ *  per-draw sets with dynamic contents. The allocator owns a ring of frame slots, one for each frame in flight.
+ *  Each slot holds a list of descriptor pools per allocating thread. The pools are created without
+ *  FREE_DESCRIPTOR_SET_BIT. Descriptor sets are allocated linearly from the current pool of the current slot and
+ *  the calling thread. When that pool is exhausted, the allocator moves on to the next pool on the list, creating
+ *  a new one if needed. When a slot is reused, the allocator waits for the fence the application associated with
+ *  it. It then releases all descriptor sets allocated from the slot with a single DescriptorPool::reset() call per
+ *  pool.
+ *
+ *  New pools are sized from the observed usage, in the same way as DescriptorPoolAllocator does it. Pools persist
+ *  across frames, and so do DescriptorSet wrappers. Each pool keeps the wrappers created for it, grouped by layout,
+ *  and re-targets them at the sets allocated after the pool is reset. After a couple of frames, allocations stop
+ *  creating new Vulkan objects or wrappers, and resetting a pool does not need to release any wrappers.
+ *
+ *  Usage:
+ *
+ *  1. Call begin_frame() at the beginning of each frame, passing the fence which is going to be signalled
+ *     when the GPU finishes executing the frame's command buffers.
+ *  2. Allocate descriptor sets with alloc_descriptor_sets(). Threads must use distinct thread indices. The sets
+ *     are owned by the allocator and stay valid until the slot is reused, n_frames_in_flight begin_frame() calls
+ *     later.
+ *
+ *  begin_frame() must not be called while any of the threads is allocating or updating descriptor sets. Layouts
+ *  used to allocate descriptor sets must stay alive for as long as the allocator, as wrappers created for them
+ *  are kept for reuse.
+ *
+ *  Inline uniform block bindings are not supported.
+ **/
+#ifndef MISC_FRAME_DESCRIPTOR_ALLOCATOR_H
+#define MISC_FRAME_DESCRIPTOR_ALLOCATOR_H
+
+#include "misc/descriptor_pool_allocator.h"
+#include "misc/frame_ring.h"
+#include "misc/types.h"
+#include <unordered_map>
+
+
+namespace Anvil
+{
+    class FrameDescriptorAllocator
+    {
+    public:
+        /* Public functions */
+
+        /** Destructor. Releases all descriptor sets and descriptor pools owned by the allocator. */
+        ~FrameDescriptorAllocator();
+
+        /** Allocates descriptor sets from the current frame slot's pools owned by thread @param in_n_thread.
+         *
+         *  All sets requested by a single call are allocated from the same pool. The sets must not be released
+         *  by the caller.
+         *
+         *  @param in_n_sets               Number of sets to allocate. Must be at least 1.
+         *  @param in_ds_allocations_ptr   Array of @param in_n_sets allocation descriptors. Must not be nullptr.
+         *  @param out_descriptor_sets_ptr Deref will be set to @param in_n_sets descriptor sets. Must not be nullptr.
+         *  @param in_n_thread             Index of the calling thread. Must be smaller than get_n_threads().
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool alloc_descriptor_sets(uint32_t                       in_n_sets,
+                                   const DescriptorSetAllocation* in_ds_allocations_ptr,
+                                   Anvil::DescriptorSet**         out_descriptor_sets_ptr,
+                                   uint32_t                       in_n_thread = 0);
+
+        /** Moves to the next frame slot.
+         *
+         *  If a fence has been associated with the slot when it was last used, the function blocks until
+         *  the fence is signalled. The fence is NOT reset. All descriptor pools of the slot are then reset,
+         *  which releases the descriptor sets allocated from them.
+         *
+         *  @param in_opt_frame_fence_ptr Fence which is going to be signalled when the GPU finishes executing
+         *                                command buffers recorded for the new frame. Must stay alive until the
+         *                                slot is reused. May be nullptr, in which case the application must
+         *                                ensure the slot's descriptor sets are no longer in use by the time
+         *                                the slot is reused.
+         *
+         *  @return true if successful, false otherwise. If the function fails, the current slot is not changed
+         *          and the call may be retried.
+         **/
+        bool begin_frame(Anvil::Fence* in_opt_frame_fence_ptr);
+
+        /** Creates a new allocator instance.
+         *
+         *  @param in_device_ptr         Device to use. Must not be nullptr.
+         *  @param in_n_frames_in_flight Number of frame slots to use. Must be at least 1.
+         *  @param in_n_threads          Number of threads which are going to allocate descriptor sets from
+         *                               the allocator. Must be at least 1.
+         *  @param in_n_sets_per_pool    Number of sets each pool should be able to hold. Must be at least 1.
+         *
+         *  @return New allocator instance.
+         **/
+        static Anvil::FrameDescriptorAllocatorUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                               uint32_t                 in_n_frames_in_flight,
+                                                               uint32_t                 in_n_threads       = 1,
+                                                               uint32_t                 in_n_sets_per_pool = 256);
+
+        /** Returns index of the current frame slot. */
+        uint32_t get_current_frame_index() const
+        {
+            return m_frame_ring.get_current_frame_index();
+        }
+
+        /** Returns the number of frame slots used by the allocator. */
+        uint32_t get_n_frames_in_flight() const
+        {
+            return static_cast<uint32_t>(m_frames.size() );
+        }
+
+        /** Returns the number of threads the allocator has been created for. */
+        uint32_t get_n_threads() const
+        {
+            return static_cast<uint32_t>(m_thread_usage.size() );
+        }
+
+    private:
+        /* Private type definitions */
+        /* Wrappers created for descriptor sets of a single layout, allocated from a single pool. The first n_ds_used
+         * ones wrap descriptor sets allocated since the pool was last reset. The others wait to be reused.
+         */
+        typedef struct WrapperData
+        {
+            std::vector<Anvil::DescriptorSetUniquePtr> ds_ptrs;
+            uint32_t                                   n_ds_used;
+
+            WrapperData()
+                :n_ds_used(0)
+            {
+                /* Stub */
+            }
+        } WrapperData;
+
+        typedef struct PoolData
+        {
+            uint32_t                                                           n_sets_allocated;
+            Anvil::DescriptorPoolUniquePtr                                     pool_ptr;
+            std::unordered_map<const Anvil::DescriptorSetLayout*, WrapperData> wrapper_data_map;
+
+            PoolData()
+                :n_sets_allocated(0)
+            {
+                /* Stub */
+            }
+        } PoolData;
+
+        typedef struct ThreadData
+        {
+            uint32_t                                n_current_pool;
+            std::vector<std::unique_ptr<PoolData> > pool_data_ptrs;
+
+            ThreadData()
+                :n_current_pool(0)
+            {
+                /* Stub */
+            }
+        } ThreadData;
+
+        typedef struct FrameData
+        {
+            std::vector<ThreadData> thread_data;
+        } FrameData;
+
+        /* Usage statistics and scratch storage are kept per thread, so that threads never need to synchronize. */
+        typedef struct ThreadUsageData
+        {
+            std::vector<VkDescriptorSet>                           ds_vk_cache;
+            DescriptorPoolAllocator::DescriptorTypeToTotalCountMap n_descriptors_allocated;
+            uint64_t                                               n_sets_allocated;
+
+            ThreadUsageData()
+                :n_sets_allocated(0)
+            {
+                /* Stub */
+            }
+        } ThreadUsageData;
+
+        /* Private functions */
+        explicit FrameDescriptorAllocator(const Anvil::BaseDevice* in_device_ptr,
+                                          uint32_t                 in_n_frames_in_flight,
+                                          uint32_t                 in_n_threads,
+                                          uint32_t                 in_n_sets_per_pool);
+
+        bool                      alloc_from_pool(PoolData*                                                in_pool_data_ptr,
+                                                  uint32_t                                                 in_n_sets,
+                                                  const DescriptorSetAllocation*                           in_ds_allocations_ptr,
+                                                  ThreadUsageData*                                         in_usage_data_ptr,
+                                                  Anvil::DescriptorSet**                                   out_descriptor_sets_ptr,
+                                                  VkResult*                                                out_result_vk_ptr) const;
+        std::unique_ptr<PoolData> create_pool    (uint32_t                                                 in_n_sets,
+                                                  const ThreadUsageData&                                   in_usage_data,
+                                                  const DescriptorPoolAllocator::DescriptorTypeToCountMap& in_n_descriptors_needed_map) const;
+
+        /* Private variables */
+        const Anvil::BaseDevice*     m_device_ptr;
+        Anvil::FrameRing             m_frame_ring;
+        std::vector<FrameData>       m_frames;
+        const uint32_t               m_n_sets_per_pool;
+        std::vector<ThreadUsageData> m_thread_usage;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(FrameDescriptorAllocator);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(FrameDescriptorAllocator);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_FRAME_DESCRIPTOR_ALLOCATOR_H */
@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements the fence-guarded ring of frame slots shared by per-frame allocators.
+ *
+ *  The ring tracks which slot is current and the fence the application associated with each slot. Owners keep
+ *  their per-slot data in a vector of their own, indexed by the slot indices reported by the ring.
+ *
+ *  A typical begin_frame() implementation calls wait_for_next_frame(), recycles the resources of the slot it
+ *  reports, and calls advance() once recycling has succeeded. If any of these steps fails, the ring keeps
+ *  pointing at the old slot, so that the frame can be retried.
+ **/
+#ifndef MISC_FRAME_RING_H
+#define MISC_FRAME_RING_H
+
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class FrameRing
+    {
+    public:
+        /* Public functions */
+
+        /** Constructor.
+         *
+         *  @param in_device_ptr Device the fences are going to be created for. Must not be nullptr.
+         *  @param in_n_frames   Number of frame slots to use. Must be at least 1.
+         **/
+        FrameRing(const Anvil::BaseDevice* in_device_ptr,
+                  uint32_t                 in_n_frames);
+
+        /** Makes the slot following the current one current, and associates @param in_opt_frame_fence_ptr with it.
+         *
+         *  Must only be called after wait_for_next_frame() has succeeded.
+         *
+         *  @param in_opt_frame_fence_ptr Fence which is going to be signalled when the GPU finishes executing the
+         *                                new frame. Must stay alive until the slot is reused. May be nullptr.
+         **/
+        void advance(Anvil::Fence* in_opt_frame_fence_ptr);
+
+        /** Returns index of the current frame slot. */
+        uint32_t get_current_frame_index() const
+        {
+            return m_n_current_frame;
+        }
+
+        /** Returns the number of frame slots in the ring. */
+        uint32_t get_n_frames() const
+        {
+            return static_cast<uint32_t>(m_fence_ptrs.size() );
+        }
+
+        /** Blocks until the fence associated with the slot following the current one, if any, is signalled.
+         *  The fence is NOT reset. The current slot is not changed.
+         *
+         *  @param out_n_next_frame_ptr Deref will be set to the index of the slot following the current one.
+         *                              Must not be nullptr.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool wait_for_next_frame(uint32_t* out_n_next_frame_ptr) const;
+
+    private:
+        /* Private variables */
+        const Anvil::BaseDevice*   m_device_ptr;
+        std::vector<Anvil::Fence*> m_fence_ptrs;
+        uint32_t                   m_n_current_frame;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(FrameRing);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(FrameRing);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_FRAME_RING_H */
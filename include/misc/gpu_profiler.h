@@ -0,0 +1,253 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a hierarchical GPU profiler, which measures execution time of nested scopes with timestamp queries.
+ *
+ *  Each frame in flight owns a timestamp query pool and a region of a persistently mapped, host-visible buffer.
+ *  At the end of a frame, query results are copied to the frame's region with vkCmdCopyQueryPoolResults().
+ *  The region is read back when the frame's resources are about to be reused, n_frames_in_flight frames later,
+ *  so retrieving the results never blocks the CPU. If the frame which last used the resources has not finished
+ *  executing by then, the resources cannot be reused yet. The new frame is then not profiled, and the read-back of
+ *  the older frame is retried once the resources come around again.
+ *
+ *  Usage:
+ *
+ *  1. Call begin_frame() at the beginning of each frame. The command buffer must execute before any command
+ *     buffer which records scopes for the frame.
+ *  2. Surround commands of interest with begin_scope() and end_scope() calls, or use GPUProfiler::Scope instances.
+ *     Scopes can be nested. Nesting is tracked separately for each command buffer.
+ *  3. Call end_frame() at the end of each frame. The command buffer must execute after all command buffers which
+ *     recorded scopes for the frame.
+ *  4. Use get_results() to retrieve timings of the most recently resolved frame.
+ *
+ *  All command buffers must be submitted to queues from families which support timestamp queries.
+ *
+ *  If a queue is specified at creation time, resolved scopes are also forwarded to the tracer while a capture is
+ *  in progress. The queue must have been calibrated with Tracer::calibrate_queue().
+ *
+ *  begin_scope() and end_scope() are thread-safe, so scopes can be recorded in parallel to multiple command buffers.
+ **/
+#ifndef MISC_GPU_PROFILER_H
+#define MISC_GPU_PROFILER_H
+
+#include "misc/types.h"
+#include <map>
+#include <mutex>
+
+
+namespace Anvil
+{
+    class GPUProfiler
+    {
+    public:
+        /* Public type definitions */
+
+        /** Records a scope covering the lifetime of the instance. */
+        class Scope
+        {
+        public:
+            Scope(Anvil::GPUProfiler*       in_profiler_ptr,
+                  Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                  const std::string&        in_name)
+                :m_cmd_buffer_ptr(in_cmd_buffer_ptr),
+                 m_profiler_ptr  (in_profiler_ptr)
+            {
+                m_profiler_ptr->begin_scope(m_cmd_buffer_ptr,
+                                            in_name);
+            }
+
+            ~Scope()
+            {
+                m_profiler_ptr->end_scope(m_cmd_buffer_ptr);
+            }
+
+        private:
+            Anvil::CommandBufferBase* m_cmd_buffer_ptr;
+            Anvil::GPUProfiler*       m_profiler_ptr;
+
+            ANVIL_DISABLE_ASSIGNMENT_OPERATOR(Scope);
+            ANVIL_DISABLE_COPY_CONSTRUCTOR(Scope);
+        };
+
+        /** Holds timing of a single scope. Scopes are stored in the order they were begun. */
+        typedef struct ScopeResult
+        {
+            /* Nesting level of the scope within its command buffer. Top-level scopes use 0. */
+            uint32_t depth;
+
+            /* Duration of the scope, in nanoseconds. */
+            double duration_ns;
+
+            /* Raw timestamp values written at the beginning and at the end of the scope. */
+            uint64_t end_timestamp;
+            uint64_t start_timestamp;
+
+            std::string name;
+
+            /* Index of the enclosing scope, or UINT32_MAX for top-level scopes. */
+            uint32_t n_parent_scope;
+        } ScopeResult;
+
+        /* Public functions */
+
+        /** Destructor. Unmaps and releases the results buffer. */
+        ~GPUProfiler();
+
+        /** Starts a new frame.
+         *
+         *  Reads back results of the frame which used the same resources n_frames_in_flight frames earlier, and
+         *  records a command which resets the frame's query pool.
+         *
+         *  If that frame has not finished executing yet, no command is recorded, and scopes recorded for the new
+         *  frame are ignored. The new frame is counted as dropped.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the reset command in. Must not be recording render
+         *                           pass commands. Must not be nullptr.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool begin_frame(Anvil::CommandBufferBase* in_cmd_buffer_ptr);
+
+        /** Records a timestamp write marking the beginning of a new scope.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the command in. Must not be nullptr.
+         *  @param in_name           Name of the scope.
+         *  @param in_stage          Pipeline stage to write the timestamp at.
+         *
+         *  @return Index of the scope in the frame's results, or UINT32_MAX if the per-frame scope limit has been
+         *          reached. end_scope() must be called in either case.
+         **/
+        uint32_t begin_scope(Anvil::CommandBufferBase*    in_cmd_buffer_ptr,
+                             const std::string&           in_name,
+                             Anvil::PipelineStageFlagBits in_stage = Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT);
+
+        /** Creates a new profiler instance.
+         *
+         *  @param in_device_ptr             Device to use. Must not be nullptr.
+         *  @param in_max_n_scopes_per_frame Maximum number of scopes which can be recorded per frame.
+         *  @param in_n_frames_in_flight     Number of frames to cycle resources through. Results of a frame are read
+         *                                   back this many frames later. Must be at least 1.
+         *  @param in_opt_trace_queue_ptr    If not nullptr, resolved scopes are forwarded to the tracer as spans executed
+         *                                   on this queue.
+         *
+         *  @return New profiler instance, or nullptr if the function failed.
+         **/
+        static Anvil::GPUProfilerUniquePtr create(Anvil::BaseDevice*  in_device_ptr,
+                                                  uint32_t            in_max_n_scopes_per_frame,
+                                                  uint32_t            in_n_frames_in_flight,
+                                                  const Anvil::Queue* in_opt_trace_queue_ptr = nullptr);
+
+        /** Records commands which copy the frame's query results to the results buffer and make them visible to the host.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the commands in. Must not be recording render pass commands.
+         *                           Must not be nullptr.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool end_frame(Anvil::CommandBufferBase* in_cmd_buffer_ptr);
+
+        /** Records a timestamp write marking the end of the innermost scope begun for @param in_cmd_buffer_ptr.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the command in. Must not be nullptr.
+         *  @param in_stage          Pipeline stage to write the timestamp at.
+         **/
+        void end_scope(Anvil::CommandBufferBase*    in_cmd_buffer_ptr,
+                       Anvil::PipelineStageFlagBits in_stage = Anvil::PipelineStageFlagBits::BOTTOM_OF_PIPE_BIT);
+
+        /** Returns the number of frames which were not profiled, because the frame which last used the same resources
+         *  had not finished executing by the time they were started.
+         **/
+        uint32_t get_n_dropped_frames() const
+        {
+            return m_n_dropped_frames;
+        }
+
+        /** Returns scope timings of the most recently resolved frame. */
+        const std::vector<ScopeResult>& get_results() const
+        {
+            return m_results;
+        }
+
+        /** Returns the index of the frame get_results() refers to, counting begin_frame() calls from 0, or UINT64_MAX
+         *  if no frame has been resolved yet.
+         **/
+        uint64_t get_results_frame_index() const
+        {
+            return m_results_frame_index;
+        }
+
+    private:
+        /* Private type definitions */
+        typedef struct PendingScope
+        {
+            uint32_t    depth;
+            bool        has_ended;
+            std::string name;
+            uint32_t    n_parent_scope;
+        } PendingScope;
+
+        typedef struct Frame
+        {
+            uint64_t                  frame_index;
+            std::vector<PendingScope> pending_scopes;
+            Anvil::QueryPoolUniquePtr query_pool_ptr;
+
+            Frame()
+                :frame_index(UINT64_MAX)
+            {
+                /* Stub */
+            }
+        } Frame;
+
+        /* Private functions */
+        GPUProfiler(Anvil::BaseDevice*  in_device_ptr,
+                    uint32_t            in_max_n_scopes_per_frame,
+                    uint32_t            in_n_frames_in_flight,
+                    const Anvil::Queue* in_opt_trace_queue_ptr);
+
+        bool init         ();
+        bool resolve_frame(Frame* in_frame_ptr);
+
+        /* Private variables */
+        Anvil::BufferUniquePtr                                      m_buffer_ptr;
+        Anvil::BaseDevice*                                          m_device_ptr;
+        std::vector<Frame>                                          m_frames;
+        bool                                                        m_is_current_frame_profiled;
+        const uint32_t                                              m_max_n_scopes_per_frame;
+        uint64_t*                                                   m_mapped_data_ptr;
+        std::mutex                                                  m_mutex;
+        uint32_t                                                    m_n_current_frame;
+        uint32_t                                                    m_n_dropped_frames;
+        uint64_t                                                    m_n_frames_started;
+        std::map<Anvil::CommandBufferBase*, std::vector<uint32_t> > m_open_scope_stacks;
+        std::vector<ScopeResult>                                    m_results;
+        uint64_t                                                    m_results_frame_index;
+        double                                                      m_timestamp_period;
+        uint64_t                                                    m_timestamp_mask;
+        const Anvil::Queue*                                         m_trace_queue_ptr;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(GPUProfiler);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(GPUProfiler);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_GPU_PROFILER_H */
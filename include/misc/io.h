@@ -99,6 +99,14 @@ namespace Anvil
         /** Tells whether the specified path exists and is a directory. */
         static bool is_directory(const std::string& in_path);
 
+        /** Renames @param in_src_filename to @param in_dst_filename. If a file already exists under
+         *  @param in_dst_filename, it is atomically replaced.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        static bool move_file(const std::string& in_src_filename,
+                              const std::string& in_dst_filename);
+
         /** Loads file contents and returns a buffer holding the read data.
          *
          *  Upon failure, the function generates an assertion failure.
@@ -19,14 +19,137 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+/** Implements MT-safety support for wrapper objects.
+ *
+ *  The lock type used by MT-safe objects is selected at build time with the ANVIL_MT_SAFETY_LOCK_TYPE
+ *  CMake option:
+ *
+ *  - MUTEX:    recursive mutexes are used. This is the default.
+ *  - SPINLOCK: recursive spin locks are used. These are cheaper to acquire if there is little contention.
+ *  - NONE:     all locking is compiled out. Only use this if Anvil objects are never accessed from more than
+ *              one thread at a time.
+ *
+ *  Objects which have been created with MT safety disabled do not take any locks, regardless of the setting.
+ **/
 #ifndef MISC_MT_SAFETY_H
 #define MISC_MT_SAFETY_H
 
+#include "config.h"
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <thread>
 
 namespace Anvil
 {
+    /** Lock which does nothing. Used when MT safety support has been compiled out. */
+    class NullMutex
+    {
+    public:
+        inline void lock()
+        {
+            /* Stub */
+        }
+
+        inline bool try_lock()
+        {
+            return true;
+        }
+
+        inline void unlock()
+        {
+            /* Stub */
+        }
+    };
+
+    /** Recursive spin lock. Waiting threads yield between lock acquisition attempts. */
+    class RecursiveSpinLock
+    {
+    public:
+        RecursiveSpinLock()
+            :m_n_lock_levels  (0),
+             m_owner_thread_id(std::thread::id() )
+        {
+            m_flag.clear();
+        }
+
+        inline void lock()
+        {
+            if (!try_lock_recursively() )
+            {
+                while (m_flag.test_and_set(std::memory_order_acquire) )
+                {
+                    std::this_thread::yield();
+                }
+
+                m_owner_thread_id.store(std::this_thread::get_id(),
+                                        std::memory_order_relaxed);
+
+                m_n_lock_levels = 1;
+            }
+        }
+
+        inline bool try_lock()
+        {
+            if (try_lock_recursively() )
+            {
+                return true;
+            }
+
+            if (m_flag.test_and_set(std::memory_order_acquire) )
+            {
+                return false;
+            }
+
+            m_owner_thread_id.store(std::this_thread::get_id(),
+                                    std::memory_order_relaxed);
+
+            m_n_lock_levels = 1;
+
+            return true;
+        }
+
+        inline void unlock()
+        {
+            if (--m_n_lock_levels == 0)
+            {
+                m_owner_thread_id.store(std::thread::id(),
+                                        std::memory_order_relaxed);
+
+                m_flag.clear(std::memory_order_release);
+            }
+        }
+
+    private:
+        /* Only the owning thread can observe its own ID, so a relaxed load is sufficient here. */
+        inline bool try_lock_recursively()
+        {
+            if (m_owner_thread_id.load(std::memory_order_relaxed) == std::this_thread::get_id() )
+            {
+                ++m_n_lock_levels;
+
+                return true;
+            }
+
+            return false;
+        }
+
+        std::atomic_flag             m_flag;
+        uint32_t                     m_n_lock_levels;
+        std::atomic<std::thread::id> m_owner_thread_id;
+
+        RecursiveSpinLock           (const RecursiveSpinLock&);
+        RecursiveSpinLock& operator=(const RecursiveSpinLock&);
+    };
+
+    #if defined(ANVIL_MT_SAFETY_LOCK_NONE)
+        typedef NullMutex            MTSafetyMutex;
+    #elif defined(ANVIL_MT_SAFETY_LOCK_SPINLOCK)
+        typedef RecursiveSpinLock    MTSafetyMutex;
+    #else
+        typedef std::recursive_mutex MTSafetyMutex;
+    #endif
+
     class MTSafetySupportProvider
     {
     public:
@@ -35,7 +158,7 @@ namespace Anvil
             if (in_enable)
             {
                 m_mutex_ptr.reset(
-                    new std::recursive_mutex()
+                    new MTSafetyMutex()
                 );
             }
         }
@@ -52,28 +175,36 @@ namespace Anvil
 
         inline void lock() const
         {
-            if (m_mutex_ptr != nullptr)
+            #if !defined(ANVIL_MT_SAFETY_LOCK_NONE)
             {
-                m_mutex_ptr->lock();
+                if (m_mutex_ptr != nullptr)
+                {
+                    m_mutex_ptr->lock();
+                }
             }
+            #endif
         }
 
         inline void unlock() const
         {
-            if (m_mutex_ptr != nullptr)
+            #if !defined(ANVIL_MT_SAFETY_LOCK_NONE)
             {
-                m_mutex_ptr->unlock();
+                if (m_mutex_ptr != nullptr)
+                {
+                    m_mutex_ptr->unlock();
+                }
             }
+            #endif
         }
 
     protected:
-        std::recursive_mutex* get_mutex() const
+        MTSafetyMutex* get_mutex() const
         {
             return m_mutex_ptr.get();
         }
 
     private:
-        std::unique_ptr<std::recursive_mutex> m_mutex_ptr;
+        std::unique_ptr<MTSafetyMutex> m_mutex_ptr;
 
         MTSafetySupportProvider           (const MTSafetySupportProvider&);
         MTSafetySupportProvider& operator=(const MTSafetySupportProvider&) const;
@@ -58,6 +58,28 @@ namespace Anvil
          */
         OBJECT_TRACKER_CALLBACK_ID_ON_SHADER_MODULE_OBJECT_REGISTERED,
 
+        /* Callback issued when an existing Buffer object instance is about to go out of scope.
+         *
+         * This callback IS issued BEFORE a corresponding Vulkan handle is destroyed.
+         *
+         * This callback MAY be issued FROM WITHIN the object's destructor, implying all WEAK POINTERS pointing
+         * to the wrapper instance will have been expired at the time of the callback.
+         *
+         * @param callback_arg OnObjectAboutToBeUnregisteredCallbackArgument structure instance
+         **/
+        OBJECT_TRACKER_CALLBACK_ID_ON_BUFFER_OBJECT_ABOUT_TO_BE_UNREGISTERED,
+
+        /* Callback issued when an existing BufferView object instance is about to go out of scope.
+         *
+         * This callback IS issued BEFORE a corresponding Vulkan handle is destroyed.
+         *
+         * This callback MAY be issued FROM WITHIN the object's destructor, implying all WEAK POINTERS pointing
+         * to the wrapper instance will have been expired at the time of the callback.
+         *
+         * @param callback_arg OnObjectAboutToBeUnregisteredCallbackArgument structure instance
+         **/
+        OBJECT_TRACKER_CALLBACK_ID_ON_BUFFER_VIEW_OBJECT_ABOUT_TO_BE_UNREGISTERED,
+
         /* Callback issued when an existing Device object instance is about to go out of scope.
          *
          * This callback IS issued BEFORE a corresponding Vulkan handle is destroyed.
@@ -80,6 +102,17 @@ namespace Anvil
          **/
         OBJECT_TRACKER_CALLBACK_ID_ON_GLSL_SHADER_TO_SPIRV_GENERATOR_OBJECT_ABOUT_TO_BE_UNREGISTERED,
 
+        /* Callback issued when an existing ImageView object instance is about to go out of scope.
+         *
+         * This callback IS issued BEFORE a corresponding Vulkan handle is destroyed.
+         *
+         * This callback MAY be issued FROM WITHIN the object's destructor, implying all WEAK POINTERS pointing
+         * to the wrapper instance will have been expired at the time of the callback.
+         *
+         * @param callback_arg OnObjectAboutToBeUnregisteredCallbackArgument structure instance
+         **/
+        OBJECT_TRACKER_CALLBACK_ID_ON_IMAGE_VIEW_OBJECT_ABOUT_TO_BE_UNREGISTERED,
+
         /* Callback issued when an existing PipelineLayout object instance is about to go out of scope.
          *
          * This callback IS issued BEFORE a corresponding Vulkan handle is destroyed.
@@ -91,6 +124,17 @@ namespace Anvil
          **/
         OBJECT_TRACKER_CALLBACK_ID_ON_PIPELINE_LAYOUT_OBJECT_ABOUT_TO_BE_UNREGISTERED,
 
+        /* Callback issued when an existing Sampler object instance is about to go out of scope.
+         *
+         * This callback IS issued BEFORE a corresponding Vulkan handle is destroyed.
+         *
+         * This callback MAY be issued FROM WITHIN the object's destructor, implying all WEAK POINTERS pointing
+         * to the wrapper instance will have been expired at the time of the callback.
+         *
+         * @param callback_arg OnObjectAboutToBeUnregisteredCallbackArgument structure instance
+         **/
+        OBJECT_TRACKER_CALLBACK_ID_ON_SAMPLER_OBJECT_ABOUT_TO_BE_UNREGISTERED,
+
         /* Callback issued when an existing ShaderModule object instance is about to go out of scope.
          *
          * This callback IS issued BEFORE a corresponding Vulkan handle is destroyed.
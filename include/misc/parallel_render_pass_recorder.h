@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a helper which records contents of a single subpass on multiple threads at once.
+ *
+ *  The subpass is split into a number of slices. Each slice is recorded into a separate secondary
+ *  command buffer by one of the worker threads. Every worker thread owns a dedicated, non-MT-safe
+ *  command pool, so recording does not involve any locking. Once all slices have been recorded,
+ *  the secondary command buffers are executed from within the user-specified primary command buffer
+ *  in slice order, so the result is deterministic regardless of how slices were scheduled.
+ *
+ *  Usage:
+ *
+ *  1. Begin a render pass in the primary command buffer with SubpassContents::SECONDARY_COMMAND_BUFFERS.
+ *  2. Call record(). The slice recording function will be called once per slice, from worker threads.
+ *  3. Continue recording the primary command buffer (next subpass, end of the render pass, etc.)
+ *  4. Once the GPU has finished executing all primary command buffers recorded with the recorder,
+ *     call reset() before recording the next frame.
+ *
+ *  record() can be called any number of times between reset() calls, for example once per subpass or
+ *  render pass. Each call uses new secondary command buffers. reset() recycles all of them at once,
+ *  by resetting the thread-owned command pools. It is the application's responsibility to ensure the
+ *  GPU has finished executing the primary command buffers before calling reset(). Applications with
+ *  multiple frames in flight should use one recorder instance per frame.
+ **/
+#ifndef MISC_PARALLEL_RENDER_PASS_RECORDER_H
+#define MISC_PARALLEL_RENDER_PASS_RECORDER_H
+
+#include "misc/thread_pool.h"
+#include "misc/types.h"
+
+
+namespace Anvil
+{
+    class ParallelRenderPassRecorder
+    {
+    public:
+        /* Public type definitions */
+
+        /** Prototype of a slice recording function.
+         *
+         *  The function is called from one of the worker threads. It must only record commands into
+         *  @param in_cmd_buffer_ptr. The command buffer is already in the recording state, and
+         *  recording will be stopped by the recorder after the function returns.
+         *
+         *  @param in_n_slice        Index of the slice to record.
+         *  @param in_cmd_buffer_ptr Secondary command buffer to record the slice's commands into.
+         **/
+        typedef std::function<void(uint32_t                       in_n_slice,
+                                   Anvil::SecondaryCommandBuffer* in_cmd_buffer_ptr)> SliceRecordingFunction;
+
+        /* Public functions */
+
+        /** Destructor. Releases all worker threads, command pools and secondary command buffers. */
+        ~ParallelRenderPassRecorder();
+
+        /** Creates a new recorder instance.
+         *
+         *  @param in_device_ptr         Device to use. Must not be nullptr.
+         *  @param in_queue_family_index Index of the Vulkan queue family the primary command buffers are going to
+         *                               be submitted to.
+         *  @param in_n_worker_threads   Number of worker threads to use. If 0, the number of hardware threads
+         *                               reported by the running platform will be used.
+         *
+         *  @return New recorder instance.
+         **/
+        static Anvil::ParallelRenderPassRecorderUniquePtr create(Anvil::BaseDevice* in_device_ptr,
+                                                                 uint32_t           in_queue_family_index,
+                                                                 uint32_t           in_n_worker_threads = 0);
+
+        /** Returns the number of worker threads used for recording. */
+        uint32_t get_n_worker_threads() const
+        {
+            return m_thread_pool_ptr->get_n_worker_threads();
+        }
+
+        /** Records @param in_n_slices secondary command buffers in parallel and issues a single
+         *  record_execute_commands() call for @param in_primary_cmd_buffer_ptr, which executes them in
+         *  slice order.
+         *
+         *  This function blocks until all slices have been recorded.
+         *
+         *  @param in_primary_cmd_buffer_ptr                     Primary command buffer to execute the slices from. It must
+         *                                                       be in the recording state, with a render pass active.
+         *                                                       Must not be nullptr.
+         *  @param in_n_slices                                   Number of slices to split the subpass into.
+         *  @param in_framebuffer_ptr                            Framebuffer the subpass renders to. May be nullptr.
+         *  @param in_render_pass_ptr                            Render pass the subpass belongs to. Must not be nullptr.
+         *  @param in_subpass_id                                 ID of the subpass to record the slices for.
+         *  @param in_slice_recording_function                   Function to call for each slice. Must not be nullptr.
+         *  @param in_occlusion_query_used_by_primary_cmd_buffer Meaning as per SecondaryCommandBuffer::start_recording().
+         *  @param in_required_occlusion_query_support_scope     Meaning as per SecondaryCommandBuffer::start_recording().
+         *  @param in_opt_device_mask                            Meaning as per SecondaryCommandBuffer::start_recording().
+         *
+         *  @return true if all slices were recorded and executed successfully, false otherwise.
+         **/
+        bool record(Anvil::PrimaryCommandBuffer*      in_primary_cmd_buffer_ptr,
+                    uint32_t                          in_n_slices,
+                    Anvil::Framebuffer*               in_framebuffer_ptr,
+                    Anvil::RenderPass*                in_render_pass_ptr,
+                    Anvil::SubPassID                  in_subpass_id,
+                    const SliceRecordingFunction&     in_slice_recording_function,
+                    bool                              in_occlusion_query_used_by_primary_cmd_buffer = false,
+                    Anvil::OcclusionQuerySupportScope in_required_occlusion_query_support_scope     = Anvil::OcclusionQuerySupportScope::NOT_REQUIRED,
+                    uint32_t                          in_opt_device_mask                            = UINT32_MAX);
+
+        /** Recycles all secondary command buffers recorded by record() calls since the last reset() call.
+         *
+         *  Must only be called once the GPU has finished executing all primary command buffers which
+         *  execute those secondary command buffers. Must not be called while record() is in progress.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool reset();
+
+    private:
+        /* Private type definitions */
+        typedef struct WorkerThreadData
+        {
+            std::vector<Anvil::SecondaryCommandBufferUniquePtr> cmd_buffer_ptrs;
+            Anvil::CommandPoolUniquePtr                         command_pool_ptr;
+            uint32_t                                            n_cmd_buffers_used;
+
+            WorkerThreadData()
+                :n_cmd_buffers_used(0)
+            {
+                /* Stub */
+            }
+        } WorkerThreadData;
+
+        /* Private functions */
+        explicit ParallelRenderPassRecorder(Anvil::BaseDevice* in_device_ptr,
+                                            uint32_t           in_queue_family_index,
+                                            uint32_t           in_n_worker_threads);
+
+        /* Private variables */
+        Anvil::BaseDevice*                          m_device_ptr;
+        std::vector<Anvil::SecondaryCommandBuffer*> m_slice_cmd_buffer_ptrs;
+        Anvil::ThreadPoolUniquePtr                  m_thread_pool_ptr;
+        std::vector<WorkerThreadData>               m_worker_thread_data;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ParallelRenderPassRecorder);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(ParallelRenderPassRecorder);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_PARALLEL_RENDER_PASS_RECORDER_H */
@@ -33,13 +33,17 @@
  *  3. Finally, at the top we have specialized classes which inherit from Pool. At instantiation time,
  *     they initialize a worker's instance and pass it down to the middle layer.
  *
- *  Pools are NOT thread-safe at the moment. This will be added in the near future.
+ *  Pools are thread-safe. Getting and returning pool items are O(1) operations, which do not
+ *  take any locks in the common case. Please see GenericPool for details.
  */
 #ifndef WRAPPERS_POOLS_H
 #define WRAPPERS_POOLS_H
 
 #include "misc/types.h"
+#include <atomic>
 #include <forward_list>
+#include <memory>
+#include <mutex>
 
 
 namespace Anvil
@@ -73,16 +77,20 @@ namespace Anvil
     {
         PoolItemPtrType item;
 
+        /* Index of the next available item plus one, or 0 if this is the last item on a free list.
+         *
+         * Only meaningful while the container is stored on the global free list. Needs to be atomic,
+         * since a thread popping the list may read the value while another thread, which has already
+         * popped the item, pushes it back.
+         */
+        std::atomic<uint32_t> n_next_item_plus_one;
+
         PoolItemContainer()
+            :n_next_item_plus_one(0)
         {
             /* Stub */
         }
 
-        PoolItemContainer(PoolItemPtrType in_item)
-        {
-            item = std::move(in_item);
-        }
-
         bool operator==(const PoolItemType* in_item_ptr) const
         {
             return item.get() == in_item_ptr;
@@ -108,21 +116,42 @@ namespace Anvil
          *  @param in_pool_ptr Pointer to the command buffer pool, to which the command buffer
          *                     should be returned when the auto pointer goes out of scope. Must
          *                     not be nullptr.
+         *  @param in_n_item   Index of the pool item the functor is going to return.
          **/
-        ReturnToPoolFunctor(GenericPool<PoolItemType, PoolItemPtrType>* in_pool_ptr)
+        ReturnToPoolFunctor(GenericPool<PoolItemType, PoolItemPtrType>* in_pool_ptr,
+                            uint32_t                                    in_n_item)
         {
+            n_item   = in_n_item;
             pool_ptr = in_pool_ptr;
         }
 
         void operator()(PoolItemType* in_item)
         {
-            pool_ptr->return_item(in_item);
+            ANVIL_REDUNDANT_ARGUMENT(in_item);
+
+            pool_ptr->return_item(n_item);
         }
 
     private:
+        uint32_t                                    n_item;
         GenericPool<PoolItemType, PoolItemPtrType>* pool_ptr;
     };
 
+    /** Generic pool implementation.
+     *
+     *  Both get_item() and item returns are O(1) and thread-safe:
+     *
+     *  - Each thread owns a small cache of available items. Cache hits do not involve any
+     *    synchronization.
+     *  - If the cache is empty (when getting an item) or full (when returning an item),
+     *    an intrusive lock-free stack of available items, shared by all threads, is used instead.
+     *  - Only creation of new items is serialized.
+     *
+     *  The thread-local cache is shared by all pools of the same type. It is bound to the pool
+     *  which the thread most recently returned an item to while the cache was empty. Items held
+     *  by a cache are not visible to other threads. When the thread exits, they are moved to the
+     *  shared stack of the pool the cache is bound to, unless the pool has been released already.
+     **/
     template <class PoolItemType,
               class PoolItemPtrType>
     class GenericPool
@@ -141,19 +170,26 @@ namespace Anvil
          **/
         GenericPool(uint32_t                      in_n_items_to_preallocate,
                     IPoolWorker<PoolItemPtrType>* in_worker_ptr)
-            :m_capacity  (in_n_items_to_preallocate),
-             m_worker_ptr(in_worker_ptr)
+            :m_alive_token_ptr            (new AliveToken(this) ),
+             m_available_items_stack_head (0),
+             m_capacity                   (in_n_items_to_preallocate),
+             m_id                         (get_next_pool_id() ),
+             m_n_items                    (0),
+             m_worker_ptr                 (in_worker_ptr)
         {
+            for (uint32_t n_chunk = 0;
+                          n_chunk < N_MAX_CHUNKS;
+                        ++n_chunk)
+            {
+                m_chunk_ptrs[n_chunk] = nullptr;
+            }
+
             for (uint32_t n_item = 0;
                           n_item < in_n_items_to_preallocate;
                         ++n_item)
             {
-                std::unique_ptr<PoolItemContainer<PoolItemType, PoolItemPtrType> > new_item_container_ptr(
-                    new PoolItemContainer<PoolItemType, PoolItemPtrType>(m_worker_ptr->create_item() )
-                );
-
-                m_available_pool_item_containers.push_back(
-                    std::move(new_item_container_ptr)
+                push_available_item(
+                    create_item()
                 );
             }
         }
@@ -165,26 +201,28 @@ namespace Anvil
          **/
         virtual ~GenericPool()
         {
-            while (!m_active_pool_item_containers.empty())
+            /* Stop threads which are exiting from returning cached items to the pool. Blocks until any
+             * return which is already in progress finishes. */
             {
-                std::unique_ptr<Anvil::PoolItemContainer<PoolItemType, PoolItemPtrType> >& current_item_container = m_active_pool_item_containers.back();
+                std::unique_lock<std::mutex> lock(m_alive_token_ptr->mutex);
 
-                m_worker_ptr->release_item(
-                    std::move(current_item_container->item)
-                );
-
-                m_active_pool_item_containers.pop_back();
+                m_alive_token_ptr->pool_ptr = nullptr;
             }
 
-            while (!m_available_pool_item_containers.empty())
+            for (uint32_t n_item = m_n_items;
+                          n_item > 0;
+                        --n_item)
             {
-                std::unique_ptr<Anvil::PoolItemContainer<PoolItemType, PoolItemPtrType> >& current_item_container = m_available_pool_item_containers.back();
-
                 m_worker_ptr->release_item(
-                    std::move(current_item_container->item)
+                    std::move(get_item_container(n_item - 1)->item)
                 );
+            }
 
-                m_available_pool_item_containers.pop_back();
+            for (uint32_t n_chunk = 0;
+                          n_chunk < N_MAX_CHUNKS;
+                        ++n_chunk)
+            {
+                delete [] m_chunk_ptrs[n_chunk].load();
             }
 
             delete m_worker_ptr;
@@ -199,100 +237,278 @@ namespace Anvil
 
         /** Returns a pool item instance.
          *
-         *  If no items are currently available in the pool, a new instance will be created. Otherwise,
-         *  an existing pool item will be popped & returned from the pool.
+         *  If no items are currently available in the pool, items whose return has been postponed are
+         *  made available first. If there are none, a new instance will be created. Otherwise, an existing
+         *  pool item will be popped & returned from the pool.
          *
          *  Callers must NOT release the retrieved instances.
          *
          *  @return As per description. */
         PoolItemPtrType get_item()
         {
-            ReturnToPoolFunctor<PoolItemType, PoolItemPtrType> release_functor(this);
-            PoolItemPtrType                                    result;
+            uint32_t n_item = UINT32_MAX;
 
-            if (!m_available_pool_item_containers.empty())
+            if (!pop_item(&n_item) )
             {
-                result = PoolItemPtrType(m_available_pool_item_containers.back()->item.get(),
-                                         release_functor);
+                if (!flush_postponed_items() ||
+                    !pop_item(&n_item) )
+                {
+                    n_item = create_item();
+                }
+            }
 
-                m_active_pool_item_containers.push_back(
-                    std::move(m_available_pool_item_containers.back() )
-                );
+            PoolItemPtrType result(get_item_container(n_item)->item.get(),
+                                   ReturnToPoolFunctor<PoolItemType, PoolItemPtrType>(this,
+                                                                                      n_item) );
 
-                m_available_pool_item_containers.pop_back();
+            m_worker_ptr->reset_item(result);
+
+            return result;
+        }
+
+        /** Stores the item at index @param in_n_item back in the pool.
+         *
+         *  Specialized pools may override this function to postpone the return, e.g. in order to
+         *  batch item reset operations. Such pools must eventually call the base implementation.
+         **/
+        virtual void return_item(uint32_t in_n_item)
+        {
+            ThreadCache& cache = get_thread_cache();
+
+            anvil_assert(in_n_item < m_n_items);
+
+            if (cache.pool_id != m_id)
+            {
+                /* Take over the cache, unless it still holds items of another live pool. */
+                if (cache.n_items == 0                 ||
+                    cache.pool_alive_token_ptr.expired() )
+                {
+                    cache.n_items              = 0;
+                    cache.pool_alive_token_ptr = m_alive_token_ptr;
+                    cache.pool_id              = m_id;
+                }
+            }
+
+            if (cache.pool_id == m_id                &&
+                cache.n_items <  N_THREAD_CACHE_ITEMS)
+            {
+                cache.items[cache.n_items++] = in_n_item;
             }
             else
             {
-                std::unique_ptr<PoolItemContainer<PoolItemType, PoolItemPtrType> > new_item_container(
-                    new PoolItemContainer<PoolItemType, PoolItemPtrType>(m_worker_ptr->create_item() )
-                );
+                push_available_item(in_n_item);
+            }
+        }
 
-                m_active_pool_item_containers.push_back(
-                    std::move(new_item_container)
-                );
+    protected:
+        /* Protected functions */
 
-                result = PoolItemPtrType(m_active_pool_item_containers.back()->item.get(),
-                                         release_functor);
-            }
+        /** Called by get_item() if no items are available. Pools which postpone returns should make the postponed
+         *  items available by calling the base return_item() implementation.
+         *
+         *  @return true if any items have been made available, false otherwise.
+         **/
+        virtual bool flush_postponed_items()
+        {
+            return false;
+        }
 
-            m_worker_ptr->reset_item(result);
+        /** Retrieves the item stored at index @param in_n_item. */
+        PoolItemType* get_item_at_index(uint32_t in_n_item) const
+        {
+            return get_item_container(in_n_item)->item.get();
+        }
 
-            return result;
+        /** Retrieves the underlying pool worker instance */
+        const IPoolWorker<PoolItemPtrType>* get_worker_ptr() const
+        {
+            return m_worker_ptr;
         }
 
-        /** Stores the provided instance back in the pool. */
-        void return_item(PoolItemType* in_item_ptr)
+    private:
+        /* Private type declarations */
+        enum
+        {
+            N_ITEMS_PER_CHUNK    = 256,
+            N_MAX_CHUNKS         = 1024,
+            N_THREAD_CACHE_ITEMS = 16
+        };
+
+        typedef PoolItemContainer<PoolItemType, PoolItemPtrType> Container;
+
+        /* Shared by the pool and the thread caches bound to it. Expires when the pool is released. pool_ptr is reset
+         * at the beginning of the pool's destructor, and can only be dereferenced with the mutex locked. */
+        typedef struct AliveToken
         {
-            std::unique_ptr<PoolItemContainer<PoolItemType, PoolItemPtrType> > container;
-            bool                                                               has_found = false;
+            std::mutex   mutex;
+            GenericPool* pool_ptr;
 
-            ANVIL_REDUNDANT_VARIABLE(has_found);
+            explicit AliveToken(GenericPool* in_pool_ptr)
+                :pool_ptr(in_pool_ptr)
+            {
+                /* Stub */
+            }
+        } AliveToken;
 
-            for (auto iterator  = m_active_pool_item_containers.begin();
-                      iterator != m_active_pool_item_containers.end();
-                    ++iterator)
+        typedef struct ThreadCache
+        {
+            uint32_t                  items[N_THREAD_CACHE_ITEMS];
+            uint32_t                  n_items;
+            std::weak_ptr<AliveToken> pool_alive_token_ptr;
+            uint64_t                  pool_id;
+
+            ThreadCache()
+                :n_items(0),
+                 pool_id(0)
             {
-                if ((*iterator)->item.get() == in_item_ptr)
+                /* Stub */
+            }
+
+            /* Called at thread exit. Hands cached items back to the pool, so that other threads can reuse them. */
+            ~ThreadCache()
+            {
+                std::shared_ptr<AliveToken> alive_token_ptr = pool_alive_token_ptr.lock();
+
+                if (alive_token_ptr == nullptr ||
+                    n_items         == 0)
                 {
-                    container = std::move(*iterator);
-                    has_found = true;
+                    return;
+                }
 
-                    m_active_pool_item_containers.erase(iterator);
+                std::unique_lock<std::mutex> lock(alive_token_ptr->mutex);
 
-                    break;
+                if (alive_token_ptr->pool_ptr != nullptr)
+                {
+                    for (uint32_t n_item = 0;
+                                  n_item < n_items;
+                                ++n_item)
+                    {
+                        alive_token_ptr->pool_ptr->push_available_item(items[n_item]);
+                    }
                 }
+
+                n_items = 0;
             }
+        } ThreadCache;
 
-            anvil_assert(has_found);
+        /* Private functions */
 
-            m_available_pool_item_containers.push_back(
-                std::move(container)
-            );
+        /** Creates a new pool item and returns its index. */
+        uint32_t create_item()
+        {
+            std::unique_lock<std::mutex> lock    (m_item_creation_mutex);
+            const uint32_t               n_item  (m_n_items.load() );
+            const uint32_t               n_chunk (n_item / N_ITEMS_PER_CHUNK);
+
+            anvil_assert(n_chunk < N_MAX_CHUNKS);
+
+            if (m_chunk_ptrs[n_chunk].load() == nullptr)
+            {
+                m_chunk_ptrs[n_chunk] = new Container[N_ITEMS_PER_CHUNK];
+            }
+
+            m_chunk_ptrs[n_chunk].load()[n_item % N_ITEMS_PER_CHUNK].item = m_worker_ptr->create_item();
+            m_n_items                                                     = n_item + 1;
+
+            return n_item;
         }
 
-    protected:
-        /* Protected type declarations */
-        typedef std::vector<std::unique_ptr<PoolItemContainer<PoolItemType, PoolItemPtrType> > > PoolItemContainers;
+        Container* get_item_container(uint32_t in_n_item) const
+        {
+            return &m_chunk_ptrs[in_n_item / N_ITEMS_PER_CHUNK].load()[in_n_item % N_ITEMS_PER_CHUNK];
+        }
 
-        /* Protected functions */
+        static uint64_t get_next_pool_id()
+        {
+            static std::atomic<uint64_t> next_pool_id(1);
 
-        /** Retrieves the underlying pool worker instance */
-        const IPoolWorker<PoolItemPtrType>* get_worker_ptr() const
+            return next_pool_id.fetch_add(1);
+        }
+
+        static ThreadCache& get_thread_cache()
         {
-            return m_worker_ptr;
+            static thread_local ThreadCache cache;
+
+            return cache;
         }
 
-        /* Protected variables */
-        PoolItemContainers m_active_pool_item_containers;
-        PoolItemContainers m_available_pool_item_containers;
+        /** Pops an item off the calling thread's cache or, if the cache is empty, off the global stack of
+         *  available items.
+         *
+         *  @return true if an item was popped, false if no items were available.
+         **/
+        bool pop_item(uint32_t* out_n_item_ptr)
+        {
+            ThreadCache& cache = get_thread_cache();
+
+            if (cache.pool_id == m_id &&
+                cache.n_items >  0)
+            {
+                *out_n_item_ptr = cache.items[--cache.n_items];
+
+                return true;
+            }
+
+            return pop_available_item(out_n_item_ptr);
+        }
+
+        /** Pops an item off the global stack of available items.
+         *
+         *  The stack head holds the index of the top item plus one in its lower 32 bits, and a tag
+         *  which is incremented on each update in its upper 32 bits. The tag protects the stack from
+         *  ABA problems.
+         *
+         *  @return true if an item was popped, false if the stack was empty.
+         **/
+        bool pop_available_item(uint32_t* out_n_item_ptr)
+        {
+            uint64_t head = m_available_items_stack_head.load();
+
+            while ((head & UINT32_MAX) != 0)
+            {
+                const uint32_t n_item   = static_cast<uint32_t>(head & UINT32_MAX) - 1;
+                const uint64_t new_head = ((head >> 32) + 1) << 32 | get_item_container(n_item)->n_next_item_plus_one.load();
+
+                if (m_available_items_stack_head.compare_exchange_weak(head,
+                                                                       new_head) )
+                {
+                    *out_n_item_ptr = n_item;
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /** Pushes an item onto the global stack of available items. See pop_available_item() for details. */
+        void push_available_item(uint32_t in_n_item)
+        {
+            Container* container_ptr = get_item_container(in_n_item);
+            uint64_t   head          = m_available_items_stack_head.load();
+            uint64_t   new_head;
+
+            do
+            {
+                container_ptr->n_next_item_plus_one = static_cast<uint32_t>(head & UINT32_MAX);
+
+                new_head = ((head >> 32) + 1) << 32 | (in_n_item + 1);
+            }
+            while (!m_available_items_stack_head.compare_exchange_weak(head,
+                                                                        new_head) );
+        }
 
-    private:
         /* Private variables */
+        std::shared_ptr<AliveToken>   m_alive_token_ptr;
+        std::atomic<uint64_t>         m_available_items_stack_head;
         uint32_t                      m_capacity;
+        std::atomic<Container*>       m_chunk_ptrs[N_MAX_CHUNKS];
+        const uint64_t                m_id;
+        std::mutex                    m_item_creation_mutex;
+        std::atomic<uint32_t>         m_n_items;
         IPoolWorker<PoolItemPtrType>* m_worker_ptr;
     };
 
-
     /** Implements IPoolWorker interface for primary command buffers. */
     template<class CommandBufferPtr>
     class CommandBufferPoolWorker : public IPoolWorker<CommandBufferPtr>
@@ -432,6 +648,178 @@ namespace Anvil
     typedef CommandBufferPool<PrimaryCommandBufferPoolWorker,   PrimaryCommandBuffer,   PrimaryCommandBufferUniquePtr>   PrimaryCommandBufferPool;
     typedef CommandBufferPool<SecondaryCommandBufferPoolWorker, SecondaryCommandBuffer, SecondaryCommandBufferUniquePtr> SecondaryCommandBufferPool;
 
+    /** Implements IPoolWorker interface for fences.
+     *
+     *  Fences are reset in bulk by FencePool before they are made available again, so reset_item()
+     *  is a nop.
+     **/
+    class FencePoolWorker : public IPoolWorker<Anvil::FenceUniquePtr>
+    {
+    public:
+        /** Constructor.
+         *
+         *  @param in_device_ptr Device to create fences for. Must not be nullptr.
+         **/
+        FencePoolWorker(const Anvil::BaseDevice* in_device_ptr)
+            :m_device_ptr(in_device_ptr)
+        {
+            anvil_assert(m_device_ptr != nullptr);
+        }
+
+        virtual ~FencePoolWorker()
+        {
+            /* Stub */
+        }
+
+        Anvil::FenceUniquePtr create_item();
+
+        void release_item(Anvil::FenceUniquePtr in_item_ptr)
+        {
+            /* Stub */
+        }
+
+        void reset_item(Anvil::FenceUniquePtr& in_item_ptr)
+        {
+            /* Stub */
+        }
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(FencePoolWorker);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR   (FencePoolWorker);
+
+    private:
+        const Anvil::BaseDevice* m_device_ptr;
+    };
+
+    /** Implements IPoolWorker interface for binary semaphores.
+     *
+     *  Semaphores cannot be reset from the host, so reset_item() is a nop. Only return semaphores
+     *  to the pool once all pending signal operations have been waited upon.
+     **/
+    class SemaphorePoolWorker : public IPoolWorker<Anvil::SemaphoreUniquePtr>
+    {
+    public:
+        /** Constructor.
+         *
+         *  @param in_device_ptr Device to create semaphores for. Must not be nullptr.
+         **/
+        SemaphorePoolWorker(const Anvil::BaseDevice* in_device_ptr)
+            :m_device_ptr(in_device_ptr)
+        {
+            anvil_assert(m_device_ptr != nullptr);
+        }
+
+        virtual ~SemaphorePoolWorker()
+        {
+            /* Stub */
+        }
+
+        Anvil::SemaphoreUniquePtr create_item();
+
+        void release_item(Anvil::SemaphoreUniquePtr in_item_ptr)
+        {
+            /* Stub */
+        }
+
+        void reset_item(Anvil::SemaphoreUniquePtr& in_item_ptr)
+        {
+            /* Stub */
+        }
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(SemaphorePoolWorker);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR   (SemaphorePoolWorker);
+
+    private:
+        const Anvil::BaseDevice* m_device_ptr;
+    };
+
+    /** Implements a fence pool.
+     *
+     *  Returned fences are not made available straight away. Instead, they are gathered and reset
+     *  with a single Fence::reset_fences() call once N_FENCES_PER_RESET_BATCH of them have been
+     *  returned. Fences retrieved from the pool are always unsignalled.
+     **/
+    class FencePool : public GenericPool<Anvil::Fence, Anvil::FenceUniquePtr>
+    {
+    public:
+        /** Creates a new fence pool.
+         *
+         *  @param in_device_ptr           Device to create fences for. Must not be nullptr.
+         *  @param in_n_preallocated_items Number of fences to preallocate at creation time.
+         **/
+        static std::unique_ptr<FencePool> create(const Anvil::BaseDevice* in_device_ptr,
+                                                 uint32_t                 in_n_preallocated_items);
+
+        /** Stub destructor */
+        virtual ~FencePool()
+        {
+            /* Stub */
+        }
+
+        /** Resets all fences, which have been returned to the pool but not reset yet, and makes them available. */
+        void flush();
+
+        /** Schedules the fence at index @param in_n_item for a reset.
+         *
+         *  Fences are reset in batches. A batch is flushed once it fills up, or when get_item() runs out of
+         *  available fences.
+         **/
+        void return_item(uint32_t in_n_item) override;
+
+    protected:
+        bool flush_postponed_items() override;
+
+    private:
+        enum
+        {
+            N_FENCES_PER_RESET_BATCH = 16
+        };
+
+        /* Constructor. Please see create() for documentation */
+        FencePool(uint32_t         in_n_preallocated_items,
+                  FencePoolWorker* in_pool_worker_ptr);
+
+        void flush_locked();
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(FencePool);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR   (FencePool);
+
+        std::mutex m_pending_items_mutex;
+        uint32_t   m_pending_items[N_FENCES_PER_RESET_BATCH];
+        uint32_t   m_n_pending_items;
+    };
+
+    /** Implements a binary semaphore pool. */
+    class SemaphorePool : public GenericPool<Anvil::Semaphore, Anvil::SemaphoreUniquePtr>
+    {
+    public:
+        /** Creates a new semaphore pool.
+         *
+         *  @param in_device_ptr           Device to create semaphores for. Must not be nullptr.
+         *  @param in_n_preallocated_items Number of semaphores to preallocate at creation time.
+         **/
+        static std::unique_ptr<SemaphorePool> create(const Anvil::BaseDevice* in_device_ptr,
+                                                     uint32_t                 in_n_preallocated_items);
+
+        /** Stub destructor */
+        virtual ~SemaphorePool()
+        {
+            /* Stub */
+        }
+
+    private:
+        /* Constructor. Please see create() for documentation */
+        SemaphorePool(uint32_t             in_n_preallocated_items,
+                      SemaphorePoolWorker* in_pool_worker_ptr)
+            :GenericPool<Anvil::Semaphore, Anvil::SemaphoreUniquePtr>(in_n_preallocated_items,
+                                                                      in_pool_worker_ptr)
+        {
+            /* Stub */
+        }
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(SemaphorePool);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR   (SemaphorePool);
+    };
+
 }; /* namespace Anvil */
 
 #endif /* WRAPPERS_POOLS_H */
\ No newline at end of file
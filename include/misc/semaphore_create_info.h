@@ -37,6 +37,7 @@ namespace Anvil
          *
          * - Exportable external semaphore handle type: none
          * - MT safety:                                 Anvil::MTSafety::INHERIT_FROM_PARENT_DEVICE
+         * - Semaphore type:                            Anvil::SemaphoreType::BINARY
          */
         static Anvil::SemaphoreCreateInfoUniquePtr create(const Anvil::BaseDevice* in_device_ptr);
 
@@ -70,11 +71,22 @@ namespace Anvil
             }
         #endif
 
+        /* Returns the initial counter value of a timeline semaphore. */
+        const uint64_t& get_initial_value() const
+        {
+            return m_initial_value;
+        }
+
         const MTSafety& get_mt_safety() const
         {
             return m_mt_safety;
         }
 
+        const Anvil::SemaphoreType& get_semaphore_type() const
+        {
+            return m_semaphore_type;
+        }
+
         void set_device(const Anvil::BaseDevice* in_device_ptr)
         {
             m_device_ptr = in_device_ptr;
@@ -128,6 +140,20 @@ namespace Anvil
             m_mt_safety = in_mt_safety;
         }
 
+        /* Specifies the type of the semaphore to create.
+         *
+         * @param in_semaphore_type Type of the semaphore.
+         * @param in_initial_value  Initial counter value. Only used for timeline semaphores.
+         *
+         * Timeline semaphores require VK_KHR_timeline_semaphore.
+         */
+        void set_semaphore_type(const Anvil::SemaphoreType& in_semaphore_type,
+                                const uint64_t&             in_initial_value = 0)
+        {
+            m_initial_value  = in_initial_value;
+            m_semaphore_type = in_semaphore_type;
+        }
+
     private:
         /* Private functions */
         SemaphoreCreateInfo(const Anvil::BaseDevice* in_device_ptr,
@@ -136,7 +162,9 @@ namespace Anvil
         /* Private variables */
         const Anvil::BaseDevice*                m_device_ptr;
         Anvil::ExternalSemaphoreHandleTypeFlags m_exportable_external_semaphore_handle_types;
+        uint64_t                                m_initial_value;
         Anvil::MTSafety                         m_mt_safety;
+        Anvil::SemaphoreType                    m_semaphore_type;
 
         #ifdef _WIN32
             ExternalNTHandleInfo m_exportable_nt_handle_info;
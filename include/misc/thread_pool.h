@@ -0,0 +1,117 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a simple thread pool, which lets Anvil helpers spread independent work items across
+ *  a fixed set of worker threads.
+ *
+ *  Each worker thread is assigned a constant index, ranging from 0 to (get_n_worker_threads() - 1).
+ *  Job functions are told which worker is executing them, so that callers can maintain thread-owned
+ *  state (eg. command pools or pipeline caches) without any additional synchronization.
+ **/
+#ifndef MISC_THREAD_POOL_H
+#define MISC_THREAD_POOL_H
+
+#include "misc/types.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+namespace Anvil
+{
+    class ThreadPool
+    {
+    public:
+        /* Public type definitions */
+
+        /** Prototype of a job function.
+         *
+         *  @param in_n_job           Index of the job to execute.
+         *  @param in_n_worker_thread Index of the worker thread the job is being executed by.
+         **/
+        typedef std::function<void(uint32_t in_n_job,
+                                   uint32_t in_n_worker_thread)> JobFunction;
+
+        /* Public functions */
+
+        /** Destructor.
+         *
+         *  Waits until all worker threads quit. Must not be called while execute() is in progress.
+         **/
+        ~ThreadPool();
+
+        /** Creates a new thread pool instance.
+         *
+         *  @param in_n_worker_threads Number of worker threads to spawn. If 0, the number of hardware threads
+         *                             reported by the running platform will be used.
+         *
+         *  @return New thread pool instance.
+         **/
+        static Anvil::ThreadPoolUniquePtr create(uint32_t in_n_worker_threads = 0);
+
+        /** Executes @param in_job_function for each job index in range [0, @param in_n_jobs) using the worker
+         *  threads, and blocks until all jobs finish executing.
+         *
+         *  Jobs are distributed dynamically, so there is no guarantee as to which worker thread is going to
+         *  execute a given job. Each job is executed exactly once.
+         *
+         *  Concurrent execute() calls are serialized. Calling this function from within a job function
+         *  will result in a deadlock.
+         *
+         *  @param in_n_jobs        Number of jobs to execute.
+         *  @param in_job_function  Function to call for each job. Must not be nullptr.
+         **/
+        void execute(uint32_t           in_n_jobs,
+                     const JobFunction& in_job_function);
+
+        /** Returns the number of worker threads owned by the pool. */
+        uint32_t get_n_worker_threads() const
+        {
+            return static_cast<uint32_t>(m_worker_threads.size() );
+        }
+
+    private:
+        /* Private functions */
+        explicit ThreadPool(uint32_t in_n_worker_threads);
+
+        void worker_thread_entrypoint(uint32_t in_n_worker_thread);
+
+        /* Private variables */
+        std::condition_variable  m_batch_available_cv;
+        std::condition_variable  m_batch_finished_cv;
+        uint64_t                 m_batch_id;
+        const JobFunction*       m_current_job_function_ptr;
+        std::mutex               m_execute_mutex;
+        std::mutex               m_mutex;
+        uint32_t                 m_n_jobs;
+        std::atomic<uint32_t>    m_n_next_job;
+        uint32_t                 m_n_worker_threads_busy;
+        bool                     m_should_terminate;
+        std::vector<std::thread> m_worker_threads;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ThreadPool);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(ThreadPool);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_THREAD_POOL_H */
@@ -20,7 +20,13 @@
 // THE SOFTWARE.
 //
 
-/*  Implements an utility which returns high-performance, monotonic time data. **/
+/*  Implements an utility which returns high-performance, monotonic time data.
+ *
+ *  Also implements a scoped CPU profiler. Scopes declared with ANVIL_PROFILE_SCOPE() (and CPU spans recorded by
+ *  Anvil's own instrumentation, see misc/tracer.h) store their durations in per-thread ring buffers while
+ *  profiling is enabled. Recording a sample takes no locks. Aggregated min/avg/p99/max values for each named
+ *  scope can be queried at any time, and are computed over the samples currently held by the ring buffers.
+ **/
 #ifndef MISC_TIME_H
 #define MISC_TIME_H
 
@@ -30,7 +36,24 @@
     #include <time.h>
 #endif
 
+#include "config.h"
+#include "misc/types_macro.h"
 #include <stdint.h>
+#include <string>
+#include <vector>
+
+#if defined(ANVIL_ENABLE_TRACING)
+    #define ANVIL_PROFILE_SCOPE_CONCAT_INTERNAL(a, b) a##b
+    #define ANVIL_PROFILE_SCOPE_CONCAT(a, b)          ANVIL_PROFILE_SCOPE_CONCAT_INTERNAL(a, b)
+
+    /* Measures the time between the point of declaration and the end of the enclosing scope.
+     *
+     * @param name Name of the scope. Must be a string literal.
+     */
+    #define ANVIL_PROFILE_SCOPE(name) Anvil::Time::ScopedProfile ANVIL_PROFILE_SCOPE_CONCAT(anvil_profile_scope_, __LINE__)(name)
+#else
+    #define ANVIL_PROFILE_SCOPE(name)
+#endif
 
 
 namespace Anvil
@@ -38,12 +61,116 @@ namespace Anvil
     class Time
     {
     public:
+        /* Public type definitions */
+
+        /** Holds aggregated timings of a named scope. */
+        typedef struct ScopeStats
+        {
+            double      avg_ns;
+            uint64_t    max_ns;
+            uint64_t    min_ns;
+            uint32_t    n_samples;
+            std::string name;
+            uint64_t    p99_ns;
+
+            ScopeStats()
+                :avg_ns   (0.0),
+                 max_ns   (0),
+                 min_ns   (0),
+                 n_samples(0),
+                 p99_ns   (0)
+            {
+                /* Stub */
+            }
+        } ScopeStats;
+
+        /** Records the lifetime of the instance as a sample of the specified scope, if scope profiling is enabled
+         *  at construction time.
+         **/
+        class ScopedProfile
+        {
+        public:
+            /** Constructor.
+             *
+             *  @param in_name Name of the scope. The string is not copied, so it must outlive the samples.
+             *                 String literals are recommended.
+             **/
+            explicit ScopedProfile(const char* in_name)
+                :m_name         (in_name),
+                 m_start_time_ns(0)
+            {
+                if (Anvil::Time::is_scope_profiling_enabled() )
+                {
+                    m_start_time_ns = Anvil::Time::get_current_time_in_nsec();
+                }
+            }
+
+            ~ScopedProfile()
+            {
+                if (m_start_time_ns != 0)
+                {
+                    Anvil::Time::add_scope_sample(m_name,
+                                                  Anvil::Time::get_current_time_in_nsec() - m_start_time_ns);
+                }
+            }
+
+        private:
+            const char* m_name;
+            uint64_t    m_start_time_ns;
+
+            ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ScopedProfile);
+            ANVIL_DISABLE_COPY_CONSTRUCTOR(ScopedProfile);
+        };
+
         /* Public functions */
          Time();
         ~Time();
 
+        /** Records a duration sample for the specified scope in the calling thread's ring buffer. Ignored if scope
+         *  profiling is disabled.
+         *
+         *  @param in_name        Name of the scope. The string is not copied, so it must outlive the samples.
+         *  @param in_duration_ns Duration, in nanoseconds.
+         **/
+        static void add_scope_sample(const char* in_name,
+                                     uint64_t    in_duration_ns);
+
+        /** Returns the value of a monotonic clock, in nanoseconds. The value is not relative to any
+         *  particular Time instance. It is never 0.
+         **/
+        static uint64_t get_current_time_in_nsec();
+
+        /** Aggregates samples of all scopes, which are held by the ring buffers.
+         *
+         *  Ring buffers of threads which have exited are released by the call. Their samples are only included
+         *  in the first set of stats gathered after the thread exits.
+         *
+         *  @param out_stats_ptr Deref will be set to the aggregated values, sorted by name. Must not be nullptr.
+         **/
+        static void get_scope_stats(std::vector<ScopeStats>* out_stats_ptr);
+
+        /** Aggregates samples of a single scope, which are held by the ring buffers. Ring buffers of threads
+         *  which have exited are released, as in the other overload.
+         *
+         *  @return true if at least one sample of the scope was found, false otherwise.
+         **/
+        static bool get_scope_stats(const std::string& in_name,
+                                    ScopeStats*        out_stats_ptr);
+
         uint64_t get_time_in_msec();
 
+        /** Returns the time elapsed since the instance was created, in nanoseconds. */
+        uint64_t get_time_in_nsec();
+
+        /** Tells whether scope samples are being recorded. */
+        static bool is_scope_profiling_enabled();
+
+        /** Discards all samples recorded so far. Samples recorded concurrently with the call may or may not be kept. */
+        static void reset_scope_stats();
+
+        /** Enables or disables recording of scope samples. Disabled by default. */
+        static void set_scope_profiling_enabled(bool in_enabled);
+
     private:
         /* Private fields */
         #ifdef _WIN32
@@ -52,7 +179,9 @@ namespace Anvil
         #else
             uint64_t m_start_time;
         #endif
+
+        uint64_t m_start_time_ns;
     };
 }; /* namespace Anvil */
 
-#endif /* MISC_TIME_H */
\ No newline at end of file
+#endif /* MISC_TIME_H */
@@ -0,0 +1,364 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/** Implements a tracer which collects CPU spans recorded by Anvil (and, optionally, by applications) and GPU
+ *  timestamp ranges, and exports both to a single Chrome trace JSON file. The file can be opened with
+ *  chrome://tracing or the Perfetto UI.
+ *
+ *  Spans are only collected while a capture is in progress. Outside captures, and with scope profiling disabled
+ *  (see Anvil::Time), instrumented code paths only pay for two relaxed atomic loads. If Anvil is built with
+ *  ANVIL_ENABLE_TRACING disabled, the instrumentation is compiled out altogether.
+ *
+ *  CPU spans are stored in per-thread buffers, so recording threads do not contend with each other.
+ *
+ *  GPU timestamps are converted to the CPU time domain using per-queue calibration data. Call
+ *  Tracer::calibrate_queue() for each queue GPU spans are going to be collected for before collecting them.
+ *  The calibration submits a single timestamp write and is accurate to within the submission's round-trip
+ *  latency.
+ **/
+#ifndef MISC_TRACER_H
+#define MISC_TRACER_H
+
+#include "misc/time.h"
+#include "misc/types.h"
+#include <atomic>
+#include <map>
+#include <mutex>
+
+#if defined(ANVIL_ENABLE_TRACING)
+    #define ANVIL_TRACE_CPU_SPAN_CONCAT_INTERNAL(a, b) a##b
+    #define ANVIL_TRACE_CPU_SPAN_CONCAT(a, b)          ANVIL_TRACE_CPU_SPAN_CONCAT_INTERNAL(a, b)
+
+    /* Records a CPU span, which starts at the point of declaration and ends at the end of the enclosing scope.
+     *
+     * @param name Name of the span. Must be a string literal.
+     */
+    #define ANVIL_TRACE_CPU_SPAN(name) Anvil::Tracer::ScopedCPUSpan ANVIL_TRACE_CPU_SPAN_CONCAT(anvil_trace_cpu_span_, __LINE__)(name)
+#else
+    #define ANVIL_TRACE_CPU_SPAN(name)
+#endif
+
+
+namespace Anvil
+{
+    class Tracer
+    {
+    public:
+        /* Public type definitions */
+
+        /** Records a CPU span covering the lifetime of the instance, if a capture is in progress at construction time.
+         *
+         *  If scope profiling is enabled (see Anvil::Time), the span's duration is also recorded as a scope sample.
+         **/
+        class ScopedCPUSpan
+        {
+        public:
+            /** Constructor.
+             *
+             *  @param in_name Name of the span. The string is not copied, so it must outlive the capture.
+             *                 String literals are recommended.
+             **/
+            explicit ScopedCPUSpan(const char* in_name)
+                :m_name         (in_name),
+                 m_start_time_ns(0)
+            {
+                if (Anvil::Tracer::is_capturing()                 ||
+                    Anvil::Time::is_scope_profiling_enabled() )
+                {
+                    m_start_time_ns = Anvil::Tracer::get_time_in_nsec();
+                }
+            }
+
+            ~ScopedCPUSpan()
+            {
+                if (m_start_time_ns != 0)
+                {
+                    const uint64_t end_time_ns = Anvil::Tracer::get_time_in_nsec();
+
+                    if (Anvil::Tracer::is_capturing() )
+                    {
+                        Anvil::Tracer::get()->add_cpu_span(m_name,
+                                                           m_start_time_ns,
+                                                           end_time_ns);
+                    }
+
+                    Anvil::Time::add_scope_sample(m_name,
+                                                  end_time_ns - m_start_time_ns);
+                }
+            }
+
+        private:
+            const char* m_name;
+            uint64_t    m_start_time_ns;
+
+            ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ScopedCPUSpan);
+            ANVIL_DISABLE_COPY_CONSTRUCTOR(ScopedCPUSpan);
+        };
+
+        /* Public functions */
+
+        /** Records a CPU span for the calling thread. Ignored if no capture is in progress.
+         *
+         *  @param in_name          Name of the span. The string is not copied, so it must outlive the capture.
+         *  @param in_start_time_ns Start time, as returned by get_time_in_nsec().
+         *  @param in_end_time_ns   End time, as returned by get_time_in_nsec().
+         **/
+        void add_cpu_span(const char* in_name,
+                          uint64_t    in_start_time_ns,
+                          uint64_t    in_end_time_ns);
+
+        /** Records a GPU span for the specified queue. Ignored if no capture is in progress.
+         *
+         *  @param in_queue_ptr     Queue the commands were executed on. Must not be nullptr.
+         *  @param in_name          Name of the span.
+         *  @param in_start_time_ns Start time, in the CPU time domain. See convert_gpu_timestamp().
+         *  @param in_end_time_ns   End time, in the CPU time domain.
+         **/
+        void add_gpu_span(const Anvil::Queue* in_queue_ptr,
+                          const std::string&  in_name,
+                          uint64_t            in_start_time_ns,
+                          uint64_t            in_end_time_ns);
+
+        /** Calculates the offset between GPU timestamps written on @param in_queue_ptr and the CPU clock used
+         *  by the tracer.
+         *
+         *  The function submits a command buffer to the queue and blocks until it finishes executing.
+         *  The queue's family must support timestamp queries.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool calibrate_queue(Anvil::Queue* in_queue_ptr);
+
+        /** Drops all spans collected so far. */
+        void clear();
+
+        /** Converts a raw timestamp value written on @param in_queue_ptr to the tracer's CPU time domain.
+         *
+         *  @return true if successful, false if the queue has not been calibrated.
+         **/
+        bool convert_gpu_timestamp(const Anvil::Queue* in_queue_ptr,
+                                   uint64_t            in_timestamp,
+                                   uint64_t*           out_time_ns_ptr) const;
+
+        /** Releases the tracer instance, if one has been created. Must not be called while other threads record spans. */
+        static void destroy();
+
+        /** Writes all spans collected so far to a Chrome trace JSON file.
+         *
+         *  CPU spans are reported under the "CPU" process, one track per thread. GPU spans are reported under the "GPU"
+         *  process, one track per queue. Timestamps are relative to the start of the first capture.
+         *
+         *  @param in_filename Name of the file to write. Existing files are overwritten.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool export_chrome_trace(const std::string& in_filename) const;
+
+        /** Returns the tracer instance, creating it first if necessary. The function is thread-safe. */
+        static Tracer* get();
+
+        /** Returns the value of the monotonic clock used by the tracer, in nanoseconds. The returned value is never 0. */
+        static uint64_t get_time_in_nsec()
+        {
+            return Anvil::Time::get_current_time_in_nsec();
+        }
+
+        /** Tells whether a capture is in progress. */
+        static bool is_capturing();
+
+        /** Assigns a name to the calling thread's track in exported traces. */
+        void set_thread_name(const std::string& in_name);
+
+        /** Starts a new capture. Spans collected by previous captures are preserved until clear() is called.
+         *
+         *  @param in_max_n_spans_per_thread Maximum number of CPU spans to store for each thread, and of GPU spans to
+         *                                   store for each queue. Further spans are dropped, so that a forgotten capture
+         *                                   cannot exhaust host memory.
+         **/
+        void start_capture(uint32_t in_max_n_spans_per_thread = 1024 * 1024);
+
+        /** Stops the capture in progress. */
+        void stop_capture();
+
+    private:
+        /* Private type definitions */
+        typedef struct CPUSpan
+        {
+            const char* name;
+            uint64_t    start_time_ns;
+            uint64_t    end_time_ns;
+        } CPUSpan;
+
+        typedef struct CPUThreadData
+        {
+            std::mutex           mutex;
+            std::string          name;
+            uint32_t             n_dropped_spans;
+            std::vector<CPUSpan> spans;
+            uint32_t             thread_index;
+
+            explicit CPUThreadData(uint32_t in_thread_index)
+                :n_dropped_spans(0),
+                 thread_index   (in_thread_index)
+            {
+                /* Stub */
+            }
+        } CPUThreadData;
+
+        typedef struct GPUSpan
+        {
+            std::string name;
+            uint64_t    start_time_ns;
+            uint64_t    end_time_ns;
+        } GPUSpan;
+
+        typedef struct QueueData
+        {
+            bool                 is_calibrated;
+            int64_t              offset_ns;
+            double               ns_per_tick;
+            uint32_t             n_dropped_spans;
+            std::vector<GPUSpan> spans;
+            uint32_t             queue_family_index;
+            uint32_t             queue_index;
+            uint64_t             timestamp_mask;
+            uint32_t             track_index;
+
+            QueueData()
+                :is_calibrated     (false),
+                 offset_ns         (0),
+                 ns_per_tick       (1.0),
+                 n_dropped_spans   (0),
+                 queue_family_index(UINT32_MAX),
+                 queue_index       (UINT32_MAX),
+                 timestamp_mask    (UINT64_MAX),
+                 track_index       (0)
+            {
+                /* Stub */
+            }
+        } QueueData;
+
+        /* Private functions */
+        Tracer();
+
+        CPUThreadData* get_cpu_thread_data();
+
+        /* Private variables */
+        uint64_t                                     m_capture_start_time_ns;
+        std::vector<std::shared_ptr<CPUThreadData> > m_cpu_thread_data_ptrs;
+        const uint32_t                               m_generation;
+        std::atomic<uint32_t>                        m_max_n_spans_per_thread;
+        mutable std::mutex                           m_mutex;
+        std::map<const Anvil::Queue*, QueueData>     m_queue_data;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(Tracer);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(Tracer);
+    };
+
+    /** Collects GPU spans with timestamp queries and forwards them to the tracer.
+     *
+     *  Usage:
+     *
+     *  1. Call record_reset() at the start of a command buffer, outside render passes.
+     *  2. Surround commands of interest with record_begin() and record_end() calls.
+     *  3. Once the command buffer finishes executing, call collect() with the queue it was submitted to.
+     *
+     *  Spans recorded while no capture is in progress are ignored. The recorder must not be reset before
+     *  the results of the previous submission are collected.
+     **/
+    class GPUSpanRecorder
+    {
+    public:
+        /* Public functions */
+
+        /** Creates a new recorder instance.
+         *
+         *  @param in_device_ptr  Device to use. Must not be nullptr.
+         *  @param in_max_n_spans Maximum number of spans which can be recorded between two record_reset() calls.
+         *
+         *  @return New recorder instance or nullptr if the function failed.
+         **/
+        static Anvil::GPUSpanRecorderUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
+                                                      uint32_t                 in_max_n_spans);
+
+        /** Destructor */
+        ~GPUSpanRecorder();
+
+        /** Reads back timestamps recorded since the last record_reset() call and forwards them to the tracer.
+         *
+         *  Blocks until the results become available.
+         *
+         *  @param in_queue_ptr Queue the command buffer was executed on. Must have been calibrated with
+         *                      Tracer::calibrate_queue().
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool collect(const Anvil::Queue* in_queue_ptr);
+
+        /** Records a timestamp write marking the beginning of a new span.
+         *
+         *  @param in_cmd_buffer_ptr Command buffer to record the command in. Must not be nullptr.
+         *  @param in_name           Name of the span.
+         *
+         *  @return ID of the span, to be passed to record_end(), or UINT32_MAX if no capture is in progress or
+         *          the recorder is full.
+         **/
+        uint32_t record_begin(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                              const std::string&        in_name);
+
+        /** Records a timestamp write marking the end of a span returned by record_begin(). UINT32_MAX is ignored. */
+        void record_end(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                        uint32_t                  in_span_id);
+
+        /** Records a query pool reset command and drops spans recorded since the previous call.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool record_reset(Anvil::CommandBufferBase* in_cmd_buffer_ptr);
+
+    private:
+        /* Private type definitions */
+        typedef struct Span
+        {
+            bool        has_ended;
+            std::string name;
+        } Span;
+
+        /* Private functions */
+        GPUSpanRecorder(const Anvil::BaseDevice* in_device_ptr,
+                        uint32_t                 in_max_n_spans);
+
+        bool init();
+
+        /* Private variables */
+        const Anvil::BaseDevice*  m_device_ptr;
+        uint32_t                  m_max_n_spans;
+        Anvil::QueryPoolUniquePtr m_query_pool_ptr;
+        std::vector<Span>         m_spans;
+        std::vector<uint64_t>     m_timestamps;
+
+        ANVIL_DISABLE_ASSIGNMENT_OPERATOR(GPUSpanRecorder);
+        ANVIL_DISABLE_COPY_CONSTRUCTOR(GPUSpanRecorder);
+    };
+}; /* namespace Anvil */
+
+#endif /* MISC_TRACER_H */
@@ -107,6 +107,7 @@ namespace Anvil
 {
     class  BaseDevice;
     class  BasePipelineCreateInfo;
+    class  BindlessDescriptorTable;
     class  Buffer;
     class  BufferCreateInfo;
     class  BufferView;
@@ -114,27 +115,36 @@ namespace Anvil
     struct CallbackArgument;
     class  CommandBufferBase;
     class  CommandPool;
+    class  ComputeDispatcher;
     class  ComputePipelineCreateInfo;
     class  ComputePipelineManager;
     class  DebugMessenger;
     class  DebugMessengerCreateInfo;
     class  DescriptorPool;
+    class  DescriptorPoolAllocator;
     class  DescriptorPoolCreateInfo;
     class  DescriptorSet;
+    class  DescriptorSetCache;
     class  DescriptorSetCreateInfo;
     class  DescriptorSetGroup;
     class  DescriptorSetLayout;
     class  DescriptorSetLayoutManager;
     class  DescriptorUpdateTemplate;
     class  DeviceCreateInfo;
+    class  DrawBatcher;
     class  ExternalHandle;
     class  Event;
     class  EventCreateInfo;
     class  Fence;
     class  FenceCreateInfo;
+    class  FenceReactor;
+    class  FrameCommandAllocator;
+    class  FrameDescriptorAllocator;
     class  Framebuffer;
     class  FramebufferCreateInfo;
     class  GLSLShaderToSPIRVGenerator;
+    class  GPUProfiler;
+    class  GPUSpanRecorder;
     class  GraphicsPipelineCreateInfo;
     class  GraphicsPipelineManager;
     class  Image;
@@ -150,6 +160,7 @@ namespace Anvil
     struct MemoryProperties;
     struct MemoryType;
     class  MGPUDevice;
+    class  ParallelRenderPassRecorder;
     class  PhysicalDevice;
     class  PipelineCache;
     class  PipelineLayout;
@@ -173,21 +184,26 @@ namespace Anvil
     class  ShaderModuleCache;
     class  Swapchain;
     class  SwapchainCreateInfo;
+    class  ThreadPool;
     class  Window;
 
     typedef std::unique_ptr<BaseDevice,                            std::function<void(BaseDevice*)> >                  BaseDeviceUniquePtr;
     typedef std::unique_ptr<BasePipelineCreateInfo>                                                                    BasePipelineCreateInfoUniquePtr;
+    typedef std::unique_ptr<BindlessDescriptorTable,               std::function<void(BindlessDescriptorTable*)> >     BindlessDescriptorTableUniquePtr;
     typedef std::unique_ptr<BufferCreateInfo>                                                                          BufferCreateInfoUniquePtr;
     typedef std::unique_ptr<Buffer,                                std::function<void(Buffer*)> >                      BufferUniquePtr;
     typedef std::unique_ptr<BufferViewCreateInfo>                                                                      BufferViewCreateInfoUniquePtr;
     typedef std::unique_ptr<BufferView,                            std::function<void(BufferView*)> >                  BufferViewUniquePtr;
     typedef std::unique_ptr<CommandBufferBase,                     std::function<void(CommandBufferBase*)> >           CommandBufferBaseUniquePtr;
     typedef std::unique_ptr<CommandPool,                           std::function<void(CommandPool*)> >                 CommandPoolUniquePtr;
+    typedef std::unique_ptr<ComputeDispatcher,                     std::function<void(ComputeDispatcher*)> >           ComputeDispatcherUniquePtr;
     typedef std::unique_ptr<ComputePipelineCreateInfo>                                                                 ComputePipelineCreateInfoUniquePtr;
     typedef std::unique_ptr<DebugMessengerCreateInfo>                                                                  DebugMessengerCreateInfoUniquePtr;
     typedef std::unique_ptr<DebugMessenger,                        std::function<void(DebugMessenger*)> >              DebugMessengerUniquePtr;
+    typedef std::unique_ptr<DescriptorPoolAllocator,               std::function<void(DescriptorPoolAllocator*)> >     DescriptorPoolAllocatorUniquePtr;
     typedef std::unique_ptr<DescriptorPoolCreateInfo>                                                                  DescriptorPoolCreateInfoUniquePtr;
     typedef std::unique_ptr<DescriptorPool,                        std::function<void(DescriptorPool*)> >              DescriptorPoolUniquePtr;
+    typedef std::unique_ptr<DescriptorSetCache,                    std::function<void(DescriptorSetCache*)> >          DescriptorSetCacheUniquePtr;
     typedef std::unique_ptr<DescriptorSetCreateInfo>                                                                   DescriptorSetCreateInfoUniquePtr;
     typedef std::unique_ptr<DescriptorSetGroup,                    std::function<void(DescriptorSetGroup*)> >          DescriptorSetGroupUniquePtr;
     typedef std::unique_ptr<DescriptorSetLayout,                   std::function<void(DescriptorSetLayout*)> >         DescriptorSetLayoutUniquePtr;
@@ -195,14 +211,20 @@ namespace Anvil
     typedef std::unique_ptr<DescriptorSet,                         std::function<void(DescriptorSet*)> >               DescriptorSetUniquePtr;
     typedef std::unique_ptr<DescriptorUpdateTemplate,              std::function<void(DescriptorUpdateTemplate*)> >    DescriptorUpdateTemplateUniquePtr;
     typedef std::unique_ptr<DeviceCreateInfo>                                                                          DeviceCreateInfoUniquePtr;
+    typedef std::unique_ptr<DrawBatcher,                           std::function<void(DrawBatcher*)> >                 DrawBatcherUniquePtr;
     typedef std::unique_ptr<ExternalHandle,                        std::function<void(ExternalHandle*)> >              ExternalHandleUniquePtr;
     typedef std::unique_ptr<EventCreateInfo>                                                                           EventCreateInfoUniquePtr;
     typedef std::unique_ptr<Event,                                 std::function<void(Event*)> >                       EventUniquePtr;
     typedef std::unique_ptr<FenceCreateInfo>                                                                           FenceCreateInfoUniquePtr;
+    typedef std::unique_ptr<FenceReactor,                          std::function<void(FenceReactor*)> >                FenceReactorUniquePtr;
     typedef std::unique_ptr<Fence,                                 std::function<void(Fence*)> >                       FenceUniquePtr;
+    typedef std::unique_ptr<FrameCommandAllocator,                 std::function<void(FrameCommandAllocator*)> >       FrameCommandAllocatorUniquePtr;
+    typedef std::unique_ptr<FrameDescriptorAllocator,              std::function<void(FrameDescriptorAllocator*)> >    FrameDescriptorAllocatorUniquePtr;
     typedef std::unique_ptr<FramebufferCreateInfo>                                                                     FramebufferCreateInfoUniquePtr;
     typedef std::unique_ptr<Framebuffer,                           std::function<void(Framebuffer*)> >                 FramebufferUniquePtr;
     typedef std::unique_ptr<GLSLShaderToSPIRVGenerator,            std::function<void(GLSLShaderToSPIRVGenerator*)> >  GLSLShaderToSPIRVGeneratorUniquePtr;
+    typedef std::unique_ptr<GPUProfiler,                           std::function<void(GPUProfiler*)> >                 GPUProfilerUniquePtr;
+    typedef std::unique_ptr<GPUSpanRecorder,                       std::function<void(GPUSpanRecorder*)> >             GPUSpanRecorderUniquePtr;
     typedef std::unique_ptr<GraphicsPipelineCreateInfo>                                                                GraphicsPipelineCreateInfoUniquePtr;
     typedef std::unique_ptr<GraphicsPipelineManager>                                                                   GraphicsPipelineManagerUniquePtr;
     typedef std::unique_ptr<ImageCreateInfo>                                                                           ImageCreateInfoUniquePtr;
@@ -215,6 +237,7 @@ namespace Anvil
     typedef std::unique_ptr<MemoryBlockCreateInfo>                                                                     MemoryBlockCreateInfoUniquePtr;
     typedef std::unique_ptr<MemoryBlock,                           std::function<void(MemoryBlock*)> >                 MemoryBlockUniquePtr;
     typedef std::unique_ptr<MGPUDevice,                            std::function<void(MGPUDevice*)> >                  MGPUDeviceUniquePtr;
+    typedef std::unique_ptr<ParallelRenderPassRecorder,            std::function<void(ParallelRenderPassRecorder*)> >  ParallelRenderPassRecorderUniquePtr;
     typedef std::unique_ptr<PipelineCache,                         std::function<void(PipelineCache*)> >               PipelineCacheUniquePtr;
     typedef std::unique_ptr<PipelineLayoutManager,                 std::function<void(PipelineLayoutManager*)> >       PipelineLayoutManagerUniquePtr;
     typedef std::unique_ptr<PipelineLayout,                        std::function<void(PipelineLayout*)> >              PipelineLayoutUniquePtr;
@@ -236,6 +259,7 @@ namespace Anvil
     typedef std::unique_ptr<ShaderModule,                          std::function<void(ShaderModule*)> >                ShaderModuleUniquePtr;
     typedef std::unique_ptr<SwapchainCreateInfo>                                                                       SwapchainCreateInfoUniquePtr;
     typedef std::unique_ptr<Swapchain,                             std::function<void(Swapchain*)> >                   SwapchainUniquePtr;
+    typedef std::unique_ptr<ThreadPool,                            std::function<void(ThreadPool*)> >                  ThreadPoolUniquePtr;
     typedef std::unique_ptr<Window,                                std::function<void(Window*)> >                      WindowUniquePtr;
 };
 
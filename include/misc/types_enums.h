@@ -836,6 +836,22 @@ namespace Anvil
 
     INJECT_BITFIELD_HELPER_FUNC_PROTOTYPES(DescriptorPoolCreateFlags, VkDescriptorPoolCreateFlags, DescriptorPoolCreateFlagBits)
 
+    /* NOTE: Maps 1:1 to VK equivalents */
+    enum class DescriptorSetLayoutCreateFlagBits
+    {
+        /* When set, descriptor sets must not be allocated using the layout. Instead, descriptors are pushed directly
+         * into a command buffer by calling CommandBufferBase::record_push_descriptor_set().
+         *
+         * Requires VK_KHR_push_descriptor.
+         **/
+        PUSH_DESCRIPTOR_BIT_KHR = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR,
+
+        NONE = 0
+    };
+    typedef Anvil::Bitfield<Anvil::DescriptorSetLayoutCreateFlagBits, VkDescriptorSetLayoutCreateFlags> DescriptorSetLayoutCreateFlags;
+
+    INJECT_BITFIELD_HELPER_FUNC_PROTOTYPES(DescriptorSetLayoutCreateFlags, VkDescriptorSetLayoutCreateFlags, DescriptorSetLayoutCreateFlagBits)
+
     enum class DescriptorSetUpdateMethod
     {
         /* Updates dirty DS bindings using vkUpdateDescriptorSet() which is available on all Vulkan implementations. */
@@ -1812,6 +1828,18 @@ namespace Anvil
         UNKNOWN = VK_SAMPLER_YCBCR_MODEL_CONVERSION_MAX_ENUM
     };
 
+    /* NOTE: These map 1:1 to VK equivalents */
+    enum class SemaphoreType
+    {
+        /* Core VK 1.0 */
+        BINARY       = VK_SEMAPHORE_TYPE_BINARY_KHR,
+
+        /* VK_KHR_timeline_semaphore */
+        TIMELINE_KHR = VK_SEMAPHORE_TYPE_TIMELINE_KHR,
+
+        UNKNOWN = VK_SEMAPHORE_TYPE_MAX_ENUM_KHR
+    };
+
     /* Specifies one of the compute / rendering pipeline stages. */
     enum class ShaderStage
     {
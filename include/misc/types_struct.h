@@ -1008,6 +1008,15 @@ namespace Anvil
         ExtensionKHRDrawIndirectCountEntrypoints();
     } ExtensionKHRDrawIndirectCountEntrypoints;
 
+    typedef struct ExtensionKHRTimelineSemaphoreEntrypoints
+    {
+        PFN_vkGetSemaphoreCounterValueKHR vkGetSemaphoreCounterValueKHR;
+        PFN_vkSignalSemaphoreKHR          vkSignalSemaphoreKHR;
+        PFN_vkWaitSemaphoresKHR           vkWaitSemaphoresKHR;
+
+        ExtensionKHRTimelineSemaphoreEntrypoints();
+    } ExtensionKHRTimelineSemaphoreEntrypoints;
+
     typedef struct ExtensionKHRBindMemory2Entrypoints
     {
         PFN_vkBindBufferMemory2KHR vkBindBufferMemory2KHR;
@@ -1132,6 +1141,13 @@ namespace Anvil
         ExtensionKHRMaintenance3Entrypoints();
     } ExtensionKHRMaintenance3Entrypoints;
 
+    typedef struct ExtensionKHRPushDescriptorEntrypoints
+    {
+        PFN_vkCmdPushDescriptorSetKHR vkCmdPushDescriptorSetKHR;
+
+        ExtensionKHRPushDescriptorEntrypoints();
+    } ExtensionKHRPushDescriptorEntrypoints;
+
     typedef struct ExtensionKHRSamplerYCbCrConversionEntrypoints
     {
         PFN_vkCreateSamplerYcbcrConversionKHR  vkCreateSamplerYcbcrConversionKHR;
@@ -1784,6 +1800,18 @@ namespace Anvil
         bool operator==(const KHRVariablePointerFeatures& in_features) const;
     } KHRVariablePointerFeatures;
 
+    typedef struct KHRTimelineSemaphoreFeatures
+    {
+        bool timeline_semaphore;
+
+        KHRTimelineSemaphoreFeatures();
+        KHRTimelineSemaphoreFeatures(const VkPhysicalDeviceTimelineSemaphoreFeaturesKHR& in_features);
+
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR get_vk_physical_device_timeline_semaphore_features() const;
+
+        bool operator==(const KHRTimelineSemaphoreFeatures& in_features) const;
+    } KHRTimelineSemaphoreFeatures;
+
     typedef struct KHRVulkanMemoryModelFeatures
     {
         bool vulkan_memory_model;
@@ -2405,6 +2433,7 @@ namespace Anvil
         const KHRMultiviewFeatures*              khr_multiview_features_ptr;
         const KHRSamplerYCbCrConversionFeatures* khr_sampler_ycbcr_conversion_features_ptr;
         const KHRShaderAtomicInt64Features*      khr_shader_atomic_int64_features_ptr;
+        const KHRTimelineSemaphoreFeatures*      khr_timeline_semaphore_features_ptr;
         const KHRVariablePointerFeatures*        khr_variable_pointer_features_ptr;
         const KHRVulkanMemoryModelFeatures*      khr_vulkan_memory_model_features_ptr;
 
@@ -2423,6 +2452,7 @@ namespace Anvil
                                const KHRMultiviewFeatures*              in_khr_multiview_features_ptr,
                                const KHRSamplerYCbCrConversionFeatures* in_khr_sampler_ycbcr_conversion_features_ptr,
                                const KHRShaderAtomicInt64Features*      in_khr_shader_atomic_int64_features_ptr,
+                               const KHRTimelineSemaphoreFeatures*      in_khr_timeline_semaphore_features_ptr,
                                const KHRVariablePointerFeatures*        in_khr_variable_pointer_features_ptr,
                                const KHRVulkanMemoryModelFeatures*      in_khr_vulkan_memory_model_features_ptr);
 
@@ -2916,6 +2946,7 @@ namespace Anvil
          *  - D3D12 fence submit info:          none
          *  - Keyed mutex acquire/release info: none
          *  - Protected submission:             no
+         *  - Timeline semaphore values:        none
          *
          *  To adjust these settings, please use corresponding set_..() functions, prior to passing the structure over to Queue::submit().
          *
@@ -3195,11 +3226,60 @@ namespace Anvil
             return wait_semaphores_sgpu_ptr;
         }
 
+        /* Returns true if set_timeline_semaphore_values() has been called prior to this call. Otherwise returns false.
+         *
+         * If the func returns true, *out_signal_semaphore_values_ptr_ptr and *out_wait_semaphore_values_ptr_ptr are set
+         * to the pointers passed to set_timeline_semaphore_values().
+         */
+        bool get_timeline_semaphore_values(const uint64_t** out_signal_semaphore_values_ptr_ptr,
+                                           const uint64_t** out_wait_semaphore_values_ptr_ptr) const
+        {
+            *out_signal_semaphore_values_ptr_ptr = timeline_signal_semaphore_values_ptr;
+            *out_wait_semaphore_values_ptr_ptr   = timeline_wait_semaphore_values_ptr;
+
+            return has_timeline_semaphore_values;
+        }
+
         const bool& is_protected_submission() const
         {
             return is_protected;
         }
 
+        /* Calling this function will make Anvil fill & chain a VkTimelineSemaphoreSubmitInfoKHR struct at queue submission time.
+         *
+         * Requires VK_KHR_timeline_semaphore support.
+         *
+         * NOTE: The structure caches the provided pointers, not the contents available under derefs! Make sure the pointers remain valid
+         *       for the time of the Queue::submit() call.
+         *
+         * @param in_signal_semaphore_values_ptr An array of exactly n_signal_semaphores values. Values corresponding to binary semaphores
+         *                                       are ignored. Must not be nullptr unless n_signal_semaphores is 0.
+         * @param in_n_signal_semaphore_values   Must be equal to n_signal_semaphores.
+         * @param in_wait_semaphore_values_ptr   An array of exactly n_wait_semaphores values. Values corresponding to binary semaphores
+         *                                       are ignored. Must not be nullptr unless n_wait_semaphores is 0.
+         * @param in_n_wait_semaphore_values     Must be equal to n_wait_semaphores.
+         **/
+        void set_timeline_semaphore_values(const uint64_t* in_signal_semaphore_values_ptr,
+                                           const uint32_t& in_n_signal_semaphore_values,
+                                           const uint64_t* in_wait_semaphore_values_ptr,
+                                           const uint32_t& in_n_wait_semaphore_values)
+        {
+            ANVIL_REDUNDANT_ARGUMENT_CONST(in_n_signal_semaphore_values);
+            ANVIL_REDUNDANT_ARGUMENT_CONST(in_n_wait_semaphore_values);
+
+            anvil_assert((n_signal_semaphores != 0  && in_signal_semaphore_values_ptr != nullptr) ||
+                         (n_signal_semaphores == 0) );
+            anvil_assert((n_wait_semaphores   != 0  && in_wait_semaphore_values_ptr   != nullptr) ||
+                         (n_wait_semaphores   == 0) );
+
+            anvil_assert(in_n_signal_semaphore_values == n_signal_semaphores);
+            anvil_assert(in_n_wait_semaphore_values   == n_wait_semaphores);
+
+            has_timeline_semaphore_values        = true;
+            timeline_signal_semaphore_values_ptr = in_signal_semaphore_values_ptr;
+            timeline_wait_semaphore_values_ptr   = in_wait_semaphore_values_ptr;
+        }
+
         #if defined(_WIN32)
             /* Calling this function will make Anvil fill & chain a VkD3D12FenceSubmitInfoKHR struct at queue submission time.
              *
@@ -3353,6 +3433,10 @@ namespace Anvil
 
         Anvil::Fence* fence_ptr;
 
+        bool            has_timeline_semaphore_values;
+        const uint64_t* timeline_signal_semaphore_values_ptr;
+        const uint64_t* timeline_wait_semaphore_values_ptr;
+
         #if defined(_WIN32)
             const uint64_t* d3d12_fence_signal_semaphore_values_ptr;
             const uint64_t* d3d12_fence_wait_semaphore_values_ptr;
@@ -106,6 +106,7 @@ namespace Anvil
         COMMAND_TYPE_NEXT_SUBPASS_2_KHR,
         COMMAND_TYPE_PIPELINE_BARRIER,
         COMMAND_TYPE_PUSH_CONSTANTS,
+        COMMAND_TYPE_PUSH_DESCRIPTOR_SET_KHR,
         COMMAND_TYPE_RESET_EVENT,
         COMMAND_TYPE_RESET_QUERY_POOL,
         COMMAND_TYPE_RESOLVE_IMAGE,
@@ -160,6 +161,8 @@ namespace Anvil
     enum CommandBufferCallbackID
     {
         /* Call-back issued whenever a vkCmdPipelineBarrier() is recorded.
+         *
+         * Only issued if Anvil has been built with ANVIL_ENABLE_COMMAND_RECORDED_CALLBACKS enabled.
          *
          * callback_arg: PipelineBarrierCommandRecordedCallback instance.
          */
@@ -452,6 +455,23 @@ namespace Anvil
          */
         void end_debug_utils_label();
 
+        /** Records all pipeline barriers which have been accumulated by preceding record_pipeline_barrier()
+         *  calls, but which have not yet been issued to the underlying Vulkan command buffer.
+         *
+         *  Anvil calls this function automatically before any command other than a state-setting one (binds,
+         *  push constants, dynamic state) is recorded, as well as at stop_recording() time. Applications only
+         *  need to call it if they record commands into the raw Vulkan command buffer handle directly.
+         *
+         *  Nop if no barriers are pending.
+         */
+        void flush_pending_pipeline_barriers()
+        {
+            if (m_pending_barrier_src_stage_mask_vk != 0)
+            {
+                flush_pending_pipeline_barriers_internal();
+            }
+        }
+
         /** Returns a handle to the raw Vulkan command buffer instance, encapsulated by the object */
         VkCommandBuffer get_command_buffer() const
         {
@@ -488,6 +508,15 @@ namespace Anvil
         void insert_debug_utils_label(const char*  in_label_name_ptr,
                                       const float* in_color_vec4_ptr);
 
+        /** Tells whether pipeline barrier batching has been enabled for this command buffer.
+         *
+         *  See set_pipeline_barrier_batching_enabled() for more details.
+         */
+        bool is_pipeline_barrier_batching_enabled() const
+        {
+            return m_pipeline_barrier_batching_enabled;
+        }
+
         /** Issues a vkCmdBeginQuery() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -1181,6 +1210,10 @@ namespace Anvil
          *  Calling this function for a command buffer which has not been put into a recording mode
          *  (by issuing a start_recording() call earlier) will result in an assertion failure.
          *
+         *  If pipeline barrier batching is enabled, the vkCmdPipelineBarrier() call is deferred until
+         *  the next non-barrier command is recorded. Consecutive barriers are merged into a single call
+         *  in the meantime. Please see set_pipeline_barrier_batching_enabled() for more details.
+         *
          *  Argument meaning is as per Vulkan API specification.
          *
          *  @return true if successful, false otherwise.
@@ -1212,6 +1245,40 @@ namespace Anvil
                                    uint32_t                in_size,
                                    const void*             in_values);
 
+        /** Issues a vkCmdPushDescriptorSetKHR() call and appends it to the internal vector of commands
+         *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
+         *  #define enabled).
+         *
+         *  Writes @param in_element_range items of a single binding straight into the command buffer, without
+         *  allocating or updating a descriptor set. The set at index @param in_set of @param in_layout_ptr must
+         *  have been created from a DescriptorSetCreateInfo instance with PUSH_DESCRIPTOR_BIT_KHR create flag.
+         *
+         *  Accepts the same binding element types as DescriptorSet::set_binding_array_items(), except
+         *  for dynamic buffer elements which cannot be pushed. The function is explicitly instantiated
+         *  for each of these types.
+         *
+         *  Calling this function for a command buffer which has not been put into a recording mode
+         *  (by issuing a start_recording() call earlier) will result in an assertion failure.
+         *
+         *  Requires VK_KHR_push_descriptor.
+         *
+         *  @param in_pipeline_bind_point Pipeline bind point to push the descriptors for.
+         *  @param in_layout_ptr          Pipeline layout to use for the push. Must not be nullptr.
+         *  @param in_set                 Index of the push descriptor set in @param in_layout_ptr.
+         *  @param in_binding_index       Index of the binding to update.
+         *  @param in_element_range       Start index and number of binding array items to update.
+         *  @param in_elements_ptr        Array of in_element_range.second binding elements. Must not be nullptr.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        template<typename BindingElementType>
+        bool record_push_descriptor_set(Anvil::PipelineBindPoint  in_pipeline_bind_point,
+                                        Anvil::PipelineLayout*    in_layout_ptr,
+                                        uint32_t                  in_set,
+                                        BindingIndex              in_binding_index,
+                                        BindingElementArrayRange  in_element_range,
+                                        const BindingElementType* in_elements_ptr);
+
         /** Issues a vkCmdResetEvent() call and appends it to the internal vector of commands
          *  recorded for the specified command buffer (for builds with STORE_COMMAND_BUFFER_COMMANDS
          *  #define enabled).
@@ -1527,6 +1594,28 @@ namespace Anvil
          **/
         bool reset(bool in_should_release_resources);
 
+        /** Enables or disables pipeline barrier batching for this command buffer. Batching is disabled
+         *  by default.
+         *
+         *  With batching enabled, record_pipeline_barrier() calls which are not separated by any other
+         *  command are merged into a single vkCmdPipelineBarrier() call. Source and destination stage masks
+         *  are OR-ed together, and barriers which have already been enqueued are not issued again.
+         *
+         *  A new barrier is NOT merged with the pending ones, and the pending barriers are flushed first, if:
+         *
+         *  - its dependency flags differ from the flags of the pending barriers.
+         *  - it refers to a buffer region or an image subresource range, which is also used by a pending barrier
+         *    that is not identical. This preserves the order of dependent layout transitions and ownership
+         *    transfers.
+         *  - it specifies global memory barriers which are not identical to the pending ones, or it mixes
+         *    global memory barriers with buffer / image barriers across the two batches.
+         *
+         *  Disabling batching flushes all pending barriers.
+         *
+         *  @param in_enable true to enable batching, false to disable it.
+         */
+        void set_pipeline_barrier_batching_enabled(bool in_enable);
+
         /** Stops an ongoing command recording process.
          *
          *  It is an error to invoke this function if the command buffer has not been put
@@ -1566,6 +1655,7 @@ namespace Anvil
         struct FillBufferCommand;
         struct NextSubpassCommand;
         struct PushConstantsCommand;
+        struct PushDescriptorSetKHRCommand;
         struct ResetEventCommand;
         struct ResetQueryPoolCommand;
         struct ResolveImageCommand;
@@ -2513,6 +2603,32 @@ namespace Anvil
             }
         } PushConstantsCommand;
 
+        /** Holds all arguments passed to a vkCmdPushDescriptorSetKHR() command. Descriptor contents are not stored. */
+        typedef struct PushDescriptorSetKHRCommand : public Command
+        {
+            Anvil::PipelineBindPoint pipeline_bind_point;
+
+            BindingIndex             binding_index;
+            Anvil::DescriptorType    descriptor_type;
+            BindingElementArrayRange element_range;
+            Anvil::PipelineLayout*   layout_ptr;
+            uint32_t                 set;
+
+            /** Constructor. **/
+            explicit PushDescriptorSetKHRCommand(Anvil::PipelineBindPoint in_pipeline_bind_point,
+                                                 Anvil::PipelineLayout*         in_layout_ptr,
+                                                 uint32_t                       in_set,
+                                                 BindingIndex                   in_binding_index,
+                                                 BindingElementArrayRange       in_element_range,
+                                                 Anvil::DescriptorType          in_descriptor_type);
+
+            /** Destructor. */
+            virtual ~PushDescriptorSetKHRCommand()
+            {
+                /* Stub */
+            }
+        } PushDescriptorSetKHRCommand;
+
         /** Holds all arguments passed to a vkCmdResetEvent() command. **/
         typedef struct ResetEventCommand : public Command
         {
@@ -2922,11 +3038,26 @@ namespace Anvil
             void clear_commands();
         #endif
 
+        void discard_pending_pipeline_barriers      ();
+        void flush_pending_pipeline_barriers_internal();
+
         /* Protected variables */
         #ifdef STORE_COMMAND_BUFFER_COMMANDS
             Commands m_commands;
         #endif
 
+        /* Pipeline barriers enqueued by record_pipeline_barrier() which have not been issued yet. Storage is retained
+         * between flushes, so that steady-state barrier recording does not allocate. A zero source stage mask indicates
+         * there are no pending barriers.
+         */
+        std::vector<VkBufferMemoryBarrier> m_pending_buffer_barriers_vk;
+        VkDependencyFlags                  m_pending_barrier_dependency_flags_vk;
+        VkPipelineStageFlags               m_pending_barrier_dst_stage_mask_vk;
+        VkPipelineStageFlags               m_pending_barrier_src_stage_mask_vk;
+        std::vector<VkImageMemoryBarrier>  m_pending_image_barriers_vk;
+        std::vector<VkMemoryBarrier>       m_pending_memory_barriers_vk;
+        bool                               m_pipeline_barrier_batching_enabled;
+
         VkCommandBuffer          m_command_buffer;
         uint32_t                 m_device_mask;
         const Anvil::BaseDevice* m_device_ptr;
@@ -2946,8 +3077,25 @@ namespace Anvil
         CommandBufferBase           (const CommandBufferBase&);
         CommandBufferBase& operator=(const CommandBufferBase&);
 
+        void append_push_descriptor_info        (const VkDescriptorBufferInfo&  in_buffer_info_vk);
+        void append_push_descriptor_info        (const VkDescriptorImageInfo&   in_image_info_vk);
+        void append_push_descriptor_info        (const VkBufferView&            in_texel_buffer_view_vk);
+        bool record_push_descriptor_set_internal(Anvil::PipelineBindPoint       in_pipeline_bind_point,
+                                                 Anvil::PipelineLayout*         in_layout_ptr,
+                                                 uint32_t                       in_set,
+                                                 BindingIndex                   in_binding_index,
+                                                 BindingElementArrayRange       in_element_range,
+                                                 Anvil::DescriptorType          in_descriptor_type);
+
         /* Private variables */
 
+        /* Descriptor info built by record_push_descriptor_set() for the vkCmdPushDescriptorSetKHR() call. Storage is retained
+         * between calls, so that steady-state descriptor pushes do not allocate.
+         */
+        std::vector<VkDescriptorBufferInfo> m_push_descriptor_buffer_info_items_vk;
+        std::vector<VkDescriptorImageInfo>  m_push_descriptor_image_info_items_vk;
+        std::vector<VkBufferView>           m_push_descriptor_texel_buffer_view_items_vk;
+
         friend class Anvil::CommandPool;
     };
 
@@ -39,8 +39,6 @@ namespace Anvil
     class ComputePipelineManager : public BasePipelineManager
     {
     public:
-       using BasePipelineManager::bake;
-
         /* Public functions */
        static std::unique_ptr<ComputePipelineManager> create(Anvil::BaseDevice*    in_device_ptr,
                                                              bool                  in_mt_safe,
@@ -49,8 +47,6 @@ namespace Anvil
 
        virtual ~ComputePipelineManager();
 
-       bool bake();
-
        private:
            /* Constructor */
            explicit ComputePipelineManager(Anvil::BaseDevice*    in_device_ptr,
@@ -58,6 +54,10 @@ namespace Anvil
                                            bool                  in_use_pipeline_cache          = false,
                                            Anvil::PipelineCache* in_pipeline_cache_to_reuse_ptr = nullptr);
 
+           bool compile_pipelines(const std::vector<BakeItem>&  in_bake_items,
+                                  const std::vector<BakeGroup>& in_bake_groups,
+                                  std::vector<VkPipeline>*      out_pipelines_ptr) override;
+
            ANVIL_DISABLE_ASSIGNMENT_OPERATOR(ComputePipelineManager);
            ANVIL_DISABLE_COPY_CONSTRUCTOR   (ComputePipelineManager);
     };
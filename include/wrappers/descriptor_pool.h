@@ -65,6 +65,9 @@ namespace Anvil
         virtual ~DescriptorPool();
 
         /** Allocates user-specified number of descriptors sets with user-defined layouts.
+         *
+         *  Layouts created with PUSH_DESCRIPTOR_BIT_KHR create flag cannot be used. The function fails if any of
+         *  the allocations uses one.
          *
          *  @param in_n_sets                     Number of sets to allocate.
          *  @param in_descriptor_set_layouts_ptr Pointer to an array of Vulkan DS layouts to use for the call.
@@ -91,6 +94,20 @@ namespace Anvil
                                    VkDescriptorSet*               out_descriptor_sets_vk_ptr,
                                    VkResult*                      out_opt_result_ptr = nullptr);
 
+        /** Returns user-specified descriptor sets back to the pool and releases their wrapper instances.
+         *
+         *  The pool must have been created with DescriptorPoolCreateFlagBits::FREE_DESCRIPTOR_SET_BIT.
+         *  The sets must not be in use by any pending command buffers.
+         *
+         *  @param in_n_sets                 Number of sets to free.
+         *  @param inout_descriptor_sets_ptr Array of @param in_n_sets descriptor sets, allocated from this pool.
+         *                                   Each item is reset to nullptr upon return. Must not be nullptr.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool free_descriptor_sets(uint32_t                in_n_sets,
+                                  DescriptorSetUniquePtr* inout_descriptor_sets_ptr);
+
         const Anvil::DescriptorPoolCreateInfo* get_create_info_ptr() const
         {
             return m_create_info_ptr.get();
@@ -113,10 +130,24 @@ namespace Anvil
          **/
         bool reset();
 
+        /** Resets the pool and releases wrapper instances of descriptor sets allocated from it.
+         *
+         *  @param in_n_sets                 Number of wrappers to release.
+         *  @param inout_descriptor_sets_ptr Array of @param in_n_sets descriptor sets, allocated from this pool.
+         *                                   Each item is reset to nullptr upon return. May be nullptr if
+         *                                   @param in_n_sets is 0.
+         *
+         *  @return true if successful, false otherwise
+         **/
+        bool reset(uint32_t                in_n_sets,
+                   DescriptorSetUniquePtr* inout_descriptor_sets_ptr);
+
     private:
         /* Private functions */
 
-        bool init();
+        bool init                           ();
+        void release_descriptor_set_wrappers(uint32_t                in_n_sets,
+                                             DescriptorSetUniquePtr* inout_descriptor_sets_ptr);
 
         /** Constructor */
         DescriptorPool(Anvil::DescriptorPoolCreateInfoUniquePtr in_create_info_ptr,
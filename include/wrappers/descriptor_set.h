@@ -683,23 +683,29 @@ namespace Anvil
             anvil_assert(in_elements_ptr != nullptr);
             anvil_assert(m_unusable       == false);
 
-            BindingItemUniquePtrs& binding_item_ptrs  = m_binding_ptrs[in_binding_index];
-            const uint32_t         last_element_index = in_element_range.second + in_element_range.first;
+            BindingData*   binding_data_ptr   = get_binding_data(in_binding_index);
+            BindingItem*   binding_items_ptr  = nullptr;
+            const uint32_t last_element_index = in_element_range.second + in_element_range.first;
+
+            if (binding_data_ptr == nullptr)
+            {
+                return false;
+            }
+
+            anvil_assert(last_element_index <= binding_data_ptr->n_items);
+
+            binding_items_ptr = m_binding_items.data() + binding_data_ptr->n_first_item;
 
             for (BindingElementIndex current_element_index = in_element_range.first;
                                      current_element_index < last_element_index;
                                    ++current_element_index)
             {
-                if (!( binding_item_ptrs[current_element_index]  != nullptr                                                         &&
-                      *binding_item_ptrs[current_element_index] == in_elements_ptr[current_element_index - in_element_range.first]) )
+                if (!(binding_items_ptr[current_element_index] == in_elements_ptr[current_element_index - in_element_range.first]) )
                 {
-                    m_dirty = true;
-
-                    binding_item_ptrs[current_element_index].reset(
-                        new Anvil::DescriptorSet::BindingItem()
-                    );
+                    m_dirty                 = true;
+                    binding_data_ptr->dirty = true;
 
-                    *binding_item_ptrs[current_element_index] = in_elements_ptr[current_element_index - in_element_range.first];
+                    binding_items_ptr[current_element_index] = in_elements_ptr[current_element_index - in_element_range.first];
                 }
             }
 
@@ -718,20 +724,30 @@ namespace Anvil
             anvil_assert(in_elements_ptr_ptr != nullptr);
             anvil_assert(m_unusable          == false);
 
-            BindingItemUniquePtrs& binding_item_ptrs  = m_binding_ptrs[in_binding_index];
-            const uint32_t         last_element_index = in_element_range.second + in_element_range.first;
+            BindingData*   binding_data_ptr   = get_binding_data(in_binding_index);
+            BindingItem*   binding_items_ptr  = nullptr;
+            const uint32_t last_element_index = in_element_range.second + in_element_range.first;
+
+            if (binding_data_ptr == nullptr)
+            {
+                return false;
+            }
+
+            anvil_assert(last_element_index <= binding_data_ptr->n_items);
+
+            binding_items_ptr = m_binding_items.data() + binding_data_ptr->n_first_item;
 
             for (BindingElementIndex current_element_index = in_element_range.first;
                                      current_element_index < last_element_index;
                                    ++current_element_index)
             {
-                m_dirty |= !(*binding_item_ptrs[current_element_index] == *in_elements_ptr_ptr[current_element_index - in_element_range.first]);
-
-                binding_item_ptrs[current_element_index].reset(
-                    new Anvil::DescriptorSet::BindingItem()
-                );
+                if (!(binding_items_ptr[current_element_index] == *in_elements_ptr_ptr[current_element_index - in_element_range.first]) )
+                {
+                    m_dirty                 = true;
+                    binding_data_ptr->dirty = true;
 
-                *binding_item_ptrs[current_element_index] = *in_elements_ptr_ptr[current_element_index - in_element_range.first];
+                    binding_items_ptr[current_element_index] = *in_elements_ptr_ptr[current_element_index - in_element_range.first];
+                }
             }
 
             return true;
@@ -776,6 +792,10 @@ namespace Anvil
                                                    const bool&         in_should_cache_raw_data);
 
         /** Updates internally-maintained Vulkan descriptor set instances.
+         *
+         *  Only bindings whose array items have been changed since the last update are written. Within such a binding,
+         *  each run of consecutive modified array items is written with a single VkWriteDescriptorSet (or a single
+         *  update template entry), so replacing one element of a large array only refreshes that one descriptor.
          *
          *  @param in_update_method Please see DescriptorSetUpdateMethod documentation for more details.
          *
@@ -783,6 +803,25 @@ namespace Anvil
          **/
         bool update(const DescriptorSetUpdateMethod& in_update_method = Anvil::DescriptorSetUpdateMethod::CORE) const;
 
+        /** Updates all dirty descriptor sets from @param in_descriptor_set_ptrs with a single vkUpdateDescriptorSets() call,
+         *  using the core update method.
+         *
+         *  Write items of all sets are gathered into scratch storage which is shared by all descriptor sets and retained
+         *  between calls, so updating many sets at once (eg. after streaming in a batch of resources) costs a single driver
+         *  call and does not allocate in steady state. Sets which are not dirty are skipped.
+         *
+         *  All descriptor sets must have been created for the same device. A descriptor set may be listed more than once,
+         *  in which case it is only updated once. Sets are locked in address order, regardless of the order they are listed in.
+         *
+         *  @param in_n_descriptor_sets   Number of descriptor sets under @param in_descriptor_set_ptrs.
+         *  @param in_descriptor_set_ptrs Array of @param in_n_descriptor_sets descriptor sets to update. Must not be nullptr
+         *                                if @param in_n_descriptor_sets is not 0.
+         *
+         *  @return true if all descriptor sets have been updated successfully, false otherwise.
+         **/
+        static bool update_many(uint32_t                    in_n_descriptor_sets,
+                                const DescriptorSet* const* in_descriptor_set_ptrs);
+
     private:
         /* Private type declarations */
 
@@ -847,7 +886,7 @@ namespace Anvil
             BindingItem& operator=(const SamplerBindingElement&              in_element);
             BindingItem& operator=(const TexelBufferBindingElement&          in_element);
 
-            /* Default dummy constructor. */ 
+            /* Default dummy constructor. Items which have not been assigned a descriptor use UNKNOWN type. */
             BindingItem()
             {
                 dirty        = false;
@@ -862,16 +901,53 @@ namespace Anvil
 
                 type_vk = Anvil::DescriptorType::UNKNOWN;
             }
-
-            /* Destructor.
-             *
-             * Releases all wrapper instances embedded in the descriptor */
-            ~BindingItem();
         } BindingItem;
 
-        typedef std::unique_ptr<BindingItem>                  BindingItemUniquePtr;
-        typedef std::vector<BindingItemUniquePtr>             BindingItemUniquePtrs;
-        typedef std::map<BindingIndex, BindingItemUniquePtrs> BindingIndexToBindingItemUniquePtrsMap;
+        typedef std::unique_ptr<BindingItem> BindingItemUniquePtr;
+
+        /** Describes a single layout binding, as seen by the descriptor set. Built once at construction time, so that
+         *  updates need not query the layout.
+         **/
+        typedef struct BindingData
+        {
+            BindingIndex                      binding_index;
+            Anvil::DescriptorType             descriptor_type;
+            bool                              dirty;
+            Anvil::DescriptorBindingFlags     flags;
+            bool                              immutable_samplers_enabled;
+            uint32_t                          n_first_item;
+            uint32_t                          n_items;
+            size_t                            template_raw_data_offset;
+
+            /* Pending update requests. Only used by inline uniform block bindings, which do not store items in m_binding_items. */
+            std::vector<BindingItemUniquePtr> iub_update_ptrs;
+
+            BindingData()
+                :binding_index             (UINT32_MAX),
+                 descriptor_type           (Anvil::DescriptorType::UNKNOWN),
+                 dirty                     (true),
+                 immutable_samplers_enabled(false),
+                 n_first_item              (0),
+                 n_items                   (0),
+                 template_raw_data_offset  (0)
+            {
+                /* Stub */
+            }
+        } BindingData;
+
+        /** Descriptor update template object, created for a specific list of template entries. */
+        typedef struct TemplateObject
+        {
+            Anvil::DescriptorUpdateTemplateUniquePtr template_ptr;
+            uint64_t                                 last_used_update_index;
+
+            explicit TemplateObject(Anvil::DescriptorUpdateTemplateUniquePtr in_template_ptr)
+                :template_ptr          (std::move(in_template_ptr) ),
+                 last_used_update_index(0)
+            {
+                /* Stub */
+            }
+        } TemplateObject;
 
         /* Private functions */
 
@@ -899,46 +975,63 @@ namespace Anvil
         DescriptorSet           (const DescriptorSet&);
         DescriptorSet& operator=(const DescriptorSet&);
 
-        void alloc_bindings                ();
-        void fill_buffer_info_vk_descriptor(const Anvil::DescriptorSet::BindingItem&   in_binding_item,
-                                            VkDescriptorBufferInfo*                    out_descriptor_ptr) const;
-        void fill_image_info_vk_descriptor (const Anvil::DescriptorSet::BindingItem&   in_binding_item,
-                                            const bool&                                in_immutable_samplers_enabled,
-                                            VkDescriptorImageInfo*                     out_descriptor_ptr) const;
-        void fill_iub_vk_descriptor        (const Anvil::DescriptorSet::BindingItem&   in_binding_item,
-                                            VkWriteDescriptorSetInlineUniformBlockEXT* out_descriptor_ptr) const;
-        void on_parent_pool_reset          ();
-        bool update_using_core_method      () const;
-        bool update_using_template_method  () const;
+        void               alloc_bindings                ();
+        void               fill_buffer_info_vk_descriptor(const Anvil::DescriptorSet::BindingItem&   in_binding_item,
+                                                          VkDescriptorBufferInfo*                    out_descriptor_ptr) const;
+        void               fill_image_info_vk_descriptor (const Anvil::DescriptorSet::BindingItem&   in_binding_item,
+                                                          const bool&                                in_immutable_samplers_enabled,
+                                                          VkDescriptorImageInfo*                     out_descriptor_ptr) const;
+        void               fill_iub_vk_descriptor        (const Anvil::DescriptorSet::BindingItem&   in_binding_item,
+                                                          VkWriteDescriptorSetInlineUniformBlockEXT* out_descriptor_ptr) const;
+        bool               fill_template_raw_data        (const Anvil::DescriptorSet::BindingItem&   in_binding_item,
+                                                          const bool&                                in_immutable_samplers_enabled,
+                                                          uint8_t*                                   out_raw_data_ptr) const;
+        bool               gather_core_write_items       (std::vector<VkDescriptorBufferInfo>*       inout_buffer_info_items_vk_ptr,
+                                                          std::vector<VkDescriptorImageInfo>*        inout_image_info_items_vk_ptr,
+                                                          std::vector<VkBufferView>*                 inout_texel_buffer_view_items_vk_ptr,
+                                                          std::vector<VkWriteDescriptorSet>*         inout_write_items_vk_ptr) const;
+        BindingData*       get_binding_data              (BindingIndex                               in_binding_index) const;
+        const BindingItem* get_binding_item              (BindingIndex                               in_binding_index,
+                                                          uint32_t                                   in_n_item) const;
+        void               on_parent_pool_reset          ();
+        void               recycle                       (VkDescriptorSet                            in_descriptor_set);
+        void               release_issued_iub_updates    () const;
+        bool               update_using_core_method      () const;
+        bool               update_using_template_method  () const;
 
         /* Private variables */
 
-        /* For descriptor types != INLINE_UNIFORM_BLOCK, this is the usual binding index->binding item map. Holds bindings associated
-         * with corresponding array items.
-         *
-         * For INLINE_UNIFORM_BLOCK descriptors, this is a binding index->pending updates map.
+        /* Layout bindings, sorted by binding index. Array items of all non-IUB bindings are stored contiguously in m_binding_items,
+         * with each binding owning the [n_first_item, n_first_item + n_items) range.
+         */
+        mutable std::vector<BindingItem>  m_binding_items;
+        mutable std::vector<BindingData>  m_bindings;
+
+        VkDescriptorSet                   m_descriptor_set;
+        const Anvil::BaseDevice*          m_device_ptr;
+        mutable bool                      m_dirty;
+        const Anvil::DescriptorSetLayout* m_layout_ptr;
+        Anvil::DescriptorPool*            m_parent_pool_ptr;
+        bool                              m_unusable;
+
+        /* Descriptor info & write items for the core update method are gathered into per-thread scratch storage shared by all
+         * descriptor sets. Inline uniform block write structs are chained to those write items, so they are kept per set.
          */
-        mutable BindingIndexToBindingItemUniquePtrsMap m_binding_ptrs;
-
-
-        VkDescriptorSet                                m_descriptor_set;
-        const Anvil::BaseDevice*                       m_device_ptr;
-        mutable bool                                   m_dirty;
-        const Anvil::DescriptorSetLayout*              m_layout_ptr;
-        Anvil::DescriptorPool*                         m_parent_pool_ptr;
-        bool                                           m_unusable;
-
-        mutable std::vector<VkDescriptorBufferInfo>                    m_cached_ds_info_buffer_info_items_vk;
-        mutable std::vector<VkDescriptorImageInfo>                     m_cached_ds_info_image_info_items_vk;
-        mutable std::vector<VkBufferView>                              m_cached_ds_info_texel_buffer_info_items_vk;
         mutable std::vector<VkWriteDescriptorSetInlineUniformBlockEXT> m_cached_ds_write_iub_items_vk;
-        mutable std::vector<VkWriteDescriptorSet>                      m_cached_ds_write_items_vk;
 
         mutable std::vector<DescriptorUpdateTemplateEntry>                                                     m_template_entries;
-        mutable std::map<std::vector<DescriptorUpdateTemplateEntry>, Anvil::DescriptorUpdateTemplateUniquePtr> m_template_object_map;
+        mutable std::map<std::vector<DescriptorUpdateTemplateEntry>, TemplateObject>                           m_template_object_map;
         mutable std::vector<uint8_t>                                                                           m_template_raw_data;
+        mutable uint64_t                                                                                       m_n_template_updates;
+
+        /* Each non-IUB binding owns a fixed region of m_template_raw_data (see BindingData::template_raw_data_offset), so that
+         * update_using_template_method() can patch modified array items in place. Pending IUB updates are appended past
+         * m_template_raw_data_fixed_size.
+         */
+        size_t                                                                                                 m_template_raw_data_fixed_size;
 
         friend class Anvil::DescriptorPool;
+        friend class Anvil::FrameDescriptorAllocator;
     };
 };
 
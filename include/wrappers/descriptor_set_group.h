@@ -99,7 +99,8 @@ namespace Anvil
          *  specified DescriptorSetGroup instance as a parent.
          *
          *  @param in_device_ptr                   Device to use.
-         *  @param in_ds_create_info_ptrs          TODO.
+         *  @param in_ds_create_info_ptrs          TODO. Must not include create info structures specified with
+         *                                         PUSH_DESCRIPTOR_BIT_KHR create flag, since no sets can be allocated for such layouts.
          *  @param in_descriptor_pool_create_flags Create flags to specify when creating a descriptor pool for the DSG.
          *  @param in_mt_safety                    MT safety setting for the created object.
          *  @param in_opt_overhead_allocations     Extra allocations to request when creating a descriptor pool for the DSG.
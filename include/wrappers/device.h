@@ -35,6 +35,7 @@
 #include "misc/device_create_info.h"
 #include "misc/extensions.h"
 #include "misc/mt_safety.h"
+#include "misc/pools.h"
 #include "misc/struct_chainer.h"
 #include "misc/types.h"
 #include <algorithm>
@@ -121,6 +122,41 @@ namespace Anvil
          **/
         Anvil::DescriptorSetLayout* get_dummy_descriptor_set_layout() const;
 
+        /** Retrieves the device-owned fence completion reactor.
+         *
+         *  The reactor, and its thread, are created on first use. Please see FenceReactor for details.
+         *
+         *  Do NOT release. This object is owned by Device and will be released at object tear-down time,
+         *  after the device has become idle.
+         **/
+        Anvil::FenceReactor* get_fence_reactor() const;
+
+        /** Retrieves an unsignalled fence from the device-owned fence pool.
+         *
+         *  The fence is returned to the pool when the returned pointer goes out of scope. Returned
+         *  fences are reset in batches, so there is no need to reset them manually. All pooled fences
+         *  must be released before the device is destroyed.
+         *
+         *  Use this function instead of Fence::create() for short-lived fences, e.g. fences used for
+         *  a single submission.
+         **/
+        Anvil::FenceUniquePtr get_fence_from_pool() const
+        {
+            return m_fence_pool_ptr->get_item();
+        }
+
+        /** Retrieves a binary semaphore from the device-owned semaphore pool.
+         *
+         *  The semaphore is returned to the pool when the returned pointer goes out of scope. Semaphores
+         *  cannot be reset from the host, so only release a semaphore once it is unsignalled, i.e. once
+         *  any wait operation, which consumes its signal, has completed. All pooled semaphores must be
+         *  released before the device is destroyed.
+         **/
+        Anvil::SemaphoreUniquePtr get_semaphore_from_pool() const
+        {
+            return m_semaphore_pool_ptr->get_item();
+        }
+
         /** Returns a container with entry-points to functions introduced by VK_AMD_buffer_marker extension.
          *
          *  Will fire an assertion failure if the extension was not requested at device creation time.
@@ -311,6 +347,17 @@ namespace Anvil
             return m_khr_maintenance3_extension_entrypoints;
         }
 
+        /** Returns a container with entry-points to functions introduced by VK_KHR_push_descriptor extension.
+         *
+         *  Will fire an assertion failure if the extension was not requested at device creation time.
+         **/
+        const ExtensionKHRPushDescriptorEntrypoints& get_extension_khr_push_descriptor_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_push_descriptor() );
+
+            return m_khr_push_descriptor_extension_entrypoints;
+        }
+
         /** Returns a container with entry-points to functions introduced by VK_KHR_sampler_ycbcr_conversion extension. **/
         const ExtensionKHRSamplerYCbCrConversionEntrypoints& get_extension_khr_sampler_ycbcr_conversion_entrypoints() const
         {
@@ -330,6 +377,17 @@ namespace Anvil
             return m_khr_swapchain_extension_entrypoints;
         }
 
+        /** Returns a container with entry-points to functions introduced by VK_KHR_timeline_semaphore extension.
+         *
+         *  Will fire an assertion failure if the extension was not requested at device creation time.
+         **/
+        const ExtensionKHRTimelineSemaphoreEntrypoints& get_extension_khr_timeline_semaphore_entrypoints() const
+        {
+            anvil_assert(m_extension_enabled_info_ptr->get_device_extension_info()->khr_timeline_semaphore() );
+
+            return m_khr_timeline_semaphore_extension_entrypoints;
+        }
+
         /** Retrieves a graphics pipeline manager, created for this device instance.
          *
          *  @return As per description
@@ -761,9 +819,11 @@ namespace Anvil
         ExtensionKHRGetMemoryRequirements2Entrypoints     m_khr_get_memory_requirements2_extension_entrypoints;
         ExtensionKHRMaintenance1Entrypoints               m_khr_maintenance1_extension_entrypoints;
         ExtensionKHRMaintenance3Entrypoints               m_khr_maintenance3_extension_entrypoints;
+        ExtensionKHRPushDescriptorEntrypoints             m_khr_push_descriptor_extension_entrypoints;
         ExtensionKHRSamplerYCbCrConversionEntrypoints     m_khr_sampler_ycbcr_conversion_extension_entrypoints;
         ExtensionKHRSurfaceEntrypoints                    m_khr_surface_extension_entrypoints;
         ExtensionKHRSwapchainEntrypoints                  m_khr_swapchain_extension_entrypoints;
+        ExtensionKHRTimelineSemaphoreEntrypoints          m_khr_timeline_semaphore_extension_entrypoints;
 
         #if defined(_WIN32)
             ExtensionKHRExternalFenceWin32Entrypoints     m_khr_external_fence_win32_extension_entrypoints;
@@ -788,9 +848,13 @@ namespace Anvil
         mutable Anvil::DescriptorSetGroupUniquePtr       m_dummy_dsg_ptr;
         mutable std::mutex                               m_dummy_dsg_mutex;
         std::unique_ptr<Anvil::ExtensionInfo<bool> >     m_extension_enabled_info_ptr;
+        std::unique_ptr<Anvil::FencePool>                m_fence_pool_ptr;
+        mutable Anvil::FenceReactorUniquePtr             m_fence_reactor_ptr;
+        mutable std::mutex                               m_fence_reactor_mutex;
         GraphicsPipelineManagerUniquePtr                 m_graphics_pipeline_manager_ptr;
         PipelineCacheUniquePtr                           m_pipeline_cache_ptr;
         PipelineLayoutManagerUniquePtr                   m_pipeline_layout_manager_ptr;
+        std::unique_ptr<Anvil::SemaphorePool>            m_semaphore_pool_ptr;
         Anvil::ShaderModuleCacheUniquePtr                m_shader_module_cache_ptr;
 
         std::vector<CommandPoolUniquePtr> m_command_pool_ptr_per_vk_queue_fam;
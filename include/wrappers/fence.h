@@ -129,14 +129,17 @@ namespace Anvil
          *  This function is expected to be more efficient than calling reset() for @param in_n_fences
          *  times, assuming @param in_n_fences is larger than 1.
          *
-         *  @param in_n_fences Number of Fence instances accessible under @param in_fences.
-         *  @param in_fences   An array of @param in_n_fences Fence instances to reset. Must not be nullptr,
-         *                     unless @param in_n_fences is 0.
+         *  All fences must have been created for the same device. Fences are reset in batches, without
+         *  any heap allocations.
+         *
+         *  @param in_n_fences   Number of Fence instances accessible under @param in_fence_ptrs.
+         *  @param in_fence_ptrs An array of @param in_n_fences Fence instances to reset. Must not be nullptr,
+         *                       unless @param in_n_fences is 0.
          *
          *  @return true if the function executed successfully, false otherwise.
          **/
         static bool reset_fences(const uint32_t in_n_fences,
-                                 Fence*         in_fences);
+                                 Fence* const*  in_fence_ptrs);
 
     private:
         /* Private functions */
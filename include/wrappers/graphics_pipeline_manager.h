@@ -49,12 +49,6 @@ namespace Anvil
 
         /* Public functions */
 
-        /** Generates a VkPipeline instance for each outstanding pipeline object.
-         *
-         *  @return true if successful, false otherwise.
-         **/
-        bool bake();
-
         bool delete_pipeline(PipelineID in_pipeline_id);
 
         /** Creates a new GraphicsPipelineManager instance.
@@ -67,6 +61,7 @@ namespace Anvil
          *  @param in_pipeline_cache_to_reuse_ptr if @param use_pipeline_cache is true, this argument can be optionally
          *                                        set to a non-nullptr value to point at an already allocated pipeline cache.
          *                                        If one is not provided and the other argument is set as described,
+         *                                        the device's pipeline cache will be used if it is persistent. Otherwise,
          *                                        a new pipeline cache with size 0 will be allocated.
          **/
         static GraphicsPipelineManagerUniquePtr create(const Anvil::BaseDevice* in_device_ptr,
@@ -136,6 +131,10 @@ namespace Anvil
                                          bool                     in_use_pipeline_cache,
                                          Anvil::PipelineCache*    in_pipeline_cache_to_reuse_ptr);
 
+        bool compile_pipelines(const std::vector<BakeItem>&  in_bake_items,
+                               const std::vector<BakeGroup>& in_bake_groups,
+                               std::vector<VkPipeline>*      out_pipelines_ptr) override;
+
         Anvil::StructChainUniquePtr<VkGraphicsPipelineCreateInfo>                   bake_graphics_pipeline_create_info                 (const Anvil::GraphicsPipelineCreateInfo*      in_gfx_pipeline_create_info_ptr,
                                                                                                                                         const Anvil::PipelineLayout*                  in_pipeline_layout_ptr,
                                                                                                                                         const VkPipeline&                             in_opt_base_pipeline_handle,
@@ -289,6 +289,7 @@ namespace Anvil
         std::unique_ptr<Anvil::KHRSamplerYCbCrConversionFeatures>                       m_khr_sampler_ycbcr_conversion_features_ptr;
         std::unique_ptr<Anvil::KHRShaderAtomicInt64Features>                            m_khr_shader_atomic_int64_features_ptr;
         std::unique_ptr<Anvil::KHRShaderFloatControlsProperties>                        m_khr_shader_float_controls_properties_ptr;
+        std::unique_ptr<Anvil::KHRTimelineSemaphoreFeatures>                            m_khr_timeline_semaphore_features_ptr;
         std::unique_ptr<Anvil::KHRVariablePointerFeatures>                              m_khr_variable_pointer_features_ptr;
         std::unique_ptr<Anvil::KHRVulkanMemoryModelFeatures>                            m_khr_vulkan_memory_model_features_ptr;
 
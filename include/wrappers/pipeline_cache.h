@@ -24,6 +24,12 @@
  *
  *  - manage life-time of pipeline cache instances.
  *  - let ObjectTracker detect leaking queue pipeline cache instances.
+ *  - optionally persist pipeline cache data on disk between executions.
+ *
+ *  Persistent pipeline caches are backed by a file, whose name is derived from the vendor ID, device ID,
+ *  driver version and pipeline cache UUID of the device. The file is prefixed with a header which is
+ *  validated at load time. Stale or corrupt files are ignored, in which case the cache starts empty.
+ *  Data is written to a temporary file first, which then atomically replaces the previous version.
  *
  *  The wrapper is NOT thread-safe.
  **/
@@ -34,6 +40,8 @@
 #include "misc/debug_marker.h"
 #include "misc/mt_safety.h"
 #include "misc/types.h"
+#include <mutex>
+#include <thread>
 
 
 namespace Anvil
@@ -58,6 +66,24 @@ namespace Anvil
                                                     size_t                   in_initial_data_size = 0,
                                                     const void*              in_initial_data      = nullptr);
 
+        /** Creates a persistent pipeline cache.
+         *
+         *  The cache is initialized with data stored in a file under @param in_directory, as long as the file
+         *  was written for a device with the same vendor ID, device ID, driver version and pipeline cache UUID,
+         *  and its contents are intact. Otherwise, the file is ignored and an empty cache is created.
+         *
+         *  Cache data is written back to the file when the wrapper is destroyed, or whenever save() or
+         *  save_async() is called.
+         *
+         *  @param in_device_ptr Vulkan device to initialize the pipeline cache with.
+         *  @param in_mt_safe    True if MT-safety should be enforced for functions that operate on the
+         *                       underlying Vulkan handle.
+         *  @param in_directory  Directory to store the pipeline cache file in. The directory must exist.
+         **/
+        static Anvil::PipelineCacheUniquePtr create_persistent(const Anvil::BaseDevice* in_device_ptr,
+                                                               bool                     in_mt_safe,
+                                                               const std::string&       in_directory);
+
         /** Destroys the Vulkan counterpart and unregisters the wrapper instance from the object tracker. */
         virtual ~PipelineCache();
 
@@ -72,6 +98,14 @@ namespace Anvil
         bool get_data(size_t* out_n_data_bytes_ptr,
                       void*   out_data_ptr);
 
+        /** Returns name of the file backing a persistent pipeline cache, or an empty string if the
+         *  pipeline cache is not persistent.
+         **/
+        const std::string& get_persistent_filename() const
+        {
+            return m_persistent_filename;
+        }
+
         /** Retrieves raw Vulkan pipeline cache handle.
          *
          *  NOTE: Clients must guarantee MT-safety when operating directly with the Vulkan handle.
@@ -81,6 +115,12 @@ namespace Anvil
             return m_pipeline_cache;
         }
 
+        /** Tells whether the pipeline cache is backed by a file. See create_persistent() for more details. */
+        bool is_persistent() const
+        {
+            return (m_persistent_filename.size() > 0);
+        }
+
         /** Adds cached pipelines in @param in_src_cache_ptrs to this pipeline instance.
          *
          *  @param in_n_pipeline_caches Number of pipeline caches under @param in_src_cache_ptrs.
@@ -91,7 +131,40 @@ namespace Anvil
         bool merge(uint32_t                           in_n_pipeline_caches,
                    const Anvil::PipelineCache* const* in_src_cache_ptrs);
 
+        /** Writes current pipeline cache data to the backing file. Only supported for persistent pipeline caches.
+         *
+         *  Blocks until any pending asynchronous save operation completes.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool save();
+
+        /** Retrieves current pipeline cache data and writes it to the backing file on a background thread.
+         *  Only supported for persistent pipeline caches.
+         *
+         *  Any pending asynchronous save operation is waited on first. The wrapper waits for the operation
+         *  to finish when it is destroyed.
+         *
+         *  @return true if the data was retrieved and the save operation was started, false otherwise.
+         **/
+        bool save_async();
+
     private:
+        /* Private type definitions */
+
+        /* Header of the file backing a persistent pipeline cache. Followed by data_size bytes of pipeline cache data. */
+        typedef struct PersistentFileHeader
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t vendor_id;
+            uint32_t device_id;
+            uint32_t driver_version;
+            uint8_t  pipeline_cache_uuid[VK_UUID_SIZE];
+            uint64_t data_size;
+            uint64_t data_hash;
+        } PersistentFileHeader;
+
         /* Private functions */
 
         /* Constructor. See create() for specification */
@@ -103,9 +176,28 @@ namespace Anvil
         PipelineCache           (const PipelineCache&);
         PipelineCache& operator=(const PipelineCache&);
 
+        static uint64_t    get_data_hash              (const uint8_t*              in_data_ptr,
+                                                       size_t                      in_data_size);
+        static std::string get_persistent_filename    (const Anvil::BaseDevice*    in_device_ptr,
+                                                       const std::string&          in_directory);
+        static void        init_persistent_file_header(const Anvil::BaseDevice*    in_device_ptr,
+                                                       PersistentFileHeader*       out_header_ptr);
+        static bool        read_persistent_file       (const PersistentFileHeader& in_expected_header,
+                                                       const std::string&          in_filename,
+                                                       std::vector<uint8_t>*       out_data_ptr);
+        bool               serialize_persistent_data  (std::vector<uint8_t>*       out_file_data_ptr);
+        void               wait_for_pending_save      ();
+        static bool        write_persistent_file      (const std::string&          in_filename,
+                                                       const std::vector<uint8_t>& in_file_data);
+
         /* Private variables */
         const Anvil::BaseDevice* m_device_ptr;
         VkPipelineCache          m_pipeline_cache;
+
+        PersistentFileHeader     m_persistent_file_header;
+        std::string              m_persistent_filename;
+        std::thread              m_save_thread;
+        std::mutex               m_save_thread_mutex;
     };
 }; /* namespace Anvil */
 
@@ -278,8 +278,32 @@ namespace Anvil
                                               Anvil::Semaphore* const*            in_wait_semaphore_ptrs_ptr,
                                               Anvil::SwapchainOperationErrorCode* out_present_results_ptr);
 
+        /** Submits work described by @param in_submit_info to the queue.
+         *
+         *  Equivalent to a submit() call with a single submission.
+         *
+         *  @return true if successful, false otherwise.
+         **/
         bool submit(const SubmitInfo& in_submit_info);
 
+        /** Submits a batch of @param in_n_submit_infos submissions to the queue with a single vkQueueSubmit() call.
+         *
+         *  Submissions are executed in the order specified. Since vkQueueSubmit() only takes a single fence,
+         *  all submissions which specify a fence must specify the same one. If any of the submissions is
+         *  blocking, the call blocks until the whole batch finishes executing.
+         *
+         *  Temporary data required to issue the call is kept in thread-local storage, so once the storage has
+         *  grown large enough, submissions do not allocate any memory.
+         *
+         *  @param in_n_submit_infos   Number of submissions available under @param in_submit_infos_ptr. Must
+         *                             be at least 1.
+         *  @param in_submit_infos_ptr Submissions to issue. Must not be nullptr.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool submit(uint32_t          in_n_submit_infos,
+                    const SubmitInfo* in_submit_infos_ptr);
+
         /** Tells whether the queue supports protected memory operations */
         bool supports_protected_memory_operations() const
         {
@@ -312,6 +336,10 @@ namespace Anvil
 
         void bind_sparse_memory_lock_unlock    (Anvil::SparseMemoryBindingUpdateInfo& in_update,
                                                 bool                                  in_should_lock);
+        void submit_lock_unlock                (uint32_t                              in_n_submit_infos,
+                                                const Anvil::SubmitInfo*              in_submit_infos_ptr,
+                                                Anvil::Fence*                         in_opt_fence_ptr,
+                                                bool                                  in_should_lock);
         void submit_command_buffers_lock_unlock(uint32_t                              in_n_command_buffers,
                                                 Anvil::CommandBufferBase* const*      in_opt_cmd_buffer_ptrs_ptr,
                                                 uint32_t                              in_n_semaphores_to_signal,
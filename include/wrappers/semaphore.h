@@ -70,6 +70,16 @@ namespace Anvil
             return m_create_info_ptr.get();
         }
 
+        /** Retrieves the current counter value of a timeline semaphore.
+         *
+         *  Requires VK_KHR_timeline_semaphore.
+         *
+         *  @param out_value_ptr Deref will be set to the counter value. Must not be nullptr.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool get_counter_value(uint64_t* out_value_ptr) const;
+
         /** Retrieves a raw handle to the underlying Vulkan semaphore instance  */
         VkSemaphore get_semaphore() const
         {
@@ -109,9 +119,55 @@ namespace Anvil
                                              const ExternalHandleType&                         in_handle);
         #endif
 
+        /** Tells whether the semaphore is a timeline semaphore. */
+        bool is_timeline() const;
+
         /** Releases the underlying Vulkan Semaphore instance and creates a new Vulkan object. */
         bool reset();
 
+        /** Sets the counter value of a timeline semaphore from the host.
+         *
+         *  Requires VK_KHR_timeline_semaphore.
+         *
+         *  @param in_value New counter value. Must be larger than the current counter value and than the
+         *                  value of any pending signal operation.
+         *
+         *  @return true if successful, false otherwise.
+         **/
+        bool signal(uint64_t in_value);
+
+        /** Blocks until the counter value of a timeline semaphore reaches @param in_value, or until
+         *  @param in_timeout nanoseconds pass.
+         *
+         *  Requires VK_KHR_timeline_semaphore.
+         *
+         *  @return true if the value was reached, false if the function timed out or failed.
+         **/
+        bool wait(uint64_t in_value,
+                  uint64_t in_timeout = UINT64_MAX) const;
+
+        /** Blocks until all (or, if @param in_wait_for_all is false, any) of the specified timeline semaphores
+         *  reach their corresponding values, or until @param in_timeout nanoseconds pass.
+         *
+         *  All semaphores must have been created for the same device.
+         *
+         *  Requires VK_KHR_timeline_semaphore.
+         *
+         *  @param in_n_semaphores   Number of semaphores under @param in_semaphore_ptrs and values under
+         *                           @param in_values_ptr.
+         *  @param in_semaphore_ptrs Semaphores to wait on. Must not be nullptr.
+         *  @param in_values_ptr     Values to wait for. Must not be nullptr.
+         *  @param in_wait_for_all   True to wait for all semaphores, false to wait for any of them.
+         *  @param in_timeout        Timeout, in nanoseconds.
+         *
+         *  @return true if the wait condition was satisfied, false if the function timed out or failed.
+         **/
+        static bool wait_semaphores(uint32_t                 in_n_semaphores,
+                                    Anvil::Semaphore* const* in_semaphore_ptrs,
+                                    const uint64_t*          in_values_ptr,
+                                    bool                     in_wait_for_all,
+                                    uint64_t                 in_timeout = UINT64_MAX);
+
     private:
         /* Private functions */
 
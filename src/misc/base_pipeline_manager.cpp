@@ -23,6 +23,7 @@
 #include "misc/base_pipeline_create_info.h"
 #include "misc/base_pipeline_manager.h"
 #include "misc/debug.h"
+#include "misc/thread_pool.h"
 #include "wrappers/descriptor_set_group.h"
 #include "wrappers/device.h"
 #include "wrappers/pipeline_layout.h"
@@ -30,16 +31,26 @@
 #include "wrappers/pipeline_cache.h"
 #include <algorithm>
 
+/* Asynchronous baking relies on the manager's mutex to synchronize with the background thread. The mutex
+ * does nothing if MT-safety support has been compiled out. */
+#if defined(ANVIL_MT_SAFETY_LOCK_NONE)
+    static const bool g_async_bake_supported = false;
+#else
+    static const bool g_async_bake_supported = true;
+#endif
+
 /** Please see header for specification */
 Anvil::BasePipelineManager::BasePipelineManager(const Anvil::BaseDevice* in_device_ptr,
                                                 bool                     in_mt_safe,
                                                 bool                     in_use_pipeline_cache,
                                                 Anvil::PipelineCache*    in_pipeline_cache_to_reuse_ptr)
-    :CallbacksSupportProvider(BASE_PIPELINE_MANAGER_CALLBACK_ID_COUNT),
-     MTSafetySupportProvider (in_mt_safe),
-     m_device_ptr            (in_device_ptr),
-     m_pipeline_cache_ptr    (nullptr),
-     m_pipeline_counter      (0)
+    :CallbacksSupportProvider            (BASE_PIPELINE_MANAGER_CALLBACK_ID_COUNT),
+     MTSafetySupportProvider             (in_mt_safe),
+     m_device_ptr                        (in_device_ptr),
+     m_pipeline_cache_ptr                (nullptr),
+     m_pipeline_counter                  (0),
+     m_async_bake_thread_should_terminate(false),
+     m_n_pending_async_bake_jobs         (0)
 {
     anvil_assert((!in_use_pipeline_cache && in_pipeline_cache_to_reuse_ptr == nullptr) ||
                    in_use_pipeline_cache);
@@ -47,6 +58,16 @@ Anvil::BasePipelineManager::BasePipelineManager(const Anvil::BaseDevice* in_devi
     m_pipeline_layout_manager_ptr = in_device_ptr->get_pipeline_layout_manager();
     anvil_assert(m_pipeline_layout_manager_ptr != nullptr);
 
+    if (in_pipeline_cache_to_reuse_ptr      == nullptr &&
+        in_use_pipeline_cache                          &&
+        in_device_ptr->get_pipeline_cache() != nullptr &&
+        in_device_ptr->get_pipeline_cache()->is_persistent() )
+    {
+        /* If the device has been set up with a persistent pipeline cache, use it by default so that
+         * pipelines baked by this manager are also preserved across executions. */
+        in_pipeline_cache_to_reuse_ptr = in_device_ptr->get_pipeline_cache();
+    }
+
     if (in_pipeline_cache_to_reuse_ptr != nullptr)
     {
         m_pipeline_cache_ptr   = in_pipeline_cache_to_reuse_ptr;
@@ -72,6 +93,7 @@ Anvil::BasePipelineManager::BasePipelineManager(const Anvil::BaseDevice* in_devi
 Anvil::BasePipelineManager::~BasePipelineManager()
 {
     anvil_assert(m_baked_pipelines.size() == 0);
+    anvil_assert(!m_async_bake_thread.joinable() );
 }
 
 
@@ -102,21 +124,52 @@ void Anvil::BasePipelineManager::Pipeline::release_pipeline()
 bool Anvil::BasePipelineManager::add_pipeline(Anvil::BasePipelineCreateInfoUniquePtr in_pipeline_create_info_ptr,
                                               PipelineID*                            out_pipeline_id_ptr)
 {
-    const Anvil::PipelineID                base_pipeline_id = in_pipeline_create_info_ptr->get_base_pipeline_id();
-    auto                                   callback_arg     = Anvil::OnNewPipelineCreatedCallbackData(UINT32_MAX);
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr        = get_mutex();
-    PipelineID                             new_pipeline_id  = 0;
-    std::unique_ptr<Pipeline>              new_pipeline_ptr;
-    bool                                   result           = false;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr = get_mutex();
+    bool                                   result    = false;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
+    result = add_pipeline_internal(std::move(in_pipeline_create_info_ptr),
+                                   out_pipeline_id_ptr);
+
+    if (mutex_lock.owns_lock() )
+    {
+        mutex_lock.unlock();
+    }
+
+    if (result)
+    {
+        fire_new_pipeline_created_callback(*out_pipeline_id_ptr);
+    }
+
+    return result;
+}
+
+/** Creates a new pipeline descriptor and stores it in the outstanding pipeline map (or the baked pipeline map,
+ *  if the pipeline is a proxy).
+ *
+ *  The caller must hold the manager's mutex, and is responsible for firing the
+ *  BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_NEW_PIPELINE_CREATED call-back after the mutex is released.
+ *
+ *  @param in_pipeline_create_info_ptr Create info of the pipeline to add.
+ *  @param out_pipeline_id_ptr         Deref will be set to the ID of the new pipeline. Must not be nullptr.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::BasePipelineManager::add_pipeline_internal(Anvil::BasePipelineCreateInfoUniquePtr in_pipeline_create_info_ptr,
+                                                       PipelineID*                            out_pipeline_id_ptr)
+{
+    const Anvil::PipelineID   base_pipeline_id = in_pipeline_create_info_ptr->get_base_pipeline_id();
+    PipelineID                new_pipeline_id  = 0;
+    std::unique_ptr<Pipeline> new_pipeline_ptr;
+    bool                      result           = false;
+
     if (base_pipeline_id != UINT32_MAX)
     {
         Anvil::BasePipelineCreateInfo* base_pipeline_create_info_ptr = nullptr;
@@ -130,6 +183,15 @@ bool Anvil::BasePipelineManager::add_pipeline(Anvil::BasePipelineCreateInfoUniqu
             {
                 base_pipeline_create_info_ptr = base_pipeline_iterator->second->pipeline_create_info_ptr.get();
             }
+            else
+            {
+                auto async_bake_job_ptr = get_async_bake_job(base_pipeline_id);
+
+                if (async_bake_job_ptr != nullptr)
+                {
+                    base_pipeline_create_info_ptr = async_bake_job_ptr->pipelines.at(base_pipeline_id)->pipeline_create_info_ptr.get();
+                }
+            }
         }
         else
         {
@@ -171,14 +233,328 @@ bool Anvil::BasePipelineManager::add_pipeline(Anvil::BasePipelineCreateInfoUniqu
 
     *out_pipeline_id_ptr = new_pipeline_id;
 
-    /* Inform subscribers about the new pipeline. */
-    callback_arg.new_pipeline_id = new_pipeline_id;
+    /* All done */
+    result = true;
+end:
+    return result;
+}
 
-    callback(BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_NEW_PIPELINE_CREATED,
-            &callback_arg);
+/* Please see header for specification */
+bool Anvil::BasePipelineManager::add_pipeline_async(Anvil::BasePipelineCreateInfoUniquePtr in_pipeline_create_info_ptr,
+                                                    PipelineID                             in_opt_fallback_pipeline_id,
+                                                    PipelineID*                            out_pipeline_id_ptr)
+{
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr       = get_mutex();
+    PipelineID                             new_pipeline_id = UINT32_MAX;
+    bool                                   result          = false;
+
+    if (!g_async_bake_supported ||
+         mutex_ptr == nullptr   ||
+        !is_pipeline_cache_mt_safe() )
+    {
+        /* Pipelines are baked asynchronously on a separate thread, so the manager and its pipeline cache need to
+         * be MT-safe. */
+        anvil_assert(g_async_bake_supported);
+        anvil_assert(mutex_ptr != nullptr);
+        anvil_assert(is_pipeline_cache_mt_safe() );
+
+        goto end;
+    }
+
+    mutex_lock = std::move(
+        std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+    );
+
+    if (in_pipeline_create_info_ptr->is_proxy() )
+    {
+        anvil_assert(!in_pipeline_create_info_ptr->is_proxy() );
+
+        goto end;
+    }
+
+    if (in_opt_fallback_pipeline_id != UINT32_MAX)
+    {
+        auto fallback_pipeline_create_info_ptr = get_pipeline_create_info(in_opt_fallback_pipeline_id);
+
+        if (fallback_pipeline_create_info_ptr == nullptr ||
+            fallback_pipeline_create_info_ptr->is_proxy() )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    if (!add_pipeline_internal(std::move(in_pipeline_create_info_ptr),
+                              &new_pipeline_id) )
+    {
+        goto end;
+    }
+
+    m_outstanding_pipelines.at(new_pipeline_id)->fallback_pipeline_id = in_opt_fallback_pipeline_id;
+
+    if (!schedule_async_bake_job(std::vector<PipelineID>(1,
+                                                         new_pipeline_id) ))
+    {
+        /* The caller is not told the new pipeline's ID, so it must not be left behind. */
+        m_outstanding_pipelines.erase(new_pipeline_id);
+
+        goto end;
+    }
+
+    *out_pipeline_id_ptr = new_pipeline_id;
 
     /* All done */
     result = true;
+end:
+    if (mutex_lock.owns_lock() )
+    {
+        mutex_lock.unlock();
+    }
+
+    if (result)
+    {
+        fire_new_pipeline_created_callback(new_pipeline_id);
+    }
+
+    return result;
+}
+
+/** Entry-point of the background thread, which bakes pipelines scheduled with bake_async().
+ *
+ *  Jobs are processed one at a time, in submission order. The manager's mutex is only held while
+ *  a job's bake items are prepared and while the results are published.
+ **/
+void Anvil::BasePipelineManager::async_bake_thread_entrypoint()
+{
+    auto mutex_ptr = get_mutex();
+
+    anvil_assert(mutex_ptr != nullptr);
+
+    for (;;)
+    {
+        std::vector<BakeGroup>        bake_groups;
+        std::vector<BakeItem>         bake_items;
+        std::vector<bool>             is_baked_items;
+        std::unique_ptr<AsyncBakeJob> job_ptr;
+        std::vector<VkPipeline>       result_pipelines;
+
+        {
+            std::unique_lock<std::mutex> async_bake_mutex_lock(m_async_bake_mutex);
+
+            m_async_bake_job_available_cv.wait(async_bake_mutex_lock,
+                                               [this]()
+                                               {
+                                                   return (m_n_pending_async_bake_jobs > 0 ||
+                                                           m_async_bake_thread_should_terminate);
+                                               });
+
+            if (m_n_pending_async_bake_jobs == 0)
+            {
+                break;
+            }
+
+            --m_n_pending_async_bake_jobs;
+        }
+
+        /* Jobs are processed in order, so any base pipeline scheduled in an earlier job has been baked by now. */
+        {
+            std::unique_lock<Anvil::MTSafetyMutex> mutex_lock(*mutex_ptr);
+
+            get_bake_items(m_async_bake_jobs.front()->pipelines,
+                          &bake_items,
+                          &bake_groups);
+        }
+
+        /* Compile with the manager unlocked, so that other threads can keep using it in the meantime. The job
+         * stays at the front of the queue, which keeps its pipelines alive even if they get deleted.
+         *
+         * If the compilation fails, handles of the pipelines which have been created regardless are left in place.
+         * Each pipeline's result is determined by its own handle, so that one failing pipeline does not fail the
+         * others.
+         */
+        if (bake_items.size() > 0)
+        {
+            compile_pipelines(bake_items,
+                              bake_groups,
+                             &result_pipelines);
+        }
+
+        is_baked_items.resize(bake_items.size(),
+                              false);
+
+        {
+            std::unique_lock<Anvil::MTSafetyMutex> mutex_lock(*mutex_ptr);
+
+            job_ptr = std::move(m_async_bake_jobs.front() );
+            m_async_bake_jobs.pop_front();
+
+            /* Failed pipelines are moved back to the outstanding pipeline map. Deleted pipelines are released
+             * together with the job. */
+            for (uint32_t n_bake_item = 0;
+                          n_bake_item < static_cast<uint32_t>(bake_items.size() );
+                        ++n_bake_item)
+            {
+                const BakeItem& current_bake_item = bake_items[n_bake_item];
+
+                is_baked_items[n_bake_item] = (n_bake_item                   <  static_cast<uint32_t>(result_pipelines.size() ) &&
+                                               result_pipelines[n_bake_item] != VK_NULL_HANDLE);
+
+                if (is_baked_items[n_bake_item])
+                {
+                    current_bake_item.pipeline_ptr->baked_pipeline = result_pipelines[n_bake_item];
+                }
+
+                if (job_ptr->deleted_pipeline_ids.find(current_bake_item.pipeline_id) != job_ptr->deleted_pipeline_ids.end() )
+                {
+                    continue;
+                }
+
+                if (is_baked_items[n_bake_item])
+                {
+                    anvil_assert(m_baked_pipelines.find(current_bake_item.pipeline_id) == m_baked_pipelines.end() );
+
+                    m_baked_pipelines[current_bake_item.pipeline_id] = std::move(job_ptr->pipelines.at(current_bake_item.pipeline_id) );
+                }
+                else
+                {
+                    m_outstanding_pipelines[current_bake_item.pipeline_id] = std::move(job_ptr->pipelines.at(current_bake_item.pipeline_id) );
+                }
+            }
+        }
+
+        /* Release any waiters before calling back, so that a handler which blocks on another thread cannot
+         * hold up threads which wait for this job. */
+        for (uint32_t n_bake_item = 0;
+                      n_bake_item < static_cast<uint32_t>(bake_items.size() );
+                    ++n_bake_item)
+        {
+            job_ptr->results.at(bake_items[n_bake_item].pipeline_id).promise.set_value(is_baked_items[n_bake_item]);
+        }
+
+        /* Inform subscribers about the outcome. Neither the manager's mutex nor the call-back mutex is held
+         * while the handlers run. */
+        for (uint32_t n_bake_item = 0;
+                      n_bake_item < static_cast<uint32_t>(bake_items.size() );
+                    ++n_bake_item)
+        {
+            const BakeItem& current_bake_item = bake_items[n_bake_item];
+
+            if (job_ptr->deleted_pipeline_ids.find(current_bake_item.pipeline_id) != job_ptr->deleted_pipeline_ids.end() )
+            {
+                continue;
+            }
+
+            auto callback_arg = Anvil::OnAsyncPipelineBakeFinishedCallbackData(current_bake_item.pipeline_id,
+                                                                              is_baked_items[n_bake_item]);
+
+            callback_unlocked(BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_ASYNC_PIPELINE_BAKE_FINISHED,
+                             &callback_arg);
+        }
+    }
+}
+
+/* Please see header for specification */
+bool Anvil::BasePipelineManager::bake()
+{
+    std::vector<BakeGroup>                 bake_groups;
+    std::vector<BakeItem>                  bake_items;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr        = get_mutex();
+    bool                                   result           = false;
+    std::vector<VkPipeline>                result_pipelines;
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    get_bake_items(m_outstanding_pipelines,
+                  &bake_items,
+                  &bake_groups);
+
+    if (bake_items.size() == 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    if (!compile_pipelines(bake_items,
+                           bake_groups,
+                          &result_pipelines) )
+    {
+        /* Other bake groups may have succeeded. Their pipelines will be re-created on the next attempt. */
+        release_compiled_pipelines(&result_pipelines);
+
+        goto end;
+    }
+
+    /* Distribute the result pipeline objects to pipeline configuration descriptors */
+    for (uint32_t n_bake_item = 0;
+                  n_bake_item < static_cast<uint32_t>(bake_items.size() );
+                ++n_bake_item)
+    {
+        const BakeItem& current_bake_item = bake_items[n_bake_item];
+
+        anvil_assert(m_baked_pipelines.find(current_bake_item.pipeline_id) == m_baked_pipelines.end() );
+        anvil_assert(result_pipelines[n_bake_item]                         != VK_NULL_HANDLE);
+
+        current_bake_item.pipeline_ptr->baked_pipeline   = result_pipelines[n_bake_item];
+        m_baked_pipelines[current_bake_item.pipeline_id] = std::move(m_outstanding_pipelines.at(current_bake_item.pipeline_id) );
+    }
+
+    m_outstanding_pipelines.clear();
+
+    /* All done */
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+bool Anvil::BasePipelineManager::bake_async()
+{
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr    = get_mutex();
+    std::vector<PipelineID>                pipeline_ids;
+    bool                                   result       = false;
+
+    if (!g_async_bake_supported ||
+         mutex_ptr == nullptr   ||
+        !is_pipeline_cache_mt_safe() )
+    {
+        /* Pipelines are baked asynchronously on a separate thread, so the manager and its pipeline cache need to
+         * be MT-safe. */
+        anvil_assert(g_async_bake_supported);
+        anvil_assert(mutex_ptr != nullptr);
+        anvil_assert(is_pipeline_cache_mt_safe() );
+
+        goto end;
+    }
+
+    mutex_lock = std::move(
+        std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+    );
+
+    if (m_outstanding_pipelines.size() == 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    pipeline_ids.reserve(m_outstanding_pipelines.size() );
+
+    for (const auto& current_pipeline : m_outstanding_pipelines)
+    {
+        pipeline_ids.push_back(current_pipeline.first);
+    }
+
+    result = schedule_async_bake_job(pipeline_ids);
 end:
     return result;
 }
@@ -222,20 +598,114 @@ void Anvil::BasePipelineManager::bake_specialization_info_vk(const Specializatio
                                                                                   : nullptr;
 }
 
+/* Please see header for specification */
+bool Anvil::BasePipelineManager::create_pipelines(const std::vector<BakeGroup>&  in_bake_groups,
+                                                  const CreatePipelinesFunction& in_create_pipelines_func)
+{
+    const uint32_t                             n_bake_groups = static_cast<uint32_t>(in_bake_groups.size() );
+    bool                                       result        = false;
+    std::vector<VkResult>                      result_vk_items(n_bake_groups,
+                                                               VK_ERROR_INITIALIZATION_FAILED);
+    std::vector<const Anvil::PipelineCache*>   worker_pipeline_cache_raw_ptrs;
+
+    if (m_bake_thread_pool_ptr == nullptr ||
+        n_bake_groups          <= 1)
+    {
+        /* Compile all bake groups on the calling thread */
+        if (m_pipeline_cache_ptr != nullptr)
+        {
+            m_pipeline_cache_ptr->lock();
+        }
+
+        for (uint32_t n_bake_group = 0;
+                      n_bake_group < n_bake_groups;
+                    ++n_bake_group)
+        {
+            result_vk_items[n_bake_group] = in_create_pipelines_func(in_bake_groups[n_bake_group],
+                                                                     (m_pipeline_cache_ptr != nullptr) ? m_pipeline_cache_ptr->get_pipeline_cache()
+                                                                                                       : VK_NULL_HANDLE);
+        }
+
+        if (m_pipeline_cache_ptr != nullptr)
+        {
+            m_pipeline_cache_ptr->unlock();
+        }
+    }
+    else
+    {
+        const uint32_t        n_worker_threads = m_bake_thread_pool_ptr->get_n_worker_threads();
+        std::vector<uint32_t> n_jobs_per_worker_thread(n_worker_threads,
+                                                       0);
+
+        m_bake_thread_pool_ptr->execute(
+            n_bake_groups,
+            [&](uint32_t in_n_job,
+                uint32_t in_n_worker_thread)
+            {
+                const VkPipelineCache pipeline_cache_vk = (m_bake_worker_pipeline_cache_ptrs.size() > 0) ? m_bake_worker_pipeline_cache_ptrs.at(in_n_worker_thread)->get_pipeline_cache()
+                                                                                                         : VK_NULL_HANDLE;
+
+                result_vk_items[in_n_job] = in_create_pipelines_func(in_bake_groups[in_n_job],
+                                                                     pipeline_cache_vk);
+
+                ++n_jobs_per_worker_thread[in_n_worker_thread];
+            }
+        );
+
+        /* Fold the caches of the workers which have compiled anything back into the manager's cache. Other workers'
+         * caches hold nothing the manager's cache does not already have. */
+        if (m_bake_worker_pipeline_cache_ptrs.size() > 0)
+        {
+            for (uint32_t n_worker_thread = 0;
+                          n_worker_thread < n_worker_threads;
+                        ++n_worker_thread)
+            {
+                if (n_jobs_per_worker_thread[n_worker_thread] > 0)
+                {
+                    worker_pipeline_cache_raw_ptrs.push_back(m_bake_worker_pipeline_cache_ptrs.at(n_worker_thread).get() );
+                }
+            }
+
+            if (worker_pipeline_cache_raw_ptrs.size() > 0)
+            {
+                m_pipeline_cache_ptr->merge(static_cast<uint32_t>(worker_pipeline_cache_raw_ptrs.size() ),
+                                           &worker_pipeline_cache_raw_ptrs.at(0) );
+            }
+        }
+    }
+
+    for (uint32_t n_bake_group = 0;
+                  n_bake_group < n_bake_groups;
+                ++n_bake_group)
+    {
+        if (!is_vk_call_successful(result_vk_items[n_bake_group]) )
+        {
+            anvil_assert_vk_call_succeeded(result_vk_items[n_bake_group]);
+
+            goto end;
+        }
+    }
+
+    /* All done */
+    result = true;
+end:
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::BasePipelineManager::delete_pipeline(PipelineID in_pipeline_id)
 {
     bool result = false;
 
     {
-        std::unique_lock<std::recursive_mutex> mutex_lock;
+        std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
         auto                                   mutex_ptr         = get_mutex();
         Pipelines::iterator                    pipeline_iterator;
 
         if (mutex_ptr != nullptr)
         {
             mutex_lock = std::move(
-                std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+                std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
             );
         }
 
@@ -249,12 +719,22 @@ bool Anvil::BasePipelineManager::delete_pipeline(PipelineID in_pipeline_id)
         {
             pipeline_iterator = m_outstanding_pipelines.find(in_pipeline_id);
 
-            if (pipeline_iterator == m_outstanding_pipelines.end() )
+            if (pipeline_iterator != m_outstanding_pipelines.end() )
             {
-                goto end;
+                m_outstanding_pipelines.erase(pipeline_iterator);
             }
+            else
+            {
+                auto async_bake_job_ptr = get_async_bake_job(in_pipeline_id);
+
+                if (async_bake_job_ptr == nullptr)
+                {
+                    goto end;
+                }
 
-            m_outstanding_pipelines.erase(pipeline_iterator);
+                /* The pipeline is being baked on the background thread. It will be released once the bake finishes. */
+                async_bake_job_ptr->deleted_pipeline_ids.insert(in_pipeline_id);
+            }
         }
     }
 
@@ -264,28 +744,202 @@ end:
     return result;
 }
 
+/** Informs subscribers about a new pipeline. Must be called without the manager's mutex held, as the
+ *  handlers are allowed to call back into the manager.
+ *
+ *  @param in_pipeline_id ID of the new pipeline.
+ **/
+void Anvil::BasePipelineManager::fire_new_pipeline_created_callback(PipelineID in_pipeline_id)
+{
+    auto callback_arg = Anvil::OnNewPipelineCreatedCallbackData(in_pipeline_id);
+
+    callback(BASE_PIPELINE_MANAGER_CALLBACK_ID_ON_NEW_PIPELINE_CREATED,
+            &callback_arg);
+}
+
+/** Returns the asynchronous bake job which owns the specified pipeline, or nullptr if the pipeline is not being
+ *  baked asynchronously. Pipelines deleted while being baked are not reported.
+ *
+ *  Must be called with the manager's mutex locked.
+ **/
+Anvil::BasePipelineManager::AsyncBakeJob* Anvil::BasePipelineManager::get_async_bake_job(PipelineID in_pipeline_id) const
+{
+    AsyncBakeJob* result_ptr = nullptr;
+
+    for (const auto& current_job_ptr : m_async_bake_jobs)
+    {
+        if (current_job_ptr->pipelines.find           (in_pipeline_id) != current_job_ptr->pipelines.end           () &&
+            current_job_ptr->deleted_pipeline_ids.find(in_pipeline_id) == current_job_ptr->deleted_pipeline_ids.end() )
+        {
+            result_ptr = current_job_ptr.get();
+
+            break;
+        }
+    }
+
+    return result_ptr;
+}
+
+/* Please see header for specification */
+void Anvil::BasePipelineManager::get_bake_items(const Pipelines&        in_pipelines,
+                                                std::vector<BakeItem>*  out_bake_items_ptr,
+                                                std::vector<BakeGroup>* out_bake_groups_ptr)
+{
+    typedef struct BakeItemLocation
+    {
+        uint32_t n_bake_group;
+        uint32_t n_bake_item;
+
+        BakeItemLocation()
+        {
+            n_bake_group = UINT32_MAX;
+            n_bake_item  = UINT32_MAX;
+        }
+
+        BakeItemLocation(uint32_t in_n_bake_group,
+                         uint32_t in_n_bake_item)
+        {
+            n_bake_group = in_n_bake_group;
+            n_bake_item  = in_n_bake_item;
+        }
+    } BakeItemLocation;
+
+    std::map<PipelineID, BakeItemLocation> bake_item_locations;
+    std::vector<std::vector<BakeItem> >    bake_items_per_group;
+    const bool                             is_parallel_bake_enabled = (m_bake_thread_pool_ptr != nullptr);
+
+    out_bake_items_ptr->clear ();
+    out_bake_groups_ptr->clear();
+
+    /* NOTE: Pipeline IDs are assigned in increasing order, and a derivative pipeline can only be added after its
+     *       base pipeline. This guarantees base pipelines are always encountered first. */
+    for (auto pipeline_iterator  = in_pipelines.begin();
+              pipeline_iterator != in_pipelines.end();
+            ++pipeline_iterator)
+    {
+        const PipelineID current_pipeline_id    = pipeline_iterator->first;
+        Pipeline*        current_pipeline_ptr   = pipeline_iterator->second.get();
+        const PipelineID base_pipeline_id       = current_pipeline_ptr->pipeline_create_info_ptr->get_base_pipeline_id();
+        const auto       base_location_iterator = bake_item_locations.find(base_pipeline_id);
+        VkPipeline       base_pipeline_handle   = VK_NULL_HANDLE;
+        int32_t          base_pipeline_index    = static_cast<int32_t>(UINT32_MAX);
+        uint32_t         n_bake_group           = 0;
+
+        if (current_pipeline_ptr->layout_ptr == nullptr)
+        {
+            get_pipeline_layout(current_pipeline_id);
+
+            anvil_assert(current_pipeline_ptr->layout_ptr != nullptr);
+        }
+
+        if (base_location_iterator != bake_item_locations.end() )
+        {
+            n_bake_group        = base_location_iterator->second.n_bake_group;
+            base_pipeline_index = static_cast<int32_t>(base_location_iterator->second.n_bake_item);
+        }
+        else
+        {
+            if (base_pipeline_id != UINT32_MAX)
+            {
+                auto baked_pipeline_iterator = m_baked_pipelines.find(base_pipeline_id);
+
+                if (baked_pipeline_iterator                         != m_baked_pipelines.end() &&
+                    baked_pipeline_iterator->second->baked_pipeline != VK_NULL_HANDLE)
+                {
+                    base_pipeline_handle = baked_pipeline_iterator->second->baked_pipeline;
+                }
+                else
+                {
+                    /* The base pipeline should be in the middle of an asynchronous bake, or still be outstanding if the
+                     * derivative has been scheduled on its own with add_pipeline_async(). If so, the pipeline is going
+                     * to be created as a regular one. Otherwise, there's a bug in the app or the manager. */
+                    anvil_assert(get_async_bake_job(base_pipeline_id)            != nullptr                      ||
+                                 m_outstanding_pipelines.find(base_pipeline_id) != m_outstanding_pipelines.end() );
+                }
+            }
+
+            if (!is_parallel_bake_enabled        &&
+                 bake_items_per_group.size() > 0)
+            {
+                n_bake_group = 0;
+            }
+            else
+            {
+                n_bake_group = static_cast<uint32_t>(bake_items_per_group.size() );
+
+                bake_items_per_group.push_back(std::vector<BakeItem>() );
+            }
+        }
+
+        bake_item_locations[current_pipeline_id] = BakeItemLocation(n_bake_group,
+                                                                    static_cast<uint32_t>(bake_items_per_group[n_bake_group].size() ));
+
+        bake_items_per_group[n_bake_group].push_back(
+            BakeItem(current_pipeline_id,
+                     current_pipeline_ptr,
+                     base_pipeline_index,
+                     base_pipeline_handle)
+        );
+    }
+
+    /* Lay the bake groups out one after another */
+    out_bake_items_ptr->reserve (in_pipelines.size() );
+    out_bake_groups_ptr->reserve(bake_items_per_group.size   () );
+
+    for (const auto& current_bake_group_items : bake_items_per_group)
+    {
+        out_bake_groups_ptr->push_back(
+            BakeGroup(static_cast<uint32_t>(out_bake_items_ptr->size() ),
+                      static_cast<uint32_t>(current_bake_group_items.size() ))
+        );
+
+        out_bake_items_ptr->insert(out_bake_items_ptr->end(),
+                                   current_bake_group_items.begin(),
+                                   current_bake_group_items.end  () );
+    }
+}
+
 /* Please see header for specification */
 VkPipeline Anvil::BasePipelineManager::get_pipeline(PipelineID in_pipeline_id)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr         = get_mutex();
+    AsyncBakeJob*                          async_bake_job_ptr = nullptr;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr          = get_mutex();
     Pipelines::const_iterator              pipeline_iterator;
-    Pipeline*                              pipeline_ptr      = nullptr;
-    VkPipeline                             result            = VK_NULL_HANDLE;
+    PipelineID                             pipeline_id        = in_pipeline_id;
+    Pipeline*                              pipeline_ptr       = nullptr;
+    VkPipeline                             result             = VK_NULL_HANDLE;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
+    /* Follow the fallback pipeline chain for as long as the pipelines are being baked asynchronously. Block if
+     * the chain runs out. */
+    while ((async_bake_job_ptr = get_async_bake_job(pipeline_id)) != nullptr)
+    {
+        const PipelineID fallback_pipeline_id = async_bake_job_ptr->pipelines.at(pipeline_id)->fallback_pipeline_id;
+
+        if (fallback_pipeline_id == UINT32_MAX)
+        {
+            wait_for_async_bake(pipeline_id,
+                               &mutex_lock);
+
+            break;
+        }
+
+        pipeline_id = fallback_pipeline_id;
+    }
+
     if (m_outstanding_pipelines.size() > 0)
     {
         bake();
     }
 
-    pipeline_iterator = m_baked_pipelines.find(in_pipeline_id);
+    pipeline_iterator = m_baked_pipelines.find(pipeline_id);
 
     if (pipeline_iterator == m_baked_pipelines.end() )
     {
@@ -311,7 +965,7 @@ end:
 
 const Anvil::BasePipelineCreateInfo* Anvil::BasePipelineManager::get_pipeline_create_info(PipelineID in_pipeline_id) const
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr         = get_mutex();
     Pipelines::const_iterator              pipeline_iterator;
     Pipeline*                              pipeline_ptr      = nullptr;
@@ -320,7 +974,7 @@ const Anvil::BasePipelineCreateInfo* Anvil::BasePipelineManager::get_pipeline_cr
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -332,9 +986,16 @@ const Anvil::BasePipelineCreateInfo* Anvil::BasePipelineManager::get_pipeline_cr
 
         if (pipeline_iterator == m_outstanding_pipelines.end() )
         {
-            anvil_assert(!(pipeline_iterator == m_outstanding_pipelines.end() ));
+            auto async_bake_job_ptr = get_async_bake_job(in_pipeline_id);
 
-            goto end;
+            if (async_bake_job_ptr == nullptr)
+            {
+                anvil_assert(!(pipeline_iterator == m_outstanding_pipelines.end() ));
+
+                goto end;
+            }
+
+            pipeline_iterator = async_bake_job_ptr->pipelines.find(in_pipeline_id);
         }
     }
 
@@ -345,10 +1006,62 @@ end:
     return result_ptr;
 }
 
+/* Please see header for specification */
+std::shared_future<bool> Anvil::BasePipelineManager::get_pipeline_future(PipelineID in_pipeline_id)
+{
+    AsyncBakeJob*                          async_bake_job_ptr = nullptr;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr          = get_mutex();
+    Pipelines::const_iterator              pipeline_iterator;
+    std::promise<bool>                     result_promise;
+    std::shared_future<bool>               result_future;
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    if (m_outstanding_pipelines.find(in_pipeline_id) != m_outstanding_pipelines.end() )
+    {
+        /* Asynchronous baking is only available for MT-safe managers. Fall back to a synchronous bake otherwise. */
+        if (mutex_ptr != nullptr)
+        {
+            bake_async();
+        }
+        else
+        {
+            bake();
+        }
+    }
+
+    async_bake_job_ptr = get_async_bake_job(in_pipeline_id);
+
+    if (async_bake_job_ptr != nullptr)
+    {
+        result_future = async_bake_job_ptr->results.at(in_pipeline_id).future;
+
+        goto end;
+    }
+
+    pipeline_iterator = m_baked_pipelines.find(in_pipeline_id);
+
+    anvil_assert(pipeline_iterator != m_baked_pipelines.end() );
+
+    result_promise.set_value(pipeline_iterator                         != m_baked_pipelines.end() &&
+                             pipeline_iterator->second->baked_pipeline != VK_NULL_HANDLE);
+
+    result_future = result_promise.get_future().share();
+
+end:
+    return result_future;
+}
+
 /* Please see header for specification */
 Anvil::PipelineLayout* Anvil::BasePipelineManager::get_pipeline_layout(PipelineID in_pipeline_id)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr         = get_mutex();
     Pipelines::iterator                    pipeline_iterator;
     Pipeline*                              pipeline_ptr      = nullptr;
@@ -357,7 +1070,7 @@ Anvil::PipelineLayout* Anvil::BasePipelineManager::get_pipeline_layout(PipelineI
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -369,9 +1082,17 @@ Anvil::PipelineLayout* Anvil::BasePipelineManager::get_pipeline_layout(PipelineI
 
         if (pipeline_iterator == m_outstanding_pipelines.end() )
         {
-            anvil_assert(!(pipeline_iterator == m_outstanding_pipelines.end() ));
+            auto async_bake_job_ptr = get_async_bake_job(in_pipeline_id);
 
-            goto end;
+            if (async_bake_job_ptr == nullptr)
+            {
+                anvil_assert(!(pipeline_iterator == m_outstanding_pipelines.end() ));
+
+                goto end;
+            }
+
+            /* NOTE: bake_async() assigns layouts to all pipelines it schedules */
+            pipeline_iterator = async_bake_job_ptr->pipelines.find(in_pipeline_id);
         }
     }
 
@@ -416,7 +1137,7 @@ bool Anvil::BasePipelineManager::get_shader_info(PipelineID                  in_
                                                  std::vector<unsigned char>* out_data_ptr)
 {
     Anvil::ExtensionAMDShaderInfoEntrypoints entrypoints       = m_device_ptr->get_extension_amd_shader_info_entrypoints();
-    std::unique_lock<std::recursive_mutex>   mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex>   mutex_lock;
     auto                                     mutex_ptr         = get_mutex();
     Pipelines::const_iterator                pipeline_iterator;
     Pipeline*                                pipeline_ptr      = nullptr;
@@ -436,10 +1157,13 @@ bool Anvil::BasePipelineManager::get_shader_info(PipelineID                  in_
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
+    wait_for_async_bake(in_pipeline_id,
+                       &mutex_lock);
+
     if (m_outstanding_pipelines.size() > 0)
     {
         bake();
@@ -538,7 +1262,7 @@ bool Anvil::BasePipelineManager::get_shader_statistics(PipelineID
                                                        VkShaderStatisticsInfoAMD*  out_shader_statistics_ptr)
 {
     Anvil::ExtensionAMDShaderInfoEntrypoints entrypoints            = m_device_ptr->get_extension_amd_shader_info_entrypoints();
-    std::unique_lock<std::recursive_mutex>   mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex>   mutex_lock;
     auto                                     mutex_ptr              = get_mutex();
     Pipelines::const_iterator                pipeline_iterator;
     Pipeline*                                pipeline_ptr           = nullptr;
@@ -557,10 +1281,13 @@ bool Anvil::BasePipelineManager::get_shader_statistics(PipelineID
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
+    wait_for_async_bake(in_pipeline_id,
+                       &mutex_lock);
+
     if (m_outstanding_pipelines.size() > 0)
     {
         bake();
@@ -606,3 +1333,272 @@ bool Anvil::BasePipelineManager::get_shader_statistics(PipelineID
 end:
     return result;
 }
+
+/** Tells whether the manager's pipeline cache, if any, can be used by more than one thread at a time. */
+bool Anvil::BasePipelineManager::is_pipeline_cache_mt_safe() const
+{
+    return (m_pipeline_cache_ptr == nullptr ||
+            m_pipeline_cache_ptr->is_mt_safe() );
+}
+
+/* Please see header for specification */
+bool Anvil::BasePipelineManager::is_pipeline_ready(PipelineID in_pipeline_id) const
+{
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr         = get_mutex();
+    Pipelines::const_iterator              pipeline_iterator;
+    bool                                   result            = false;
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    pipeline_iterator = m_baked_pipelines.find(in_pipeline_id);
+
+    if (pipeline_iterator != m_baked_pipelines.end() )
+    {
+        result = (pipeline_iterator->second->baked_pipeline != VK_NULL_HANDLE);
+    }
+
+    return result;
+}
+
+/** Destroys all Vulkan pipeline objects held by @param inout_pipelines_ptr and resets the handles to VK_NULL_HANDLE.
+ *
+ *  Used to release the pipelines created by a compile_pipelines() call which has failed, since some of the
+ *  vkCreate*Pipelines() calls it has issued may have succeeded.
+ *
+ *  @param inout_pipelines_ptr Pipeline handles to release. Null handles are skipped. Must not be nullptr.
+ **/
+void Anvil::BasePipelineManager::release_compiled_pipelines(std::vector<VkPipeline>* inout_pipelines_ptr) const
+{
+    for (auto& current_pipeline : *inout_pipelines_ptr)
+    {
+        if (current_pipeline != VK_NULL_HANDLE)
+        {
+            Anvil::Vulkan::vkDestroyPipeline(m_device_ptr->get_device_vk(),
+                                             current_pipeline,
+                                             nullptr /* pAllocator */);
+
+            current_pipeline = VK_NULL_HANDLE;
+        }
+    }
+}
+
+/** Moves the specified outstanding pipelines to a new asynchronous bake job and hands the job over to the background
+ *  thread, which is spawned if needed.
+ *
+ *  Must be called with the manager's mutex locked.
+ *
+ *  @param in_pipeline_ids IDs of outstanding pipelines to schedule. Must not be empty.
+ *
+ *  @return true if successful, false otherwise. If the function fails, the pipelines stay outstanding.
+ **/
+bool Anvil::BasePipelineManager::schedule_async_bake_job(const std::vector<PipelineID>& in_pipeline_ids)
+{
+    std::unique_ptr<AsyncBakeJob> job_ptr;
+    bool                          result  = false;
+
+    anvil_assert(in_pipeline_ids.size() > 0);
+
+    /* Assign pipeline layouts upfront, so that they can be safely queried while the pipelines are being baked. */
+    for (const auto& current_pipeline_id : in_pipeline_ids)
+    {
+        if (m_outstanding_pipelines.at(current_pipeline_id)->layout_ptr == nullptr)
+        {
+            if (get_pipeline_layout(current_pipeline_id) == nullptr)
+            {
+                goto end;
+            }
+        }
+    }
+
+    job_ptr.reset(
+        new AsyncBakeJob()
+    );
+
+    for (const auto& current_pipeline_id : in_pipeline_ids)
+    {
+        auto pipeline_iterator = m_outstanding_pipelines.find(current_pipeline_id);
+
+        job_ptr->pipelines[current_pipeline_id] = std::move(pipeline_iterator->second);
+        job_ptr->results  [current_pipeline_id];
+
+        m_outstanding_pipelines.erase(pipeline_iterator);
+    }
+
+    m_async_bake_jobs.push_back(std::move(job_ptr) );
+
+    {
+        std::unique_lock<std::mutex> async_bake_mutex_lock(m_async_bake_mutex);
+
+        if (!m_async_bake_thread.joinable() )
+        {
+            m_async_bake_thread_should_terminate = false;
+            m_async_bake_thread                  = std::thread(&Anvil::BasePipelineManager::async_bake_thread_entrypoint,
+                                                               this);
+        }
+
+        ++m_n_pending_async_bake_jobs;
+    }
+
+    m_async_bake_job_available_cv.notify_one();
+
+    /* All done */
+    result = true;
+end:
+    return result;
+}
+
+/* Please see header for specification */
+void Anvil::BasePipelineManager::set_n_bake_worker_threads(uint32_t in_n_worker_threads)
+{
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr = get_mutex();
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    /* The thread pool may be in use by the background thread */
+    anvil_assert(m_async_bake_jobs.size() == 0);
+
+    m_bake_worker_pipeline_cache_ptrs.clear();
+
+    if (in_n_worker_threads == 1)
+    {
+        m_bake_thread_pool_ptr.reset();
+
+        return;
+    }
+
+    /* Worker caches are merged into the manager's cache, which may be shared with other managers baking at the
+     * same time. */
+    if (!is_pipeline_cache_mt_safe() )
+    {
+        anvil_assert(is_pipeline_cache_mt_safe() );
+
+        m_bake_thread_pool_ptr.reset();
+
+        return;
+    }
+
+    m_bake_thread_pool_ptr = Anvil::ThreadPool::create(in_n_worker_threads);
+
+    /* Spawn a separate pipeline cache for each worker thread, so that the threads do not contend for the manager's
+     * cache. Seed each one with what the manager's cache holds at this point. */
+    if (m_pipeline_cache_ptr != nullptr)
+    {
+        const uint32_t             n_worker_threads   = m_bake_thread_pool_ptr->get_n_worker_threads();
+        std::vector<unsigned char> cache_data;
+        size_t                     n_cache_data_bytes = 0;
+
+        m_pipeline_cache_ptr->lock();
+        {
+            if (!m_pipeline_cache_ptr->get_data(&n_cache_data_bytes,
+                                                nullptr) ) /* out_data_ptr */
+            {
+                n_cache_data_bytes = 0;
+            }
+
+            if (n_cache_data_bytes > 0)
+            {
+                cache_data.resize(n_cache_data_bytes);
+
+                if (!m_pipeline_cache_ptr->get_data(&n_cache_data_bytes,
+                                                    &cache_data.at(0) ) )
+                {
+                    n_cache_data_bytes = 0;
+                }
+            }
+        }
+        m_pipeline_cache_ptr->unlock();
+
+        m_bake_worker_pipeline_cache_ptrs.reserve(n_worker_threads);
+
+        for (uint32_t n_worker_thread = 0;
+                      n_worker_thread < n_worker_threads;
+                    ++n_worker_thread)
+        {
+            auto worker_pipeline_cache_ptr = Anvil::PipelineCache::create(m_device_ptr,
+                                                                          false, /* in_mt_safe */
+                                                                          n_cache_data_bytes,
+                                                                          (n_cache_data_bytes > 0) ? &cache_data.at(0) : nullptr);
+
+            if (worker_pipeline_cache_ptr == nullptr)
+            {
+                /* Workers are going to compile without a pipeline cache */
+                anvil_assert(worker_pipeline_cache_ptr != nullptr);
+
+                m_bake_worker_pipeline_cache_ptrs.clear();
+
+                break;
+            }
+
+            m_bake_worker_pipeline_cache_ptrs.push_back(
+                std::move(worker_pipeline_cache_ptr)
+            );
+        }
+    }
+}
+
+/* Please see header for specification */
+void Anvil::BasePipelineManager::stop_async_bake_thread()
+{
+    {
+        std::unique_lock<std::mutex> async_bake_mutex_lock(m_async_bake_mutex);
+
+        if (!m_async_bake_thread.joinable() )
+        {
+            return;
+        }
+
+        m_async_bake_thread_should_terminate = true;
+    }
+
+    /* The background thread only quits once all pending jobs are processed */
+    m_async_bake_job_available_cv.notify_one();
+    m_async_bake_thread.join                ();
+}
+
+/** Blocks until the asynchronous bake of the specified pipeline finishes. Returns immediately if the pipeline
+ *  is not being baked asynchronously.
+ *
+ *  The manager's mutex is released for the duration of the wait, since the background thread needs it to
+ *  publish the results. The caller must not hold the mutex at any other level.
+ *
+ *  @param in_pipeline_id       ID of the pipeline to wait for.
+ *  @param inout_mutex_lock_ptr Lock the caller holds the manager's mutex with. Must not be nullptr.
+ **/
+void Anvil::BasePipelineManager::wait_for_async_bake(PipelineID                              in_pipeline_id,
+                                                     std::unique_lock<Anvil::MTSafetyMutex>* inout_mutex_lock_ptr)
+{
+    auto async_bake_job_ptr = get_async_bake_job(in_pipeline_id);
+
+    if (async_bake_job_ptr != nullptr)
+    {
+        std::shared_future<bool> result_future = async_bake_job_ptr->results.at(in_pipeline_id).future;
+
+        /* The background thread would wait for itself, since jobs are processed one at a time. */
+        if (std::this_thread::get_id() == m_async_bake_thread.get_id() )
+        {
+            anvil_assert_fail();
+
+            return;
+        }
+
+        anvil_assert(inout_mutex_lock_ptr->owns_lock() );
+
+        inout_mutex_lock_ptr->unlock();
+        {
+            result_future.wait();
+        }
+        inout_mutex_lock_ptr->lock();
+    }
+}
@@ -0,0 +1,427 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/bindless_descriptor_table.h"
+#include "misc/debug.h"
+#include "misc/descriptor_pool_create_info.h"
+#include "misc/descriptor_set_create_info.h"
+#include "wrappers/descriptor_pool.h"
+#include "wrappers/descriptor_set_layout.h"
+#include "wrappers/descriptor_set_layout_manager.h"
+#include "wrappers/device.h"
+
+
+/** Please see header for specification */
+Anvil::BindlessDescriptorTable::BindlessDescriptorTable(const Anvil::BaseDevice* in_device_ptr,
+                                                        uint32_t                 in_n_frames_in_flight,
+                                                        bool                     in_mt_safe)
+    :MTSafetySupportProvider(in_mt_safe),
+     m_device_ptr           (in_device_ptr),
+     m_frame_ring           (in_device_ptr,
+                             in_n_frames_in_flight)
+{
+    m_frames.resize(in_n_frames_in_flight);
+}
+
+/** Please see header for specification */
+Anvil::BindlessDescriptorTable::~BindlessDescriptorTable()
+{
+    /* Descriptor set wrappers need to be released before their parent pool. */
+    for (auto& current_table : m_tables)
+    {
+        current_table.second->ds_ptr.reset();
+    }
+
+    m_pool_ptr.reset();
+    m_tables.clear  ();
+}
+
+/** Please see header for specification */
+uint32_t Anvil::BindlessDescriptorTable::alloc_slot(Anvil::DescriptorType in_descriptor_type)
+{
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr      = get_mutex();
+    uint32_t                               result         = UINT32_MAX;
+    TableData*                             table_data_ptr = get_table_data(in_descriptor_type);
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    if (table_data_ptr == nullptr)
+    {
+        anvil_assert(table_data_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (table_data_ptr->free_slots.size() == 0)
+    {
+        goto end;
+    }
+
+    result = table_data_ptr->free_slots.back();
+
+    table_data_ptr->free_slots.pop_back();
+
+    anvil_assert(!table_data_ptr->slot_allocated.at(result) );
+
+    table_data_ptr->slot_allocated.at(result) = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::BindlessDescriptorTable::begin_frame(Anvil::Fence* in_opt_frame_fence_ptr)
+{
+    FrameData*                             frame_ptr    = nullptr;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr    = get_mutex();
+    uint32_t                               n_next_frame = 0;
+    bool                                   result       = false;
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    if (!m_frame_ring.wait_for_next_frame(&n_next_frame) )
+    {
+        goto end;
+    }
+
+    frame_ptr = &m_frames.at(n_next_frame);
+
+    /* The GPU is done with the frame, so slots released while it was being recorded can be reused. */
+    for (const auto& current_released_slot : frame_ptr->released_slots)
+    {
+        TableData* table_data_ptr = get_table_data(current_released_slot.first);
+
+        table_data_ptr->free_slots.push_back(current_released_slot.second);
+    }
+
+    frame_ptr->released_slots.clear();
+
+    m_frame_ring.advance(in_opt_frame_fence_ptr);
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::BindlessDescriptorTableUniquePtr Anvil::BindlessDescriptorTable::create(const Anvil::BaseDevice*     in_device_ptr,
+                                                                               uint32_t                     in_n_resource_types,
+                                                                               const Anvil::DescriptorType* in_resource_types_ptr,
+                                                                               const uint32_t*              in_n_slots_ptr,
+                                                                               Anvil::ShaderStageFlags      in_stage_flags,
+                                                                               uint32_t                     in_n_frames_in_flight,
+                                                                               MTSafety                     in_mt_safety)
+{
+    const bool                              is_mt_safe = Anvil::Utils::convert_mt_safety_enum_to_boolean(in_mt_safety,
+                                                                                                         in_device_ptr);
+    Anvil::BindlessDescriptorTableUniquePtr result_ptr(nullptr,
+                                                       std::default_delete<Anvil::BindlessDescriptorTable>() );
+
+    anvil_assert(in_device_ptr         != nullptr);
+    anvil_assert(in_n_resource_types   >= 1);
+    anvil_assert(in_resource_types_ptr != nullptr);
+    anvil_assert(in_n_slots_ptr        != nullptr);
+    anvil_assert(in_n_frames_in_flight >= 1);
+
+    result_ptr.reset(
+        new Anvil::BindlessDescriptorTable(in_device_ptr,
+                                           in_n_frames_in_flight,
+                                           is_mt_safe)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init(in_n_resource_types,
+                              in_resource_types_ptr,
+                              in_n_slots_ptr,
+                              in_stage_flags) )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::DescriptorSet* Anvil::BindlessDescriptorTable::get_descriptor_set(Anvil::DescriptorType in_descriptor_type) const
+{
+    TableData* table_data_ptr = get_table_data(in_descriptor_type);
+
+    return (table_data_ptr != nullptr) ? table_data_ptr->ds_ptr.get()
+                                       : nullptr;
+}
+
+/** Please see header for specification */
+const Anvil::DescriptorSetCreateInfo* Anvil::BindlessDescriptorTable::get_descriptor_set_create_info(Anvil::DescriptorType in_descriptor_type) const
+{
+    TableData* table_data_ptr = get_table_data(in_descriptor_type);
+
+    return (table_data_ptr != nullptr) ? table_data_ptr->layout_ptr->get_create_info()
+                                       : nullptr;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::BindlessDescriptorTable::get_n_free_slots(Anvil::DescriptorType in_descriptor_type) const
+{
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr      = get_mutex();
+    TableData*                             table_data_ptr = get_table_data(in_descriptor_type);
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    return (table_data_ptr != nullptr) ? static_cast<uint32_t>(table_data_ptr->free_slots.size() )
+                                       : 0;
+}
+
+/** Returns the table holding resources of type @param in_descriptor_type, or nullptr if there is no such table. */
+Anvil::BindlessDescriptorTable::TableData* Anvil::BindlessDescriptorTable::get_table_data(Anvil::DescriptorType in_descriptor_type) const
+{
+    auto table_iterator = m_tables.find(in_descriptor_type);
+
+    return (table_iterator != m_tables.end() ) ? table_iterator->second.get()
+                                               : nullptr;
+}
+
+/** Verifies the device supports the requested resource types, and creates the layouts, the pool and the descriptor sets.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::BindlessDescriptorTable::init(uint32_t                     in_n_resource_types,
+                                          const Anvil::DescriptorType* in_resource_types_ptr,
+                                          const uint32_t*              in_n_slots_ptr,
+                                          Anvil::ShaderStageFlags      in_stage_flags)
+{
+    const Anvil::DescriptorBindingFlags         binding_flags      = Anvil::DescriptorBindingFlagBits::UPDATE_AFTER_BIND_BIT           |
+                                                                     Anvil::DescriptorBindingFlagBits::PARTIALLY_BOUND_BIT             |
+                                                                     Anvil::DescriptorBindingFlagBits::UPDATE_UNUSED_WHILE_PENDING_BIT;
+    Anvil::DescriptorPoolCreateInfoUniquePtr    dp_create_info_ptr;
+    std::vector<Anvil::DescriptorSetAllocation> ds_allocations;
+    std::vector<Anvil::DescriptorSetUniquePtr>  ds_ptrs            (in_n_resource_types);
+    const Anvil::EXTDescriptorIndexingFeatures* features_ptr       = nullptr;
+    bool                                        result             = false;
+
+    if (!m_device_ptr->get_extension_info()->ext_descriptor_indexing() )
+    {
+        anvil_assert(m_device_ptr->get_extension_info()->ext_descriptor_indexing() );
+
+        goto end;
+    }
+
+    features_ptr = m_device_ptr->get_physical_device_features().ext_descriptor_indexing_features_ptr;
+
+    if (features_ptr                                                 == nullptr ||
+        !features_ptr->descriptor_binding_partially_bound                       ||
+        !features_ptr->descriptor_binding_update_unused_while_pending)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    dp_create_info_ptr = Anvil::DescriptorPoolCreateInfo::create(m_device_ptr,
+                                                                 in_n_resource_types,
+                                                                 Anvil::DescriptorPoolCreateFlagBits::UPDATE_AFTER_BIND_BIT,
+                                                                 Anvil::MTSafety::DISABLED);
+
+    for (uint32_t n_resource_type = 0;
+                  n_resource_type < in_n_resource_types;
+                ++n_resource_type)
+    {
+        const Anvil::DescriptorType             current_descriptor_type = in_resource_types_ptr[n_resource_type];
+        Anvil::DescriptorSetCreateInfoUniquePtr ds_create_info_ptr;
+        bool                                    is_supported            = false;
+        std::unique_ptr<TableData>              new_table_data_ptr;
+
+        switch (current_descriptor_type)
+        {
+            case Anvil::DescriptorType::COMBINED_IMAGE_SAMPLER:
+            case Anvil::DescriptorType::SAMPLED_IMAGE:
+            case Anvil::DescriptorType::SAMPLER:              is_supported = features_ptr->descriptor_binding_sampled_image_update_after_bind;        break;
+            case Anvil::DescriptorType::STORAGE_BUFFER:       is_supported = features_ptr->descriptor_binding_storage_buffer_update_after_bind;       break;
+            case Anvil::DescriptorType::STORAGE_IMAGE:        is_supported = features_ptr->descriptor_binding_storage_image_update_after_bind;        break;
+            case Anvil::DescriptorType::STORAGE_TEXEL_BUFFER: is_supported = features_ptr->descriptor_binding_storage_texel_buffer_update_after_bind; break;
+            case Anvil::DescriptorType::UNIFORM_BUFFER:       is_supported = features_ptr->descriptor_binding_uniform_buffer_update_after_bind;       break;
+            case Anvil::DescriptorType::UNIFORM_TEXEL_BUFFER: is_supported = features_ptr->descriptor_binding_uniform_texel_buffer_update_after_bind; break;
+
+            default:
+            {
+                /* Dynamic buffers, input attachments and inline uniform blocks cannot use UPDATE_AFTER_BIND. */
+                is_supported = false;
+            }
+        }
+
+        if (!is_supported                                                    ||
+            in_n_slots_ptr[n_resource_type]        == 0                      ||
+            m_tables.find(current_descriptor_type) != m_tables.end() )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        new_table_data_ptr.reset(new TableData() );
+        ds_create_info_ptr = Anvil::DescriptorSetCreateInfo::create();
+
+        if (!ds_create_info_ptr->add_binding(0, /* in_binding_index */
+                                             current_descriptor_type,
+                                             in_n_slots_ptr[n_resource_type],
+                                             in_stage_flags,
+                                             binding_flags) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        if (!m_device_ptr->get_descriptor_set_layout_manager()->get_layout(ds_create_info_ptr.get(),
+                                                                          &new_table_data_ptr->layout_ptr) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        new_table_data_ptr->n_slots = in_n_slots_ptr[n_resource_type];
+
+        new_table_data_ptr->slot_allocated.resize(new_table_data_ptr->n_slots,
+                                                  false);
+        new_table_data_ptr->free_slots.reserve   (new_table_data_ptr->n_slots);
+
+        /* Hand out low slot indices first */
+        for (uint32_t n_slot = new_table_data_ptr->n_slots;
+                      n_slot > 0;
+                    --n_slot)
+        {
+            new_table_data_ptr->free_slots.push_back(n_slot - 1);
+        }
+
+        dp_create_info_ptr->set_n_descriptors_for_descriptor_type(current_descriptor_type,
+                                                                  new_table_data_ptr->n_slots);
+
+        ds_allocations.push_back(
+            Anvil::DescriptorSetAllocation(new_table_data_ptr->layout_ptr.get() )
+        );
+
+        m_tables[current_descriptor_type] = std::move(new_table_data_ptr);
+    }
+
+    m_pool_ptr = Anvil::DescriptorPool::create(std::move(dp_create_info_ptr) );
+
+    if (m_pool_ptr == nullptr)
+    {
+        anvil_assert(m_pool_ptr != nullptr);
+
+        goto end;
+    }
+
+    if (!m_pool_ptr->alloc_descriptor_sets(in_n_resource_types,
+                                          &ds_allocations.at(0),
+                                          &ds_ptrs.at(0) ) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    for (uint32_t n_resource_type = 0;
+                  n_resource_type < in_n_resource_types;
+                ++n_resource_type)
+    {
+        m_tables.at(in_resource_types_ptr[n_resource_type])->ds_ptr = std::move(ds_ptrs.at(n_resource_type) );
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::BindlessDescriptorTable::release_slot(Anvil::DescriptorType in_descriptor_type,
+                                                  uint32_t              in_n_slot)
+{
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr      = get_mutex();
+    TableData*                             table_data_ptr = get_table_data(in_descriptor_type);
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    if ( table_data_ptr                            == nullptr   ||
+         table_data_ptr->n_slots                   <= in_n_slot ||
+        !table_data_ptr->slot_allocated.at(in_n_slot) )
+    {
+        anvil_assert_fail();
+
+        return;
+    }
+
+    table_data_ptr->slot_allocated.at(in_n_slot) = false;
+
+    /* The slot's descriptor is left intact. PARTIALLY_BOUND makes this valid, as long as shaders do not access the slot. */
+    m_frames.at(m_frame_ring.get_current_frame_index() ).released_slots.push_back(
+        std::make_pair(in_descriptor_type,
+                       in_n_slot)
+    );
+}
+
+/** Please see header for specification */
+bool Anvil::BindlessDescriptorTable::update()
+{
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr = get_mutex();
+    bool                                   result    = true;
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    for (auto& current_table : m_tables)
+    {
+        result &= current_table.second->ds_ptr->update();
+    }
+
+    return result;
+}
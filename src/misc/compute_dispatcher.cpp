@@ -0,0 +1,606 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/compute_dispatcher.h"
+#include "misc/debug.h"
+#include "misc/semaphore_create_info.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+#include "wrappers/queue.h"
+#include "wrappers/semaphore.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::ComputeDispatcher::ComputeDispatcher(Anvil::BaseDevice* in_device_ptr)
+    :m_device_ptr             (in_device_ptr),
+     m_n_next_queue           (0),
+     m_use_timeline_semaphores(false)
+{
+    anvil_assert(m_device_ptr != nullptr);
+}
+
+/** Please see header for specification */
+Anvil::ComputeDispatcher::~ComputeDispatcher()
+{
+    wait_idle();
+
+    /* Command buffers must be released before the command pools they were allocated from.
+     * Member destruction order of QueueData takes care of that. */
+    m_queues.clear();
+}
+
+/** Please see header for specification */
+Anvil::ComputeDispatcherUniquePtr Anvil::ComputeDispatcher::create(Anvil::BaseDevice* in_device_ptr)
+{
+    Anvil::ComputeDispatcherUniquePtr result_ptr(nullptr,
+                                                 std::default_delete<Anvil::ComputeDispatcher>() );
+
+    result_ptr.reset(
+        new Anvil::ComputeDispatcher(in_device_ptr)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::ComputeDispatcher::JobHandle Anvil::ComputeDispatcher::dispatch(const RecordingFunction&  in_recording_function,
+                                                                       uint32_t                  in_n_dependencies,
+                                                                       const JobHandle*          in_opt_dependencies_ptr,
+                                                                       Anvil::PipelineStageFlags in_wait_stage_mask)
+{
+    Anvil::PrimaryCommandBufferUniquePtr   cmd_buffer_ptr;
+    bool                                   dependencies_met = true;
+    Anvil::FenceUniquePtr                  fence_ptr;
+    uint32_t                               n_queue        = UINT32_MAX;
+    QueueData*                             queue_data_ptr = nullptr;
+    JobHandle                              result;
+    std::vector<Anvil::Semaphore*>         wait_semaphore_ptrs;
+    std::vector<Anvil::PipelineStageFlags> wait_stage_masks;
+    std::vector<uint64_t>                  wait_values;
+
+    anvil_assert(in_recording_function   != nullptr);
+    anvil_assert(in_n_dependencies       == 0       ||
+                 in_opt_dependencies_ptr != nullptr);
+
+    /* 1. Pick the target queue. The job counts as outstanding from this point on, so that concurrent dispatch()
+     *    calls are spread across other queues while this one is being recorded. */
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        n_queue        = pick_queue();
+        queue_data_ptr = &m_queues.at(n_queue);
+
+        queue_data_ptr->n_jobs_being_recorded++;
+
+        if (!queue_data_ptr->free_cmd_buffer_ptrs.empty() )
+        {
+            cmd_buffer_ptr = std::move(queue_data_ptr->free_cmd_buffer_ptrs.back() );
+
+            queue_data_ptr->free_cmd_buffer_ptrs.pop_back();
+        }
+    }
+
+    /* 2. Record the job. Command buffers allocated from the same pool must not be recorded concurrently, hence the
+     *    per-queue lock. */
+    {
+        std::unique_lock<std::mutex> recording_lock(*queue_data_ptr->recording_mutex_ptr);
+
+        if (cmd_buffer_ptr == nullptr)
+        {
+            cmd_buffer_ptr = queue_data_ptr->command_pool_ptr->alloc_primary_level_command_buffer();
+        }
+
+        if (cmd_buffer_ptr != nullptr)
+        {
+            if (!cmd_buffer_ptr->start_recording(true,   /* one_time_submit          */
+                                                 false)) /* simultaneous_use_allowed */
+            {
+                anvil_assert_fail();
+
+                cmd_buffer_ptr.reset();
+            }
+            else
+            {
+                in_recording_function(cmd_buffer_ptr.get() );
+
+                if (!cmd_buffer_ptr->stop_recording() )
+                {
+                    anvil_assert_fail();
+
+                    cmd_buffer_ptr.reset();
+                }
+            }
+        }
+        else
+        {
+            anvil_assert(cmd_buffer_ptr != nullptr);
+        }
+    }
+
+    /* 3. Without timeline semaphores, there is no way to express the dependencies GPU-side across queues. Wait for
+     *    them to finish CPU-side. This is done without the lock held, so that other threads are not blocked. */
+    if (!m_use_timeline_semaphores &&
+         cmd_buffer_ptr != nullptr)
+    {
+        for (uint32_t n_dependency = 0;
+                      n_dependency < in_n_dependencies;
+                    ++n_dependency)
+        {
+            if (!wait_for_job(in_opt_dependencies_ptr[n_dependency]) )
+            {
+                anvil_assert_fail();
+
+                dependencies_met = false;
+                break;
+            }
+        }
+    }
+
+    /* 4. Resolve dependencies and submit the job. Values must be signalled in submission order, so the whole
+     *    step is performed under the lock. */
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        anvil_assert(queue_data_ptr->n_jobs_being_recorded > 0);
+        queue_data_ptr->n_jobs_being_recorded--;
+
+        if (cmd_buffer_ptr == nullptr ||
+            !dependencies_met)
+        {
+            goto end;
+        }
+
+        if (m_use_timeline_semaphores)
+        {
+            for (uint32_t n_dependency = 0;
+                          n_dependency < in_n_dependencies;
+                        ++n_dependency)
+            {
+                const auto& current_dependency = in_opt_dependencies_ptr[n_dependency];
+
+                if (current_dependency.value   == 0 ||
+                    current_dependency.n_queue >= static_cast<uint32_t>(m_queues.size() ))
+                {
+                    continue;
+                }
+
+                auto& dependency_queue_data = m_queues.at(current_dependency.n_queue);
+
+                anvil_assert(current_dependency.value <= dependency_queue_data.last_submitted_value);
+
+                if (current_dependency.value <= dependency_queue_data.last_completed_value)
+                {
+                    continue;
+                }
+
+                /* Only wait for the largest value requested for each queue. */
+                bool is_known = false;
+
+                for (uint32_t n_wait_semaphore = 0;
+                              n_wait_semaphore < static_cast<uint32_t>(wait_semaphore_ptrs.size() );
+                            ++n_wait_semaphore)
+                {
+                    if (wait_semaphore_ptrs.at(n_wait_semaphore) == dependency_queue_data.timeline_semaphore_ptr.get() )
+                    {
+                        wait_values.at(n_wait_semaphore) = std::max(wait_values.at(n_wait_semaphore),
+                                                                    current_dependency.value);
+                        is_known                         = true;
+
+                        break;
+                    }
+                }
+
+                if (!is_known)
+                {
+                    wait_semaphore_ptrs.push_back(dependency_queue_data.timeline_semaphore_ptr.get() );
+                    wait_stage_masks.push_back   (in_wait_stage_mask);
+                    wait_values.push_back        (current_dependency.value);
+                }
+            }
+        }
+        else
+        {
+            fence_ptr = m_device_ptr->get_fence_from_pool();
+        }
+
+        {
+            Anvil::Semaphore* signal_semaphore_ptr = queue_data_ptr->timeline_semaphore_ptr.get();
+            const uint64_t    signal_value         = queue_data_ptr->last_submitted_value + 1;
+            auto              submit_info          = Anvil::SubmitInfo::create(cmd_buffer_ptr.get(),
+                                                                               (m_use_timeline_semaphores) ? 1u : 0u,
+                                                                               (m_use_timeline_semaphores) ? &signal_semaphore_ptr : nullptr,
+                                                                               static_cast<uint32_t>(wait_semaphore_ptrs.size() ),
+                                                                               (wait_semaphore_ptrs.size() > 0) ? &wait_semaphore_ptrs.at(0) : nullptr,
+                                                                               (wait_stage_masks.size()    > 0) ? &wait_stage_masks.at   (0) : nullptr,
+                                                                               false, /* in_should_block */
+                                                                               fence_ptr.get() );
+
+            if (m_use_timeline_semaphores)
+            {
+                submit_info.set_timeline_semaphore_values(&signal_value,
+                                                          1,
+                                                          (wait_values.size() > 0) ? &wait_values.at(0) : nullptr,
+                                                          static_cast<uint32_t>(wait_values.size() ));
+            }
+
+            if (!queue_data_ptr->queue_ptr->submit(submit_info) )
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+
+            queue_data_ptr->last_submitted_value = signal_value;
+
+            result = JobHandle(n_queue,
+                               signal_value);
+
+            {
+                InFlightJob new_job;
+
+                new_job.cmd_buffer_ptr = std::move(cmd_buffer_ptr);
+                new_job.fence_ptr      = std::shared_ptr<Anvil::Fence>(std::move(fence_ptr) );
+                new_job.value          = signal_value;
+
+                queue_data_ptr->in_flight_jobs.push_back(std::move(new_job) );
+            }
+        }
+
+end:
+        if (cmd_buffer_ptr != nullptr)
+        {
+            /* Submission failed. The command buffer is reset when it is next recorded into. */
+            queue_data_ptr->free_cmd_buffer_ptrs.push_back(std::move(cmd_buffer_ptr) );
+        }
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::ComputeDispatcher::get_n_outstanding_jobs(uint32_t in_n_queue)
+{
+    std::unique_lock<std::mutex> lock      (m_mutex);
+    auto&                        queue_data(m_queues.at(in_n_queue) );
+
+    retire_completed_jobs(&queue_data);
+
+    return static_cast<uint32_t>(queue_data.in_flight_jobs.size() );
+}
+
+/** Please see header for specification */
+bool Anvil::ComputeDispatcher::init()
+{
+    Anvil::QueueFamilyType queue_family_type = Anvil::QueueFamilyType::COMPUTE;
+    uint32_t               n_queues          = m_device_ptr->get_n_queues(queue_family_type);
+    bool                   result            = false;
+
+    if (n_queues == 0)
+    {
+        queue_family_type = Anvil::QueueFamilyType::UNIVERSAL;
+        n_queues          = m_device_ptr->get_n_queues(queue_family_type);
+    }
+
+    if (n_queues == 0)
+    {
+        anvil_assert(n_queues != 0);
+
+        goto end;
+    }
+
+    m_use_timeline_semaphores = m_device_ptr->get_extension_info()->khr_timeline_semaphore();
+
+    m_queues.resize(n_queues);
+
+    for (uint32_t n_queue = 0;
+                  n_queue < n_queues;
+                ++n_queue)
+    {
+        auto& queue_data = m_queues.at(n_queue);
+
+        queue_data.queue_ptr = m_device_ptr->get_queue(queue_family_type,
+                                                       n_queue);
+
+        queue_data.recording_mutex_ptr.reset(new std::mutex() );
+
+        if (queue_data.queue_ptr == nullptr)
+        {
+            anvil_assert(queue_data.queue_ptr != nullptr);
+
+            goto end;
+        }
+
+        /* Access to the pool is synchronized by the dispatcher. */
+        queue_data.command_pool_ptr = Anvil::CommandPool::create(m_device_ptr,
+                                                                 Anvil::CommandPoolCreateFlagBits::CREATE_RESET_COMMAND_BUFFER_BIT,
+                                                                 queue_data.queue_ptr->get_queue_family_index(),
+                                                                 Anvil::MTSafety::DISABLED);
+
+        if (queue_data.command_pool_ptr == nullptr)
+        {
+            anvil_assert(queue_data.command_pool_ptr != nullptr);
+
+            goto end;
+        }
+
+        if (m_use_timeline_semaphores)
+        {
+            auto create_info_ptr = Anvil::SemaphoreCreateInfo::create(m_device_ptr);
+
+            create_info_ptr->set_semaphore_type(Anvil::SemaphoreType::TIMELINE_KHR,
+                                                0); /* in_initial_value */
+
+            queue_data.timeline_semaphore_ptr = Anvil::Semaphore::create(std::move(create_info_ptr) );
+
+            if (queue_data.timeline_semaphore_ptr == nullptr)
+            {
+                anvil_assert(queue_data.timeline_semaphore_ptr != nullptr);
+
+                goto end;
+            }
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::ComputeDispatcher::is_job_finished(const JobHandle& in_job)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (in_job.value   == 0 ||
+        in_job.n_queue >= static_cast<uint32_t>(m_queues.size() ))
+    {
+        return true;
+    }
+
+    auto& queue_data = m_queues.at(in_job.n_queue);
+
+    retire_completed_jobs(&queue_data);
+
+    return (in_job.value <= queue_data.last_completed_value);
+}
+
+/** Selects the queue with the smallest number of outstanding jobs. Ties are broken in round-robin fashion.
+ *
+ *  Must be called with m_mutex locked.
+ **/
+uint32_t Anvil::ComputeDispatcher::pick_queue()
+{
+    const uint32_t n_queues      = static_cast<uint32_t>(m_queues.size() );
+    uint32_t       result        = m_n_next_queue % n_queues;
+    uint32_t       result_n_jobs = UINT32_MAX;
+
+    for (uint32_t n_iteration = 0;
+                  n_iteration < n_queues;
+                ++n_iteration)
+    {
+        const uint32_t n_queue    = (m_n_next_queue + n_iteration) % n_queues;
+        auto&          queue_data = m_queues.at(n_queue);
+        uint32_t       n_jobs;
+
+        retire_completed_jobs(&queue_data);
+
+        n_jobs = static_cast<uint32_t>(queue_data.in_flight_jobs.size() ) + queue_data.n_jobs_being_recorded;
+
+        if (n_jobs < result_n_jobs)
+        {
+            result        = n_queue;
+            result_n_jobs = n_jobs;
+
+            if (n_jobs == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    m_n_next_queue = (result + 1) % n_queues;
+
+    return result;
+}
+
+/** Moves command buffers of jobs which have finished executing on the specified queue back to the free list.
+ *
+ *  Must be called with m_mutex locked.
+ **/
+void Anvil::ComputeDispatcher::retire_completed_jobs(QueueData* in_queue_data_ptr)
+{
+    if (in_queue_data_ptr->in_flight_jobs.empty() )
+    {
+        return;
+    }
+
+    if (m_use_timeline_semaphores)
+    {
+        uint64_t counter_value = 0;
+
+        if (!in_queue_data_ptr->timeline_semaphore_ptr->get_counter_value(&counter_value) )
+        {
+            anvil_assert_fail();
+
+            return;
+        }
+
+        in_queue_data_ptr->last_completed_value = std::max(in_queue_data_ptr->last_completed_value,
+                                                           counter_value);
+    }
+    else
+    {
+        /* Jobs submitted to the same queue need not finish in submission order, but a job only counts as finished
+         * once all earlier ones have, so that last_completed_value remains meaningful. */
+        while (!in_queue_data_ptr->in_flight_jobs.empty()             &&
+                in_queue_data_ptr->in_flight_jobs.front().fence_ptr->is_set() )
+        {
+            in_queue_data_ptr->last_completed_value = in_queue_data_ptr->in_flight_jobs.front().value;
+
+            in_queue_data_ptr->free_cmd_buffer_ptrs.push_back(std::move(in_queue_data_ptr->in_flight_jobs.front().cmd_buffer_ptr) );
+            in_queue_data_ptr->in_flight_jobs.pop_front      ();
+        }
+
+        return;
+    }
+
+    while (!in_queue_data_ptr->in_flight_jobs.empty()                                                   &&
+            in_queue_data_ptr->in_flight_jobs.front().value <= in_queue_data_ptr->last_completed_value)
+    {
+        in_queue_data_ptr->free_cmd_buffer_ptrs.push_back(std::move(in_queue_data_ptr->in_flight_jobs.front().cmd_buffer_ptr) );
+        in_queue_data_ptr->in_flight_jobs.pop_front      ();
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::ComputeDispatcher::wait_for_job(const JobHandle& in_job)
+{
+    std::vector<std::shared_ptr<Anvil::Fence> > fence_ptrs;
+    bool                                        result                 = true;
+    Anvil::Semaphore*                           timeline_semaphore_ptr = nullptr;
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        if (in_job.value   == 0 ||
+            in_job.n_queue >= static_cast<uint32_t>(m_queues.size() ))
+        {
+            return true;
+        }
+
+        auto& queue_data = m_queues.at(in_job.n_queue);
+
+        retire_completed_jobs(&queue_data);
+
+        if (in_job.value <= queue_data.last_completed_value)
+        {
+            return true;
+        }
+
+        if (m_use_timeline_semaphores)
+        {
+            timeline_semaphore_ptr = queue_data.timeline_semaphore_ptr.get();
+        }
+        else
+        {
+            /* Hold references to the fences, so that they are not returned to the device's pool while they are being
+             * waited upon without the lock held. */
+            for (const auto& current_job : queue_data.in_flight_jobs)
+            {
+                if (current_job.value > in_job.value)
+                {
+                    break;
+                }
+
+                fence_ptrs.push_back(current_job.fence_ptr);
+            }
+        }
+    }
+
+    /* Timeline semaphores live as long as the dispatcher, and fences are kept alive by the references taken above,
+     * so there is no need to block other threads while waiting. */
+    if (timeline_semaphore_ptr != nullptr)
+    {
+        result = timeline_semaphore_ptr->wait(in_job.value);
+    }
+    else
+    if (fence_ptrs.size() > 0)
+    {
+        std::vector<VkFence> fences_vk;
+        VkResult             wait_result;
+
+        fences_vk.reserve(fence_ptrs.size() );
+
+        for (const auto& current_fence_ptr : fence_ptrs)
+        {
+            fences_vk.push_back(current_fence_ptr->get_fence() );
+        }
+
+        wait_result = Anvil::Vulkan::vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                     static_cast<uint32_t>(fences_vk.size() ),
+                                                    &fences_vk.at(0),
+                                                     VK_TRUE, /* waitAll */
+                                                     UINT64_MAX);
+
+        if (!is_vk_call_successful(wait_result) )
+        {
+            anvil_assert_vk_call_succeeded(wait_result);
+
+            result = false;
+        }
+    }
+
+    if (!result)
+    {
+        anvil_assert_fail();
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        retire_completed_jobs(&m_queues.at(in_job.n_queue) );
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::ComputeDispatcher::wait_idle()
+{
+    uint32_t n_queues = 0;
+    bool     result   = true;
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        n_queues = static_cast<uint32_t>(m_queues.size() );
+    }
+
+    for (uint32_t n_queue = 0;
+                  n_queue < n_queues;
+                ++n_queue)
+    {
+        uint64_t last_submitted_value = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            last_submitted_value = m_queues.at(n_queue).last_submitted_value;
+        }
+
+        result &= wait_for_job(JobHandle(n_queue,
+                                         last_submitted_value) );
+    }
+
+    return result;
+}
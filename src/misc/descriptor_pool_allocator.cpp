@@ -0,0 +1,563 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/descriptor_pool_allocator.h"
+#include "misc/descriptor_pool_create_info.h"
+#include "misc/descriptor_set_create_info.h"
+#include "wrappers/descriptor_pool.h"
+#include "wrappers/descriptor_set.h"
+#include "wrappers/descriptor_set_layout.h"
+#include "wrappers/device.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::DescriptorPoolAllocator::DescriptorPoolAllocator(const Anvil::BaseDevice*         in_device_ptr,
+                                                        uint32_t                         in_n_sets_per_pool,
+                                                        Anvil::DescriptorPoolCreateFlags in_pool_create_flags,
+                                                        bool                             in_mt_safe)
+    :MTSafetySupportProvider(in_mt_safe),
+     m_current_pool_data_ptr(nullptr),
+     m_device_ptr           (in_device_ptr),
+     m_n_sets_allocated     (0),
+     m_n_sets_per_pool      (in_n_sets_per_pool),
+     m_pool_create_flags    (in_pool_create_flags)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::DescriptorPoolAllocator::~DescriptorPoolAllocator()
+{
+    /* Descriptor set wrappers need to be released before their parent pools. */
+    for (auto& current_pool_data_ptr : m_pool_data_ptrs)
+    {
+        current_pool_data_ptr->ds_ptrs.clear ();
+        current_pool_data_ptr->pool_ptr.reset();
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::DescriptorPoolAllocator::alloc_descriptor_sets(uint32_t                       in_n_sets,
+                                                           const DescriptorSetAllocation* in_ds_allocations_ptr,
+                                                           Anvil::DescriptorSet**         out_descriptor_sets_ptr)
+{
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr         = get_mutex();
+    DescriptorTypeToCountMap               n_descriptors_needed_map;
+    PoolData*                              new_pool_data_ptr = nullptr;
+    bool                                   result            = false;
+    VkResult                               result_vk         = VK_ERROR_INITIALIZATION_FAILED;
+
+    anvil_assert(in_n_sets               >= 1);
+    anvil_assert(in_ds_allocations_ptr   != nullptr);
+    anvil_assert(out_descriptor_sets_ptr != nullptr);
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    if (!get_n_descriptors_needed(in_n_sets,
+                                  in_ds_allocations_ptr,
+                                 &n_descriptors_needed_map) )
+    {
+        goto end;
+    }
+
+    /* Update usage statistics first, so that any pool created below accounts for this request. */
+    m_n_sets_allocated += in_n_sets;
+
+    for (const auto& current_map_entry : n_descriptors_needed_map)
+    {
+        m_n_descriptors_allocated[current_map_entry.first] += current_map_entry.second;
+    }
+
+    if (m_current_pool_data_ptr != nullptr)
+    {
+        if (alloc_from_pool(m_current_pool_data_ptr,
+                            in_n_sets,
+                            in_ds_allocations_ptr,
+                            out_descriptor_sets_ptr,
+                           &result_vk) )
+        {
+            result = true;
+
+            goto end;
+        }
+
+        /* Drivers which do not support VK_KHR_maintenance1 may report other errors if the pool is exhausted. */
+        anvil_assert(result_vk == VK_ERROR_OUT_OF_POOL_MEMORY            ||
+                     result_vk == VK_ERROR_FRAGMENTED_POOL               ||
+                     result_vk == VK_ERROR_OUT_OF_HOST_MEMORY            ||
+                     result_vk == VK_ERROR_OUT_OF_DEVICE_MEMORY);
+
+        /* The pool is going to be recycled when its last set is retired. If it holds no live sets, this is
+         * a fresh pool which is too small for the request, so recycle it right away.
+         */
+        {
+            PoolData* exhausted_pool_data_ptr = m_current_pool_data_ptr;
+
+            m_current_pool_data_ptr = nullptr;
+
+            if (exhausted_pool_data_ptr->n_sets_alive == 0)
+            {
+                recycle_pool(exhausted_pool_data_ptr);
+            }
+        }
+    }
+
+    /* Try pools available for reuse first, starting with the most recent one. A pool which cannot hold the
+     * request may still fit later requests, so it is kept for reuse. Pools are only released by trim().
+     */
+    for (uint32_t n_free_pool = static_cast<uint32_t>(m_free_pool_data_ptrs.size() );
+                  n_free_pool > 0;
+                --n_free_pool)
+    {
+        PoolData* pool_data_ptr = m_free_pool_data_ptrs.at(n_free_pool - 1);
+
+        anvil_assert(pool_data_ptr->n_sets_alive                                                      == 0 ||
+                     (m_pool_create_flags & Anvil::DescriptorPoolCreateFlagBits::FREE_DESCRIPTOR_SET_BIT) != 0);
+
+        if (alloc_from_pool(pool_data_ptr,
+                            in_n_sets,
+                            in_ds_allocations_ptr,
+                            out_descriptor_sets_ptr,
+                           &result_vk) )
+        {
+            m_free_pool_data_ptrs.erase(m_free_pool_data_ptrs.begin() + (n_free_pool - 1) );
+
+            m_current_pool_data_ptr = pool_data_ptr;
+            pool_data_ptr->is_free  = false;
+            result                  = true;
+
+            goto end;
+        }
+    }
+
+    /* Need a new pool */
+    new_pool_data_ptr = create_pool(in_n_sets,
+                                    n_descriptors_needed_map);
+
+    if (new_pool_data_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    if (!alloc_from_pool(new_pool_data_ptr,
+                         in_n_sets,
+                         in_ds_allocations_ptr,
+                         out_descriptor_sets_ptr,
+                        &result_vk) )
+    {
+        anvil_assert_vk_call_succeeded(result_vk);
+
+        make_pool_free(new_pool_data_ptr);
+
+        goto end;
+    }
+
+    m_current_pool_data_ptr = new_pool_data_ptr;
+    result                  = true;
+end:
+    return result;
+}
+
+/** Allocates @param in_n_sets descriptor sets from the pool described by @param in_pool_data_ptr.
+ *
+ *  @param out_result_vk_ptr Deref will be set to the result of the vkAllocateDescriptorSets() call.
+ *                           Must not be nullptr.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::DescriptorPoolAllocator::alloc_from_pool(PoolData*                      in_pool_data_ptr,
+                                                     uint32_t                       in_n_sets,
+                                                     const DescriptorSetAllocation* in_ds_allocations_ptr,
+                                                     Anvil::DescriptorSet**         out_descriptor_sets_ptr,
+                                                     VkResult*                      out_result_vk_ptr)
+{
+    std::vector<Anvil::DescriptorSetUniquePtr> new_ds_ptrs(in_n_sets);
+    bool                                       result     (false);
+
+    *out_result_vk_ptr = VK_ERROR_INITIALIZATION_FAILED;
+
+    if (!in_pool_data_ptr->pool_ptr->alloc_descriptor_sets(in_n_sets,
+                                                           in_ds_allocations_ptr,
+                                                          &new_ds_ptrs.at(0),
+                                                           out_result_vk_ptr) )
+    {
+        goto end;
+    }
+
+    for (uint32_t n_set = 0;
+                  n_set < in_n_sets;
+                ++n_set)
+    {
+        out_descriptor_sets_ptr[n_set] = new_ds_ptrs.at(n_set).get();
+
+        m_ds_to_pool_data_map[out_descriptor_sets_ptr[n_set] ] = in_pool_data_ptr;
+
+        in_pool_data_ptr->ds_ptrs.push_back(
+            std::move(new_ds_ptrs.at(n_set) )
+        );
+    }
+
+    in_pool_data_ptr->n_sets_alive += in_n_sets;
+    result                          = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::DescriptorPoolAllocatorUniquePtr Anvil::DescriptorPoolAllocator::create(const Anvil::BaseDevice*         in_device_ptr,
+                                                                               uint32_t                         in_n_sets_per_pool,
+                                                                               Anvil::DescriptorPoolCreateFlags in_pool_create_flags,
+                                                                               MTSafety                         in_mt_safety)
+{
+    const bool                              is_mt_safe = Anvil::Utils::convert_mt_safety_enum_to_boolean(in_mt_safety,
+                                                                                                         in_device_ptr);
+    Anvil::DescriptorPoolAllocatorUniquePtr result_ptr(nullptr,
+                                                       std::default_delete<Anvil::DescriptorPoolAllocator>() );
+
+    anvil_assert(in_device_ptr      != nullptr);
+    anvil_assert(in_n_sets_per_pool >= 1);
+
+    result_ptr.reset(
+        new Anvil::DescriptorPoolAllocator(in_device_ptr,
+                                           in_n_sets_per_pool,
+                                           in_pool_create_flags,
+                                           is_mt_safe)
+    );
+
+    return result_ptr;
+}
+
+/** Creates a new pool, sized for n_sets_per_pool sets of the average composition observed so far.
+ *
+ *  @param in_n_sets                   Number of sets the pool must be able to hold, at minimum.
+ *  @param in_n_descriptors_needed_map Number of descriptors of each type the pool must be able to hold, at minimum.
+ *
+ *  @return Descriptor of the new pool, or nullptr if the pool could not be created.
+ **/
+Anvil::DescriptorPoolAllocator::PoolData* Anvil::DescriptorPoolAllocator::create_pool(uint32_t                        in_n_sets,
+                                                                                      const DescriptorTypeToCountMap& in_n_descriptors_needed_map)
+{
+    const uint32_t            n_max_sets         = std::max(m_n_sets_per_pool,
+                                                            in_n_sets);
+    auto                      dp_create_info_ptr = Anvil::DescriptorPoolCreateInfo::create(m_device_ptr,
+                                                                                           n_max_sets,
+                                                                                           m_pool_create_flags,
+                                                                                           Anvil::MTSafety::DISABLED);
+    std::unique_ptr<PoolData> new_pool_data_ptr  (new PoolData() );
+    PoolData*                 result_ptr         = nullptr;
+
+    set_pool_descriptor_counts(n_max_sets,
+                               m_n_sets_allocated,
+                               m_n_descriptors_allocated,
+                               in_n_descriptors_needed_map,
+                               dp_create_info_ptr.get() );
+
+    new_pool_data_ptr->pool_ptr = Anvil::DescriptorPool::create(std::move(dp_create_info_ptr) );
+
+    if (new_pool_data_ptr->pool_ptr == nullptr)
+    {
+        anvil_assert(new_pool_data_ptr->pool_ptr != nullptr);
+
+        goto end;
+    }
+
+    result_ptr = new_pool_data_ptr.get();
+
+    m_pool_data_ptrs.push_back(
+        std::move(new_pool_data_ptr)
+    );
+
+end:
+    return result_ptr;
+}
+
+/** Frees descriptor set @param in_ds_ptr, allocated from the pool described by @param in_pool_data_ptr, and
+ *  releases its wrapper. The pool must have been created with FREE_DESCRIPTOR_SET_BIT.
+ **/
+void Anvil::DescriptorPoolAllocator::free_set(PoolData*             in_pool_data_ptr,
+                                              Anvil::DescriptorSet* in_ds_ptr)
+{
+    auto ds_iterator = std::find_if(in_pool_data_ptr->ds_ptrs.begin(),
+                                    in_pool_data_ptr->ds_ptrs.end  (),
+                                    [in_ds_ptr](const Anvil::DescriptorSetUniquePtr& in_current_ds_ptr)
+                                    {
+                                        return in_current_ds_ptr.get() == in_ds_ptr;
+                                    });
+
+    if (ds_iterator == in_pool_data_ptr->ds_ptrs.end() )
+    {
+        anvil_assert(ds_iterator != in_pool_data_ptr->ds_ptrs.end() );
+
+        return;
+    }
+
+    if (!in_pool_data_ptr->pool_ptr->free_descriptor_sets(1, /* in_n_sets */
+                                                         &(*ds_iterator) ))
+    {
+        anvil_assert_fail();
+    }
+
+    /* Order of the wrappers is irrelevant, so avoid shifting the remaining ones. */
+    std::swap(*ds_iterator,
+              in_pool_data_ptr->ds_ptrs.back() );
+
+    in_pool_data_ptr->ds_ptrs.pop_back();
+}
+
+/** Please see header for specification */
+bool Anvil::DescriptorPoolAllocator::get_n_descriptors_needed(uint32_t                       in_n_sets,
+                                                              const DescriptorSetAllocation* in_ds_allocations_ptr,
+                                                              DescriptorTypeToCountMap*      out_n_descriptors_needed_map_ptr)
+{
+    bool result = false;
+
+    for (uint32_t n_set = 0;
+                  n_set < in_n_sets;
+                ++n_set)
+    {
+        const Anvil::DescriptorSetCreateInfo* ds_create_info_ptr                = nullptr;
+        uint32_t                              n_ds_bindings                     = 0;
+        uint32_t                              variable_descriptor_binding_index = UINT32_MAX;
+
+        if (in_ds_allocations_ptr[n_set].ds_layout_ptr == nullptr)
+        {
+            /* Gap sets use the dummy layout, which holds no bindings */
+            continue;
+        }
+
+        ds_create_info_ptr = in_ds_allocations_ptr[n_set].ds_layout_ptr->get_create_info();
+        n_ds_bindings      = ds_create_info_ptr->get_n_bindings();
+
+        ds_create_info_ptr->contains_variable_descriptor_count_binding(&variable_descriptor_binding_index);
+
+        for (uint32_t n_ds_binding = 0;
+                      n_ds_binding < n_ds_bindings;
+                    ++n_ds_binding)
+        {
+            uint32_t              ds_binding_array_size = 0;
+            uint32_t              ds_binding_index      = UINT32_MAX;
+            Anvil::DescriptorType ds_binding_type       = Anvil::DescriptorType::UNKNOWN;
+
+            ds_create_info_ptr->get_binding_properties_by_index_number(n_ds_binding,
+                                                                      &ds_binding_index,
+                                                                      &ds_binding_type,
+                                                                      &ds_binding_array_size,
+                                                                       nullptr,  /* out_opt_stage_flags_ptr                */
+                                                                       nullptr,  /* out_opt_immutable_samplers_enabled_ptr */
+                                                                       nullptr); /* out_opt_flags_ptr                      */
+
+            if (ds_binding_type == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK)
+            {
+                anvil_assert(ds_binding_type != Anvil::DescriptorType::INLINE_UNIFORM_BLOCK);
+
+                goto end;
+            }
+
+            if (ds_binding_index == variable_descriptor_binding_index)
+            {
+                ds_binding_array_size = in_ds_allocations_ptr[n_set].n_variable_descriptor_bindings;
+            }
+
+            (*out_n_descriptors_needed_map_ptr)[ds_binding_type] += ds_binding_array_size;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Makes the pool described by @param in_pool_data_ptr available for reuse, unless it is the current one or
+ *  it is already available.
+ **/
+void Anvil::DescriptorPoolAllocator::make_pool_free(PoolData* in_pool_data_ptr)
+{
+    if (in_pool_data_ptr != m_current_pool_data_ptr &&
+       !in_pool_data_ptr->is_free)
+    {
+        in_pool_data_ptr->is_free = true;
+
+        m_free_pool_data_ptrs.push_back(in_pool_data_ptr);
+    }
+}
+
+/** Resets the pool described by @param in_pool_data_ptr and releases wrappers of all sets allocated from it.
+ *  Unless the pool is the current one, it is then made available for reuse.
+ **/
+void Anvil::DescriptorPoolAllocator::recycle_pool(PoolData* in_pool_data_ptr)
+{
+    anvil_assert(in_pool_data_ptr->n_sets_alive == 0);
+
+    if (!in_pool_data_ptr->pool_ptr->reset(static_cast<uint32_t>(in_pool_data_ptr->ds_ptrs.size() ),
+                                           (in_pool_data_ptr->ds_ptrs.size() > 0) ? &in_pool_data_ptr->ds_ptrs.at(0)
+                                                                                  : nullptr) )
+    {
+        anvil_assert_fail();
+    }
+
+    in_pool_data_ptr->ds_ptrs.clear();
+
+    make_pool_free(in_pool_data_ptr);
+}
+
+/** Please see header for specification */
+void Anvil::DescriptorPoolAllocator::retire_descriptor_sets(uint32_t                     in_n_sets,
+                                                            Anvil::DescriptorSet* const* in_descriptor_sets_ptr)
+{
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr  = get_mutex();
+
+    anvil_assert(in_descriptor_sets_ptr != nullptr);
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    for (uint32_t n_set = 0;
+                  n_set < in_n_sets;
+                ++n_set)
+    {
+        auto      ds_iterator   = m_ds_to_pool_data_map.find(in_descriptor_sets_ptr[n_set]);
+        PoolData* pool_data_ptr = nullptr;
+
+        if (ds_iterator == m_ds_to_pool_data_map.end() )
+        {
+            anvil_assert(ds_iterator != m_ds_to_pool_data_map.end() );
+
+            continue;
+        }
+
+        pool_data_ptr = ds_iterator->second;
+
+        m_ds_to_pool_data_map.erase(ds_iterator);
+
+        anvil_assert(pool_data_ptr->n_sets_alive > 0);
+
+        --pool_data_ptr->n_sets_alive;
+
+        if ((m_pool_create_flags & Anvil::DescriptorPoolCreateFlagBits::FREE_DESCRIPTOR_SET_BIT) != 0)
+        {
+            /* The space taken by the set can be reused right away. */
+            free_set(pool_data_ptr,
+                     in_descriptor_sets_ptr[n_set]);
+
+            make_pool_free(pool_data_ptr);
+        }
+        else
+        if (pool_data_ptr->n_sets_alive == 0)
+        {
+            recycle_pool(pool_data_ptr);
+        }
+    }
+}
+
+/** Please see header for specification */
+void Anvil::DescriptorPoolAllocator::set_pool_descriptor_counts(uint32_t                             in_n_max_sets,
+                                                                uint64_t                             in_n_sets_allocated,
+                                                                const DescriptorTypeToTotalCountMap& in_n_descriptors_allocated,
+                                                                const DescriptorTypeToCountMap&      in_n_descriptors_needed_map,
+                                                                Anvil::DescriptorPoolCreateInfo*     in_dp_create_info_ptr)
+{
+    anvil_assert(in_n_sets_allocated   > 0);
+    anvil_assert(in_dp_create_info_ptr != nullptr);
+
+    for (const auto& current_map_entry : in_n_descriptors_allocated)
+    {
+        const auto needed_map_iterator = in_n_descriptors_needed_map.find(current_map_entry.first);
+        uint64_t   n_descriptors       = (current_map_entry.second * in_n_max_sets + in_n_sets_allocated - 1) / in_n_sets_allocated;
+
+        if (needed_map_iterator != in_n_descriptors_needed_map.end() )
+        {
+            n_descriptors = std::max(n_descriptors,
+                                     static_cast<uint64_t>(needed_map_iterator->second) );
+        }
+
+        in_dp_create_info_ptr->set_n_descriptors_for_descriptor_type(current_map_entry.first,
+                                                                     static_cast<uint32_t>(n_descriptors) );
+    }
+}
+
+/** Please see header for specification */
+uint32_t Anvil::DescriptorPoolAllocator::trim(uint32_t in_n_free_pools_to_keep)
+{
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr          = get_mutex();
+    uint32_t                               n_free_pool        = 0;
+    uint32_t                               n_pools_released   = 0;
+    uint32_t                               n_pools_to_release = 0;
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    if (m_free_pool_data_ptrs.size() <= in_n_free_pools_to_keep)
+    {
+        return 0;
+    }
+
+    n_pools_to_release = static_cast<uint32_t>(m_free_pool_data_ptrs.size() ) - in_n_free_pools_to_keep;
+
+    /* Free pools are kept in the order they became available, so the pools recycled the longest time ago come first.
+     * Pools created with FREE_DESCRIPTOR_SET_BIT may become available while still holding live sets. These are kept.
+     */
+    while (n_free_pool      < static_cast<uint32_t>(m_free_pool_data_ptrs.size() ) &&
+           n_pools_released < n_pools_to_release)
+    {
+        PoolData* pool_data_ptr = m_free_pool_data_ptrs.at(n_free_pool);
+
+        if (pool_data_ptr->n_sets_alive > 0)
+        {
+            ++n_free_pool;
+
+            continue;
+        }
+
+        anvil_assert(pool_data_ptr->ds_ptrs.size() == 0);
+
+        m_free_pool_data_ptrs.erase(m_free_pool_data_ptrs.begin() + n_free_pool);
+
+        m_pool_data_ptrs.erase(std::find_if(m_pool_data_ptrs.begin(),
+                                            m_pool_data_ptrs.end  (),
+                                            [pool_data_ptr](const std::unique_ptr<PoolData>& in_pool_data_ptr)
+                                            {
+                                                return in_pool_data_ptr.get() == pool_data_ptr;
+                                            }) );
+
+        ++n_pools_released;
+    }
+
+    return n_pools_released;
+}
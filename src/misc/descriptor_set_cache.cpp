@@ -0,0 +1,805 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/descriptor_pool_allocator.h"
+#include "misc/descriptor_set_cache.h"
+#include "misc/descriptor_set_create_info.h"
+#include "misc/object_tracker.h"
+#include "wrappers/descriptor_set.h"
+#include "wrappers/descriptor_set_layout.h"
+#include "wrappers/descriptor_set_layout_manager.h"
+#include "wrappers/device.h"
+#include <functional>
+
+
+/** Mixes @param in_value into the hash stored under @param inout_hash_ptr. */
+static void combine_hash(size_t* inout_hash_ptr,
+                         size_t  in_value)
+{
+    *inout_hash_ptr ^= in_value + 0x9e3779b9 + (*inout_hash_ptr << 6) + (*inout_hash_ptr >> 2);
+}
+
+/** Please see header for specification */
+Anvil::DescriptorSetCache::Bindings::Bindings()
+    :m_hash(0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+void Anvil::DescriptorSetCache::Bindings::add_item(BindingIndex                                                    in_binding_index,
+                                                   BindingElementIndex                                             in_element_index,
+                                                   Anvil::DescriptorType                                           in_descriptor_type,
+                                                   const Anvil::DescriptorSet::BufferBindingElement&               in_element)
+{
+    Item new_item;
+
+    new_item.binding_index   = in_binding_index;
+    new_item.descriptor_type = in_descriptor_type;
+    new_item.element_index   = in_element_index;
+    new_item.image_layout    = Anvil::ImageLayout::UNKNOWN;
+    new_item.object_ptr      = in_element.buffer_ptr;
+    new_item.sampler_ptr     = nullptr;
+    new_item.size            = in_element.size;
+    new_item.start_offset    = in_element.start_offset;
+
+    add_item(new_item);
+}
+
+/** Please see header for specification */
+void Anvil::DescriptorSetCache::Bindings::add_item(BindingIndex                                                    in_binding_index,
+                                                   BindingElementIndex                                             in_element_index,
+                                                   Anvil::DescriptorType                                           in_descriptor_type,
+                                                   const Anvil::DescriptorSet::CombinedImageSamplerBindingElement& in_element)
+{
+    Item new_item;
+
+    new_item.binding_index   = in_binding_index;
+    new_item.descriptor_type = in_descriptor_type;
+    new_item.element_index   = in_element_index;
+    new_item.image_layout    = in_element.image_layout;
+    new_item.object_ptr      = in_element.image_view_ptr;
+    new_item.sampler_ptr     = in_element.sampler_ptr;
+    new_item.size            = 0;
+    new_item.start_offset    = 0;
+
+    add_item(new_item);
+}
+
+/** Please see header for specification */
+void Anvil::DescriptorSetCache::Bindings::add_item(BindingIndex                                                    in_binding_index,
+                                                   BindingElementIndex                                             in_element_index,
+                                                   Anvil::DescriptorType                                           in_descriptor_type,
+                                                   const Anvil::DescriptorSet::ImageBindingElement&                in_element)
+{
+    Item new_item;
+
+    new_item.binding_index   = in_binding_index;
+    new_item.descriptor_type = in_descriptor_type;
+    new_item.element_index   = in_element_index;
+    new_item.image_layout    = in_element.image_layout;
+    new_item.object_ptr      = in_element.image_view_ptr;
+    new_item.sampler_ptr     = nullptr;
+    new_item.size            = 0;
+    new_item.start_offset    = 0;
+
+    add_item(new_item);
+}
+
+/** Please see header for specification */
+void Anvil::DescriptorSetCache::Bindings::add_item(BindingIndex                                                    in_binding_index,
+                                                   BindingElementIndex                                             in_element_index,
+                                                   Anvil::DescriptorType                                           in_descriptor_type,
+                                                   const Anvil::DescriptorSet::SamplerBindingElement&              in_element)
+{
+    Item new_item;
+
+    new_item.binding_index   = in_binding_index;
+    new_item.descriptor_type = in_descriptor_type;
+    new_item.element_index   = in_element_index;
+    new_item.image_layout    = Anvil::ImageLayout::UNKNOWN;
+    new_item.object_ptr      = nullptr;
+    new_item.sampler_ptr     = in_element.sampler_ptr;
+    new_item.size            = 0;
+    new_item.start_offset    = 0;
+
+    add_item(new_item);
+}
+
+/** Please see header for specification */
+void Anvil::DescriptorSetCache::Bindings::add_item(BindingIndex                                                    in_binding_index,
+                                                   BindingElementIndex                                             in_element_index,
+                                                   Anvil::DescriptorType                                           in_descriptor_type,
+                                                   const Anvil::DescriptorSet::TexelBufferBindingElement&          in_element)
+{
+    Item new_item;
+
+    new_item.binding_index   = in_binding_index;
+    new_item.descriptor_type = in_descriptor_type;
+    new_item.element_index   = in_element_index;
+    new_item.image_layout    = Anvil::ImageLayout::UNKNOWN;
+    new_item.object_ptr      = in_element.buffer_view_ptr;
+    new_item.sampler_ptr     = nullptr;
+    new_item.size            = 0;
+    new_item.start_offset    = 0;
+
+    add_item(new_item);
+}
+
+/** Please see header for specification */
+void Anvil::DescriptorSetCache::Bindings::add_item(const Item& in_item)
+{
+    combine_hash(&m_hash, std::hash<uint32_t>    ()(in_item.binding_index) );
+    combine_hash(&m_hash, std::hash<uint32_t>    ()(in_item.element_index) );
+    combine_hash(&m_hash, std::hash<uint32_t>    ()(static_cast<uint32_t>(in_item.descriptor_type) ));
+    combine_hash(&m_hash, std::hash<uint32_t>    ()(static_cast<uint32_t>(in_item.image_layout) ));
+    combine_hash(&m_hash, std::hash<void*>       ()(in_item.object_ptr) );
+    combine_hash(&m_hash, std::hash<void*>       ()(in_item.sampler_ptr) );
+    combine_hash(&m_hash, std::hash<VkDeviceSize>()(in_item.size) );
+    combine_hash(&m_hash, std::hash<VkDeviceSize>()(in_item.start_offset) );
+
+    m_items.push_back(in_item);
+}
+
+/** Please see header for specification */
+void Anvil::DescriptorSetCache::Bindings::clear()
+{
+    m_hash = 0;
+
+    m_items.clear();
+}
+
+/** Please see header for specification */
+bool Anvil::DescriptorSetCache::Bindings::operator==(const Bindings& in_bindings) const
+{
+    return (m_hash  == in_bindings.m_hash &&
+            m_items == in_bindings.m_items);
+}
+
+/** Please see header for specification */
+Anvil::DescriptorSetCache::DescriptorSetCache(const Anvil::BaseDevice* in_device_ptr,
+                                              uint32_t                 in_n_max_unused_frames,
+                                              uint32_t                 in_n_sets_per_pool,
+                                              bool                     in_mt_safe)
+    :MTSafetySupportProvider(in_mt_safe),
+     m_device_ptr           (in_device_ptr),
+     m_n_current_frame      (0),
+     m_n_hits               (0),
+     m_n_max_unused_frames  (in_n_max_unused_frames),
+     m_n_misses             (0),
+     m_n_sets_per_pool      (in_n_sets_per_pool)
+{
+    update_subscriptions(true);
+}
+
+/** Please see header for specification */
+Anvil::DescriptorSetCache::~DescriptorSetCache()
+{
+    update_subscriptions(false);
+
+    /* Sets need to be released before their parent pools and layouts. */
+    while (m_sets.size() > 0)
+    {
+        evict(m_sets.begin() );
+    }
+
+    m_allocator_ptr.reset                  ();
+    m_update_after_bind_allocator_ptr.reset();
+
+    m_layouts.clear();
+}
+
+/** Assigns binding items described by @param in_bindings to descriptor set @param in_ds_ptr. **/
+bool Anvil::DescriptorSetCache::assign_bindings(const Bindings&       in_bindings,
+                                                Anvil::DescriptorSet* in_ds_ptr) const
+{
+    bool result = true;
+
+    for (const auto& current_item : in_bindings.m_items)
+    {
+        const Anvil::BindingElementArrayRange element_range(current_item.element_index,
+                                                            1); /* NumberOfBindingElements */
+
+        switch (current_item.descriptor_type)
+        {
+            case Anvil::DescriptorType::COMBINED_IMAGE_SAMPLER:
+            {
+                const Anvil::DescriptorSet::CombinedImageSamplerBindingElement element(current_item.image_layout,
+                                                                                       static_cast<Anvil::ImageView*>(current_item.object_ptr),
+                                                                                       current_item.sampler_ptr);
+
+                result &= in_ds_ptr->set_binding_array_items(current_item.binding_index,
+                                                             element_range,
+                                                            &element);
+
+                break;
+            }
+
+            case Anvil::DescriptorType::INPUT_ATTACHMENT:
+            {
+                const Anvil::DescriptorSet::InputAttachmentBindingElement element(current_item.image_layout,
+                                                                                  static_cast<Anvil::ImageView*>(current_item.object_ptr) );
+
+                result &= in_ds_ptr->set_binding_array_items(current_item.binding_index,
+                                                             element_range,
+                                                            &element);
+
+                break;
+            }
+
+            case Anvil::DescriptorType::SAMPLED_IMAGE:
+            {
+                const Anvil::DescriptorSet::SampledImageBindingElement element(current_item.image_layout,
+                                                                               static_cast<Anvil::ImageView*>(current_item.object_ptr) );
+
+                result &= in_ds_ptr->set_binding_array_items(current_item.binding_index,
+                                                             element_range,
+                                                            &element);
+
+                break;
+            }
+
+            case Anvil::DescriptorType::SAMPLER:
+            {
+                const Anvil::DescriptorSet::SamplerBindingElement element(current_item.sampler_ptr);
+
+                result &= in_ds_ptr->set_binding_array_items(current_item.binding_index,
+                                                             element_range,
+                                                            &element);
+
+                break;
+            }
+
+            case Anvil::DescriptorType::STORAGE_BUFFER:
+            {
+                const Anvil::DescriptorSet::StorageBufferBindingElement element(static_cast<Anvil::Buffer*>(current_item.object_ptr),
+                                                                                current_item.start_offset,
+                                                                                current_item.size);
+
+                result &= in_ds_ptr->set_binding_array_items(current_item.binding_index,
+                                                             element_range,
+                                                            &element);
+
+                break;
+            }
+
+            case Anvil::DescriptorType::STORAGE_BUFFER_DYNAMIC:
+            {
+                const Anvil::DescriptorSet::DynamicStorageBufferBindingElement element(static_cast<Anvil::Buffer*>(current_item.object_ptr),
+                                                                                       current_item.start_offset,
+                                                                                       current_item.size);
+
+                result &= in_ds_ptr->set_binding_array_items(current_item.binding_index,
+                                                             element_range,
+                                                            &element);
+
+                break;
+            }
+
+            case Anvil::DescriptorType::STORAGE_IMAGE:
+            {
+                const Anvil::DescriptorSet::StorageImageBindingElement element(current_item.image_layout,
+                                                                               static_cast<Anvil::ImageView*>(current_item.object_ptr) );
+
+                result &= in_ds_ptr->set_binding_array_items(current_item.binding_index,
+                                                             element_range,
+                                                            &element);
+
+                break;
+            }
+
+            case Anvil::DescriptorType::STORAGE_TEXEL_BUFFER:
+            {
+                const Anvil::DescriptorSet::StorageTexelBufferBindingElement element(static_cast<Anvil::BufferView*>(current_item.object_ptr) );
+
+                result &= in_ds_ptr->set_binding_array_items(current_item.binding_index,
+                                                             element_range,
+                                                            &element);
+
+                break;
+            }
+
+            case Anvil::DescriptorType::UNIFORM_BUFFER:
+            {
+                const Anvil::DescriptorSet::UniformBufferBindingElement element(static_cast<Anvil::Buffer*>(current_item.object_ptr),
+                                                                                current_item.start_offset,
+                                                                                current_item.size);
+
+                result &= in_ds_ptr->set_binding_array_items(current_item.binding_index,
+                                                             element_range,
+                                                            &element);
+
+                break;
+            }
+
+            case Anvil::DescriptorType::UNIFORM_BUFFER_DYNAMIC:
+            {
+                const Anvil::DescriptorSet::DynamicUniformBufferBindingElement element(static_cast<Anvil::Buffer*>(current_item.object_ptr),
+                                                                                       current_item.start_offset,
+                                                                                       current_item.size);
+
+                result &= in_ds_ptr->set_binding_array_items(current_item.binding_index,
+                                                             element_range,
+                                                            &element);
+
+                break;
+            }
+
+            case Anvil::DescriptorType::UNIFORM_TEXEL_BUFFER:
+            {
+                const Anvil::DescriptorSet::UniformTexelBufferBindingElement element(static_cast<Anvil::BufferView*>(current_item.object_ptr) );
+
+                result &= in_ds_ptr->set_binding_array_items(current_item.binding_index,
+                                                             element_range,
+                                                            &element);
+
+                break;
+            }
+
+            default:
+            {
+                anvil_assert_fail();
+
+                result = false;
+            }
+        }
+    }
+
+    if (result)
+    {
+        result = in_ds_ptr->update();
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::DescriptorSetCache::begin_frame()
+{
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr  = get_mutex();
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    ++m_n_current_frame;
+
+    /* m_sets is kept in MRU order, so the least recently used sets sit at the back of the list. */
+    while (m_sets.size() > 0                                                            &&
+           m_n_current_frame - m_sets.back().last_used_frame > m_n_max_unused_frames)
+    {
+        evict(std::prev(m_sets.end() ));
+    }
+
+    return true;
+}
+
+/** Please see header for specification */
+Anvil::DescriptorSetCacheUniquePtr Anvil::DescriptorSetCache::create(const Anvil::BaseDevice* in_device_ptr,
+                                                                     uint32_t                 in_n_max_unused_frames,
+                                                                     uint32_t                 in_n_sets_per_pool,
+                                                                     MTSafety                 in_mt_safety)
+{
+    const bool                         is_mt_safe = Anvil::Utils::convert_mt_safety_enum_to_boolean(in_mt_safety,
+                                                                                                    in_device_ptr);
+    Anvil::DescriptorSetCacheUniquePtr result_ptr(nullptr,
+                                                  std::default_delete<Anvil::DescriptorSetCache>() );
+
+    anvil_assert(in_device_ptr      != nullptr);
+    anvil_assert(in_n_sets_per_pool >= 1);
+
+    result_ptr.reset(
+        new Anvil::DescriptorSetCache(in_device_ptr,
+                                      in_n_max_unused_frames,
+                                      in_n_sets_per_pool,
+                                      is_mt_safe)
+    );
+
+    return result_ptr;
+}
+
+/** Frees the descriptor set held by the specified cache item and removes the item from the cache. */
+void Anvil::DescriptorSetCache::evict(CachedSets::iterator in_set_iterator)
+{
+    auto hash_range = m_set_iterators.equal_range(in_set_iterator->hash);
+
+    for (auto hash_iterator  = hash_range.first;
+              hash_iterator != hash_range.second;
+            ++hash_iterator)
+    {
+        if (hash_iterator->second == in_set_iterator)
+        {
+            m_set_iterators.erase(hash_iterator);
+
+            break;
+        }
+    }
+
+    update_object_reference_counts(in_set_iterator->bindings,
+                                   false); /* in_should_increment */
+
+    in_set_iterator->allocator_ptr->retire_descriptor_sets(1, /* in_n_sets */
+                                                          &in_set_iterator->ds_ptr);
+
+    m_sets.erase(in_set_iterator);
+}
+
+/** Please see header for specification */
+Anvil::DescriptorSet* Anvil::DescriptorSetCache::get_descriptor_set(const Anvil::DescriptorSetLayout* in_layout_ptr,
+                                                                    const Bindings&                   in_bindings)
+{
+    Anvil::DescriptorSetAllocation         allocation;
+    size_t                                 hash            = std::hash<const void*>()(in_layout_ptr);
+    LayoutData*                            layout_data_ptr = nullptr;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr       = get_mutex();
+    Anvil::DescriptorSet*                  new_ds_ptr      = nullptr;
+    Anvil::DescriptorSet*                  result_ptr      = nullptr;
+
+    anvil_assert(in_layout_ptr != nullptr);
+
+    combine_hash(&hash,
+                 in_bindings.get_hash() );
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    {
+        auto hash_range = m_set_iterators.equal_range(hash);
+
+        for (auto hash_iterator  = hash_range.first;
+                  hash_iterator != hash_range.second;
+                ++hash_iterator)
+        {
+            auto set_iterator = hash_iterator->second;
+
+            if (set_iterator->layout_ptr == in_layout_ptr &&
+                set_iterator->bindings   == in_bindings)
+            {
+                /* Cache hit. Move the set to the front of the MRU list. */
+                m_sets.splice(m_sets.begin(),
+                              m_sets,
+                              set_iterator);
+
+                set_iterator->last_used_frame = m_n_current_frame;
+                result_ptr                    = set_iterator->ds_ptr;
+
+                m_n_hits++;
+
+                goto end;
+            }
+        }
+    }
+
+    /* Cache miss. Allocate and write a new set. Push descriptor layouts cannot be used to allocate sets. */
+    if ((in_layout_ptr->get_create_info()->get_create_flags() & Anvil::DescriptorSetLayoutCreateFlagBits::PUSH_DESCRIPTOR_BIT_KHR) != 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    layout_data_ptr = get_layout_data(in_layout_ptr);
+
+    if (layout_data_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    allocation = (in_layout_ptr->get_create_info()->contains_variable_descriptor_count_binding() ) ? Anvil::DescriptorSetAllocation(in_layout_ptr,
+                                                                                                                                   layout_data_ptr->n_variable_descriptor_count_binding_size)
+                                                                                                  : Anvil::DescriptorSetAllocation(in_layout_ptr);
+
+    if (!layout_data_ptr->allocator_ptr->alloc_descriptor_sets(1, /* in_n_sets */
+                                                              &allocation,
+                                                              &new_ds_ptr) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    m_sets.push_front(CachedSet() );
+
+    {
+        auto& new_set = m_sets.front();
+
+        new_set.allocator_ptr   = layout_data_ptr->allocator_ptr;
+        new_set.bindings        = in_bindings;
+        new_set.ds_ptr          = new_ds_ptr;
+        new_set.hash            = hash;
+        new_set.last_used_frame = m_n_current_frame;
+        new_set.layout_ptr      = in_layout_ptr;
+
+        m_set_iterators.insert(
+            std::make_pair(hash,
+                           m_sets.begin() )
+        );
+
+        update_object_reference_counts(in_bindings,
+                                       true); /* in_should_increment */
+
+        if (!assign_bindings(in_bindings,
+                             new_set.ds_ptr) )
+        {
+            anvil_assert_fail();
+
+            evict(m_sets.begin() );
+
+            goto end;
+        }
+
+        result_ptr = new_set.ds_ptr;
+    }
+
+    m_n_misses++;
+end:
+    return result_ptr;
+}
+
+/** Returns allocation properties of layout @param in_layout_ptr, creating them if necessary.
+ *
+ *  @return Requested layout descriptor, or nullptr if the layout is not supported.
+ **/
+Anvil::DescriptorSetCache::LayoutData* Anvil::DescriptorSetCache::get_layout_data(const Anvil::DescriptorSetLayout* in_layout_ptr)
+{
+    const Anvil::DescriptorSetCreateInfo* ds_create_info_ptr               = in_layout_ptr->get_create_info();
+    bool                                  is_update_after_bind             = false;
+    auto                                  layout_iterator                  = m_layouts.find(in_layout_ptr);
+    uint32_t                              n_ds_bindings                    = 0;
+    std::unique_ptr<LayoutData>           new_layout_data_ptr;
+    LayoutData*                           result_ptr                       = nullptr;
+    uint32_t                              variable_descriptor_binding_size = 0;
+
+    if (layout_iterator != m_layouts.end() )
+    {
+        result_ptr = layout_iterator->second.get();
+
+        goto end;
+    }
+
+    new_layout_data_ptr.reset(new LayoutData() );
+
+    /* Hold a reference to the layout, so that it outlives the sets allocated with it. */
+    if (!m_device_ptr->get_descriptor_set_layout_manager()->get_layout(ds_create_info_ptr,
+                                                                       &new_layout_data_ptr->layout_reference_ptr) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    n_ds_bindings = ds_create_info_ptr->get_n_bindings();
+
+    ds_create_info_ptr->contains_variable_descriptor_count_binding(nullptr, /* out_opt_binding_index_ptr */
+                                                                   &variable_descriptor_binding_size);
+
+    for (uint32_t n_ds_binding = 0;
+                  n_ds_binding < n_ds_bindings;
+                ++n_ds_binding)
+    {
+        Anvil::DescriptorBindingFlags ds_binding_flags;
+        Anvil::DescriptorType         ds_binding_type  = Anvil::DescriptorType::UNKNOWN;
+
+        ds_create_info_ptr->get_binding_properties_by_index_number(n_ds_binding,
+                                                                   nullptr,  /* out_opt_binding_index_ptr              */
+                                                                  &ds_binding_type,
+                                                                   nullptr,  /* out_opt_descriptor_array_size_ptr      */
+                                                                   nullptr,  /* out_opt_stage_flags_ptr                */
+                                                                   nullptr,  /* out_opt_immutable_samplers_enabled_ptr */
+                                                                  &ds_binding_flags);
+
+        if (ds_binding_type == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK)
+        {
+            anvil_assert(ds_binding_type != Anvil::DescriptorType::INLINE_UNIFORM_BLOCK);
+
+            goto end;
+        }
+
+        if ((ds_binding_flags & Anvil::DescriptorBindingFlagBits::UPDATE_AFTER_BIND_BIT) != 0)
+        {
+            is_update_after_bind = true;
+        }
+    }
+
+    /* Sets are evicted one by one, so they are freed individually rather than pinning their pools until every
+     * set in there has been evicted. Sets using update-after-bind bindings must come from pools created with
+     * the matching flag.
+     */
+    if (is_update_after_bind)
+    {
+        if (m_update_after_bind_allocator_ptr == nullptr)
+        {
+            m_update_after_bind_allocator_ptr = Anvil::DescriptorPoolAllocator::create(m_device_ptr,
+                                                                                       m_n_sets_per_pool,
+                                                                                       Anvil::DescriptorPoolCreateFlagBits::FREE_DESCRIPTOR_SET_BIT |
+                                                                                       Anvil::DescriptorPoolCreateFlagBits::UPDATE_AFTER_BIND_BIT,
+                                                                                       Anvil::MTSafety::DISABLED);
+        }
+
+        new_layout_data_ptr->allocator_ptr = m_update_after_bind_allocator_ptr.get();
+    }
+    else
+    {
+        if (m_allocator_ptr == nullptr)
+        {
+            m_allocator_ptr = Anvil::DescriptorPoolAllocator::create(m_device_ptr,
+                                                                     m_n_sets_per_pool,
+                                                                     Anvil::DescriptorPoolCreateFlagBits::FREE_DESCRIPTOR_SET_BIT,
+                                                                     Anvil::MTSafety::DISABLED);
+        }
+
+        new_layout_data_ptr->allocator_ptr = m_allocator_ptr.get();
+    }
+
+    if (new_layout_data_ptr->allocator_ptr == nullptr)
+    {
+        anvil_assert(new_layout_data_ptr->allocator_ptr != nullptr);
+
+        goto end;
+    }
+
+    new_layout_data_ptr->n_variable_descriptor_count_binding_size = variable_descriptor_binding_size;
+    result_ptr                                                    = new_layout_data_ptr.get();
+
+    m_layouts[in_layout_ptr] = std::move(new_layout_data_ptr);
+end:
+    return result_ptr;
+}
+
+/** Evicts all cached sets which refer to the wrapper instance which is about to be released.
+ *
+ *  @param in_callback_arg_ptr OnObjectAboutToBeUnregisteredCallbackArgument instance.
+ **/
+void Anvil::DescriptorSetCache::on_object_about_to_be_unregistered(CallbackArgument* in_callback_arg_ptr)
+{
+    const auto                             callback_arg_ptr = dynamic_cast<Anvil::OnObjectAboutToBeUnregisteredCallbackArgument*>(in_callback_arg_ptr);
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
+    auto                                   mutex_ptr        = get_mutex();
+    const void*                            object_ptr       = nullptr;
+
+    anvil_assert(callback_arg_ptr != nullptr);
+
+    object_ptr = callback_arg_ptr->object_raw_ptr;
+
+    if (mutex_ptr != nullptr)
+    {
+        mutex_lock = std::move(
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
+        );
+    }
+
+    if (m_n_object_references.find(object_ptr) == m_n_object_references.end() )
+    {
+        return;
+    }
+
+    for (auto set_iterator  = m_sets.begin();
+              set_iterator != m_sets.end();
+             )
+    {
+        auto current_set_iterator = set_iterator++;
+        bool should_evict         = false;
+
+        for (const auto& current_item : current_set_iterator->bindings.m_items)
+        {
+            if (current_item.object_ptr  == object_ptr ||
+                current_item.sampler_ptr == object_ptr)
+            {
+                should_evict = true;
+
+                break;
+            }
+        }
+
+        if (should_evict)
+        {
+            evict(current_set_iterator);
+        }
+    }
+
+    anvil_assert(m_n_object_references.find(object_ptr) == m_n_object_references.end() );
+}
+
+/** Updates m_n_object_references to account for a set with bindings @param in_bindings being added to
+ *  (@param in_should_increment is true) or removed from (false) the cache.
+ **/
+void Anvil::DescriptorSetCache::update_object_reference_counts(const Bindings& in_bindings,
+                                                               bool            in_should_increment)
+{
+    for (const auto& current_item : in_bindings.m_items)
+    {
+        const void* object_ptrs[] =
+        {
+            current_item.object_ptr,
+            current_item.sampler_ptr
+        };
+
+        for (const auto current_object_ptr : object_ptrs)
+        {
+            if (current_object_ptr == nullptr)
+            {
+                continue;
+            }
+
+            if (in_should_increment)
+            {
+                m_n_object_references[current_object_ptr]++;
+            }
+            else
+            {
+                auto reference_iterator = m_n_object_references.find(current_object_ptr);
+
+                anvil_assert(reference_iterator != m_n_object_references.end() );
+
+                if (--reference_iterator->second == 0)
+                {
+                    m_n_object_references.erase(reference_iterator);
+                }
+            }
+        }
+    }
+}
+
+/** Subscribes to (@param in_should_init is true) or unsubscribes from (false) object tracker notifications
+ *  about releases of objects which can be bound to cached sets.
+ **/
+void Anvil::DescriptorSetCache::update_subscriptions(bool in_should_init)
+{
+    static const Anvil::ObjectTrackerCallbackID callback_ids[] =
+    {
+        OBJECT_TRACKER_CALLBACK_ID_ON_BUFFER_OBJECT_ABOUT_TO_BE_UNREGISTERED,
+        OBJECT_TRACKER_CALLBACK_ID_ON_BUFFER_VIEW_OBJECT_ABOUT_TO_BE_UNREGISTERED,
+        OBJECT_TRACKER_CALLBACK_ID_ON_IMAGE_VIEW_OBJECT_ABOUT_TO_BE_UNREGISTERED,
+        OBJECT_TRACKER_CALLBACK_ID_ON_SAMPLER_OBJECT_ABOUT_TO_BE_UNREGISTERED
+    };
+
+    auto object_tracker_ptr                      = Anvil::ObjectTracker::get();
+    auto on_object_about_to_be_unregistered_func = std::bind(&DescriptorSetCache::on_object_about_to_be_unregistered,
+                                                             this,
+                                                             std::placeholders::_1);
+
+    for (const auto current_callback_id : callback_ids)
+    {
+        if (in_should_init)
+        {
+            object_tracker_ptr->register_for_callbacks(current_callback_id,
+                                                       on_object_about_to_be_unregistered_func,
+                                                       this);
+        }
+        else
+        {
+            object_tracker_ptr->unregister_from_callbacks(current_callback_id,
+                                                          on_object_about_to_be_unregistered_func,
+                                                          this);
+        }
+    }
+}
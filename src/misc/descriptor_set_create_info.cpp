@@ -24,10 +24,12 @@
 #include "misc/struct_chainer.h"
 #include "wrappers/device.h"
 #include "wrappers/sampler.h"
+#include <algorithm>
 
 /** Please see header for specification */
-Anvil::DescriptorSetCreateInfo::DescriptorSetCreateInfo()
-    :m_n_variable_descriptor_count_binding   (UINT32_MAX),
+Anvil::DescriptorSetCreateInfo::DescriptorSetCreateInfo(const Anvil::DescriptorSetLayoutCreateFlags& in_create_flags)
+    :m_create_flags                          (in_create_flags),
+     m_n_variable_descriptor_count_binding   (UINT32_MAX),
      m_variable_descriptor_count_binding_size(0)
 {
     /* Stub */
@@ -47,10 +49,19 @@ bool Anvil::DescriptorSetCreateInfo::add_binding(uint32_t
                                                  const Anvil::DescriptorBindingFlags& in_flags,
                                                  const Anvil::Sampler* const*         in_immutable_sampler_ptrs)
 {
-    bool result = false;
+    auto binding_iterator = std::lower_bound(m_bindings.begin(),
+                                             m_bindings.end  (),
+                                             in_binding_index,
+                                             [](const Binding& in_binding,
+                                                BindingIndex   in_binding_index)
+                                             {
+                                                 return in_binding.binding_index < in_binding_index;
+                                             });
+    bool result           = false;
 
     /* Make sure the binding is not already defined */
-    if (m_bindings.find(in_binding_index) != m_bindings.end() )
+    if (binding_iterator                != m_bindings.end() &&
+        binding_iterator->binding_index == in_binding_index)
     {
         anvil_assert_fail();
 
@@ -74,6 +85,18 @@ bool Anvil::DescriptorSetCreateInfo::add_binding(uint32_t
         anvil_assert((in_descriptor_array_size % 4) == 0);
     }
 
+    /* Dynamic buffer descriptors cannot be pushed. */
+    if ((m_create_flags & Anvil::DescriptorSetLayoutCreateFlagBits::PUSH_DESCRIPTOR_BIT_KHR) != 0)
+    {
+        if (in_descriptor_type == Anvil::DescriptorType::STORAGE_BUFFER_DYNAMIC ||
+            in_descriptor_type == Anvil::DescriptorType::UNIFORM_BUFFER_DYNAMIC)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
     if ((in_flags & Anvil::DescriptorBindingFlagBits::VARIABLE_DESCRIPTOR_COUNT_BIT) != 0)
     {
         if (m_n_variable_descriptor_count_binding != UINT32_MAX)
@@ -90,11 +113,13 @@ bool Anvil::DescriptorSetCreateInfo::add_binding(uint32_t
 
     /* Add a new binding entry and mark the layout as dirty, so that it is re-baked next time
      * the user calls the getter func */
-    m_bindings[in_binding_index] = Binding(in_descriptor_array_size,
-                                           in_descriptor_type,
-                                           in_stage_flags,
-                                           in_immutable_sampler_ptrs,
-                                           in_flags);
+    m_bindings.insert(binding_iterator,
+                      Binding(in_binding_index,
+                              in_descriptor_array_size,
+                              in_descriptor_type,
+                              in_stage_flags,
+                              in_immutable_sampler_ptrs,
+                              in_flags) );
 
     result  = true;
 end:
@@ -102,13 +127,13 @@ end:
 }
 
 /** Please see header for specification */
-Anvil::DescriptorSetCreateInfoUniquePtr Anvil::DescriptorSetCreateInfo::create()
+Anvil::DescriptorSetCreateInfoUniquePtr Anvil::DescriptorSetCreateInfo::create(const Anvil::DescriptorSetLayoutCreateFlags& in_create_flags)
 {
     Anvil::DescriptorSetCreateInfoUniquePtr result_ptr(nullptr,
                                                        std::default_delete<Anvil::DescriptorSetCreateInfo>() );
 
     result_ptr.reset(
-        new Anvil::DescriptorSetCreateInfo()
+        new Anvil::DescriptorSetCreateInfo(in_create_flags)
     );
 
     return result_ptr;
@@ -135,16 +160,24 @@ std::unique_ptr<Anvil::DescriptorSetLayoutCreateInfoContainer> Anvil::Descriptor
         goto end;
     }
 
+    if ((m_create_flags & Anvil::DescriptorSetLayoutCreateFlagBits::PUSH_DESCRIPTOR_BIT_KHR) != 0 &&
+        !in_device_ptr->get_extension_info()->khr_push_descriptor() )
+    {
+        /* Push descriptor set layouts are only available on implementations that report support for
+         * VK_KHR_push_descriptor extension!
+         */
+        anvil_assert(in_device_ptr->get_extension_info()->khr_push_descriptor() );
+
+        result_ptr.reset();
+        goto end;
+    }
+
     /* Count the number of immutable samplers defined. This is needed because if sampler_items is reallocated
      * after we start building the VkSampler array contents, all previously initialized VkDescriptorSetLayoutBinding
      * instances will start referring to invalid sampler arrays.
      */
-    for (auto binding_iterator  = m_bindings.begin();
-              binding_iterator != m_bindings.end();
-            ++binding_iterator)
+    for (const auto& binding_data : m_bindings)
     {
-        const auto& binding_data = binding_iterator->second;
-
         n_samplers_defined += static_cast<uint32_t>(binding_data.immutable_samplers.size() );
     }
 
@@ -156,9 +189,9 @@ std::unique_ptr<Anvil::DescriptorSetLayoutCreateInfoContainer> Anvil::Descriptor
         n_bindings_defined = static_cast<uint32_t>(m_bindings.size() );
     }
     else
-    for (auto binding : m_bindings)
+    for (const auto& binding : m_bindings)
     {
-        if (binding.second.descriptor_array_size > 0)
+        if (binding.descriptor_array_size > 0)
         {
             ++n_bindings_defined;
         }
@@ -171,7 +204,7 @@ std::unique_ptr<Anvil::DescriptorSetLayoutCreateInfoContainer> Anvil::Descriptor
         VkDescriptorSetLayoutCreateInfo create_info;
 
         create_info.bindingCount = n_bindings_defined;
-        create_info.flags        = 0;
+        create_info.flags        = m_create_flags.get_vk();
         create_info.pNext        = nullptr;
         create_info.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 
@@ -181,9 +214,9 @@ std::unique_ptr<Anvil::DescriptorSetLayoutCreateInfoContainer> Anvil::Descriptor
                       binding_iterator != m_bindings.end();
                     ++binding_iterator, ++n_binding)
             {
-                const auto&                   binding_data  = binding_iterator->second;
+                const auto&                   binding_data  = *binding_iterator;
                 VkDescriptorBindingFlagsEXT   binding_flags = 0;
-                const BindingIndex&           binding_index = binding_iterator->first;
+                const BindingIndex&           binding_index = binding_iterator->binding_index;
                 VkDescriptorSetLayoutBinding& binding_vk    = result_ptr->binding_info_items.at(n_binding);
 
                 if (binding_data.descriptor_array_size == 0)
@@ -217,26 +250,26 @@ std::unique_ptr<Anvil::DescriptorSetLayoutCreateInfoContainer> Anvil::Descriptor
                     binding_vk.pImmutableSamplers = nullptr;
                 }
 
-                if ((binding_iterator->second.flags & Anvil::DescriptorBindingFlagBits::UPDATE_AFTER_BIND_BIT) != 0)
+                if ((binding_data.flags & Anvil::DescriptorBindingFlagBits::UPDATE_AFTER_BIND_BIT) != 0)
                 {
                     binding_flags                     |= VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT;
                     create_info.flags                 |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
                     should_chain_binding_flags_struct  = true;
                 }
 
-                if ((binding_iterator->second.flags & Anvil::DescriptorBindingFlagBits::UPDATE_UNUSED_WHILE_PENDING_BIT) != 0)
+                if ((binding_data.flags & Anvil::DescriptorBindingFlagBits::UPDATE_UNUSED_WHILE_PENDING_BIT) != 0)
                 {
                     binding_flags                     |= VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
                     should_chain_binding_flags_struct  = true;
                 }
 
-                if ((binding_iterator->second.flags & Anvil::DescriptorBindingFlagBits::PARTIALLY_BOUND_BIT) != 0)
+                if ((binding_data.flags & Anvil::DescriptorBindingFlagBits::PARTIALLY_BOUND_BIT) != 0)
                 {
                     binding_flags                     |= VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT;
                     should_chain_binding_flags_struct  = true;
                 }
 
-                if ((binding_iterator->second.flags & Anvil::DescriptorBindingFlagBits::VARIABLE_DESCRIPTOR_COUNT_BIT) != 0)
+                if ((binding_data.flags & Anvil::DescriptorBindingFlagBits::VARIABLE_DESCRIPTOR_COUNT_BIT) != 0)
                 {
                     binding_flags                     |= VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT;
                     should_chain_binding_flags_struct  = true;
@@ -290,6 +323,38 @@ end:
     return result_ptr;
 }
 
+/** Returns a pointer to the binding at index @param in_binding_index, or nullptr if no such binding has been added. */
+const Anvil::DescriptorSetCreateInfo::Binding* Anvil::DescriptorSetCreateInfo::get_binding(BindingIndex in_binding_index) const
+{
+    const Binding* result_ptr = nullptr;
+
+    /* Bindings usually use consecutive indices starting at zero, in which case no search is needed. */
+    if (in_binding_index                           < m_bindings.size() &&
+        m_bindings[in_binding_index].binding_index == in_binding_index)
+    {
+        result_ptr = &m_bindings[in_binding_index];
+    }
+    else
+    {
+        auto binding_iterator = std::lower_bound(m_bindings.begin(),
+                                                 m_bindings.end  (),
+                                                 in_binding_index,
+                                                 [](const Binding& in_binding,
+                                                    BindingIndex   in_binding_index)
+                                                 {
+                                                     return in_binding.binding_index < in_binding_index;
+                                                 });
+
+        if (binding_iterator                != m_bindings.end() &&
+            binding_iterator->binding_index == in_binding_index)
+        {
+            result_ptr = &(*binding_iterator);
+        }
+    }
+
+    return result_ptr;
+}
+
 /** Please see header for specification */
 bool Anvil::DescriptorSetCreateInfo::get_binding_properties_by_binding_index(uint32_t                       in_binding_index,
                                                                              Anvil::DescriptorType*         out_opt_descriptor_type_ptr,
@@ -298,37 +363,37 @@ bool Anvil::DescriptorSetCreateInfo::get_binding_properties_by_binding_index(uin
                                                                              bool*                          out_opt_immutable_samplers_enabled_ptr,
                                                                              Anvil::DescriptorBindingFlags* out_opt_flags_ptr) const
 {
-    auto binding_iterator = m_bindings.find(in_binding_index);
-    bool result           = false;
+    const Binding* binding_ptr = get_binding(in_binding_index);
+    bool           result      = false;
 
-    if (binding_iterator == m_bindings.end() )
+    if (binding_ptr == nullptr)
     {
         goto end;
     }
 
     if (out_opt_descriptor_array_size_ptr != nullptr)
     {
-        *out_opt_descriptor_array_size_ptr = binding_iterator->second.descriptor_array_size;
+        *out_opt_descriptor_array_size_ptr = binding_ptr->descriptor_array_size;
     }
 
     if (out_opt_descriptor_type_ptr != nullptr)
     {
-        *out_opt_descriptor_type_ptr = binding_iterator->second.descriptor_type;
+        *out_opt_descriptor_type_ptr = binding_ptr->descriptor_type;
     }
 
     if (out_opt_immutable_samplers_enabled_ptr != nullptr)
     {
-        *out_opt_immutable_samplers_enabled_ptr = (binding_iterator->second.immutable_samplers.size() != 0);
+        *out_opt_immutable_samplers_enabled_ptr = (binding_ptr->immutable_samplers.size() != 0);
     }
 
     if (out_opt_stage_flags_ptr != nullptr)
     {
-        *out_opt_stage_flags_ptr = binding_iterator->second.stage_flags;
+        *out_opt_stage_flags_ptr = binding_ptr->stage_flags;
     }
 
     if (out_opt_flags_ptr != nullptr)
     {
-        *out_opt_flags_ptr = binding_iterator->second.flags;
+        *out_opt_flags_ptr = binding_ptr->flags;
     }
 
     result = true;
@@ -346,56 +411,48 @@ bool Anvil::DescriptorSetCreateInfo::get_binding_properties_by_index_number(uint
                                                                             bool*                          out_opt_immutable_samplers_enabled_ptr,
                                                                             Anvil::DescriptorBindingFlags* out_opt_flags_ptr) const
 {
-    auto binding_iterator = m_bindings.begin();
-    bool result           = false;
+    const Binding* binding_ptr = nullptr;
+    bool           result      = false;
 
     if (m_bindings.size() <= in_n_binding)
     {
         goto end;
     }
 
-    for (uint32_t n_current_binding = 0;
-                  n_current_binding < in_n_binding;
-                ++n_current_binding)
+    binding_ptr = &m_bindings.at(in_n_binding);
+
+    if (out_opt_binding_index_ptr != nullptr)
     {
-        binding_iterator ++;
+        *out_opt_binding_index_ptr = binding_ptr->binding_index;
     }
 
-    if (binding_iterator != m_bindings.end() )
+    if (out_opt_descriptor_array_size_ptr != nullptr)
     {
-        if (out_opt_binding_index_ptr != nullptr)
-        {
-            *out_opt_binding_index_ptr = binding_iterator->first;
-        }
-
-        if (out_opt_descriptor_array_size_ptr != nullptr)
-        {
-            *out_opt_descriptor_array_size_ptr = binding_iterator->second.descriptor_array_size;
-        }
-
-        if (out_opt_descriptor_type_ptr != nullptr)
-        {
-            *out_opt_descriptor_type_ptr = binding_iterator->second.descriptor_type;
-        }
+        *out_opt_descriptor_array_size_ptr = binding_ptr->descriptor_array_size;
+    }
 
-        if (out_opt_immutable_samplers_enabled_ptr != nullptr)
-        {
-            *out_opt_immutable_samplers_enabled_ptr = (binding_iterator->second.immutable_samplers.size() != 0);
-        }
+    if (out_opt_descriptor_type_ptr != nullptr)
+    {
+        *out_opt_descriptor_type_ptr = binding_ptr->descriptor_type;
+    }
 
-        if (out_opt_stage_flags_ptr != nullptr)
-        {
-            *out_opt_stage_flags_ptr = binding_iterator->second.stage_flags;
-        }
+    if (out_opt_immutable_samplers_enabled_ptr != nullptr)
+    {
+        *out_opt_immutable_samplers_enabled_ptr = (binding_ptr->immutable_samplers.size() != 0);
+    }
 
-        if (out_opt_flags_ptr != nullptr)
-        {
-            *out_opt_flags_ptr = binding_iterator->second.flags;
-        }
+    if (out_opt_stage_flags_ptr != nullptr)
+    {
+        *out_opt_stage_flags_ptr = binding_ptr->stage_flags;
+    }
 
-        result = true;
+    if (out_opt_flags_ptr != nullptr)
+    {
+        *out_opt_flags_ptr = binding_ptr->flags;
     }
 
+    result = true;
+
 end:
     return result;
 }
@@ -424,6 +481,7 @@ end:
 bool Anvil::DescriptorSetCreateInfo::operator==(const Anvil::DescriptorSetCreateInfo& in_ds) const
 {
     return (m_bindings                               == in_ds.m_bindings                               &&
+            m_create_flags                           == in_ds.m_create_flags                           &&
             m_n_variable_descriptor_count_binding    == in_ds.m_n_variable_descriptor_count_binding    &&
             m_variable_descriptor_count_binding_size == in_ds.m_variable_descriptor_count_binding_size);
 }
\ No newline at end of file
@@ -0,0 +1,307 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/draw_batcher.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/memory_block.h"
+#include <algorithm>
+#include <cstring>
+
+
+/** Please see header for specification */
+Anvil::DrawBatcher::DrawBatcher(Anvil::BaseDevice* in_device_ptr,
+                                uint32_t           in_max_n_draws,
+                                uint32_t           in_n_frames_in_flight)
+    :m_counts_region_offset (0),
+     m_device_ptr           (in_device_ptr),
+     m_frame_region_size    (0),
+     m_mapped_data_ptr      (nullptr),
+     m_max_n_draws          (in_max_n_draws),
+     m_max_n_draws_per_call (1),
+     m_n_current_frame      (0),
+     m_n_draws              (0),
+     m_n_frames_in_flight   (in_n_frames_in_flight),
+     m_n_used_counts        (0),
+     m_next_draw_offset     (0),
+     m_use_count_entrypoints(false)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+Anvil::DrawBatcher::~DrawBatcher()
+{
+    if (m_mapped_data_ptr != nullptr)
+    {
+        m_buffer_ptr->get_memory_block(0)->unmap();
+
+        m_mapped_data_ptr = nullptr;
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::DrawBatcher::add_draw(uint32_t in_vertex_count,
+                                  uint32_t in_instance_count,
+                                  uint32_t in_first_vertex,
+                                  uint32_t in_first_instance)
+{
+    VkDrawIndirectCommand command;
+
+    command.firstInstance = in_first_instance;
+    command.firstVertex   = in_first_vertex;
+    command.instanceCount = in_instance_count;
+    command.vertexCount   = in_vertex_count;
+
+    return add_draw_data(false, /* in_indexed */
+                        &command,
+                         sizeof(command) );
+}
+
+/** Please see header for specification */
+bool Anvil::DrawBatcher::add_draw_data(bool        in_indexed,
+                                       const void* in_data_ptr,
+                                       uint32_t    in_data_size)
+{
+    bool result = false;
+
+    if (m_n_draws == m_max_n_draws)
+    {
+        anvil_assert(m_n_draws < m_max_n_draws);
+
+        goto end;
+    }
+
+    if (m_batches.size()         == 0          ||
+        m_batches.back().indexed != in_indexed)
+    {
+        m_batches.push_back(
+            Batch(in_indexed,
+                  m_next_draw_offset)
+        );
+    }
+
+    memcpy(m_mapped_data_ptr + m_n_current_frame * m_frame_region_size + m_next_draw_offset,
+           in_data_ptr,
+           in_data_size);
+
+    m_batches.back().n_draws++;
+
+    m_n_draws++;
+    m_next_draw_offset += in_data_size;
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::DrawBatcher::add_draw_indexed(uint32_t in_index_count,
+                                          uint32_t in_instance_count,
+                                          uint32_t in_first_index,
+                                          int32_t  in_vertex_offset,
+                                          uint32_t in_first_instance)
+{
+    VkDrawIndexedIndirectCommand command;
+
+    command.firstIndex    = in_first_index;
+    command.firstInstance = in_first_instance;
+    command.indexCount    = in_index_count;
+    command.instanceCount = in_instance_count;
+    command.vertexOffset  = in_vertex_offset;
+
+    return add_draw_data(true, /* in_indexed */
+                        &command,
+                         sizeof(command) );
+}
+
+/** Please see header for specification */
+void Anvil::DrawBatcher::begin_frame()
+{
+    anvil_assert(m_batches.size() == 0);
+
+    m_n_current_frame  = (m_n_current_frame + 1) % m_n_frames_in_flight;
+    m_n_draws          = 0;
+    m_n_used_counts    = 0;
+    m_next_draw_offset = 0;
+}
+
+/** Please see header for specification */
+Anvil::DrawBatcherUniquePtr Anvil::DrawBatcher::create(Anvil::BaseDevice* in_device_ptr,
+                                                       uint32_t           in_max_n_draws,
+                                                       uint32_t           in_n_frames_in_flight)
+{
+    Anvil::DrawBatcherUniquePtr result_ptr(nullptr,
+                                           std::default_delete<Anvil::DrawBatcher>() );
+
+    anvil_assert(in_device_ptr         != nullptr);
+    anvil_assert(in_max_n_draws        >  0);
+    anvil_assert(in_n_frames_in_flight >= 1);
+
+    result_ptr.reset(
+        new Anvil::DrawBatcher(in_device_ptr,
+                               in_max_n_draws,
+                               in_n_frames_in_flight)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::DrawBatcher::flush(Anvil::CommandBufferBase* in_cmd_buffer_ptr)
+{
+    const VkDeviceSize frame_offset = m_n_current_frame * m_frame_region_size;
+    bool               result       = true;
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    for (const auto& current_batch : m_batches)
+    {
+        const uint32_t stride = (current_batch.indexed) ? sizeof(VkDrawIndexedIndirectCommand)
+                                                        : sizeof(VkDrawIndirectCommand);
+
+        for (uint32_t n_first_draw = 0;
+                      n_first_draw < current_batch.n_draws && result;
+                      n_first_draw += m_max_n_draws_per_call)
+        {
+            const uint32_t     n_draws     = std::min(current_batch.n_draws - n_first_draw,
+                                                      m_max_n_draws_per_call);
+            const VkDeviceSize draw_offset = frame_offset + current_batch.start_offset + n_first_draw * stride;
+
+            if (m_use_count_entrypoints)
+            {
+                const VkDeviceSize count_offset = frame_offset + m_counts_region_offset + m_n_used_counts * sizeof(uint32_t);
+
+                anvil_assert(m_n_used_counts < m_max_n_draws);
+
+                memcpy(m_mapped_data_ptr + count_offset,
+                      &n_draws,
+                       sizeof(n_draws) );
+
+                m_n_used_counts++;
+
+                result = (current_batch.indexed) ? in_cmd_buffer_ptr->record_draw_indexed_indirect_count_KHR(m_buffer_ptr.get(),
+                                                                                                             draw_offset,
+                                                                                                             m_buffer_ptr.get(),
+                                                                                                             count_offset,
+                                                                                                             n_draws,
+                                                                                                             stride)
+                                                 : in_cmd_buffer_ptr->record_draw_indirect_count_KHR        (m_buffer_ptr.get(),
+                                                                                                             draw_offset,
+                                                                                                             m_buffer_ptr.get(),
+                                                                                                             count_offset,
+                                                                                                             n_draws,
+                                                                                                             stride);
+            }
+            else
+            {
+                result = (current_batch.indexed) ? in_cmd_buffer_ptr->record_draw_indexed_indirect(m_buffer_ptr.get(),
+                                                                                                   draw_offset,
+                                                                                                   n_draws,
+                                                                                                   stride)
+                                                 : in_cmd_buffer_ptr->record_draw_indirect        (m_buffer_ptr.get(),
+                                                                                                   draw_offset,
+                                                                                                   n_draws,
+                                                                                                   stride);
+            }
+        }
+    }
+
+    m_batches.clear();
+
+    return result;
+}
+
+/** Initializes the indirect buffer.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::DrawBatcher::init()
+{
+    const auto& features          = m_device_ptr->get_physical_device_features();
+    const auto& limits            = m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits;
+    bool        result            = false;
+    void*       mapped_data_ptr   = nullptr;
+
+    if (features.core_vk1_0_features_ptr->multi_draw_indirect)
+    {
+        m_max_n_draws_per_call  = limits.max_draw_indirect_count;
+        m_use_count_entrypoints = m_device_ptr->get_extension_info()->khr_draw_indirect_count();
+    }
+
+    /* Each frame region holds draw parameters, followed by draw counts used by the count entrypoints. Draw parameter
+     * structures are tightly packed and their sizes are multiples of 4, which satisfies the offset alignment
+     * requirements of both the draw and the count arguments. */
+    m_counts_region_offset = m_max_n_draws * sizeof(VkDrawIndexedIndirectCommand);
+    m_frame_region_size    = m_counts_region_offset + ((m_use_count_entrypoints) ? m_max_n_draws * sizeof(uint32_t)
+                                                                                  : 0);
+
+    {
+        auto create_info_ptr = Anvil::BufferCreateInfo::create_alloc(m_device_ptr,
+                                                                     m_frame_region_size * m_n_frames_in_flight,
+                                                                     Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
+                                                                     Anvil::SharingMode::EXCLUSIVE,
+                                                                     Anvil::BufferCreateFlagBits::NONE,
+                                                                     Anvil::BufferUsageFlagBits::INDIRECT_BUFFER_BIT,
+                                                                     Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT | Anvil::MemoryFeatureFlagBits::HOST_COHERENT_BIT);
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        m_buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+    }
+
+    if (m_buffer_ptr == nullptr)
+    {
+        anvil_assert(m_buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    /* The buffer stays mapped for the lifetime of the batcher. Since its memory is host-coherent, no explicit
+     * flushes are needed after draw parameters are written. */
+    if (!m_buffer_ptr->get_memory_block(0)->map(0, /* in_start_offset */
+                                                m_frame_region_size * m_n_frames_in_flight,
+                                               &mapped_data_ptr) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    m_mapped_data_ptr = static_cast<uint8_t*>(mapped_data_ptr);
+    m_n_current_frame = m_n_frames_in_flight - 1;
+
+    result = true;
+end:
+    return result;
+}
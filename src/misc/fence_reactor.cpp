@@ -0,0 +1,411 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/fence_create_info.h"
+#include "misc/fence_reactor.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+#include "wrappers/queue.h"
+#include <algorithm>
+
+/* Timeout used by the reactor thread when waiting on fences. The thread is woken up with the wake fence whenever
+ * it needs to pick up new callbacks or terminate, so there is no need to poll.
+ */
+static const uint64_t g_wait_timeout_ns = UINT64_MAX;
+
+
+/** Please see header for specification */
+Anvil::FenceReactor::FenceReactor(const Anvil::BaseDevice* in_device_ptr)
+    :m_device_ptr       (in_device_ptr),
+     m_has_failed       (false),
+     m_is_dispatching   (false),
+     m_is_wake_pending  (false),
+     m_is_wake_submitted(false),
+     m_is_waiting       (false),
+     m_should_terminate (false),
+     m_wake_queue_ptr   (nullptr)
+{
+    static const Anvil::QueueFamilyType wake_queue_family_types[] =
+    {
+        /* Prefer queues which are least likely to be busy with the application's own submissions. */
+        Anvil::QueueFamilyType::TRANSFER,
+        Anvil::QueueFamilyType::COMPUTE,
+        Anvil::QueueFamilyType::UNIVERSAL,
+    };
+
+    anvil_assert(m_device_ptr != nullptr);
+
+    for (const auto& current_queue_family_type : wake_queue_family_types)
+    {
+        if (m_device_ptr->get_n_queues(current_queue_family_type) > 0)
+        {
+            m_wake_queue_ptr = m_device_ptr->get_queue(current_queue_family_type,
+                                                       0); /* in_n_queue */
+
+            break;
+        }
+    }
+
+    m_wake_fence_ptr = Anvil::Fence::create(
+        Anvil::FenceCreateInfo::create(m_device_ptr,
+                                       false) /* in_create_signalled */
+    );
+
+    anvil_assert(m_wake_fence_ptr != nullptr);
+    anvil_assert(m_wake_queue_ptr != nullptr);
+
+    m_reactor_thread = std::thread(&FenceReactor::reactor_thread_entrypoint,
+                                   this);
+}
+
+/** Please see header for specification */
+Anvil::FenceReactor::~FenceReactor()
+{
+    bool should_wake = false;
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_should_terminate = true;
+        should_wake        = should_wake_reactor_thread();
+    }
+
+    m_pending_callbacks_cv.notify_all();
+
+    if (should_wake)
+    {
+        wake_reactor_thread();
+    }
+
+    m_reactor_thread.join();
+
+    /* The wake fence may still be in use by a wake-up submission the thread has not waited for. */
+    if (m_is_wake_pending)
+    {
+        VkFence wake_fence_vk = m_wake_fence_ptr->get_fence();
+
+        Anvil::Vulkan::vkWaitForFences(m_device_ptr->get_device_vk(),
+                                       1, /* fenceCount */
+                                      &wake_fence_vk,
+                                       VK_TRUE, /* waitAll */
+                                       g_wait_timeout_ns);
+    }
+
+    /* Flush callbacks of any work that has finished in the meantime. */
+    dispatch_callbacks(static_cast<uint32_t>(m_pending_callbacks.size() ),
+                       true); /* in_should_check_fences */
+
+    m_pending_callbacks.clear();
+}
+
+/** Please see header for specification */
+void Anvil::FenceReactor::add_callback(Anvil::Fence*              in_fence_ptr,
+                                       CompletionCallbackFunction in_callback_function)
+{
+    add_pending_callback(
+        PendingCallback(in_fence_ptr,
+                        Anvil::FenceUniquePtr(),
+                        std::move(in_callback_function) )
+    );
+}
+
+/** Please see header for specification */
+void Anvil::FenceReactor::add_callback(Anvil::FenceUniquePtr      in_fence_ptr,
+                                       CompletionCallbackFunction in_callback_function)
+{
+    Anvil::Fence* fence_ptr = in_fence_ptr.get();
+
+    add_pending_callback(
+        PendingCallback(fence_ptr,
+                        std::move(in_fence_ptr),
+                        std::move(in_callback_function) )
+    );
+}
+
+/** Stores a new pending callback and wakes up the reactor thread.
+ *
+ *  If the reactor has stopped waiting on fences because of an error, the callback is dispatched right away
+ *  from the calling thread instead.
+ **/
+void Anvil::FenceReactor::add_pending_callback(PendingCallback in_callback)
+{
+    bool should_wake = false;
+
+    anvil_assert(in_callback.callback_function != nullptr);
+    anvil_assert(in_callback.fence_ptr         != nullptr);
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        if (m_has_failed)
+        {
+            lock.unlock();
+
+            in_callback.callback_function();
+
+            return;
+        }
+
+        m_pending_callbacks.push_back(std::move(in_callback) );
+
+        should_wake = should_wake_reactor_thread();
+    }
+
+    m_pending_callbacks_cv.notify_one();
+
+    if (should_wake)
+    {
+        wake_reactor_thread();
+    }
+}
+
+/** Creates a new FenceReactor instance. Please see header for specification */
+Anvil::FenceReactorUniquePtr Anvil::FenceReactor::create(const Anvil::BaseDevice* in_device_ptr)
+{
+    Anvil::FenceReactorUniquePtr result_ptr(nullptr,
+                                            std::default_delete<Anvil::FenceReactor>() );
+
+    result_ptr.reset(
+        new Anvil::FenceReactor(in_device_ptr)
+    );
+
+    return result_ptr;
+}
+
+/** Moves callbacks out of the pending list and dispatches them.
+ *
+ *  Callbacks are called without the reactor lock held, so that other threads can keep registering
+ *  new callbacks in the meantime.
+ *
+ *  @param in_n_callbacks_to_check Number of pending callbacks, counting from the oldest one, to consider.
+ *                                 Callbacks registered later are left intact.
+ *  @param in_should_check_fences  true to only dispatch callbacks whose fences are signalled. false to
+ *                                 dispatch all considered callbacks, regardless of their fence status.
+ **/
+void Anvil::FenceReactor::dispatch_callbacks(uint32_t in_n_callbacks_to_check,
+                                             bool     in_should_check_fences)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        auto callbacks_to_check_end_iterator   = m_pending_callbacks.begin() + std::min(in_n_callbacks_to_check,
+                                                                                        static_cast<uint32_t>(m_pending_callbacks.size() ));
+        auto first_completed_callback_iterator = m_pending_callbacks.begin();
+
+        if (in_should_check_fences)
+        {
+            first_completed_callback_iterator = std::stable_partition(m_pending_callbacks.begin(),
+                                                                      callbacks_to_check_end_iterator,
+                                                                      [](const PendingCallback& in_callback)
+                                                                      {
+                                                                          return !in_callback.fence_ptr->is_set();
+                                                                      });
+        }
+
+        std::move(first_completed_callback_iterator,
+                  callbacks_to_check_end_iterator,
+                  std::back_inserter(m_completed_callbacks) );
+
+        m_pending_callbacks.erase(first_completed_callback_iterator,
+                                  callbacks_to_check_end_iterator);
+
+        m_is_dispatching = true;
+    }
+
+    for (auto& current_callback : m_completed_callbacks)
+    {
+        current_callback.callback_function();
+    }
+
+    /* Releases any owned fences and objects captured by the callbacks. The vector's storage is retained,
+     * so that subsequent dispatches do not need to allocate memory.
+     */
+    m_completed_callbacks.clear();
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_is_dispatching = false;
+    }
+
+    m_idle_cv.notify_all();
+}
+
+/** Please see header for specification */
+uint32_t Anvil::FenceReactor::get_n_pending_callbacks() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return static_cast<uint32_t>(m_pending_callbacks.size() );
+}
+
+/** Entry-point of the reactor thread. */
+void Anvil::FenceReactor::reactor_thread_entrypoint()
+{
+    VkFence fences_vk[N_MAX_FENCES_PER_WAIT];
+
+    while (true)
+    {
+        uint32_t n_callbacks = 0;
+        VkResult result_vk   = VK_ERROR_INITIALIZATION_FAILED;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_pending_callbacks_cv.wait(lock,
+                                        [this]()
+                                        {
+                                            return m_should_terminate || !m_pending_callbacks.empty();
+                                        });
+
+            if (m_should_terminate)
+            {
+                break;
+            }
+
+            /* The wake fence always takes the first slot. Pending callbacks are only ever appended by other
+             * threads, so the callbacks waited on stay at the front of the list until they are dispatched.
+             */
+            fences_vk[0] = m_wake_fence_ptr->get_fence();
+
+            for (const auto& current_callback : m_pending_callbacks)
+            {
+                if (n_callbacks == N_MAX_FENCES_PER_WAIT - 1)
+                {
+                    break;
+                }
+
+                fences_vk[1 + n_callbacks++] = current_callback.fence_ptr->get_fence();
+            }
+
+            m_is_waiting = true;
+        }
+
+        /* vkWaitForFences() does not require external synchronization of the fences, so there is no need
+         * to lock them. */
+        result_vk = Anvil::Vulkan::vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                   1 + n_callbacks,
+                                                   fences_vk,
+                                                   VK_FALSE, /* waitAll */
+                                                   g_wait_timeout_ns);
+
+        if (!is_vk_call_successful(result_vk) )
+        {
+            /* The fences may never become signalled (eg. the device has been lost), so waiting on them again
+             * would never return. Flush all pending callbacks, so that the objects they release are not leaked
+             * and wait_idle() returns, and stop the reactor.
+             */
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                m_has_failed = true;
+                m_is_waiting = false;
+                n_callbacks  = static_cast<uint32_t>(m_pending_callbacks.size() );
+            }
+
+            dispatch_callbacks(n_callbacks,
+                               false); /* in_should_check_fences */
+
+            break;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            /* The wake fence must not be reset while the submission which signals it may still be in progress. */
+            if (m_is_wake_submitted           &&
+                m_wake_fence_ptr->is_set() )
+            {
+                m_wake_fence_ptr->reset();
+
+                m_is_wake_pending   = false;
+                m_is_wake_submitted = false;
+            }
+
+            m_is_waiting = false;
+        }
+
+        /* Only the callbacks waited on may have become signalled in the meantime. The rest are going to be
+         * considered in the next iteration.
+         */
+        if (result_vk == VK_SUCCESS)
+        {
+            dispatch_callbacks(n_callbacks,
+                               true); /* in_should_check_fences */
+        }
+    }
+}
+
+/** Tells whether the reactor thread needs to be woken up in order to notice a new callback, or a termination
+ *  request. If so, marks the wake-up as pending, so that it is only requested once.
+ *
+ *  Must be called with m_mutex locked.
+ **/
+bool Anvil::FenceReactor::should_wake_reactor_thread()
+{
+    bool result = false;
+
+    if (m_is_waiting       &&
+       !m_is_wake_pending)
+    {
+        m_is_wake_pending = true;
+        result            = true;
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::FenceReactor::wait_idle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_idle_cv.wait(lock,
+                   [this]()
+                   {
+                       return m_pending_callbacks.empty() && !m_is_dispatching;
+                   });
+}
+
+/** Signals the wake fence with an empty submission, so that the reactor thread returns from vkWaitForFences(). */
+void Anvil::FenceReactor::wake_reactor_thread()
+{
+    const bool result = m_wake_queue_ptr->submit(
+            Anvil::SubmitInfo::create(nullptr, /* in_opt_cmd_buffer_ptr                  */
+                                      0,       /* in_n_semaphores_to_signal              */
+                                      nullptr, /* in_opt_semaphore_to_signal_ptrs_ptr    */
+                                      0,       /* in_n_semaphores_to_wait_on             */
+                                      nullptr, /* in_opt_semaphore_to_wait_on_ptrs_ptr   */
+                                      nullptr, /* in_opt_dst_stage_masks_to_wait_on_ptrs */
+                                      false,   /* in_should_block                        */
+                                      m_wake_fence_ptr.get() ));
+
+    /* If the device has been lost, the reactor thread is going to notice on its own. */
+    anvil_assert(result);
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_is_wake_submitted = true;
+    }
+}
@@ -0,0 +1,163 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/frame_command_allocator.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+
+
+/** Please see header for specification */
+Anvil::FrameCommandAllocator::FrameCommandAllocator(Anvil::BaseDevice* in_device_ptr,
+                                                    uint32_t           in_queue_family_index,
+                                                    uint32_t           in_n_frames_in_flight,
+                                                    uint32_t           in_n_threads)
+    :m_device_ptr(in_device_ptr),
+     m_frame_ring(in_device_ptr,
+                  in_n_frames_in_flight),
+     m_n_threads (in_n_threads)
+{
+    m_frames.resize(in_n_frames_in_flight);
+
+    for (auto& current_frame : m_frames)
+    {
+        current_frame.thread_data.resize(in_n_threads);
+
+        for (auto& current_thread_data : current_frame.thread_data)
+        {
+            /* Each pool is only ever accessed by a single thread, so there is no need to pay for locking. */
+            current_thread_data.command_pool_ptr = Anvil::CommandPool::create(in_device_ptr,
+                                                                              Anvil::CommandPoolCreateFlagBits::CREATE_TRANSIENT_BIT,
+                                                                              in_queue_family_index,
+                                                                              Anvil::MTSafety::DISABLED);
+        }
+    }
+}
+
+/** Please see header for specification */
+Anvil::FrameCommandAllocator::~FrameCommandAllocator()
+{
+    /* Command buffers need to be released before their parent pools. */
+    for (auto& current_frame : m_frames)
+    {
+        for (auto& current_thread_data : current_frame.thread_data)
+        {
+            current_thread_data.primary_cmd_buffer_ptrs.clear  ();
+            current_thread_data.secondary_cmd_buffer_ptrs.clear();
+            current_thread_data.command_pool_ptr.reset         ();
+        }
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::FrameCommandAllocator::begin_frame(Anvil::Fence* in_opt_frame_fence_ptr)
+{
+    FrameData* frame_ptr    = nullptr;
+    uint32_t   n_next_frame = 0;
+    bool       result       = false;
+
+    if (!m_frame_ring.wait_for_next_frame(&n_next_frame) )
+    {
+        goto end;
+    }
+
+    frame_ptr = &m_frames.at(n_next_frame);
+
+    for (auto& current_thread_data : frame_ptr->thread_data)
+    {
+        if (current_thread_data.n_primary_cmd_buffers_used   == 0 &&
+            current_thread_data.n_secondary_cmd_buffers_used == 0)
+        {
+            continue;
+        }
+
+        if (!current_thread_data.command_pool_ptr->reset(false /* in_release_resources */) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        current_thread_data.n_primary_cmd_buffers_used   = 0;
+        current_thread_data.n_secondary_cmd_buffers_used = 0;
+    }
+
+    m_frame_ring.advance(in_opt_frame_fence_ptr);
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::FrameCommandAllocatorUniquePtr Anvil::FrameCommandAllocator::create(Anvil::BaseDevice* in_device_ptr,
+                                                                           uint32_t           in_queue_family_index,
+                                                                           uint32_t           in_n_frames_in_flight,
+                                                                           uint32_t           in_n_threads)
+{
+    Anvil::FrameCommandAllocatorUniquePtr result_ptr(nullptr,
+                                                     std::default_delete<Anvil::FrameCommandAllocator>() );
+
+    anvil_assert(in_device_ptr         != nullptr);
+    anvil_assert(in_n_frames_in_flight >= 1);
+    anvil_assert(in_n_threads          >= 1);
+
+    result_ptr.reset(
+        new Anvil::FrameCommandAllocator(in_device_ptr,
+                                         in_queue_family_index,
+                                         in_n_frames_in_flight,
+                                         in_n_threads)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+Anvil::PrimaryCommandBuffer* Anvil::FrameCommandAllocator::get_primary_command_buffer(uint32_t in_n_thread)
+{
+    auto& thread_data = m_frames.at(m_frame_ring.get_current_frame_index() ).thread_data.at(in_n_thread);
+
+    if (thread_data.n_primary_cmd_buffers_used == thread_data.primary_cmd_buffer_ptrs.size() )
+    {
+        thread_data.primary_cmd_buffer_ptrs.push_back(
+            thread_data.command_pool_ptr->alloc_primary_level_command_buffer()
+        );
+    }
+
+    return thread_data.primary_cmd_buffer_ptrs.at(thread_data.n_primary_cmd_buffers_used++).get();
+}
+
+/** Please see header for specification */
+Anvil::SecondaryCommandBuffer* Anvil::FrameCommandAllocator::get_secondary_command_buffer(uint32_t in_n_thread)
+{
+    auto& thread_data = m_frames.at(m_frame_ring.get_current_frame_index() ).thread_data.at(in_n_thread);
+
+    if (thread_data.n_secondary_cmd_buffers_used == thread_data.secondary_cmd_buffer_ptrs.size() )
+    {
+        thread_data.secondary_cmd_buffer_ptrs.push_back(
+            thread_data.command_pool_ptr->alloc_secondary_level_command_buffer()
+        );
+    }
+
+    return thread_data.secondary_cmd_buffer_ptrs.at(thread_data.n_secondary_cmd_buffers_used++).get();
+}
@@ -0,0 +1,360 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/descriptor_pool_create_info.h"
+#include "misc/frame_descriptor_allocator.h"
+#include "wrappers/descriptor_pool.h"
+#include "wrappers/descriptor_set.h"
+#include "wrappers/device.h"
+#include <algorithm>
+
+
+/** Please see header for specification */
+Anvil::FrameDescriptorAllocator::FrameDescriptorAllocator(const Anvil::BaseDevice* in_device_ptr,
+                                                          uint32_t                 in_n_frames_in_flight,
+                                                          uint32_t                 in_n_threads,
+                                                          uint32_t                 in_n_sets_per_pool)
+    :m_device_ptr     (in_device_ptr),
+     m_frame_ring     (in_device_ptr,
+                       in_n_frames_in_flight),
+     m_n_sets_per_pool(in_n_sets_per_pool)
+{
+    m_frames.resize      (in_n_frames_in_flight);
+    m_thread_usage.resize(in_n_threads);
+
+    for (auto& current_frame : m_frames)
+    {
+        current_frame.thread_data.resize(in_n_threads);
+    }
+}
+
+/** Please see header for specification */
+Anvil::FrameDescriptorAllocator::~FrameDescriptorAllocator()
+{
+    /* Descriptor set wrappers need to be released before their parent pools. */
+    for (auto& current_frame : m_frames)
+    {
+        for (auto& current_thread_data : current_frame.thread_data)
+        {
+            for (auto& current_pool_data_ptr : current_thread_data.pool_data_ptrs)
+            {
+                current_pool_data_ptr->wrapper_data_map.clear();
+                current_pool_data_ptr->pool_ptr.reset        ();
+            }
+        }
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::FrameDescriptorAllocator::alloc_descriptor_sets(uint32_t                       in_n_sets,
+                                                            const DescriptorSetAllocation* in_ds_allocations_ptr,
+                                                            Anvil::DescriptorSet**         out_descriptor_sets_ptr,
+                                                            uint32_t                       in_n_thread)
+{
+    DescriptorPoolAllocator::DescriptorTypeToCountMap n_descriptors_needed_map;
+    PoolData*                                         pool_data_ptr           = nullptr;
+    bool                                              result                  = false;
+    VkResult                                          result_vk               = VK_ERROR_INITIALIZATION_FAILED;
+    auto&                                             thread_data             = m_frames.at(m_frame_ring.get_current_frame_index() ).thread_data.at(in_n_thread);
+    auto&                                             usage_data              = m_thread_usage.at(in_n_thread);
+
+    anvil_assert(in_n_sets               >= 1);
+    anvil_assert(in_ds_allocations_ptr   != nullptr);
+    anvil_assert(out_descriptor_sets_ptr != nullptr);
+
+    if (!DescriptorPoolAllocator::get_n_descriptors_needed(in_n_sets,
+                                                           in_ds_allocations_ptr,
+                                                          &n_descriptors_needed_map) )
+    {
+        goto end;
+    }
+
+    /* Update usage statistics first, so that any pool created below accounts for this request. */
+    usage_data.n_sets_allocated += in_n_sets;
+
+    for (const auto& current_map_entry : n_descriptors_needed_map)
+    {
+        usage_data.n_descriptors_allocated[current_map_entry.first] += current_map_entry.second;
+    }
+
+    /* Bump-allocate from the current pool. Once a pool is exhausted, it is not revisited until the slot is reused. */
+    while (thread_data.n_current_pool < thread_data.pool_data_ptrs.size() )
+    {
+        pool_data_ptr = thread_data.pool_data_ptrs.at(thread_data.n_current_pool).get();
+
+        if (alloc_from_pool(pool_data_ptr,
+                            in_n_sets,
+                            in_ds_allocations_ptr,
+                           &usage_data,
+                            out_descriptor_sets_ptr,
+                           &result_vk) )
+        {
+            break;
+        }
+
+        if (result_vk == VK_SUCCESS)
+        {
+            /* The sets have been allocated, but could not be wrapped. */
+            goto end;
+        }
+
+        /* Drivers which do not support VK_KHR_maintenance1 may report other errors if the pool is exhausted. */
+        anvil_assert(result_vk == VK_ERROR_OUT_OF_POOL_MEMORY            ||
+                     result_vk == VK_ERROR_FRAGMENTED_POOL               ||
+                     result_vk == VK_ERROR_OUT_OF_HOST_MEMORY            ||
+                     result_vk == VK_ERROR_OUT_OF_DEVICE_MEMORY);
+
+        if (pool_data_ptr->n_sets_allocated == 0)
+        {
+            /* An empty pool which cannot hold the request has been sized for an older usage pattern. Release it,
+             * so that it gets replaced with a pool sized for the current one.
+             */
+            thread_data.pool_data_ptrs.erase(thread_data.pool_data_ptrs.begin() + thread_data.n_current_pool);
+        }
+        else
+        {
+            ++thread_data.n_current_pool;
+        }
+
+        pool_data_ptr = nullptr;
+    }
+
+    if (pool_data_ptr == nullptr)
+    {
+        /* Need a new pool */
+        auto new_pool_data_ptr = create_pool(in_n_sets,
+                                             usage_data,
+                                             n_descriptors_needed_map);
+
+        if (new_pool_data_ptr == nullptr)
+        {
+            goto end;
+        }
+
+        if (!alloc_from_pool(new_pool_data_ptr.get(),
+                             in_n_sets,
+                             in_ds_allocations_ptr,
+                            &usage_data,
+                             out_descriptor_sets_ptr,
+                            &result_vk) )
+        {
+            anvil_assert_vk_call_succeeded(result_vk);
+
+            goto end;
+        }
+
+        thread_data.n_current_pool = static_cast<uint32_t>(thread_data.pool_data_ptrs.size() );
+
+        thread_data.pool_data_ptrs.push_back(
+            std::move(new_pool_data_ptr)
+        );
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Allocates @param in_n_sets descriptor sets from the pool described by @param in_pool_data_ptr with a single
+ *  vkAllocateDescriptorSets() call, and wraps them with wrappers retained by the pool, creating new ones only if needed.
+ *
+ *  @param in_usage_data_ptr Data of the calling thread. Must not be nullptr.
+ *  @param out_result_vk_ptr Deref will be set to the result of the vkAllocateDescriptorSets() call.
+ *                           Must not be nullptr.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::FrameDescriptorAllocator::alloc_from_pool(PoolData*                      in_pool_data_ptr,
+                                                      uint32_t                       in_n_sets,
+                                                      const DescriptorSetAllocation* in_ds_allocations_ptr,
+                                                      ThreadUsageData*               in_usage_data_ptr,
+                                                      Anvil::DescriptorSet**         out_descriptor_sets_ptr,
+                                                      VkResult*                      out_result_vk_ptr) const
+{
+    bool result = false;
+
+    in_usage_data_ptr->ds_vk_cache.resize(in_n_sets);
+
+    if (!in_pool_data_ptr->pool_ptr->alloc_descriptor_sets(in_n_sets,
+                                                           in_ds_allocations_ptr,
+                                                          &in_usage_data_ptr->ds_vk_cache.at(0),
+                                                           out_result_vk_ptr) )
+    {
+        goto end;
+    }
+
+    /* The sets are released by the next reset of the pool, even if wrapping some of them fails below. */
+    in_pool_data_ptr->n_sets_allocated += in_n_sets;
+
+    for (uint32_t n_set = 0;
+                  n_set < in_n_sets;
+                ++n_set)
+    {
+        const Anvil::DescriptorSetLayout* ds_layout_ptr = in_ds_allocations_ptr[n_set].ds_layout_ptr;
+        const VkDescriptorSet             ds_vk         = in_usage_data_ptr->ds_vk_cache.at(n_set);
+        auto&                             wrapper_data  = in_pool_data_ptr->wrapper_data_map[ds_layout_ptr];
+
+        if (wrapper_data.n_ds_used < static_cast<uint32_t>(wrapper_data.ds_ptrs.size() ))
+        {
+            wrapper_data.ds_ptrs.at(wrapper_data.n_ds_used)->recycle(ds_vk);
+        }
+        else
+        {
+            auto new_ds_ptr = Anvil::DescriptorSet::create(m_device_ptr,
+                                                           in_pool_data_ptr->pool_ptr.get(),
+                                                           ds_layout_ptr,
+                                                           ds_vk,
+                                                           Anvil::MTSafety::DISABLED);
+
+            if (new_ds_ptr == nullptr)
+            {
+                anvil_assert(new_ds_ptr != nullptr);
+
+                goto end;
+            }
+
+            wrapper_data.ds_ptrs.push_back(
+                std::move(new_ds_ptr)
+            );
+        }
+
+        out_descriptor_sets_ptr[n_set] = wrapper_data.ds_ptrs.at(wrapper_data.n_ds_used++).get();
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::FrameDescriptorAllocator::begin_frame(Anvil::Fence* in_opt_frame_fence_ptr)
+{
+    FrameData* frame_ptr    = nullptr;
+    uint32_t   n_next_frame = 0;
+    bool       result       = false;
+
+    if (!m_frame_ring.wait_for_next_frame(&n_next_frame) )
+    {
+        goto end;
+    }
+
+    frame_ptr = &m_frames.at(n_next_frame);
+
+    for (auto& current_thread_data : frame_ptr->thread_data)
+    {
+        for (auto& current_pool_data_ptr : current_thread_data.pool_data_ptrs)
+        {
+            if (current_pool_data_ptr->n_sets_allocated == 0)
+            {
+                continue;
+            }
+
+            /* Wrappers stay subscribed to the pool, which marks them as unusable until they are recycled. */
+            if (!current_pool_data_ptr->pool_ptr->reset() )
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+
+            for (auto& current_wrapper_data : current_pool_data_ptr->wrapper_data_map)
+            {
+                current_wrapper_data.second.n_ds_used = 0;
+            }
+
+            current_pool_data_ptr->n_sets_allocated = 0;
+        }
+
+        current_thread_data.n_current_pool = 0;
+    }
+
+    m_frame_ring.advance(in_opt_frame_fence_ptr);
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::FrameDescriptorAllocatorUniquePtr Anvil::FrameDescriptorAllocator::create(const Anvil::BaseDevice* in_device_ptr,
+                                                                                 uint32_t                 in_n_frames_in_flight,
+                                                                                 uint32_t                 in_n_threads,
+                                                                                 uint32_t                 in_n_sets_per_pool)
+{
+    Anvil::FrameDescriptorAllocatorUniquePtr result_ptr(nullptr,
+                                                        std::default_delete<Anvil::FrameDescriptorAllocator>() );
+
+    anvil_assert(in_device_ptr         != nullptr);
+    anvil_assert(in_n_frames_in_flight >= 1);
+    anvil_assert(in_n_threads          >= 1);
+    anvil_assert(in_n_sets_per_pool    >= 1);
+
+    result_ptr.reset(
+        new Anvil::FrameDescriptorAllocator(in_device_ptr,
+                                            in_n_frames_in_flight,
+                                            in_n_threads,
+                                            in_n_sets_per_pool)
+    );
+
+    return result_ptr;
+}
+
+/** Creates a new pool, sized for n_sets_per_pool sets of the average composition observed so far by the
+ *  calling thread.
+ *
+ *  @param in_n_sets                   Number of sets the pool must be able to hold, at minimum.
+ *  @param in_usage_data               Usage statistics of the calling thread.
+ *  @param in_n_descriptors_needed_map Number of descriptors of each type the pool must be able to hold, at minimum.
+ *
+ *  @return New pool descriptor, or nullptr if the pool could not be created.
+ **/
+std::unique_ptr<Anvil::FrameDescriptorAllocator::PoolData> Anvil::FrameDescriptorAllocator::create_pool(uint32_t                                                 in_n_sets,
+                                                                                                       const ThreadUsageData&                                   in_usage_data,
+                                                                                                       const DescriptorPoolAllocator::DescriptorTypeToCountMap& in_n_descriptors_needed_map) const
+{
+    const uint32_t            n_max_sets         = std::max(m_n_sets_per_pool,
+                                                            in_n_sets);
+    auto                      dp_create_info_ptr = Anvil::DescriptorPoolCreateInfo::create(m_device_ptr,
+                                                                                           n_max_sets,
+                                                                                           Anvil::DescriptorPoolCreateFlagBits::NONE,
+                                                                                           Anvil::MTSafety::DISABLED);
+    std::unique_ptr<PoolData> result_ptr         (new PoolData() );
+
+    DescriptorPoolAllocator::set_pool_descriptor_counts(n_max_sets,
+                                                        in_usage_data.n_sets_allocated,
+                                                        in_usage_data.n_descriptors_allocated,
+                                                        in_n_descriptors_needed_map,
+                                                        dp_create_info_ptr.get() );
+
+    /* Each pool is only ever accessed by a single thread, so there is no need to pay for locking. */
+    result_ptr->pool_ptr = Anvil::DescriptorPool::create(std::move(dp_create_info_ptr) );
+
+    if (result_ptr->pool_ptr == nullptr)
+    {
+        anvil_assert(result_ptr->pool_ptr != nullptr);
+
+        result_ptr.reset();
+    }
+
+    return result_ptr;
+}
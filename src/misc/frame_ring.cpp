@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/frame_ring.h"
+#include "wrappers/device.h"
+#include "wrappers/fence.h"
+
+
+/** Please see header for specification */
+Anvil::FrameRing::FrameRing(const Anvil::BaseDevice* in_device_ptr,
+                            uint32_t                 in_n_frames)
+    :m_device_ptr     (in_device_ptr),
+     m_fence_ptrs     (in_n_frames,
+                       nullptr),
+     m_n_current_frame(in_n_frames - 1)
+{
+    anvil_assert(in_device_ptr != nullptr);
+    anvil_assert(in_n_frames   >= 1);
+}
+
+/** Please see header for specification */
+void Anvil::FrameRing::advance(Anvil::Fence* in_opt_frame_fence_ptr)
+{
+    m_n_current_frame                  = (m_n_current_frame + 1) % static_cast<uint32_t>(m_fence_ptrs.size() );
+    m_fence_ptrs.at(m_n_current_frame) = in_opt_frame_fence_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::FrameRing::wait_for_next_frame(uint32_t* out_n_next_frame_ptr) const
+{
+    const uint32_t n_next_frame = (m_n_current_frame + 1) % static_cast<uint32_t>(m_fence_ptrs.size() );
+    Anvil::Fence*  fence_ptr    = m_fence_ptrs.at(n_next_frame);
+    bool           result       = false;
+
+    if (fence_ptr != nullptr)
+    {
+        const VkResult result_vk = Anvil::Vulkan::vkWaitForFences(m_device_ptr->get_device_vk(),
+                                                                  1, /* fenceCount */
+                                                                  fence_ptr->get_fence_ptr(),
+                                                                  VK_TRUE, /* waitAll */
+                                                                  UINT64_MAX);
+
+        if (!is_vk_call_successful(result_vk) )
+        {
+            anvil_assert_vk_call_succeeded(result_vk);
+
+            goto end;
+        }
+    }
+
+    *out_n_next_frame_ptr = n_next_frame;
+    result                = true;
+end:
+    return result;
+}
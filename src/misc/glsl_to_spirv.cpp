@@ -23,6 +23,7 @@
 #include "misc/glsl_to_spirv.h"
 #include "misc/io.h"
 #include "misc/object_tracker.h"
+#include "misc/tracer.h"
 #include "wrappers/device.h"
 #include "wrappers/shader_module.h"
 #include <algorithm>
@@ -516,6 +517,8 @@ end:
 /* Please see header for specification */
 bool Anvil::GLSLShaderToSPIRVGenerator::bake_spirv_blob() const
 {
+    ANVIL_TRACE_CPU_SPAN("GLSLShaderToSPIRVGenerator::bake_spirv_blob");
+
     bool           glsl_filename_is_temporary = false;
     std::string    glsl_filename_with_path;
     bool           result                     = false;
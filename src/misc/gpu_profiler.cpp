@@ -0,0 +1,430 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/buffer_create_info.h"
+#include "misc/debug.h"
+#include "misc/gpu_profiler.h"
+#include "misc/tracer.h"
+#include "wrappers/buffer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/device.h"
+#include "wrappers/memory_block.h"
+#include "wrappers/query_pool.h"
+#include <algorithm>
+#include <cstring>
+
+/* Each query takes two 64-bit values in the results buffer: the timestamp and its availability. Each scope
+ * uses two queries. */
+static const uint32_t g_n_values_per_scope = 4;
+
+
+/** Please see header for specification */
+Anvil::GPUProfiler::GPUProfiler(Anvil::BaseDevice*  in_device_ptr,
+                                uint32_t            in_max_n_scopes_per_frame,
+                                uint32_t            in_n_frames_in_flight,
+                                const Anvil::Queue* in_opt_trace_queue_ptr)
+    :m_device_ptr               (in_device_ptr),
+     m_frames                   (in_n_frames_in_flight),
+     m_is_current_frame_profiled(false),
+     m_max_n_scopes_per_frame   (in_max_n_scopes_per_frame),
+     m_mapped_data_ptr          (nullptr),
+     m_n_current_frame          (in_n_frames_in_flight - 1),
+     m_n_dropped_frames         (0),
+     m_n_frames_started         (0),
+     m_results_frame_index      (UINT64_MAX),
+     m_timestamp_period         (1.0),
+     m_timestamp_mask           (UINT64_MAX),
+     m_trace_queue_ptr          (in_opt_trace_queue_ptr)
+{
+    anvil_assert(in_device_ptr             != nullptr);
+    anvil_assert(in_max_n_scopes_per_frame >  0);
+    anvil_assert(in_n_frames_in_flight     >  0);
+}
+
+/** Please see header for specification */
+Anvil::GPUProfiler::~GPUProfiler()
+{
+    if (m_mapped_data_ptr != nullptr)
+    {
+        m_buffer_ptr->get_memory_block(0)->unmap();
+
+        m_mapped_data_ptr = nullptr;
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::GPUProfiler::begin_frame(Anvil::CommandBufferBase* in_cmd_buffer_ptr)
+{
+    std::unique_lock<std::mutex> lock     (m_mutex);
+    Frame*                       frame_ptr(nullptr);
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    m_n_current_frame = (m_n_current_frame + 1) % static_cast<uint32_t>(m_frames.size() );
+    frame_ptr         = &m_frames.at(m_n_current_frame);
+
+    m_open_scope_stacks.clear();
+
+    if (frame_ptr->frame_index != UINT64_MAX &&
+        !resolve_frame(frame_ptr) )
+    {
+        /* The frame which last used the resources is still executing, so neither its results nor its query pool
+         * can be touched yet. Leave them be, and retry when the resources come around again. */
+        m_is_current_frame_profiled = false;
+        m_n_dropped_frames++;
+        m_n_frames_started++;
+
+        return true;
+    }
+
+    /* Zero availability values left behind by the previous use of the region, so that resolve_frame() can tell
+     * whether the copy recorded by end_frame() has executed. The memory is host-coherent, and host writes are
+     * made visible to commands submitted afterward, so no flush or barrier is needed. */
+    memset(m_mapped_data_ptr + m_n_current_frame * m_max_n_scopes_per_frame * g_n_values_per_scope,
+           0,
+           sizeof(uint64_t) * m_max_n_scopes_per_frame * g_n_values_per_scope);
+
+    frame_ptr->frame_index = m_n_frames_started++;
+    frame_ptr->pending_scopes.clear();
+
+    m_is_current_frame_profiled = true;
+
+    return in_cmd_buffer_ptr->record_reset_query_pool(frame_ptr->query_pool_ptr.get(),
+                                                      0, /* in_start_query */
+                                                      m_max_n_scopes_per_frame * 2);
+}
+
+/** Please see header for specification */
+uint32_t Anvil::GPUProfiler::begin_scope(Anvil::CommandBufferBase*    in_cmd_buffer_ptr,
+                                         const std::string&           in_name,
+                                         Anvil::PipelineStageFlagBits in_stage)
+{
+    std::unique_lock<std::mutex> lock       (m_mutex);
+    auto&                        frame      (m_frames.at(m_n_current_frame) );
+    auto&                        scope_stack(m_open_scope_stacks[in_cmd_buffer_ptr]);
+    uint32_t                     result     (UINT32_MAX);
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    if (m_is_current_frame_profiled                          &&
+        frame.pending_scopes.size() < m_max_n_scopes_per_frame)
+    {
+        PendingScope new_scope;
+
+        result = static_cast<uint32_t>(frame.pending_scopes.size() );
+
+        new_scope.depth          = static_cast<uint32_t>(scope_stack.size() );
+        new_scope.has_ended      = false;
+        new_scope.name           = in_name;
+        new_scope.n_parent_scope = (scope_stack.size() > 0) ? scope_stack.back() : UINT32_MAX;
+
+        frame.pending_scopes.push_back(std::move(new_scope) );
+
+        in_cmd_buffer_ptr->record_write_timestamp(in_stage,
+                                                  frame.query_pool_ptr.get(),
+                                                  result * 2);
+    }
+
+    /* Scopes which were not recorded still go on the stack, so that the matching end_scope() call pops the right entry. */
+    scope_stack.push_back(result);
+
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::GPUProfilerUniquePtr Anvil::GPUProfiler::create(Anvil::BaseDevice*  in_device_ptr,
+                                                       uint32_t            in_max_n_scopes_per_frame,
+                                                       uint32_t            in_n_frames_in_flight,
+                                                       const Anvil::Queue* in_opt_trace_queue_ptr)
+{
+    Anvil::GPUProfilerUniquePtr result_ptr(nullptr,
+                                           std::default_delete<Anvil::GPUProfiler>() );
+
+    result_ptr.reset(
+        new Anvil::GPUProfiler(in_device_ptr,
+                               in_max_n_scopes_per_frame,
+                               in_n_frames_in_flight,
+                               in_opt_trace_queue_ptr)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::GPUProfiler::end_frame(Anvil::CommandBufferBase* in_cmd_buffer_ptr)
+{
+    std::unique_lock<std::mutex> lock         (m_mutex);
+    auto&                        frame        (m_frames.at(m_n_current_frame) );
+    const uint32_t               n_scopes     (static_cast<uint32_t>(frame.pending_scopes.size() ));
+    const VkDeviceSize           region_offset(sizeof(uint64_t) * m_n_current_frame * m_max_n_scopes_per_frame * g_n_values_per_scope);
+    bool                         result       (false);
+
+    anvil_assert(in_cmd_buffer_ptr != nullptr);
+
+    /* Copying a query which was never written to with VK_QUERY_RESULT_WAIT_BIT would hang the device. */
+    for (const auto& current_scope_stack : m_open_scope_stacks)
+    {
+        if (!current_scope_stack.second.empty() )
+        {
+            anvil_assert(current_scope_stack.second.empty() );
+
+            goto end;
+        }
+    }
+
+    if (m_is_current_frame_profiled &&
+        n_scopes > 0)
+    {
+        const Anvil::BufferBarrier results_barrier(Anvil::AccessFlagBits::TRANSFER_WRITE_BIT,
+                                                   Anvil::AccessFlagBits::HOST_READ_BIT,
+                                                   VK_QUEUE_FAMILY_IGNORED,
+                                                   VK_QUEUE_FAMILY_IGNORED,
+                                                   m_buffer_ptr.get(),
+                                                   region_offset,
+                                                   sizeof(uint64_t) * n_scopes * g_n_values_per_scope);
+
+        if (!in_cmd_buffer_ptr->record_copy_query_pool_results(frame.query_pool_ptr.get(),
+                                                               0, /* in_start_query */
+                                                               n_scopes * 2,
+                                                               m_buffer_ptr.get(),
+                                                               region_offset,
+                                                               sizeof(uint64_t) * 2, /* in_dst_stride */
+                                                               VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT) )
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        if (!in_cmd_buffer_ptr->record_pipeline_barrier(Anvil::PipelineStageFlagBits::TRANSFER_BIT,
+                                                        Anvil::PipelineStageFlagBits::HOST_BIT,
+                                                        Anvil::DependencyFlagBits::NONE,
+                                                        0,       /* in_memory_barrier_count        */
+                                                        nullptr, /* in_memory_barriers_ptr         */
+                                                        1,       /* in_buffer_memory_barrier_count */
+                                                       &results_barrier,
+                                                        0,        /* in_image_memory_barrier_count */
+                                                        nullptr)) /* in_image_memory_barriers_ptr  */
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::GPUProfiler::end_scope(Anvil::CommandBufferBase*    in_cmd_buffer_ptr,
+                                   Anvil::PipelineStageFlagBits in_stage)
+{
+    std::unique_lock<std::mutex> lock       (m_mutex);
+    auto&                        frame      (m_frames.at(m_n_current_frame) );
+    auto&                        scope_stack(m_open_scope_stacks[in_cmd_buffer_ptr]);
+    uint32_t                     n_scope;
+
+    if (scope_stack.empty() )
+    {
+        anvil_assert(!scope_stack.empty() );
+
+        return;
+    }
+
+    n_scope = scope_stack.back();
+
+    scope_stack.pop_back();
+
+    if (n_scope != UINT32_MAX)
+    {
+        in_cmd_buffer_ptr->record_write_timestamp(in_stage,
+                                                  frame.query_pool_ptr.get(),
+                                                  n_scope * 2 + 1);
+
+        frame.pending_scopes.at(n_scope).has_ended = true;
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::GPUProfiler::init()
+{
+    const VkDeviceSize buffer_size      = sizeof(uint64_t) * m_frames.size() * m_max_n_scopes_per_frame * g_n_values_per_scope;
+    void*              mapped_data_ptr  = nullptr;
+    uint32_t           n_timestamp_bits = 64;
+    bool               result           = false;
+
+    /* Timestamps only have as many valid bits as the queue family they were written on supports. Since scopes may be
+     * recorded for any family, wrap deltas at the smallest non-zero width. */
+    for (const auto& current_queue_family_info : m_device_ptr->get_physical_device_queue_families() )
+    {
+        if (current_queue_family_info.n_timestamp_bits != 0)
+        {
+            n_timestamp_bits = std::min(n_timestamp_bits,
+                                        current_queue_family_info.n_timestamp_bits);
+        }
+    }
+
+    m_timestamp_mask   = (n_timestamp_bits >= 64) ? UINT64_MAX : ((1ull << n_timestamp_bits) - 1);
+    m_timestamp_period = static_cast<double>(m_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.timestamp_period);
+
+    for (auto& current_frame : m_frames)
+    {
+        current_frame.query_pool_ptr = Anvil::QueryPool::create_non_ps_query_pool(m_device_ptr,
+                                                                                  VK_QUERY_TYPE_TIMESTAMP,
+                                                                                  m_max_n_scopes_per_frame * 2);
+
+        if (current_frame.query_pool_ptr == nullptr)
+        {
+            anvil_assert(current_frame.query_pool_ptr != nullptr);
+
+            goto end;
+        }
+
+        current_frame.pending_scopes.reserve(m_max_n_scopes_per_frame);
+    }
+
+    {
+        auto create_info_ptr = Anvil::BufferCreateInfo::create_alloc(m_device_ptr,
+                                                                     buffer_size,
+                                                                     Anvil::QueueFamilyFlagBits::COMPUTE_BIT | Anvil::QueueFamilyFlagBits::GRAPHICS_BIT,
+                                                                     Anvil::SharingMode::EXCLUSIVE,
+                                                                     Anvil::BufferCreateFlagBits::NONE,
+                                                                     Anvil::BufferUsageFlagBits::TRANSFER_DST_BIT,
+                                                                     Anvil::MemoryFeatureFlagBits::MAPPABLE_BIT | Anvil::MemoryFeatureFlagBits::HOST_COHERENT_BIT);
+
+        create_info_ptr->set_mt_safety(Anvil::MTSafety::DISABLED);
+
+        m_buffer_ptr = Anvil::Buffer::create(std::move(create_info_ptr) );
+    }
+
+    if (m_buffer_ptr == nullptr)
+    {
+        anvil_assert(m_buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    /* The buffer stays mapped for the lifetime of the profiler. */
+    if (!m_buffer_ptr->get_memory_block(0)->map(0, /* in_start_offset */
+                                                buffer_size,
+                                               &mapped_data_ptr) )
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    m_mapped_data_ptr = static_cast<uint64_t*>(mapped_data_ptr);
+
+    m_results.reserve(m_max_n_scopes_per_frame);
+
+    result = true;
+end:
+    return result;
+}
+
+/** Converts results of @param in_frame_ptr, written by the copy recorded by end_frame(), to scope timings.
+ *
+ *  Must be called with m_mutex locked.
+ *
+ *  @return true if the frame has been resolved, false if it has not finished executing yet.
+ **/
+bool Anvil::GPUProfiler::resolve_frame(Frame* in_frame_ptr)
+{
+    const uint32_t  n_frame        = static_cast<uint32_t>(in_frame_ptr - &m_frames.at(0) );
+    const uint64_t* frame_data_ptr = m_mapped_data_ptr + n_frame * m_max_n_scopes_per_frame * g_n_values_per_scope;
+    const uint32_t  n_scopes       = static_cast<uint32_t>(in_frame_ptr->pending_scopes.size() );
+    Anvil::Tracer*  tracer_ptr     = nullptr;
+
+    for (uint32_t n_scope = 0;
+                  n_scope < n_scopes;
+                ++n_scope)
+    {
+        const uint64_t* scope_data_ptr = frame_data_ptr + n_scope * g_n_values_per_scope;
+
+        if (scope_data_ptr[1] == 0 ||
+            scope_data_ptr[3] == 0)
+        {
+            /* The frame has not finished executing. Do not wait for it. */
+            return false;
+        }
+    }
+
+    if (m_trace_queue_ptr != nullptr        &&
+        Anvil::Tracer::is_capturing() )
+    {
+        tracer_ptr = Anvil::Tracer::get();
+    }
+
+    m_results.clear();
+
+    for (uint32_t n_scope = 0;
+                  n_scope < n_scopes;
+                ++n_scope)
+    {
+        const auto&     current_scope  = in_frame_ptr->pending_scopes.at(n_scope);
+        const uint64_t* scope_data_ptr = frame_data_ptr + n_scope * g_n_values_per_scope;
+        ScopeResult     new_result;
+
+        new_result.depth           = current_scope.depth;
+        new_result.end_timestamp   = scope_data_ptr[2];
+        new_result.name            = current_scope.name;
+        new_result.n_parent_scope  = current_scope.n_parent_scope;
+        new_result.start_timestamp = scope_data_ptr[0];
+        new_result.duration_ns     = static_cast<double>((new_result.end_timestamp - new_result.start_timestamp) & m_timestamp_mask) * m_timestamp_period;
+
+        if (tracer_ptr != nullptr)
+        {
+            uint64_t end_time_ns   = 0;
+            uint64_t start_time_ns = 0;
+
+            if (tracer_ptr->convert_gpu_timestamp(m_trace_queue_ptr,
+                                                  new_result.start_timestamp,
+                                                 &start_time_ns) &&
+                tracer_ptr->convert_gpu_timestamp(m_trace_queue_ptr,
+                                                  new_result.end_timestamp,
+                                                 &end_time_ns) )
+            {
+                tracer_ptr->add_gpu_span(m_trace_queue_ptr,
+                                         new_result.name,
+                                         start_time_ns,
+                                         end_time_ns);
+            }
+        }
+
+        m_results.push_back(std::move(new_result) );
+    }
+
+    m_results_frame_index = in_frame_ptr->frame_index;
+
+    return true;
+}
@@ -269,6 +269,28 @@ bool Anvil::IO::is_directory(const std::string& in_path)
     return result;
 }
 
+/* Please see header for specification */
+bool Anvil::IO::move_file(const std::string& in_src_filename,
+                          const std::string& in_dst_filename)
+{
+    #ifdef _WIN32
+    {
+        const std::wstring src_filename_wide(in_src_filename.begin(), in_src_filename.end() );
+        const std::wstring dst_filename_wide(in_dst_filename.begin(), in_dst_filename.end() );
+
+        return (::MoveFileExW(src_filename_wide.c_str(),
+                              dst_filename_wide.c_str(),
+                              MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0);
+    }
+    #else
+    {
+        /* rename() is guaranteed to replace the destination file atomically. */
+        return (rename(in_src_filename.c_str(),
+                       in_dst_filename.c_str() ) == 0);
+    }
+    #endif
+}
+
 /** Reads contents of a file with user-specified name and returns it to the caller.
  *
  *  @param in_filename        Name of the file to use for the operation.
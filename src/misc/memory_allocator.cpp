@@ -28,6 +28,7 @@
 #include "misc/memory_allocator.h"
 #include "misc/memalloc_backends/backend_oneshot.h"
 #include "misc/memalloc_backends/backend_vma.h"
+#include "misc/tracer.h"
 #include "wrappers/buffer.h"
 #include "wrappers/device.h"
 #include "wrappers/fence.h"
@@ -477,13 +478,13 @@ bool Anvil::MemoryAllocator::add_buffer(Anvil::Buffer*
                                         const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                         const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr  = get_mutex();
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -606,14 +607,14 @@ bool Anvil::MemoryAllocator::add_buffer_with_float_data_ptr_based_post_fill(Anvi
                                                                             const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                             const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr  = get_mutex();
     bool                                   result;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -649,14 +650,14 @@ bool Anvil::MemoryAllocator::add_buffer_with_float_data_vector_ptr_based_post_fi
                                                                                    const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                                    const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr  = get_mutex();
     bool                                   result;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -694,7 +695,7 @@ bool Anvil::MemoryAllocator::add_buffer_with_float_data_vector_ptr_based_post_fi
                                                                                    const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                                    const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr  = get_mutex();
     auto                                   ptr        = std::unique_ptr<std::vector<float>, std::function<void (std::vector<float>*) > >(const_cast<std::vector<float>* >(in_data_vector_ptr),
                                                                                                                                          [](const std::vector<float>*)
@@ -706,7 +707,7 @@ bool Anvil::MemoryAllocator::add_buffer_with_float_data_vector_ptr_based_post_fi
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -744,14 +745,14 @@ bool Anvil::MemoryAllocator::add_buffer_with_uchar8_data_ptr_based_post_fill(Anv
                                                                              const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                              const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr  = get_mutex();
     bool                                   result;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -787,14 +788,14 @@ bool Anvil::MemoryAllocator::add_buffer_with_uchar8_data_vector_ptr_based_post_f
                                                                                     const MGPUBindSparseDeviceIndices*           in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                                     const float&                                 in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr  = get_mutex();
     bool                                   result;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -832,14 +833,14 @@ bool Anvil::MemoryAllocator::add_buffer_with_uint32_data_ptr_based_post_fill(Anv
                                                                              const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                              const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr  = get_mutex();
     bool                                   result;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -875,14 +876,14 @@ bool Anvil::MemoryAllocator::add_buffer_with_uint32_data_vector_ptr_based_post_f
                                                                                     const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                                     const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr  = get_mutex();
     bool                                   result;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -920,7 +921,7 @@ bool Anvil::MemoryAllocator::add_buffer_with_uint32_data_vector_ptr_based_post_f
                                                                                     const MGPUBindSparseDeviceIndices*          in_opt_mgpu_bind_sparse_device_indices_ptr,
                                                                                     const float&                                in_opt_memory_priority)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr  = get_mutex();
     auto                                   ptr        = std::unique_ptr<std::vector<uint32_t>, std::function<void (std::vector<uint32_t>*) > >(const_cast<std::vector<uint32_t>* >(in_data_vector_ptr),
                                                                                                                                               [](const std::vector<uint32_t>*)
@@ -932,7 +933,7 @@ bool Anvil::MemoryAllocator::add_buffer_with_uint32_data_vector_ptr_based_post_f
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -975,7 +976,7 @@ bool Anvil::MemoryAllocator::add_image_whole(Anvil::Image*
     uint32_t                               image_memory_types    = 0;
     const auto                             image_n_planes        = Anvil::Formats::get_format_n_planes(in_image_ptr->get_create_info_ptr()->get_format() );
     VkDeviceSize                           image_storage_size    = 0;
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr             = get_mutex();
     std::unique_ptr<Item>                  new_item_ptr;
     bool                                   result                = true;
@@ -983,7 +984,7 @@ bool Anvil::MemoryAllocator::add_image_whole(Anvil::Image*
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -1070,7 +1071,7 @@ bool Anvil::MemoryAllocator::add_sparse_buffer_region(Anvil::Buffer*
 {
     uint32_t                               filtered_memory_types = 0;
     const auto&                            memory_reqs           = in_buffer_ptr->get_memory_requirements();
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr             = get_mutex();
     std::unique_ptr<Item>                  new_item_ptr;
     bool                                   result                = true;
@@ -1090,7 +1091,7 @@ bool Anvil::MemoryAllocator::add_sparse_buffer_region(Anvil::Buffer*
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -1160,7 +1161,7 @@ bool Anvil::MemoryAllocator::add_sparse_image_miptail(Anvil::Image*
 {
     const Anvil::SparseImageAspectProperties* aspect_props_ptr      = nullptr;
     uint32_t                                  filtered_memory_types = 0;
-    std::unique_lock<std::recursive_mutex>    mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex>    mutex_lock;
     auto                                      mutex_ptr             = get_mutex();
     std::unique_ptr<Item>                     new_item_ptr;
     uint32_t                                  miptail_memory_types  = 0;
@@ -1188,7 +1189,7 @@ bool Anvil::MemoryAllocator::add_sparse_image_miptail(Anvil::Image*
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -1275,7 +1276,7 @@ bool Anvil::MemoryAllocator::add_sparse_image_subresource(Anvil::Image*
     uint32_t                                  filtered_memory_types      = 0;
     const auto                                image_format               = in_image_ptr->get_create_info_ptr()->get_format();
     uint32_t                                  mip_size[3];
-    std::unique_lock<std::recursive_mutex>    mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex>    mutex_lock;
     auto                                      mutex_ptr                  = get_mutex();
     std::unique_ptr<Item>                     new_item_ptr;
     const uint32_t                            n_plane                    = (in_subresource.aspect_mask == Anvil::ImageAspectFlagBits::PLANE_1_BIT) ? 1
@@ -1309,7 +1310,7 @@ bool Anvil::MemoryAllocator::add_sparse_image_subresource(Anvil::Image*
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -1488,10 +1489,12 @@ end:
 /* Please see header for specification */
 bool Anvil::MemoryAllocator::bake()
 {
+    ANVIL_TRACE_CPU_SPAN("MemoryAllocator::bake");
+
     Anvil::SparseMemoryBindInfoID                                          default_sparse_bind_info_id               = UINT32_MAX;
     std::map<ResourceMemoryDeviceIndexPair, Anvil::SparseMemoryBindInfoID> device_index_pair_to_sparse_bind_info_map;
     std::vector<Anvil::FenceUniquePtr>                                     fences;
-    std::unique_lock<std::recursive_mutex>                                 mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex>                                 mutex_lock;
     auto                                                                   mutex_ptr                                 = get_mutex();
     bool                                                                   needs_sparse_memory_binding               = false;
     bool                                                                   result                                    = false;
@@ -1500,7 +1503,7 @@ bool Anvil::MemoryAllocator::bake()
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -2207,13 +2210,13 @@ void Anvil::MemoryAllocator::on_is_alloc_pending_for_buffer_query(CallbackArgume
 {
     IsBufferMemoryAllocPendingQueryCallbackArgument* query_ptr                 = dynamic_cast<IsBufferMemoryAllocPendingQueryCallbackArgument*>(in_callback_arg_ptr);
     auto                                             alloc_status_map_iterator = m_per_object_pending_alloc_status.find                        (query_ptr->buffer_ptr);
-    std::unique_lock<std::recursive_mutex>           mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex>           mutex_lock;
     auto                                             mutex_ptr                 = get_mutex();
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -2228,13 +2231,13 @@ void Anvil::MemoryAllocator::on_is_alloc_pending_for_image_query(CallbackArgumen
 {
     IsImageMemoryAllocPendingQueryCallbackArgument* query_ptr                 = dynamic_cast<IsImageMemoryAllocPendingQueryCallbackArgument*>(in_callback_arg_ptr);
     auto                                            alloc_status_map_iterator = m_per_object_pending_alloc_status.find                       (query_ptr->image_ptr);
-    std::unique_lock<std::recursive_mutex>          mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex>          mutex_lock;
     auto                                            mutex_ptr                 = get_mutex();
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -2256,13 +2259,13 @@ void Anvil::MemoryAllocator::on_implicit_bake_needed()
 /* Please see header for specification */
 void Anvil::MemoryAllocator::set_post_bake_callback(MemoryAllocatorBakeCallbackFunction in_post_bake_callback_function)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr = get_mutex();
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
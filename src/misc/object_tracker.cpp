@@ -208,6 +208,18 @@ void Anvil::ObjectTracker::unregister_object(const ObjectType& in_object_type,
     }
 
     /* Notify any observers about the event. */
+    if (in_object_type == Anvil::ObjectType::BUFFER)
+    {
+        callback_safe(OBJECT_TRACKER_CALLBACK_ID_ON_BUFFER_OBJECT_ABOUT_TO_BE_UNREGISTERED,
+                     &callback_arg);
+    }
+    else
+    if (in_object_type == Anvil::ObjectType::BUFFER_VIEW)
+    {
+        callback_safe(OBJECT_TRACKER_CALLBACK_ID_ON_BUFFER_VIEW_OBJECT_ABOUT_TO_BE_UNREGISTERED,
+                     &callback_arg);
+    }
+    else
     if (in_object_type == Anvil::ObjectType::DEVICE)
     {
         callback_safe(OBJECT_TRACKER_CALLBACK_ID_ON_DEVICE_OBJECT_ABOUT_TO_BE_UNREGISTERED,
@@ -220,12 +232,24 @@ void Anvil::ObjectTracker::unregister_object(const ObjectType& in_object_type,
                      &callback_arg);
     }
     else
+    if (in_object_type == Anvil::ObjectType::IMAGE_VIEW)
+    {
+        callback_safe(OBJECT_TRACKER_CALLBACK_ID_ON_IMAGE_VIEW_OBJECT_ABOUT_TO_BE_UNREGISTERED,
+                     &callback_arg);
+    }
+    else
     if (in_object_type == Anvil::ObjectType::PIPELINE_LAYOUT)
     {
         callback_safe(OBJECT_TRACKER_CALLBACK_ID_ON_PIPELINE_LAYOUT_OBJECT_ABOUT_TO_BE_UNREGISTERED,
                      &callback_arg);
     }
     else
+    if (in_object_type == Anvil::ObjectType::SAMPLER)
+    {
+        callback_safe(OBJECT_TRACKER_CALLBACK_ID_ON_SAMPLER_OBJECT_ABOUT_TO_BE_UNREGISTERED,
+                     &callback_arg);
+    }
+    else
     if (in_object_type == Anvil::ObjectType::SHADER_MODULE)
     {
         callback_safe(OBJECT_TRACKER_CALLBACK_ID_ON_SHADER_MODULE_OBJECT_ABOUT_TO_BE_UNREGISTERED,
@@ -0,0 +1,199 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/parallel_render_pass_recorder.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include <atomic>
+
+
+/** Please see header for specification */
+Anvil::ParallelRenderPassRecorder::ParallelRenderPassRecorder(Anvil::BaseDevice* in_device_ptr,
+                                                              uint32_t           in_queue_family_index,
+                                                              uint32_t           in_n_worker_threads)
+    :m_device_ptr(in_device_ptr)
+{
+    uint32_t n_worker_threads = 0;
+
+    m_thread_pool_ptr = Anvil::ThreadPool::create(in_n_worker_threads);
+    n_worker_threads  = m_thread_pool_ptr->get_n_worker_threads();
+
+    m_worker_thread_data.resize(n_worker_threads);
+
+    for (auto& current_worker_thread_data : m_worker_thread_data)
+    {
+        /* Each pool is only ever accessed by a single thread at a time, so there is no need to pay for locking. */
+        current_worker_thread_data.command_pool_ptr = Anvil::CommandPool::create(in_device_ptr,
+                                                                                 Anvil::CommandPoolCreateFlagBits::CREATE_TRANSIENT_BIT,
+                                                                                 in_queue_family_index,
+                                                                                 Anvil::MTSafety::DISABLED);
+    }
+}
+
+/** Please see header for specification */
+Anvil::ParallelRenderPassRecorder::~ParallelRenderPassRecorder()
+{
+    /* Command buffers need to be released before their parent pools. */
+    for (auto& current_worker_thread_data : m_worker_thread_data)
+    {
+        current_worker_thread_data.cmd_buffer_ptrs.clear();
+        current_worker_thread_data.command_pool_ptr.reset();
+    }
+
+    m_thread_pool_ptr.reset();
+}
+
+/** Please see header for specification */
+Anvil::ParallelRenderPassRecorderUniquePtr Anvil::ParallelRenderPassRecorder::create(Anvil::BaseDevice* in_device_ptr,
+                                                                                     uint32_t           in_queue_family_index,
+                                                                                     uint32_t           in_n_worker_threads)
+{
+    Anvil::ParallelRenderPassRecorderUniquePtr result_ptr(nullptr,
+                                                          std::default_delete<Anvil::ParallelRenderPassRecorder>() );
+
+    anvil_assert(in_device_ptr != nullptr);
+
+    result_ptr.reset(
+        new Anvil::ParallelRenderPassRecorder(in_device_ptr,
+                                              in_queue_family_index,
+                                              in_n_worker_threads)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::ParallelRenderPassRecorder::record(Anvil::PrimaryCommandBuffer*      in_primary_cmd_buffer_ptr,
+                                               uint32_t                          in_n_slices,
+                                               Anvil::Framebuffer*               in_framebuffer_ptr,
+                                               Anvil::RenderPass*                in_render_pass_ptr,
+                                               Anvil::SubPassID                  in_subpass_id,
+                                               const SliceRecordingFunction&     in_slice_recording_function,
+                                               bool                              in_occlusion_query_used_by_primary_cmd_buffer,
+                                               Anvil::OcclusionQuerySupportScope in_required_occlusion_query_support_scope,
+                                               uint32_t                          in_opt_device_mask)
+{
+    std::atomic<bool> has_failed(false);
+    bool              result    (false);
+
+    anvil_assert(in_primary_cmd_buffer_ptr   != nullptr);
+    anvil_assert(in_render_pass_ptr          != nullptr);
+    anvil_assert(in_slice_recording_function != nullptr);
+
+    if (in_n_slices == 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    /* NOTE: Command buffers recorded by earlier record() calls may still be referenced by primary command buffers,
+     *       so new ones are always used. They are only recycled by reset(). */
+    m_slice_cmd_buffer_ptrs.resize(in_n_slices);
+
+    m_thread_pool_ptr->execute(
+        in_n_slices,
+        [&](uint32_t in_n_slice,
+            uint32_t in_n_worker_thread)
+        {
+            auto&                          worker_thread_data = m_worker_thread_data.at(in_n_worker_thread);
+            Anvil::SecondaryCommandBuffer* cmd_buffer_ptr     = nullptr;
+
+            if (worker_thread_data.n_cmd_buffers_used == worker_thread_data.cmd_buffer_ptrs.size() )
+            {
+                worker_thread_data.cmd_buffer_ptrs.push_back(
+                    worker_thread_data.command_pool_ptr->alloc_secondary_level_command_buffer()
+                );
+            }
+
+            cmd_buffer_ptr = worker_thread_data.cmd_buffer_ptrs.at(worker_thread_data.n_cmd_buffers_used++).get();
+
+            if (!cmd_buffer_ptr->start_recording(true,  /* in_one_time_submit          */
+                                                 false, /* in_simultaneous_use_allowed */
+                                                 true,  /* in_renderpass_usage_only    */
+                                                 in_framebuffer_ptr,
+                                                 in_render_pass_ptr,
+                                                 in_subpass_id,
+                                                 in_required_occlusion_query_support_scope,
+                                                 in_occlusion_query_used_by_primary_cmd_buffer,
+                                                 Anvil::QueryPipelineStatisticFlags(),
+                                                 in_opt_device_mask) )
+            {
+                has_failed = true;
+
+                return;
+            }
+
+            in_slice_recording_function(in_n_slice,
+                                        cmd_buffer_ptr);
+
+            if (!cmd_buffer_ptr->stop_recording() )
+            {
+                has_failed = true;
+            }
+
+            m_slice_cmd_buffer_ptrs.at(in_n_slice) = cmd_buffer_ptr;
+        }
+    );
+
+    if (has_failed)
+    {
+        anvil_assert(!has_failed);
+
+        goto end;
+    }
+
+    result = in_primary_cmd_buffer_ptr->record_execute_commands(in_n_slices,
+                                                               &m_slice_cmd_buffer_ptrs.at(0) );
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::ParallelRenderPassRecorder::reset()
+{
+    bool result = true;
+
+    /* Workers are idle at this point, so it is safe to recycle their command buffers from this thread.
+     * A single pool reset is much cheaper than resetting each command buffer separately.
+     */
+    for (auto& current_worker_thread_data : m_worker_thread_data)
+    {
+        if (current_worker_thread_data.n_cmd_buffers_used > 0)
+        {
+            if (!current_worker_thread_data.command_pool_ptr->reset(false /* in_release_resources */) )
+            {
+                anvil_assert_fail();
+
+                result = false;
+                continue;
+            }
+
+            current_worker_thread_data.n_cmd_buffers_used = 0;
+        }
+    }
+
+    return result;
+}
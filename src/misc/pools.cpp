@@ -21,9 +21,13 @@
 //
 
 #include "misc/debug.h"
+#include "misc/fence_create_info.h"
 #include "misc/pools.h"
+#include "misc/semaphore_create_info.h"
 #include "wrappers/command_buffer.h"
 #include "wrappers/command_pool.h"
+#include "wrappers/fence.h"
+#include "wrappers/semaphore.h"
 
 Anvil::PrimaryCommandBufferUniquePtr Anvil::PrimaryCommandBufferPoolWorker::create_item()
 {
@@ -44,4 +48,117 @@ Anvil::SecondaryCommandBufferUniquePtr Anvil::SecondaryCommandBufferPoolWorker::
 void Anvil::SecondaryCommandBufferPoolWorker::reset_item(Anvil::SecondaryCommandBufferUniquePtr& in_item_ptr)
 {
     in_item_ptr->reset(false /* should_release_resources */);
-}
\ No newline at end of file
+}
+
+
+Anvil::FenceUniquePtr Anvil::FencePoolWorker::create_item()
+{
+    auto create_info_ptr = Anvil::FenceCreateInfo::create(m_device_ptr,
+                                                          false); /* in_create_signalled */
+
+    return Anvil::Fence::create(std::move(create_info_ptr) );
+}
+
+
+Anvil::SemaphoreUniquePtr Anvil::SemaphorePoolWorker::create_item()
+{
+    auto create_info_ptr = Anvil::SemaphoreCreateInfo::create(m_device_ptr);
+
+    return Anvil::Semaphore::create(std::move(create_info_ptr) );
+}
+
+
+Anvil::FencePool::FencePool(uint32_t         in_n_preallocated_items,
+                            FencePoolWorker* in_pool_worker_ptr)
+    :GenericPool<Anvil::Fence, Anvil::FenceUniquePtr>(in_n_preallocated_items,
+                                                      in_pool_worker_ptr),
+     m_n_pending_items                               (0)
+{
+    /* Stub */
+}
+
+std::unique_ptr<Anvil::FencePool> Anvil::FencePool::create(const Anvil::BaseDevice* in_device_ptr,
+                                                           uint32_t                 in_n_preallocated_items)
+{
+    std::unique_ptr<Anvil::FencePool> result_ptr;
+
+    result_ptr.reset(
+        new Anvil::FencePool(in_n_preallocated_items,
+                             new FencePoolWorker(in_device_ptr) )
+    );
+
+    return result_ptr;
+}
+
+void Anvil::FencePool::flush()
+{
+    std::unique_lock<std::mutex> lock(m_pending_items_mutex);
+
+    flush_locked();
+}
+
+/* Called by get_item() if no fences are available. Resetting the pending fences is cheaper than creating a new one. */
+bool Anvil::FencePool::flush_postponed_items()
+{
+    std::unique_lock<std::mutex> lock  (m_pending_items_mutex);
+    const bool                   result(m_n_pending_items > 0);
+
+    flush_locked();
+
+    return result;
+}
+
+void Anvil::FencePool::flush_locked()
+{
+    Anvil::Fence* fence_ptrs[N_FENCES_PER_RESET_BATCH];
+
+    if (m_n_pending_items > 0)
+    {
+        for (uint32_t n_pending_item = 0;
+                      n_pending_item < m_n_pending_items;
+                    ++n_pending_item)
+        {
+            fence_ptrs[n_pending_item] = get_item_at_index(m_pending_items[n_pending_item]);
+        }
+
+        Anvil::Fence::reset_fences(m_n_pending_items,
+                                   fence_ptrs);
+
+        for (uint32_t n_pending_item = 0;
+                      n_pending_item < m_n_pending_items;
+                    ++n_pending_item)
+        {
+            GenericPool<Anvil::Fence, Anvil::FenceUniquePtr>::return_item(m_pending_items[n_pending_item]);
+        }
+
+        m_n_pending_items = 0;
+    }
+}
+
+void Anvil::FencePool::return_item(uint32_t in_n_item)
+{
+    std::unique_lock<std::mutex> lock(m_pending_items_mutex);
+
+    anvil_assert(m_n_pending_items < N_FENCES_PER_RESET_BATCH);
+
+    m_pending_items[m_n_pending_items++] = in_n_item;
+
+    if (m_n_pending_items == N_FENCES_PER_RESET_BATCH)
+    {
+        flush_locked();
+    }
+}
+
+
+std::unique_ptr<Anvil::SemaphorePool> Anvil::SemaphorePool::create(const Anvil::BaseDevice* in_device_ptr,
+                                                                   uint32_t                 in_n_preallocated_items)
+{
+    std::unique_ptr<Anvil::SemaphorePool> result_ptr;
+
+    result_ptr.reset(
+        new Anvil::SemaphorePool(in_n_preallocated_items,
+                                 new SemaphorePoolWorker(in_device_ptr) )
+    );
+
+    return result_ptr;
+}
@@ -39,11 +39,13 @@ Anvil::SemaphoreCreateInfo::SemaphoreCreateInfo(const Anvil::BaseDevice* in_devi
                                                 MTSafety                 in_mt_safety)
     :m_device_ptr                                             (in_device_ptr),
      m_exportable_external_semaphore_handle_types             (Anvil::ExternalSemaphoreHandleTypeFlagBits::NONE),
+     m_initial_value                                          (0),
 #if defined(_WIN32)
      m_exportable_nt_handle_info_specified                    (false),
      m_exportable_nt_handle_info_security_attributes_specified(false),
 #endif
-     m_mt_safety                                              (in_mt_safety)
+     m_mt_safety                                              (in_mt_safety),
+     m_semaphore_type                                         (Anvil::SemaphoreType::BINARY)
 {
     /* Stub */
 }
\ No newline at end of file
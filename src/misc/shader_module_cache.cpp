@@ -61,7 +61,7 @@ void Anvil::ShaderModuleCache::cache(Anvil::ShaderModule* in_shader_module_ptr)
     anvil_assert(in_shader_module_ptr != nullptr);
 
     {
-        std::unique_lock<std::recursive_mutex> mutex_lock(*get_mutex() );
+        std::unique_lock<Anvil::MTSafetyMutex> mutex_lock(*get_mutex() );
 
         auto items_map_iterator    = m_item_ptrs.find(hash);
         bool should_store_new_item = false;
@@ -149,7 +149,7 @@ Anvil::ShaderModuleUniquePtr Anvil::ShaderModuleCache::get_cached_shader_module(
     Anvil::ShaderModuleUniquePtr result_ptr;
 
     {
-        std::unique_lock<std::recursive_mutex> mutex_lock(*get_mutex() );
+        std::unique_lock<Anvil::MTSafetyMutex> mutex_lock(*get_mutex() );
 
         const auto hash              (get_hash(in_spirv_blob,
                                                in_n_spirv_blob_bytes,
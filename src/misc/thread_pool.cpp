@@ -0,0 +1,172 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/thread_pool.h"
+
+
+/** Please see header for specification */
+Anvil::ThreadPool::ThreadPool(uint32_t in_n_worker_threads)
+    :m_batch_id                (0),
+     m_current_job_function_ptr(nullptr),
+     m_n_jobs                  (0),
+     m_n_next_job              (0),
+     m_n_worker_threads_busy   (0),
+     m_should_terminate        (false)
+{
+    anvil_assert(in_n_worker_threads > 0);
+
+    for (uint32_t n_worker_thread = 0;
+                  n_worker_thread < in_n_worker_threads;
+                ++n_worker_thread)
+    {
+        m_worker_threads.push_back(
+            std::thread(&ThreadPool::worker_thread_entrypoint,
+                        this,
+                        n_worker_thread)
+        );
+    }
+}
+
+/** Please see header for specification */
+Anvil::ThreadPool::~ThreadPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_should_terminate = true;
+    }
+
+    m_batch_available_cv.notify_all();
+
+    for (auto& current_thread : m_worker_threads)
+    {
+        current_thread.join();
+    }
+}
+
+/** Please see header for specification */
+Anvil::ThreadPoolUniquePtr Anvil::ThreadPool::create(uint32_t in_n_worker_threads)
+{
+    Anvil::ThreadPoolUniquePtr result_ptr(nullptr,
+                                          std::default_delete<Anvil::ThreadPool>() );
+
+    if (in_n_worker_threads == 0)
+    {
+        in_n_worker_threads = std::max(std::thread::hardware_concurrency(),
+                                       1u);
+    }
+
+    result_ptr.reset(
+        new Anvil::ThreadPool(in_n_worker_threads)
+    );
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+void Anvil::ThreadPool::execute(uint32_t           in_n_jobs,
+                                const JobFunction& in_job_function)
+{
+    anvil_assert(in_job_function != nullptr);
+
+    if (in_n_jobs == 0)
+    {
+        goto end;
+    }
+
+    {
+        std::unique_lock<std::mutex> execute_lock(m_execute_mutex);
+        std::unique_lock<std::mutex> lock        (m_mutex);
+
+        m_current_job_function_ptr = &in_job_function;
+        m_n_jobs                   = in_n_jobs;
+        m_n_next_job               = 0;
+        m_n_worker_threads_busy    = static_cast<uint32_t>(m_worker_threads.size() );
+
+        ++m_batch_id;
+
+        m_batch_available_cv.notify_all();
+        m_batch_finished_cv.wait(lock,
+                                 [this]()
+                                 {
+                                     return (m_n_worker_threads_busy == 0);
+                                 });
+
+        m_current_job_function_ptr = nullptr;
+    }
+
+end:
+    ;
+}
+
+/** Main loop of each worker thread. Every worker takes part in each batch submitted via execute(),
+ *  picking up job indices until none are left.
+ *
+ *  @param in_n_worker_thread Index of the worker thread.
+ */
+void Anvil::ThreadPool::worker_thread_entrypoint(uint32_t in_n_worker_thread)
+{
+    uint64_t last_batch_id = 0;
+
+    while (true)
+    {
+        const JobFunction* job_function_ptr = nullptr;
+        uint32_t           n_jobs           = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_batch_available_cv.wait(lock,
+                                      [this, &last_batch_id]()
+                                      {
+                                          return (m_should_terminate || m_batch_id != last_batch_id);
+                                      });
+
+            if (m_should_terminate)
+            {
+                break;
+            }
+
+            job_function_ptr = m_current_job_function_ptr;
+            last_batch_id    = m_batch_id;
+            n_jobs           = m_n_jobs;
+        }
+
+        for (uint32_t n_job  = m_n_next_job.fetch_add(1);
+                      n_job  < n_jobs;
+                      n_job  = m_n_next_job.fetch_add(1) )
+        {
+            (*job_function_ptr)(n_job,
+                                in_n_worker_thread);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            if (--m_n_worker_threads_busy == 0)
+            {
+                m_batch_finished_cv.notify_all();
+            }
+        }
+    }
+}
@@ -21,6 +21,193 @@
 //
 
 #include "misc/time.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+
+
+namespace
+{
+    /* Number of samples each thread's ring buffer holds. Older samples are overwritten. */
+    const uint32_t g_n_samples_per_thread = 4096;
+
+    typedef struct ScopeSample
+    {
+        std::atomic<uint64_t>    duration_ns;
+        std::atomic<const char*> name;
+    } ScopeSample;
+
+    /* Single-producer, multi-consumer ring of samples. Only the owning thread writes to the ring. Readers detect
+     * samples which were overwritten while they were being copied by re-reading the write counter afterward. */
+    typedef struct ThreadSampleRing
+    {
+        bool                  is_owner_alive; /* guarded by g_thread_sample_rings_mutex */
+        std::atomic<uint64_t> n_first_valid_sample;
+        std::atomic<uint64_t> n_samples_written;
+        ScopeSample           samples[g_n_samples_per_thread];
+
+        ThreadSampleRing()
+            :is_owner_alive      (true),
+             n_first_valid_sample(0),
+             n_samples_written   (0)
+        {
+            for (auto& current_sample : samples)
+            {
+                current_sample.duration_ns.store(0,       std::memory_order_relaxed);
+                current_sample.name.store       (nullptr, std::memory_order_relaxed);
+            }
+        }
+    } ThreadSampleRing;
+
+    std::atomic<bool> g_scope_profiling_enabled(false);
+    std::mutex        g_thread_sample_rings_mutex;
+
+    /* Rings of finished threads stay registered until the next collection drains them. */
+    std::vector<std::shared_ptr<ThreadSampleRing> >& get_thread_sample_rings()
+    {
+        static std::vector<std::shared_ptr<ThreadSampleRing> > rings;
+
+        return rings;
+    }
+
+    /* Owns the calling thread's ring. Marks the ring as retired at thread exit, so that it gets unregistered. */
+    typedef struct ThreadSampleRingHolder
+    {
+        std::shared_ptr<ThreadSampleRing> ring_ptr;
+
+        ~ThreadSampleRingHolder()
+        {
+            if (ring_ptr != nullptr)
+            {
+                std::unique_lock<std::mutex> lock(g_thread_sample_rings_mutex);
+
+                ring_ptr->is_owner_alive = false;
+            }
+        }
+    } ThreadSampleRingHolder;
+
+    ThreadSampleRing* get_thread_sample_ring()
+    {
+        static thread_local ThreadSampleRingHolder holder;
+
+        if (holder.ring_ptr == nullptr)
+        {
+            std::unique_lock<std::mutex> lock(g_thread_sample_rings_mutex);
+
+            holder.ring_ptr.reset(
+                new ThreadSampleRing()
+            );
+
+            get_thread_sample_rings().push_back(holder.ring_ptr);
+        }
+
+        return holder.ring_ptr.get();
+    }
+
+    /* Unregisters rings of finished threads. Must be called with g_thread_sample_rings_mutex locked. */
+    void remove_retired_thread_sample_rings()
+    {
+        auto& rings = get_thread_sample_rings();
+
+        rings.erase(std::remove_if(rings.begin(),
+                                   rings.end  (),
+                                   [](const std::shared_ptr<ThreadSampleRing>& in_ring_ptr)
+                                   {
+                                       return !in_ring_ptr->is_owner_alive;
+                                   }),
+                    rings.end() );
+    }
+
+    /* Copies all samples currently held by the rings, grouped by scope name. Rings of finished threads are drained
+     * and unregistered, so their samples are only reported by the first collection after the thread exits. */
+    void gather_scope_samples(std::map<std::string, std::vector<uint64_t> >* out_samples_ptr)
+    {
+        std::vector<std::shared_ptr<ThreadSampleRing> > rings;
+
+        {
+            std::unique_lock<std::mutex> lock(g_thread_sample_rings_mutex);
+
+            rings = get_thread_sample_rings();
+
+            remove_retired_thread_sample_rings();
+        }
+
+        for (const auto& current_ring_ptr : rings)
+        {
+            std::vector<std::pair<const char*, uint64_t> > copied_samples;
+            const uint64_t                                 n_samples_written     = current_ring_ptr->n_samples_written.load(std::memory_order_acquire);
+            uint64_t                                       n_first_sample        = std::max(current_ring_ptr->n_first_valid_sample.load(std::memory_order_relaxed),
+                                                                                            (n_samples_written > g_n_samples_per_thread) ? n_samples_written - g_n_samples_per_thread : 0);
+            uint64_t                                       n_samples_written_now;
+
+            copied_samples.reserve(static_cast<size_t>(n_samples_written - std::min(n_first_sample, n_samples_written) ));
+
+            for (uint64_t n_sample = n_first_sample;
+                          n_sample < n_samples_written;
+                        ++n_sample)
+            {
+                const auto& current_sample = current_ring_ptr->samples[n_sample % g_n_samples_per_thread];
+
+                copied_samples.push_back(std::make_pair(current_sample.name.load       (std::memory_order_relaxed),
+                                                        current_sample.duration_ns.load(std::memory_order_relaxed) ));
+            }
+
+            /* Samples the owning thread overwrote in the meantime, including the one it may be writing right now,
+             * must be discarded. */
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            n_samples_written_now = current_ring_ptr->n_samples_written.load(std::memory_order_relaxed);
+
+            if (n_samples_written_now + 1 > g_n_samples_per_thread)
+            {
+                const uint64_t n_first_intact_sample = n_samples_written_now + 1 - g_n_samples_per_thread;
+
+                if (n_first_intact_sample > n_first_sample)
+                {
+                    const uint64_t n_samples_to_discard = std::min(n_first_intact_sample - n_first_sample,
+                                                                   static_cast<uint64_t>(copied_samples.size() ));
+
+                    copied_samples.erase(copied_samples.begin(),
+                                         copied_samples.begin() + static_cast<ptrdiff_t>(n_samples_to_discard) );
+                }
+            }
+
+            for (const auto& current_sample : copied_samples)
+            {
+                if (current_sample.first != nullptr)
+                {
+                    (*out_samples_ptr)[current_sample.first].push_back(current_sample.second);
+                }
+            }
+        }
+    }
+
+    /* Computes stats of a single scope. Sorts @param in_samples. */
+    void calculate_scope_stats(const std::string&       in_name,
+                               std::vector<uint64_t>&   in_samples,
+                               Anvil::Time::ScopeStats* out_stats_ptr)
+    {
+        const uint32_t n_samples = static_cast<uint32_t>(in_samples.size() );
+        double         sum_ns    = 0.0;
+
+        std::sort(in_samples.begin(),
+                  in_samples.end  () );
+
+        for (const auto& current_sample : in_samples)
+        {
+            sum_ns += static_cast<double>(current_sample);
+        }
+
+        out_stats_ptr->avg_ns    = sum_ns / static_cast<double>(n_samples);
+        out_stats_ptr->max_ns    = in_samples.back ();
+        out_stats_ptr->min_ns    = in_samples.front();
+        out_stats_ptr->n_samples = n_samples;
+        out_stats_ptr->name      = in_name;
+        out_stats_ptr->p99_ns    = in_samples.at((n_samples * 99 + 99) / 100 - 1); /* nearest-rank */
+    }
+};
 
 
 /** Please see header for specification */
@@ -40,6 +227,8 @@ Anvil::Time::Time()
         m_start_time = static_cast<uint64_t>(1000LL /* SEC_TO_MSEC */ * current_timespec.tv_sec + current_timespec.tv_nsec / 1000000LL /* MSEC_TO_NSEC */);
     }
     #endif
+
+    m_start_time_ns = get_current_time_in_nsec();
 }
 
 /** Please see header for specification */
@@ -48,6 +237,108 @@ Anvil::Time::~Time()
     /* Stub */
 }
 
+/** Please see header for specification */
+void Anvil::Time::add_scope_sample(const char* in_name,
+                                   uint64_t    in_duration_ns)
+{
+    ThreadSampleRing* ring_ptr = nullptr;
+    uint64_t          n_sample;
+
+    if (!is_scope_profiling_enabled() )
+    {
+        return;
+    }
+
+    ring_ptr = get_thread_sample_ring();
+    n_sample = ring_ptr->n_samples_written.load(std::memory_order_relaxed);
+
+    {
+        auto& sample = ring_ptr->samples[n_sample % g_n_samples_per_thread];
+
+        sample.duration_ns.store(in_duration_ns, std::memory_order_relaxed);
+        sample.name.store       (in_name,        std::memory_order_relaxed);
+    }
+
+    ring_ptr->n_samples_written.store(n_sample + 1,
+                                      std::memory_order_release);
+}
+
+/** Please see header for specification */
+uint64_t Anvil::Time::get_current_time_in_nsec()
+{
+    uint64_t result = 0;
+
+    #ifdef _WIN32
+    {
+        LARGE_INTEGER current_time;
+        LARGE_INTEGER frequency;
+
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter  (&current_time);
+
+        /* Split the conversion to avoid overflowing 64 bits for large counter values */
+        result = static_cast<uint64_t>((current_time.QuadPart / frequency.QuadPart) * 1000000000LL /* ns in s */ +
+                                       (current_time.QuadPart % frequency.QuadPart) * 1000000000LL /* ns in s */ / frequency.QuadPart);
+    }
+    #else
+    {
+        struct timespec current_timespec;
+
+        clock_gettime(CLOCK_MONOTONIC, &current_timespec);
+
+        result = static_cast<uint64_t>(1000000000LL /* SEC_TO_NSEC */ * current_timespec.tv_sec + current_timespec.tv_nsec);
+    }
+    #endif
+
+    /* 0 is used as a "not set" marker by scoped profiles */
+    return (result != 0) ? result : 1;
+}
+
+/** Please see header for specification */
+void Anvil::Time::get_scope_stats(std::vector<ScopeStats>* out_stats_ptr)
+{
+    std::map<std::string, std::vector<uint64_t> > samples;
+
+    gather_scope_samples(&samples);
+
+    out_stats_ptr->clear  ();
+    out_stats_ptr->reserve(samples.size() );
+
+    for (auto& current_scope : samples)
+    {
+        ScopeStats new_stats;
+
+        calculate_scope_stats(current_scope.first,
+                              current_scope.second,
+                             &new_stats);
+
+        out_stats_ptr->push_back(std::move(new_stats) );
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::Time::get_scope_stats(const std::string& in_name,
+                                  ScopeStats*        out_stats_ptr)
+{
+    std::map<std::string, std::vector<uint64_t> > samples;
+    decltype(samples)::iterator                    scope_iterator;
+
+    gather_scope_samples(&samples);
+
+    scope_iterator = samples.find(in_name);
+
+    if (scope_iterator == samples.end() )
+    {
+        return false;
+    }
+
+    calculate_scope_stats(scope_iterator->first,
+                          scope_iterator->second,
+                          out_stats_ptr);
+
+    return true;
+}
+
 /** Please see header for specification */
 uint64_t Anvil::Time::get_time_in_msec()
 {
@@ -73,3 +364,35 @@ uint64_t Anvil::Time::get_time_in_msec()
 
     return result;
 }
+
+/** Please see header for specification */
+uint64_t Anvil::Time::get_time_in_nsec()
+{
+    return get_current_time_in_nsec() - m_start_time_ns;
+}
+
+/** Please see header for specification */
+bool Anvil::Time::is_scope_profiling_enabled()
+{
+    return g_scope_profiling_enabled.load(std::memory_order_relaxed);
+}
+
+/** Please see header for specification */
+void Anvil::Time::reset_scope_stats()
+{
+    std::unique_lock<std::mutex> lock(g_thread_sample_rings_mutex);
+
+    remove_retired_thread_sample_rings();
+
+    for (auto& current_ring_ptr : get_thread_sample_rings() )
+    {
+        current_ring_ptr->n_first_valid_sample.store(current_ring_ptr->n_samples_written.load(std::memory_order_acquire),
+                                                     std::memory_order_relaxed);
+    }
+}
+
+/** Please see header for specification */
+void Anvil::Time::set_scope_profiling_enabled(bool in_enabled)
+{
+    g_scope_profiling_enabled.store(in_enabled);
+}
@@ -0,0 +1,801 @@
+//
+// Copyright (c) 2017-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "misc/debug.h"
+#include "misc/io.h"
+#include "misc/tracer.h"
+#include "wrappers/command_buffer.h"
+#include "wrappers/command_pool.h"
+#include "wrappers/device.h"
+#include "wrappers/query_pool.h"
+#include "wrappers/queue.h"
+#include <algorithm>
+#include <sstream>
+
+
+namespace
+{
+    std::atomic<bool>           g_is_capturing         (false);
+    std::atomic<uint32_t>       g_n_tracers_created    (0);
+    std::atomic<Anvil::Tracer*> g_tracer_ptr           (nullptr);
+    std::mutex                  g_tracer_creation_mutex;
+
+    /* Caches the calling thread's span buffer. The generation number tells which tracer instance the buffer
+     * belongs to, so that stale buffers are not used after the tracer is destroyed and re-created. */
+    template<typename ThreadDataType>
+    struct CPUThreadDataCache
+    {
+        uint32_t                        generation;
+        std::shared_ptr<ThreadDataType> data_ptr;
+
+        CPUThreadDataCache()
+            :generation(UINT32_MAX)
+        {
+            /* Stub */
+        }
+    };
+
+    /* Writes @param in_string to @param in_stream as a JSON string literal. */
+    void write_json_string(std::stringstream& in_stream,
+                           const char*        in_string)
+    {
+        in_stream << '"';
+
+        for (const char* current_char_ptr = in_string;
+                        *current_char_ptr != 0;
+                       ++current_char_ptr)
+        {
+            const char current_char = *current_char_ptr;
+
+            switch (current_char)
+            {
+                case '"':  in_stream << "\\\""; break;
+                case '\\': in_stream << "\\\\"; break;
+                case '\n': in_stream << "\\n";  break;
+                case '\r': in_stream << "\\r";  break;
+                case '\t': in_stream << "\\t";  break;
+
+                default:
+                {
+                    if (static_cast<unsigned char>(current_char) < 0x20)
+                    {
+                        char temp[8];
+
+                        snprintf(temp,
+                                 sizeof(temp),
+                                 "\\u%04x",
+                                 static_cast<unsigned int>(current_char) );
+
+                        in_stream << temp;
+                    }
+                    else
+                    {
+                        in_stream << current_char;
+                    }
+                }
+            }
+        }
+
+        in_stream << '"';
+    }
+
+    /* Writes a single complete ("X") event. Times are converted from nanoseconds to the microseconds used by the format. */
+    void write_json_span(std::stringstream& in_stream,
+                         const char*        in_name,
+                         const char*        in_category,
+                         uint32_t           in_pid,
+                         uint32_t           in_tid,
+                         uint64_t           in_start_time_ns,
+                         uint64_t           in_end_time_ns,
+                         uint64_t           in_base_time_ns,
+                         bool*              inout_is_first_event_ptr)
+    {
+        char           temp[128];
+        const int64_t  start_ns = static_cast<int64_t>(in_start_time_ns - in_base_time_ns);
+        const uint64_t dur_ns   = (in_end_time_ns > in_start_time_ns) ? (in_end_time_ns - in_start_time_ns) : 0;
+
+        in_stream << ((*inout_is_first_event_ptr) ? "\n" : ",\n")
+                  << "{\"name\":";
+
+        write_json_string(in_stream,
+                          in_name);
+
+        snprintf(temp,
+                 sizeof(temp),
+                 ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                 in_category,
+                 in_pid,
+                 in_tid,
+                 static_cast<double>(start_ns) / 1000.0,
+                 static_cast<double>(dur_ns)   / 1000.0);
+
+        in_stream << temp;
+
+        *inout_is_first_event_ptr = false;
+    }
+
+    /* Writes a metadata ("M") event, which names a process or a thread. */
+    void write_json_name(std::stringstream& in_stream,
+                         const char*        in_event_name,
+                         uint32_t           in_pid,
+                         uint32_t           in_tid,
+                         const char*        in_name,
+                         bool*              inout_is_first_event_ptr)
+    {
+        in_stream << ((*inout_is_first_event_ptr) ? "\n" : ",\n")
+                  << "{\"name\":\""
+                  << in_event_name
+                  << "\",\"ph\":\"M\",\"pid\":"
+                  << in_pid
+                  << ",\"tid\":"
+                  << in_tid
+                  << ",\"args\":{\"name\":";
+
+        write_json_string(in_stream,
+                          in_name);
+
+        in_stream << "}}";
+
+        *inout_is_first_event_ptr = false;
+    }
+};
+
+
+/** Please see header for specification */
+Anvil::Tracer::Tracer()
+    :m_capture_start_time_ns (0),
+     m_generation            (g_n_tracers_created.fetch_add(1) ),
+     m_max_n_spans_per_thread(0)
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+void Anvil::Tracer::add_cpu_span(const char* in_name,
+                                 uint64_t    in_start_time_ns,
+                                 uint64_t    in_end_time_ns)
+{
+    CPUThreadData* thread_data_ptr = nullptr;
+
+    if (!is_capturing() )
+    {
+        return;
+    }
+
+    thread_data_ptr = get_cpu_thread_data();
+
+    {
+        std::unique_lock<std::mutex> lock(thread_data_ptr->mutex);
+
+        if (thread_data_ptr->spans.size() >= m_max_n_spans_per_thread.load(std::memory_order_relaxed) )
+        {
+            thread_data_ptr->n_dropped_spans++;
+
+            return;
+        }
+
+        thread_data_ptr->spans.push_back(CPUSpan() );
+
+        auto& new_span = thread_data_ptr->spans.back();
+
+        new_span.end_time_ns   = in_end_time_ns;
+        new_span.name          = in_name;
+        new_span.start_time_ns = in_start_time_ns;
+    }
+}
+
+/** Please see header for specification */
+void Anvil::Tracer::add_gpu_span(const Anvil::Queue* in_queue_ptr,
+                                 const std::string&  in_name,
+                                 uint64_t            in_start_time_ns,
+                                 uint64_t            in_end_time_ns)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    QueueData*                   queue_data_ptr;
+
+    anvil_assert(in_queue_ptr != nullptr);
+
+    if (!is_capturing() )
+    {
+        return;
+    }
+
+    queue_data_ptr = &m_queue_data[in_queue_ptr];
+
+    if (queue_data_ptr->queue_family_index == UINT32_MAX)
+    {
+        queue_data_ptr->queue_family_index = in_queue_ptr->get_queue_family_index();
+        queue_data_ptr->queue_index        = in_queue_ptr->get_queue_index       ();
+        queue_data_ptr->track_index        = static_cast<uint32_t>(m_queue_data.size() - 1);
+    }
+
+    if (queue_data_ptr->spans.size() >= m_max_n_spans_per_thread.load(std::memory_order_relaxed) )
+    {
+        queue_data_ptr->n_dropped_spans++;
+
+        return;
+    }
+
+    queue_data_ptr->spans.push_back(GPUSpan() );
+
+    auto& new_span = queue_data_ptr->spans.back();
+
+    new_span.end_time_ns   = in_end_time_ns;
+    new_span.name          = in_name;
+    new_span.start_time_ns = in_start_time_ns;
+}
+
+/** Please see header for specification */
+bool Anvil::Tracer::calibrate_queue(Anvil::Queue* in_queue_ptr)
+{
+    Anvil::PrimaryCommandBufferUniquePtr cmd_buffer_ptr;
+    Anvil::CommandPoolUniquePtr          command_pool_ptr;
+    uint64_t                             cpu_time_after_ns  = 0;
+    uint64_t                             cpu_time_before_ns = 0;
+    Anvil::BaseDevice*                   device_ptr         = nullptr;
+    const Anvil::QueueFamilyInfo*        queue_family_info_ptr;
+    Anvil::QueryPoolUniquePtr            query_pool_ptr;
+    bool                                 result             = false;
+    bool                                 result_available   = false;
+    uint64_t                             timestamp          = 0;
+    uint64_t                             timestamp_mask;
+
+    anvil_assert(in_queue_ptr != nullptr);
+
+    /* Command pools require a non-const device, which queues do not expose. */
+    device_ptr            = const_cast<Anvil::BaseDevice*>(in_queue_ptr->get_parent_device() );
+    queue_family_info_ptr = device_ptr->get_queue_family_info(in_queue_ptr->get_queue_family_index() );
+
+    if (queue_family_info_ptr                   == nullptr ||
+        queue_family_info_ptr->n_timestamp_bits == 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    timestamp_mask = (queue_family_info_ptr->n_timestamp_bits >= 64) ? UINT64_MAX
+                                                                      : ((1ull << queue_family_info_ptr->n_timestamp_bits) - 1);
+
+    command_pool_ptr = Anvil::CommandPool::create(device_ptr,
+                                                  Anvil::CommandPoolCreateFlagBits::CREATE_TRANSIENT_BIT,
+                                                  in_queue_ptr->get_queue_family_index(),
+                                                  Anvil::MTSafety::DISABLED);
+    query_pool_ptr   = Anvil::QueryPool::create_non_ps_query_pool(device_ptr,
+                                                                  VK_QUERY_TYPE_TIMESTAMP,
+                                                                  1, /* in_n_max_concurrent_queries */
+                                                                  Anvil::MTSafety::DISABLED);
+
+    if (command_pool_ptr == nullptr ||
+        query_pool_ptr   == nullptr)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    cmd_buffer_ptr = command_pool_ptr->alloc_primary_level_command_buffer();
+
+    if (cmd_buffer_ptr == nullptr)
+    {
+        anvil_assert(cmd_buffer_ptr != nullptr);
+
+        goto end;
+    }
+
+    cmd_buffer_ptr->start_recording(true,  /* one_time_submit          */
+                                    false); /* simultaneous_use_allowed */
+    {
+        cmd_buffer_ptr->record_reset_query_pool(query_pool_ptr.get(),
+                                                0,  /* in_start_query */
+                                                1); /* in_query_count */
+        cmd_buffer_ptr->record_write_timestamp (Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT,
+                                                query_pool_ptr.get(),
+                                                0); /* in_entry */
+    }
+    cmd_buffer_ptr->stop_recording();
+
+    /* The timestamp is written at some point between the two CPU time reads. Assume it sits half-way. */
+    cpu_time_before_ns = get_time_in_nsec();
+    {
+        if (!in_queue_ptr->submit(Anvil::SubmitInfo::create(cmd_buffer_ptr.get(),
+                                                            0,        /* in_n_semaphores_to_signal */
+                                                            nullptr,  /* in_opt_semaphore_to_signal_ptrs_ptr */
+                                                            0,        /* in_n_semaphores_to_wait_on */
+                                                            nullptr,  /* in_opt_semaphore_to_wait_on_ptrs_ptr */
+                                                            nullptr,  /* in_opt_dst_stage_masks_to_wait_on_ptrs */
+                                                            true) ))  /* in_should_block */
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+    cpu_time_after_ns = get_time_in_nsec();
+
+    if (!query_pool_ptr->get_query_pool_results(0, /* in_first_query_index */
+                                                1, /* in_n_queries */
+                                                Anvil::QueryResultFlagBits::WAIT_BIT,
+                                               &timestamp,
+                                               &result_available) ||
+        !result_available)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock      (m_mutex);
+        auto&                        queue_data(m_queue_data[in_queue_ptr]);
+
+        if (queue_data.queue_family_index == UINT32_MAX)
+        {
+            queue_data.queue_family_index = in_queue_ptr->get_queue_family_index();
+            queue_data.queue_index        = in_queue_ptr->get_queue_index       ();
+            queue_data.track_index        = static_cast<uint32_t>(m_queue_data.size() - 1);
+        }
+
+        queue_data.is_calibrated  = true;
+        queue_data.ns_per_tick    = static_cast<double>(device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr->limits.timestamp_period);
+        queue_data.timestamp_mask = timestamp_mask;
+        queue_data.offset_ns      = static_cast<int64_t>(cpu_time_before_ns + (cpu_time_after_ns - cpu_time_before_ns) / 2) -
+                                    static_cast<int64_t>(static_cast<double>(timestamp & timestamp_mask) * queue_data.ns_per_tick);
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::Tracer::clear()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (auto& current_thread_data_ptr : m_cpu_thread_data_ptrs)
+    {
+        std::unique_lock<std::mutex> thread_lock(current_thread_data_ptr->mutex);
+
+        current_thread_data_ptr->n_dropped_spans = 0;
+        current_thread_data_ptr->spans.clear();
+    }
+
+    for (auto& current_queue_data : m_queue_data)
+    {
+        current_queue_data.second.n_dropped_spans = 0;
+        current_queue_data.second.spans.clear();
+    }
+}
+
+/** Please see header for specification */
+bool Anvil::Tracer::convert_gpu_timestamp(const Anvil::Queue* in_queue_ptr,
+                                          uint64_t            in_timestamp,
+                                          uint64_t*           out_time_ns_ptr) const
+{
+    std::unique_lock<std::mutex> lock          (m_mutex);
+    auto                         queue_data_iterator = m_queue_data.find(in_queue_ptr);
+
+    if (queue_data_iterator == m_queue_data.end() ||
+        !queue_data_iterator->second.is_calibrated)
+    {
+        return false;
+    }
+
+    const auto& queue_data = queue_data_iterator->second;
+
+    *out_time_ns_ptr = static_cast<uint64_t>(static_cast<int64_t>(static_cast<double>(in_timestamp & queue_data.timestamp_mask) * queue_data.ns_per_tick) + queue_data.offset_ns);
+
+    return true;
+}
+
+/** Please see header for specification */
+void Anvil::Tracer::destroy()
+{
+    std::unique_lock<std::mutex> lock(g_tracer_creation_mutex);
+
+    g_is_capturing = false;
+
+    delete g_tracer_ptr.exchange(nullptr);
+}
+
+/** Please see header for specification */
+bool Anvil::Tracer::export_chrome_trace(const std::string& in_filename) const
+{
+    bool                         is_first_event = true;
+    std::unique_lock<std::mutex> lock          (m_mutex);
+    std::stringstream            stream;
+
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    write_json_name(stream, "process_name", 0 /* pid */, 0 /* tid */, "CPU", &is_first_event);
+    write_json_name(stream, "process_name", 1 /* pid */, 0 /* tid */, "GPU", &is_first_event);
+
+    for (const auto& current_thread_data_ptr : m_cpu_thread_data_ptrs)
+    {
+        std::unique_lock<std::mutex> thread_lock(current_thread_data_ptr->mutex);
+        std::string                  thread_name(current_thread_data_ptr->name);
+
+        if (thread_name.empty() )
+        {
+            thread_name = "Thread " + std::to_string(current_thread_data_ptr->thread_index);
+        }
+
+        if (current_thread_data_ptr->n_dropped_spans > 0)
+        {
+            thread_name += " (" + std::to_string(current_thread_data_ptr->n_dropped_spans) + " spans dropped)";
+        }
+
+        write_json_name(stream,
+                        "thread_name",
+                        0, /* pid */
+                        current_thread_data_ptr->thread_index,
+                        thread_name.c_str(),
+                       &is_first_event);
+
+        for (const auto& current_span : current_thread_data_ptr->spans)
+        {
+            write_json_span(stream,
+                            current_span.name,
+                            "cpu",
+                            0, /* pid */
+                            current_thread_data_ptr->thread_index,
+                            current_span.start_time_ns,
+                            current_span.end_time_ns,
+                            m_capture_start_time_ns,
+                           &is_first_event);
+        }
+    }
+
+    for (const auto& current_queue_data : m_queue_data)
+    {
+        std::string queue_name = "Queue family " + std::to_string(current_queue_data.second.queue_family_index) +
+                                 ", index "      + std::to_string(current_queue_data.second.queue_index);
+
+        if (current_queue_data.second.n_dropped_spans > 0)
+        {
+            queue_name += " (" + std::to_string(current_queue_data.second.n_dropped_spans) + " spans dropped)";
+        }
+
+        write_json_name(stream,
+                        "thread_name",
+                        1, /* pid */
+                        current_queue_data.second.track_index,
+                        queue_name.c_str(),
+                       &is_first_event);
+
+        for (const auto& current_span : current_queue_data.second.spans)
+        {
+            write_json_span(stream,
+                            current_span.name.c_str(),
+                            "gpu",
+                            1, /* pid */
+                            current_queue_data.second.track_index,
+                            current_span.start_time_ns,
+                            current_span.end_time_ns,
+                            m_capture_start_time_ns,
+                           &is_first_event);
+        }
+    }
+
+    stream << "\n]}\n";
+
+    return Anvil::IO::write_text_file(in_filename,
+                                      stream.str() );
+}
+
+/** Please see header for specification */
+Anvil::Tracer* Anvil::Tracer::get()
+{
+    Anvil::Tracer* result_ptr = g_tracer_ptr.load();
+
+    if (result_ptr == nullptr)
+    {
+        std::unique_lock<std::mutex> lock(g_tracer_creation_mutex);
+
+        result_ptr = g_tracer_ptr.load();
+
+        if (result_ptr == nullptr)
+        {
+            result_ptr = new Anvil::Tracer();
+
+            g_tracer_ptr.store(result_ptr);
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Returns the span buffer of the calling thread, creating it first if necessary. */
+Anvil::Tracer::CPUThreadData* Anvil::Tracer::get_cpu_thread_data()
+{
+    static thread_local CPUThreadDataCache<CPUThreadData> cache;
+
+    if (cache.generation != m_generation ||
+        cache.data_ptr   == nullptr)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        cache.data_ptr.reset(
+            new CPUThreadData(static_cast<uint32_t>(m_cpu_thread_data_ptrs.size() ))
+        );
+        cache.generation = m_generation;
+
+        m_cpu_thread_data_ptrs.push_back(cache.data_ptr);
+    }
+
+    return cache.data_ptr.get();
+}
+
+/** Please see header for specification */
+bool Anvil::Tracer::is_capturing()
+{
+    return g_is_capturing.load(std::memory_order_relaxed);
+}
+
+/** Please see header for specification */
+void Anvil::Tracer::set_thread_name(const std::string& in_name)
+{
+    CPUThreadData* thread_data_ptr = get_cpu_thread_data();
+
+    std::unique_lock<std::mutex> lock(thread_data_ptr->mutex);
+
+    thread_data_ptr->name = in_name;
+}
+
+/** Please see header for specification */
+void Anvil::Tracer::start_capture(uint32_t in_max_n_spans_per_thread)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_capture_start_time_ns == 0)
+    {
+        m_capture_start_time_ns = get_time_in_nsec();
+    }
+
+    m_max_n_spans_per_thread = in_max_n_spans_per_thread;
+    g_is_capturing           = true;
+}
+
+/** Please see header for specification */
+void Anvil::Tracer::stop_capture()
+{
+    g_is_capturing = false;
+}
+
+
+/** Please see header for specification */
+Anvil::GPUSpanRecorder::GPUSpanRecorder(const Anvil::BaseDevice* in_device_ptr,
+                                        uint32_t                 in_max_n_spans)
+    :m_device_ptr (in_device_ptr),
+     m_max_n_spans(in_max_n_spans)
+{
+    anvil_assert(in_device_ptr  != nullptr);
+    anvil_assert(in_max_n_spans >  0);
+}
+
+/** Please see header for specification */
+Anvil::GPUSpanRecorder::~GPUSpanRecorder()
+{
+    /* Stub */
+}
+
+/** Please see header for specification */
+bool Anvil::GPUSpanRecorder::collect(const Anvil::Queue* in_queue_ptr)
+{
+    const uint32_t n_spans    = static_cast<uint32_t>(m_spans.size() );
+    bool           result     = false;
+    auto           tracer_ptr = Anvil::Tracer::get();
+
+    if (n_spans == 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    /* Timestamps of spans which have not ended were never written, so waiting on them would block forever. Read
+     * the whole range at once only if all spans ended. */
+    if (std::all_of(m_spans.begin(),
+                    m_spans.end  (),
+                    [](const Span& in_span)
+                    {
+                        return in_span.has_ended;
+                    }) )
+    {
+        bool result_available = false;
+
+        if (!m_query_pool_ptr->get_query_pool_results(0, /* in_first_query_index */
+                                                      n_spans * 2,
+                                                      Anvil::QueryResultFlagBits::WAIT_BIT,
+                                                     &m_timestamps.at(0),
+                                                     &result_available) ||
+            !result_available)
+        {
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+    else
+    {
+        for (uint32_t n_span = 0;
+                      n_span < n_spans;
+                    ++n_span)
+        {
+            bool result_available = false;
+
+            if (!m_spans.at(n_span).has_ended)
+            {
+                continue;
+            }
+
+            if (!m_query_pool_ptr->get_query_pool_results(n_span * 2,
+                                                          2, /* in_n_queries */
+                                                          Anvil::QueryResultFlagBits::WAIT_BIT,
+                                                         &m_timestamps.at(n_span * 2),
+                                                         &result_available) ||
+                !result_available)
+            {
+                anvil_assert_fail();
+
+                goto end;
+            }
+        }
+    }
+
+    for (uint32_t n_span = 0;
+                  n_span < n_spans;
+                ++n_span)
+    {
+        uint64_t end_time_ns   = 0;
+        uint64_t start_time_ns = 0;
+
+        if (!m_spans.at(n_span).has_ended)
+        {
+            continue;
+        }
+
+        if (!tracer_ptr->convert_gpu_timestamp(in_queue_ptr,
+                                               m_timestamps.at(n_span * 2),
+                                              &start_time_ns)                  ||
+            !tracer_ptr->convert_gpu_timestamp(in_queue_ptr,
+                                               m_timestamps.at(n_span * 2 + 1),
+                                              &end_time_ns) )
+        {
+            /* Queue has not been calibrated */
+            anvil_assert_fail();
+
+            goto end;
+        }
+
+        tracer_ptr->add_gpu_span(in_queue_ptr,
+                                 m_spans.at(n_span).name,
+                                 start_time_ns,
+                                 end_time_ns);
+    }
+
+    result = true;
+end:
+    m_spans.clear();
+
+    return result;
+}
+
+/** Please see header for specification */
+Anvil::GPUSpanRecorderUniquePtr Anvil::GPUSpanRecorder::create(const Anvil::BaseDevice* in_device_ptr,
+                                                               uint32_t                 in_max_n_spans)
+{
+    Anvil::GPUSpanRecorderUniquePtr result_ptr(nullptr,
+                                               std::default_delete<Anvil::GPUSpanRecorder>() );
+
+    result_ptr.reset(
+        new Anvil::GPUSpanRecorder(in_device_ptr,
+                                   in_max_n_spans)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        if (!result_ptr->init() )
+        {
+            result_ptr.reset();
+        }
+    }
+
+    return result_ptr;
+}
+
+/** Please see header for specification */
+bool Anvil::GPUSpanRecorder::init()
+{
+    m_query_pool_ptr = Anvil::QueryPool::create_non_ps_query_pool(m_device_ptr,
+                                                                  VK_QUERY_TYPE_TIMESTAMP,
+                                                                  m_max_n_spans * 2);
+
+    if (m_query_pool_ptr == nullptr)
+    {
+        anvil_assert(m_query_pool_ptr != nullptr);
+
+        return false;
+    }
+
+    m_spans.reserve   (m_max_n_spans);
+    m_timestamps.resize(m_max_n_spans * 2);
+
+    return true;
+}
+
+/** Please see header for specification */
+uint32_t Anvil::GPUSpanRecorder::record_begin(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                              const std::string&        in_name)
+{
+    uint32_t result = UINT32_MAX;
+
+    if (!Anvil::Tracer::is_capturing()      ||
+        m_spans.size()    >= m_max_n_spans)
+    {
+        goto end;
+    }
+
+    result = static_cast<uint32_t>(m_spans.size() );
+
+    m_spans.push_back(Span() );
+
+    m_spans.back().has_ended = false;
+    m_spans.back().name      = in_name;
+
+    in_cmd_buffer_ptr->record_write_timestamp(Anvil::PipelineStageFlagBits::TOP_OF_PIPE_BIT,
+                                              m_query_pool_ptr.get(),
+                                              result * 2);
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+void Anvil::GPUSpanRecorder::record_end(Anvil::CommandBufferBase* in_cmd_buffer_ptr,
+                                        uint32_t                  in_span_id)
+{
+    if (in_span_id == UINT32_MAX)
+    {
+        return;
+    }
+
+    anvil_assert(in_span_id < static_cast<uint32_t>(m_spans.size() ));
+    anvil_assert(!m_spans.at(in_span_id).has_ended);
+
+    in_cmd_buffer_ptr->record_write_timestamp(Anvil::PipelineStageFlagBits::BOTTOM_OF_PIPE_BIT,
+                                              m_query_pool_ptr.get(),
+                                              in_span_id * 2 + 1);
+
+    m_spans.at(in_span_id).has_ended = true;
+}
+
+/** Please see header for specification */
+bool Anvil::GPUSpanRecorder::record_reset(Anvil::CommandBufferBase* in_cmd_buffer_ptr)
+{
+    m_spans.clear();
+
+    return in_cmd_buffer_ptr->record_reset_query_pool(m_query_pool_ptr.get(),
+                                                      0, /* in_start_query */
+                                                      m_max_n_spans * 2);
+}
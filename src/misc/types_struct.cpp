@@ -444,6 +444,13 @@ Anvil::ExtensionKHRDrawIndirectCountEntrypoints::ExtensionKHRDrawIndirectCountEn
     vkCmdDrawIndirectCountKHR        = nullptr;
 }
 
+Anvil::ExtensionKHRTimelineSemaphoreEntrypoints::ExtensionKHRTimelineSemaphoreEntrypoints()
+{
+    vkGetSemaphoreCounterValueKHR = nullptr;
+    vkSignalSemaphoreKHR          = nullptr;
+    vkWaitSemaphoresKHR           = nullptr;
+}
+
 Anvil::ExtensionKHRExternalFenceCapabilitiesEntrypoints::ExtensionKHRExternalFenceCapabilitiesEntrypoints()
 {
     vkGetPhysicalDeviceExternalFencePropertiesKHR = nullptr;
@@ -507,6 +514,11 @@ Anvil::ExtensionKHRMaintenance3Entrypoints::ExtensionKHRMaintenance3Entrypoints(
     vkGetDescriptorSetLayoutSupportKHR = nullptr;
 }
 
+Anvil::ExtensionKHRPushDescriptorEntrypoints::ExtensionKHRPushDescriptorEntrypoints()
+{
+    vkCmdPushDescriptorSetKHR = nullptr;
+}
+
 Anvil::ExtensionKHRSamplerYCbCrConversionEntrypoints::ExtensionKHRSamplerYCbCrConversionEntrypoints()
 {
     vkCreateSamplerYcbcrConversionKHR  = nullptr;
@@ -1815,6 +1827,32 @@ bool Anvil::KHRVariablePointerFeatures::operator==(const Anvil::KHRVariablePoint
             variable_pointers_storage_buffer == in_props.variable_pointers_storage_buffer);
 }
 
+Anvil::KHRTimelineSemaphoreFeatures::KHRTimelineSemaphoreFeatures()
+{
+    timeline_semaphore = false;
+}
+
+Anvil::KHRTimelineSemaphoreFeatures::KHRTimelineSemaphoreFeatures(const VkPhysicalDeviceTimelineSemaphoreFeaturesKHR& in_features)
+{
+    timeline_semaphore = VK_BOOL32_TO_BOOL(in_features.timelineSemaphore);
+}
+
+VkPhysicalDeviceTimelineSemaphoreFeaturesKHR Anvil::KHRTimelineSemaphoreFeatures::get_vk_physical_device_timeline_semaphore_features() const
+{
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR result;
+
+    result.pNext             = nullptr;
+    result.sType             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+    result.timelineSemaphore = BOOL_TO_VK_BOOL32(timeline_semaphore);
+
+    return result;
+}
+
+bool Anvil::KHRTimelineSemaphoreFeatures::operator==(const KHRTimelineSemaphoreFeatures& in_features) const
+{
+    return (in_features.timeline_semaphore == timeline_semaphore);
+}
+
 Anvil::KHRVulkanMemoryModelFeatures::KHRVulkanMemoryModelFeatures()
 {
     vulkan_memory_model                                = false;
@@ -2839,6 +2877,7 @@ Anvil::PhysicalDeviceFeatures::PhysicalDeviceFeatures()
     khr_multiview_features_ptr                = nullptr;
     khr_sampler_ycbcr_conversion_features_ptr = nullptr;
     khr_shader_atomic_int64_features_ptr      = nullptr;
+    khr_timeline_semaphore_features_ptr       = nullptr;
     khr_variable_pointer_features_ptr         = nullptr;
     khr_vulkan_memory_model_features_ptr      = nullptr;
 }
@@ -2857,6 +2896,7 @@ Anvil::PhysicalDeviceFeatures::PhysicalDeviceFeatures(const PhysicalDeviceFeatur
                                                       const KHRMultiviewFeatures*              in_khr_multiview_features_ptr,
                                                       const KHRSamplerYCbCrConversionFeatures* in_khr_sampler_ycbcr_conversion_features_ptr,
                                                       const KHRShaderAtomicInt64Features*      in_khr_shader_atomic_int64_features_ptr,
+                                                      const KHRTimelineSemaphoreFeatures*      in_khr_timeline_semaphore_features_ptr,
                                                       const KHRVariablePointerFeatures*        in_khr_variable_pointer_features_ptr,
                                                       const KHRVulkanMemoryModelFeatures*      in_khr_vulkan_memory_model_features_ptr)
 {
@@ -2874,6 +2914,7 @@ Anvil::PhysicalDeviceFeatures::PhysicalDeviceFeatures(const PhysicalDeviceFeatur
     khr_multiview_features_ptr                = in_khr_multiview_features_ptr;
     khr_sampler_ycbcr_conversion_features_ptr = in_khr_sampler_ycbcr_conversion_features_ptr;
     khr_shader_atomic_int64_features_ptr      = in_khr_shader_atomic_int64_features_ptr;
+    khr_timeline_semaphore_features_ptr       = in_khr_timeline_semaphore_features_ptr;
     khr_variable_pointer_features_ptr         = in_khr_variable_pointer_features_ptr;
     khr_vulkan_memory_model_features_ptr      = in_khr_vulkan_memory_model_features_ptr;
 }
@@ -2895,6 +2936,7 @@ bool Anvil::PhysicalDeviceFeatures::operator==(const PhysicalDeviceFeatures& in_
     bool       khr_multiview_features_match                = false;
     bool       khr_sampler_ycbcr_conversion_features_match = false;
     bool       khr_shader_atomic_int64_features_match      = false;
+    bool       khr_timeline_semaphore_features_match       = false;
     bool       khr_variable_pointer_features_match         = false;
     bool       khr_vulkan_memory_features_match            = false;
 
@@ -3036,6 +3078,17 @@ bool Anvil::PhysicalDeviceFeatures::operator==(const PhysicalDeviceFeatures& in_
                                                in_physical_device_features.khr_variable_pointer_features_ptr == nullptr);
     }
 
+    if (khr_timeline_semaphore_features_ptr                             != nullptr &&
+        in_physical_device_features.khr_timeline_semaphore_features_ptr != nullptr)
+    {
+        khr_timeline_semaphore_features_match = (*khr_timeline_semaphore_features_ptr == *in_physical_device_features.khr_timeline_semaphore_features_ptr);
+    }
+    else
+    {
+        khr_timeline_semaphore_features_match = (khr_timeline_semaphore_features_ptr                             == nullptr &&
+                                                 in_physical_device_features.khr_timeline_semaphore_features_ptr == nullptr);
+    }
+
     if (khr_vulkan_memory_model_features_ptr                             != nullptr &&
         in_physical_device_features.khr_vulkan_memory_model_features_ptr != nullptr)
     {
@@ -3061,6 +3114,7 @@ bool Anvil::PhysicalDeviceFeatures::operator==(const PhysicalDeviceFeatures& in_
            khr_multiview_features_match                &&
            khr_sampler_ycbcr_conversion_features_match &&
            khr_shader_atomic_int64_features_match      &&
+           khr_timeline_semaphore_features_match       &&
            khr_variable_pointer_features_match         &&
            khr_vulkan_memory_features_match;
 }
@@ -4101,6 +4155,7 @@ Anvil::SubmitInfo::SubmitInfo(uint32_t                         in_n_command_buff
 #endif
      dst_stage_wait_masks                          (in_n_semaphores_to_wait_on),
      fence_ptr                                     (in_opt_fence_ptr),
+     has_timeline_semaphore_values                 (false),
 #if defined(_WIN32)
      keyed_mutex_n_acquire_keys                     (0),
      keyed_mutex_acquire_d3d11_memory_block_ptrs_ptr(nullptr),
@@ -4117,6 +4172,8 @@ Anvil::SubmitInfo::SubmitInfo(uint32_t                         in_n_command_buff
      signal_semaphores_mgpu_ptr                    (nullptr),
      signal_semaphores_sgpu_ptr                    (in_opt_semaphore_to_signal_ptrs_ptr),
      should_block                                  (in_should_block),
+     timeline_signal_semaphore_values_ptr          (nullptr),
+     timeline_wait_semaphore_values_ptr            (nullptr),
      timeout                                       (UINT64_MAX),
      type                                          (SubmissionType::SGPU),
      wait_semaphores_mgpu_ptr                      (nullptr),
@@ -4166,6 +4223,7 @@ Anvil::SubmitInfo::SubmitInfo(uint32_t                           in_n_command_bu
 #endif
      dst_stage_wait_masks                          (in_n_wait_semaphore_submissions),
      fence_ptr                                     (in_opt_fence_ptr),
+     has_timeline_semaphore_values                 (false),
      is_protected                                  (false),
 #if defined(_WIN32)
      keyed_mutex_n_acquire_keys                     (0),
@@ -4182,6 +4240,8 @@ Anvil::SubmitInfo::SubmitInfo(uint32_t                           in_n_command_bu
      signal_semaphores_mgpu_ptr                    (in_opt_signal_semaphore_submissions_ptr),
      signal_semaphores_sgpu_ptr                    (nullptr),
      should_block                                  (in_should_block),
+     timeline_signal_semaphore_values_ptr          (nullptr),
+     timeline_wait_semaphore_values_ptr            (nullptr),
      timeout                                       (UINT64_MAX),
      type                                          (SubmissionType::MGPU),
      wait_semaphores_mgpu_ptr                      (in_opt_wait_semaphore_submissions_ptr),
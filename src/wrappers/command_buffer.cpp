@@ -20,6 +20,7 @@
 // THE SOFTWARE.
 //
 
+#include "misc/buffer_create_info.h"
 #include "misc/callbacks.h"
 #include "misc/debug.h"
 #include "misc/descriptor_set_create_info.h"
@@ -44,12 +45,163 @@
 #include "wrappers/pipeline_layout.h"
 #include "wrappers/query_pool.h"
 #include "wrappers/render_pass.h"
+#include "wrappers/sampler.h"
 
 
 /* Command stashing should be enabled by default for builds that care. */
 bool Anvil::CommandBufferBase::m_command_stashing_disabled = false;
 
 
+namespace
+{
+    bool are_buffer_barriers_equal(const VkBufferMemoryBarrier& in_barrier1,
+                                   const VkBufferMemoryBarrier& in_barrier2)
+    {
+        return (in_barrier1.buffer              == in_barrier2.buffer              &&
+                in_barrier1.dstAccessMask       == in_barrier2.dstAccessMask       &&
+                in_barrier1.dstQueueFamilyIndex == in_barrier2.dstQueueFamilyIndex &&
+                in_barrier1.offset              == in_barrier2.offset              &&
+                in_barrier1.pNext               == in_barrier2.pNext               &&
+                in_barrier1.size                == in_barrier2.size                &&
+                in_barrier1.srcAccessMask       == in_barrier2.srcAccessMask       &&
+                in_barrier1.srcQueueFamilyIndex == in_barrier2.srcQueueFamilyIndex);
+    }
+
+    bool are_image_barriers_equal(const VkImageMemoryBarrier& in_barrier1,
+                                  const VkImageMemoryBarrier& in_barrier2)
+    {
+        return (in_barrier1.dstAccessMask                   == in_barrier2.dstAccessMask                   &&
+                in_barrier1.dstQueueFamilyIndex             == in_barrier2.dstQueueFamilyIndex             &&
+                in_barrier1.image                           == in_barrier2.image                           &&
+                in_barrier1.newLayout                       == in_barrier2.newLayout                       &&
+                in_barrier1.oldLayout                       == in_barrier2.oldLayout                       &&
+                in_barrier1.pNext                           == in_barrier2.pNext                           &&
+                in_barrier1.srcAccessMask                   == in_barrier2.srcAccessMask                   &&
+                in_barrier1.srcQueueFamilyIndex             == in_barrier2.srcQueueFamilyIndex             &&
+                in_barrier1.subresourceRange.aspectMask     == in_barrier2.subresourceRange.aspectMask     &&
+                in_barrier1.subresourceRange.baseArrayLayer == in_barrier2.subresourceRange.baseArrayLayer &&
+                in_barrier1.subresourceRange.baseMipLevel   == in_barrier2.subresourceRange.baseMipLevel   &&
+                in_barrier1.subresourceRange.layerCount     == in_barrier2.subresourceRange.layerCount     &&
+                in_barrier1.subresourceRange.levelCount     == in_barrier2.subresourceRange.levelCount);
+    }
+
+    bool are_memory_barriers_equal(const VkMemoryBarrier& in_barrier1,
+                                   const VkMemoryBarrier& in_barrier2)
+    {
+        return (in_barrier1.dstAccessMask == in_barrier2.dstAccessMask &&
+                in_barrier1.pNext         == in_barrier2.pNext         &&
+                in_barrier1.srcAccessMask == in_barrier2.srcAccessMask);
+    }
+
+    /* Tells whether [in_start1, in_start1 + in_size1) and [in_start2, in_start2 + in_size2) overlap. in_remaining_size
+     * is the special value, which indicates a range spanning till the end of the resource.
+     */
+    template<typename Type>
+    bool do_ranges_overlap(const Type& in_start1,
+                           const Type& in_size1,
+                           const Type& in_start2,
+                           const Type& in_size2,
+                           const Type& in_remaining_size)
+    {
+        const bool is_range1_unbound = (in_size1 == in_remaining_size) || (in_start1 + in_size1 < in_start1);
+        const bool is_range2_unbound = (in_size2 == in_remaining_size) || (in_start2 + in_size2 < in_start2);
+
+        return (is_range2_unbound || in_start1 < in_start2 + in_size2) &&
+               (is_range1_unbound || in_start2 < in_start1 + in_size1);
+    }
+
+    bool do_buffer_barriers_overlap(const VkBufferMemoryBarrier& in_barrier1,
+                                    const VkBufferMemoryBarrier& in_barrier2)
+    {
+        return (in_barrier1.buffer == in_barrier2.buffer) &&
+               do_ranges_overlap<VkDeviceSize>(in_barrier1.offset,
+                                               in_barrier1.size,
+                                               in_barrier2.offset,
+                                               in_barrier2.size,
+                                               VK_WHOLE_SIZE);
+    }
+
+    bool do_image_barriers_overlap(const VkImageMemoryBarrier& in_barrier1,
+                                   const VkImageMemoryBarrier& in_barrier2)
+    {
+        const VkImageSubresourceRange& range1 = in_barrier1.subresourceRange;
+        const VkImageSubresourceRange& range2 = in_barrier2.subresourceRange;
+
+        return (in_barrier1.image                              == in_barrier2.image) &&
+               ((range1.aspectMask & range2.aspectMask)        != 0)                 &&
+               do_ranges_overlap<uint32_t>(range1.baseMipLevel,
+                                           range1.levelCount,
+                                           range2.baseMipLevel,
+                                           range2.levelCount,
+                                           VK_REMAINING_MIP_LEVELS)                  &&
+               do_ranges_overlap<uint32_t>(range1.baseArrayLayer,
+                                           range1.layerCount,
+                                           range2.baseArrayLayer,
+                                           range2.layerCount,
+                                           VK_REMAINING_ARRAY_LAYERS);
+    }
+
+    /* Converts binding elements passed to CommandBufferBase::record_push_descriptor_set() to Vulkan descriptors. */
+    VkDescriptorBufferInfo get_push_descriptor_info(const Anvil::DescriptorSet::BufferBindingElement& in_element)
+    {
+        VkDescriptorBufferInfo result;
+
+        result.buffer = in_element.buffer_ptr->get_buffer();
+
+        if (in_element.start_offset != UINT64_MAX)
+        {
+            result.offset = in_element.start_offset;
+            result.range  = in_element.size;
+        }
+        else
+        {
+            result.offset = in_element.buffer_ptr->get_create_info_ptr()->get_start_offset();
+            result.range  = in_element.buffer_ptr->get_create_info_ptr()->get_size        ();
+        }
+
+        return result;
+    }
+
+    VkDescriptorImageInfo get_push_descriptor_info(const Anvil::DescriptorSet::CombinedImageSamplerBindingElement& in_element)
+    {
+        VkDescriptorImageInfo result;
+
+        result.imageLayout = static_cast<VkImageLayout>(in_element.image_layout);
+        result.imageView   = in_element.image_view_ptr->get_image_view();
+        result.sampler     = (in_element.sampler_ptr != nullptr) ? in_element.sampler_ptr->get_sampler() : VK_NULL_HANDLE;
+
+        return result;
+    }
+
+    VkDescriptorImageInfo get_push_descriptor_info(const Anvil::DescriptorSet::ImageBindingElement& in_element)
+    {
+        VkDescriptorImageInfo result;
+
+        result.imageLayout = static_cast<VkImageLayout>(in_element.image_layout);
+        result.imageView   = in_element.image_view_ptr->get_image_view();
+        result.sampler     = VK_NULL_HANDLE;
+
+        return result;
+    }
+
+    VkDescriptorImageInfo get_push_descriptor_info(const Anvil::DescriptorSet::SamplerBindingElement& in_element)
+    {
+        VkDescriptorImageInfo result;
+
+        result.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        result.imageView   = VK_NULL_HANDLE;
+        result.sampler     = (in_element.sampler_ptr != nullptr) ? in_element.sampler_ptr->get_sampler() : VK_NULL_HANDLE;
+
+        return result;
+    }
+
+    VkBufferView get_push_descriptor_info(const Anvil::DescriptorSet::TexelBufferBindingElement& in_element)
+    {
+        return in_element.buffer_view_ptr->get_buffer_view();
+    }
+};
+
+
 /** Please see header for specification */
 Anvil::CommandBufferBase::BeginQueryCommand::BeginQueryCommand(Anvil::QueryPool*        in_query_pool_ptr,
                                                                Anvil::QueryIndex        in_entry,
@@ -804,6 +956,23 @@ Anvil::CommandBufferBase::PushConstantsCommand::PushConstantsCommand(Anvil::Pipe
     values      = in_values;
 }
 
+/** Please see header for specification */
+Anvil::CommandBufferBase::PushDescriptorSetKHRCommand::PushDescriptorSetKHRCommand(Anvil::PipelineBindPoint in_pipeline_bind_point,
+                                                                                   Anvil::PipelineLayout*   in_layout_ptr,
+                                                                                   uint32_t                 in_set,
+                                                                                   BindingIndex             in_binding_index,
+                                                                                   BindingElementArrayRange in_element_range,
+                                                                                   Anvil::DescriptorType    in_descriptor_type)
+    :Command(COMMAND_TYPE_PUSH_DESCRIPTOR_SET_KHR)
+{
+    binding_index       = in_binding_index;
+    descriptor_type     = in_descriptor_type;
+    element_range       = in_element_range;
+    layout_ptr          = in_layout_ptr;
+    pipeline_bind_point = in_pipeline_bind_point;
+    set                 = in_set;
+}
+
 /** Please see header for specification */
 Anvil::CommandBufferBase::ResetEventCommand::ResetEventCommand(Anvil::Event*             in_event_ptr,
                                                                Anvil::PipelineStageFlags in_stage_mask)
@@ -1063,19 +1232,23 @@ Anvil::CommandBufferBase::CommandBufferBase(const Anvil::BaseDevice* in_device_p
                                             Anvil::CommandPool*      in_parent_command_pool_ptr,
                                             Anvil::CommandBufferType in_type,
                                             bool                     in_mt_safe)
-    :MTSafetySupportProvider        (in_mt_safe),
-     DebugMarkerSupportProvider     (in_device_ptr,
-                                     Anvil::ObjectType::COMMAND_BUFFER),
-     CallbacksSupportProvider       (COMMAND_BUFFER_CALLBACK_ID_COUNT),
-     m_command_buffer               (VK_NULL_HANDLE),
-     m_device_mask                  (0),
-     m_device_ptr                   (in_device_ptr),
-     m_is_renderpass_active         (false),
-     m_n_debug_label_regions_started(0),
-     m_parent_command_pool_ptr      (in_parent_command_pool_ptr),
-     m_recording_in_progress        (false),
-     m_renderpass_device_mask       (0),
-     m_type                         (in_type)
+    :MTSafetySupportProvider              (in_mt_safe),
+     DebugMarkerSupportProvider           (in_device_ptr,
+                                           Anvil::ObjectType::COMMAND_BUFFER),
+     CallbacksSupportProvider             (COMMAND_BUFFER_CALLBACK_ID_COUNT),
+     m_pending_barrier_dependency_flags_vk(0),
+     m_pending_barrier_dst_stage_mask_vk  (0),
+     m_pending_barrier_src_stage_mask_vk  (0),
+     m_pipeline_barrier_batching_enabled  (false),
+     m_command_buffer                     (VK_NULL_HANDLE),
+     m_device_mask                        (0),
+     m_device_ptr                         (in_device_ptr),
+     m_is_renderpass_active               (false),
+     m_n_debug_label_regions_started      (0),
+     m_parent_command_pool_ptr            (in_parent_command_pool_ptr),
+     m_recording_in_progress              (false),
+     m_renderpass_device_mask             (0),
+     m_type                               (in_type)
 {
     anvil_assert(in_parent_command_pool_ptr != nullptr);
 }
@@ -1115,6 +1288,24 @@ Anvil::CommandBufferBase::~CommandBufferBase()
     #endif
 }
 
+/** Appends a Vulkan descriptor to the list of descriptors to be used by the next record_push_descriptor_set_internal()
+ *  call.
+ **/
+void Anvil::CommandBufferBase::append_push_descriptor_info(const VkDescriptorBufferInfo& in_buffer_info_vk)
+{
+    m_push_descriptor_buffer_info_items_vk.push_back(in_buffer_info_vk);
+}
+
+void Anvil::CommandBufferBase::append_push_descriptor_info(const VkDescriptorImageInfo& in_image_info_vk)
+{
+    m_push_descriptor_image_info_items_vk.push_back(in_image_info_vk);
+}
+
+void Anvil::CommandBufferBase::append_push_descriptor_info(const VkBufferView& in_texel_buffer_view_vk)
+{
+    m_push_descriptor_texel_buffer_view_items_vk.push_back(in_texel_buffer_view_vk);
+}
+
 /** Please see header for specification */
 void Anvil::CommandBufferBase::begin_debug_utils_label(const char*  in_label_name_ptr,
                                                        const float* in_color_vec4_ptr)
@@ -1124,6 +1315,8 @@ void Anvil::CommandBufferBase::begin_debug_utils_label(const char*  in_label_nam
         goto end;
     }
 
+    flush_pending_pipeline_barriers();
+
     {
         const auto&          entrypoints = m_device_ptr->get_parent_instance()->get_extension_ext_debug_utils_entrypoints();
         VkDebugUtilsLabelEXT label_info;
@@ -1153,6 +1346,18 @@ end:
     }
 #endif
 
+/** Drops all pipeline barriers which have been enqueued but not yet recorded. Storage is retained. */
+void Anvil::CommandBufferBase::discard_pending_pipeline_barriers()
+{
+    m_pending_buffer_barriers_vk.clear();
+    m_pending_image_barriers_vk.clear ();
+    m_pending_memory_barriers_vk.clear();
+
+    m_pending_barrier_dependency_flags_vk = 0;
+    m_pending_barrier_dst_stage_mask_vk   = 0;
+    m_pending_barrier_src_stage_mask_vk   = 0;
+}
+
 /* Please see header for specification */
 void Anvil::CommandBufferBase::end_debug_utils_label()
 {
@@ -1168,6 +1373,8 @@ void Anvil::CommandBufferBase::end_debug_utils_label()
         goto end;
     }
 
+    flush_pending_pipeline_barriers();
+
     {
         const auto& entrypoints = m_device_ptr->get_parent_instance()->get_extension_ext_debug_utils_entrypoints();
 
@@ -1179,6 +1386,35 @@ end:
     ;
 }
 
+/** Issues a single vkCmdPipelineBarrier() call for all pending pipeline barriers and clears the queue. */
+void Anvil::CommandBufferBase::flush_pending_pipeline_barriers_internal()
+{
+    const uint32_t n_buffer_barriers = static_cast<uint32_t>(m_pending_buffer_barriers_vk.size() );
+    const uint32_t n_image_barriers  = static_cast<uint32_t>(m_pending_image_barriers_vk.size () );
+    const uint32_t n_memory_barriers = static_cast<uint32_t>(m_pending_memory_barriers_vk.size() );
+
+    anvil_assert(m_recording_in_progress);
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        Anvil::Vulkan::vkCmdPipelineBarrier(m_command_buffer,
+                                            m_pending_barrier_src_stage_mask_vk,
+                                            m_pending_barrier_dst_stage_mask_vk,
+                                            m_pending_barrier_dependency_flags_vk,
+                                            n_memory_barriers,
+                                            (n_memory_barriers > 0) ? &m_pending_memory_barriers_vk.at(0) : nullptr,
+                                            n_buffer_barriers,
+                                            (n_buffer_barriers > 0) ? &m_pending_buffer_barriers_vk.at(0) : nullptr,
+                                            n_image_barriers,
+                                            (n_image_barriers  > 0) ? &m_pending_image_barriers_vk.at (0) : nullptr);
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    discard_pending_pipeline_barriers();
+}
+
 /** Please see header for specification */
 void Anvil::CommandBufferBase::insert_debug_utils_label(const char*  in_label_name_ptr,
                                                         const float* in_color_vec4_ptr)
@@ -1188,6 +1424,8 @@ void Anvil::CommandBufferBase::insert_debug_utils_label(const char*  in_label_na
         goto end;
     }
 
+    flush_pending_pipeline_barriers();
+
     {
         const auto&          entrypoints = m_device_ptr->get_parent_instance()->get_extension_ext_debug_utils_entrypoints();
         VkDebugUtilsLabelEXT label_info;
@@ -1234,6 +1472,8 @@ bool Anvil::CommandBufferBase::record_begin_query(Anvil::QueryPool*        in_qu
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -1279,6 +1519,8 @@ bool Anvil::CommandBufferBase::record_begin_query_indexed(Anvil::QueryPool*
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -1359,6 +1601,8 @@ bool Anvil::CommandBufferBase::record_begin_transform_feedback_EXT(const uint32_
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -1689,6 +1933,8 @@ bool Anvil::CommandBufferBase::record_blit_image(Anvil::Image*           in_src_
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -1743,6 +1989,8 @@ bool Anvil::CommandBufferBase::record_clear_attachments(uint32_t
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -1796,6 +2044,8 @@ bool Anvil::CommandBufferBase::record_clear_color_image(Anvil::Image*
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -1850,6 +2100,8 @@ bool Anvil::CommandBufferBase::record_clear_depth_stencil_image(Anvil::Image*
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -1902,6 +2154,8 @@ bool Anvil::CommandBufferBase::record_copy_buffer(Anvil::Buffer*           in_sr
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -1955,6 +2209,8 @@ bool Anvil::CommandBufferBase::record_copy_buffer_to_image(Anvil::Buffer*
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2011,6 +2267,8 @@ bool Anvil::CommandBufferBase::record_copy_image(Anvil::Image*           in_src_
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2066,6 +2324,8 @@ bool Anvil::CommandBufferBase::record_copy_image_to_buffer(Anvil::Image*
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2124,6 +2384,8 @@ bool Anvil::CommandBufferBase::record_copy_query_pool_results(Anvil::QueryPool*
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2176,6 +2438,8 @@ bool Anvil::CommandBufferBase::record_dispatch(uint32_t in_x,
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2237,6 +2501,8 @@ bool Anvil::CommandBufferBase::record_debug_marker_begin_EXT(const std::string&
     marker_info.pNext       = nullptr;
     marker_info.sType       = VK_STRUCTURE_TYPE_DEBUG_MARKER_MARKER_INFO_EXT;
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     {
         entrypoints.vkCmdDebugMarkerBeginEXT(m_command_buffer,
@@ -2274,6 +2540,8 @@ bool Anvil::CommandBufferBase::record_debug_marker_end_EXT()
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     {
         entrypoints.vkCmdDebugMarkerEndEXT(m_command_buffer);
@@ -2331,6 +2599,8 @@ bool Anvil::CommandBufferBase::record_debug_marker_insert_EXT(const std::string&
     marker_info.pNext       = nullptr;
     marker_info.sType       = VK_STRUCTURE_TYPE_DEBUG_MARKER_MARKER_INFO_EXT;
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     {
         entrypoints.vkCmdDebugMarkerInsertEXT(m_command_buffer,
@@ -2385,6 +2655,8 @@ bool Anvil::CommandBufferBase::record_dispatch_base_KHR(uint32_t in_base_group_x
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2434,6 +2706,8 @@ bool Anvil::CommandBufferBase::record_dispatch_indirect(Anvil::Buffer* in_buffer
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2483,6 +2757,8 @@ bool Anvil::CommandBufferBase::record_draw(uint32_t in_vertex_count,
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2536,6 +2812,8 @@ bool Anvil::CommandBufferBase::record_draw_indexed(uint32_t in_index_count,
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2588,6 +2866,8 @@ bool Anvil::CommandBufferBase::record_draw_indexed_indirect(Anvil::Buffer* in_bu
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2644,6 +2924,8 @@ bool Anvil::CommandBufferBase::record_draw_indirect_byte_count_EXT(const uint32_
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2707,6 +2989,8 @@ bool Anvil::CommandBufferBase::record_draw_indexed_indirect_count_AMD(Anvil::Buf
 
     entrypoints = m_device_ptr->get_extension_amd_draw_indirect_count_entrypoints();
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2770,6 +3054,8 @@ bool Anvil::CommandBufferBase::record_draw_indexed_indirect_count_KHR(Anvil::Buf
 
     entrypoints = m_device_ptr->get_extension_khr_draw_indirect_count_entrypoints();
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2823,6 +3109,8 @@ bool Anvil::CommandBufferBase::record_draw_indirect(Anvil::Buffer* in_buffer_ptr
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2884,6 +3172,8 @@ bool Anvil::CommandBufferBase::record_draw_indirect_count_AMD(Anvil::Buffer* in_
 
     entrypoints = m_device_ptr->get_extension_amd_draw_indirect_count_entrypoints();
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2947,6 +3237,8 @@ bool Anvil::CommandBufferBase::record_draw_indirect_count_KHR(Anvil::Buffer* in_
 
     entrypoints = m_device_ptr->get_extension_khr_draw_indirect_count_entrypoints();
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -2990,6 +3282,8 @@ bool Anvil::CommandBufferBase::record_end_query(Anvil::QueryPool* in_query_pool_
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -3032,6 +3326,8 @@ bool Anvil::CommandBufferBase::record_end_query_indexed_EXT(Anvil::QueryPool*
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -3110,6 +3406,8 @@ bool Anvil::CommandBufferBase::record_end_transform_feedback_EXT(const uint32_t&
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -3161,6 +3459,8 @@ bool Anvil::CommandBufferBase::record_fill_buffer(Anvil::Buffer* in_dst_buffer_p
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -3190,10 +3490,7 @@ bool Anvil::CommandBufferBase::record_pipeline_barrier(Anvil::PipelineStageFlags
                                                        const ImageBarrier*  const in_image_memory_barriers_ptr)
 {
     /* NOTE: The command can be executed both inside and outside a renderpass */
-    auto buffer_barriers_vk = std::vector<VkBufferMemoryBarrier>(in_buffer_memory_barrier_count);
-    auto image_barriers_vk  = std::vector<VkImageMemoryBarrier> (in_image_memory_barrier_count);
-    auto memory_barriers_vk = std::vector<VkMemoryBarrier>      (in_memory_barrier_count);
-    bool result             = false;
+    bool result = false;
 
     if (!m_recording_in_progress)
     {
@@ -3222,61 +3519,164 @@ bool Anvil::CommandBufferBase::record_pipeline_barrier(Anvil::PipelineStageFlags
     }
     #endif
 
-    if (get_n_of_callback_subscribers(COMMAND_BUFFER_CALLBACK_ID_PIPELINE_BARRIER_COMMAND_RECORDED) > 0)
+    #if defined(ANVIL_ENABLE_COMMAND_RECORDED_CALLBACKS)
     {
-        PipelineBarrierCommand                       command_data(in_src_stage_mask,
-                                                                  in_dst_stage_mask,
-                                                                  in_dependency_flags,
-                                                                  in_memory_barrier_count,
-                                                                  in_memory_barriers_ptr,
-                                                                  in_buffer_memory_barrier_count,
-                                                                  in_buffer_memory_barriers_ptr,
-                                                                  in_image_memory_barrier_count,
-                                                                  in_image_memory_barriers_ptr);
-        OnPipelineBarrierCommandRecordedCallbackData callback_data(this,
-                                                                  &command_data);
+        if (get_n_of_callback_subscribers(COMMAND_BUFFER_CALLBACK_ID_PIPELINE_BARRIER_COMMAND_RECORDED) > 0)
+        {
+            PipelineBarrierCommand                       command_data(in_src_stage_mask,
+                                                                      in_dst_stage_mask,
+                                                                      in_dependency_flags,
+                                                                      in_memory_barrier_count,
+                                                                      in_memory_barriers_ptr,
+                                                                      in_buffer_memory_barrier_count,
+                                                                      in_buffer_memory_barriers_ptr,
+                                                                      in_image_memory_barrier_count,
+                                                                      in_image_memory_barriers_ptr);
+            OnPipelineBarrierCommandRecordedCallbackData callback_data(this,
+                                                                      &command_data);
+
+            callback(COMMAND_BUFFER_CALLBACK_ID_PIPELINE_BARRIER_COMMAND_RECORDED,
+                    &callback_data);
+        }
+    }
+    #endif
+
+    /* Pending barriers can only absorb the new ones if that does not break any dependency between the two sets. */
+    if (m_pending_barrier_src_stage_mask_vk != 0)
+    {
+        bool can_merge = (m_pending_barrier_dependency_flags_vk == in_dependency_flags.get_vk() );
+
+        if (can_merge && (in_memory_barrier_count > 0 || m_pending_memory_barriers_vk.size() > 0) )
+        {
+            can_merge = (m_pending_buffer_barriers_vk.size() == 0        &&
+                         m_pending_image_barriers_vk.size () == 0        &&
+                         in_buffer_memory_barrier_count      == 0        &&
+                         in_image_memory_barrier_count       == 0);
+
+            for (uint32_t n_memory_barrier = 0;
+                          n_memory_barrier < in_memory_barrier_count && can_merge;
+                        ++n_memory_barrier)
+            {
+                const VkMemoryBarrier memory_barrier_vk = in_memory_barriers_ptr[n_memory_barrier].get_barrier_vk();
+
+                can_merge = std::find_if(m_pending_memory_barriers_vk.begin(),
+                                         m_pending_memory_barriers_vk.end  (),
+                                         [&memory_barrier_vk](const VkMemoryBarrier& in_pending_barrier_vk)
+                                         {
+                                             return are_memory_barriers_equal(in_pending_barrier_vk,
+                                                                              memory_barrier_vk);
+                                         }) != m_pending_memory_barriers_vk.end();
+            }
+        }
+
+        for (uint32_t n_buffer_barrier = 0;
+                      n_buffer_barrier < in_buffer_memory_barrier_count && can_merge;
+                    ++n_buffer_barrier)
+        {
+            const VkBufferMemoryBarrier buffer_barrier_vk = in_buffer_memory_barriers_ptr[n_buffer_barrier].get_barrier_vk();
+
+            for (const auto& current_pending_barrier_vk : m_pending_buffer_barriers_vk)
+            {
+                if (do_buffer_barriers_overlap(current_pending_barrier_vk,
+                                               buffer_barrier_vk)         &&
+                   !are_buffer_barriers_equal (current_pending_barrier_vk,
+                                               buffer_barrier_vk) )
+                {
+                    can_merge = false;
+
+                    break;
+                }
+            }
+        }
+
+        for (uint32_t n_image_barrier = 0;
+                      n_image_barrier < in_image_memory_barrier_count && can_merge;
+                    ++n_image_barrier)
+        {
+            const VkImageMemoryBarrier image_barrier_vk = in_image_memory_barriers_ptr[n_image_barrier].get_barrier_vk();
 
-        callback(COMMAND_BUFFER_CALLBACK_ID_PIPELINE_BARRIER_COMMAND_RECORDED,
-                &callback_data);
+            for (const auto& current_pending_barrier_vk : m_pending_image_barriers_vk)
+            {
+                if (do_image_barriers_overlap(current_pending_barrier_vk,
+                                              image_barrier_vk)          &&
+                   !are_image_barriers_equal (current_pending_barrier_vk,
+                                              image_barrier_vk) )
+                {
+                    can_merge = false;
+
+                    break;
+                }
+            }
+        }
+
+        if (!can_merge)
+        {
+            flush_pending_pipeline_barriers_internal();
+        }
     }
 
     for (uint32_t n_buffer_barrier = 0;
                   n_buffer_barrier < in_buffer_memory_barrier_count;
                 ++n_buffer_barrier)
     {
-        buffer_barriers_vk.at(n_buffer_barrier) = in_buffer_memory_barriers_ptr[n_buffer_barrier].get_barrier_vk();
+        const VkBufferMemoryBarrier buffer_barrier_vk = in_buffer_memory_barriers_ptr[n_buffer_barrier].get_barrier_vk();
+
+        if (std::find_if(m_pending_buffer_barriers_vk.begin(),
+                         m_pending_buffer_barriers_vk.end  (),
+                         [&buffer_barrier_vk](const VkBufferMemoryBarrier& in_pending_barrier_vk)
+                         {
+                             return are_buffer_barriers_equal(in_pending_barrier_vk,
+                                                              buffer_barrier_vk);
+                         }) == m_pending_buffer_barriers_vk.end() )
+        {
+            m_pending_buffer_barriers_vk.push_back(buffer_barrier_vk);
+        }
     }
 
     for (uint32_t n_image_barrier = 0;
                   n_image_barrier < in_image_memory_barrier_count;
                 ++n_image_barrier)
     {
-        image_barriers_vk.at(n_image_barrier) = in_image_memory_barriers_ptr[n_image_barrier].get_barrier_vk();
+        const VkImageMemoryBarrier image_barrier_vk = in_image_memory_barriers_ptr[n_image_barrier].get_barrier_vk();
+
+        if (std::find_if(m_pending_image_barriers_vk.begin(),
+                         m_pending_image_barriers_vk.end  (),
+                         [&image_barrier_vk](const VkImageMemoryBarrier& in_pending_barrier_vk)
+                         {
+                             return are_image_barriers_equal(in_pending_barrier_vk,
+                                                             image_barrier_vk);
+                         }) == m_pending_image_barriers_vk.end() )
+        {
+            m_pending_image_barriers_vk.push_back(image_barrier_vk);
+        }
     }
 
     for (uint32_t n_memory_barrier = 0;
                   n_memory_barrier < in_memory_barrier_count;
                 ++n_memory_barrier)
     {
-        memory_barriers_vk.at(n_memory_barrier) = in_memory_barriers_ptr[n_memory_barrier].get_barrier_vk();
+        const VkMemoryBarrier memory_barrier_vk = in_memory_barriers_ptr[n_memory_barrier].get_barrier_vk();
+
+        if (std::find_if(m_pending_memory_barriers_vk.begin(),
+                         m_pending_memory_barriers_vk.end  (),
+                         [&memory_barrier_vk](const VkMemoryBarrier& in_pending_barrier_vk)
+                         {
+                             return are_memory_barriers_equal(in_pending_barrier_vk,
+                                                              memory_barrier_vk);
+                         }) == m_pending_memory_barriers_vk.end() )
+        {
+            m_pending_memory_barriers_vk.push_back(memory_barrier_vk);
+        }
     }
 
-    m_parent_command_pool_ptr->lock();
-    lock();
+    m_pending_barrier_dependency_flags_vk  = in_dependency_flags.get_vk();
+    m_pending_barrier_dst_stage_mask_vk   |= in_dst_stage_mask.get_vk  ();
+    m_pending_barrier_src_stage_mask_vk   |= in_src_stage_mask.get_vk  ();
+
+    if (!m_pipeline_barrier_batching_enabled)
     {
-        Anvil::Vulkan::vkCmdPipelineBarrier(m_command_buffer,
-                                            in_src_stage_mask.get_vk  (),
-                                            in_dst_stage_mask.get_vk  (),
-                                            in_dependency_flags.get_vk(),
-                                            in_memory_barrier_count,
-                                            (in_memory_barrier_count > 0) ? &memory_barriers_vk.at(0) : nullptr,
-                                            in_buffer_memory_barrier_count,
-                                            (in_buffer_memory_barrier_count > 0) ? &buffer_barriers_vk.at(0) : nullptr,
-                                            in_image_memory_barrier_count,
-                                            (in_image_memory_barrier_count > 0) ? &image_barriers_vk.at(0) : nullptr);
+        flush_pending_pipeline_barriers_internal();
     }
-    unlock();
-    m_parent_command_pool_ptr->unlock();
 
     result = true;
 end:
@@ -3331,6 +3731,143 @@ end:
     return result;
 }
 
+/** Please see header for specification */
+template<typename BindingElementType>
+bool Anvil::CommandBufferBase::record_push_descriptor_set(Anvil::PipelineBindPoint  in_pipeline_bind_point,
+                                                          Anvil::PipelineLayout*    in_layout_ptr,
+                                                          uint32_t                  in_set,
+                                                          BindingIndex              in_binding_index,
+                                                          BindingElementArrayRange  in_element_range,
+                                                          const BindingElementType* in_elements_ptr)
+{
+    anvil_assert(in_elements_ptr         != nullptr);
+    anvil_assert(in_element_range.second >  0);
+
+    m_push_descriptor_buffer_info_items_vk.clear      ();
+    m_push_descriptor_image_info_items_vk.clear       ();
+    m_push_descriptor_texel_buffer_view_items_vk.clear();
+
+    for (uint32_t n_element = 0;
+                  n_element < in_element_range.second;
+                ++n_element)
+    {
+        append_push_descriptor_info(get_push_descriptor_info(in_elements_ptr[n_element]) );
+    }
+
+    return record_push_descriptor_set_internal(in_pipeline_bind_point,
+                                               in_layout_ptr,
+                                               in_set,
+                                               in_binding_index,
+                                               in_element_range,
+                                               in_elements_ptr[0].get_type() );
+}
+
+/* Dynamic buffer binding elements are deliberately left out, since they cannot be pushed. */
+#define ANVIL_INSTANTIATE_RECORD_PUSH_DESCRIPTOR_SET(BindingElementType)                                             \
+    template bool Anvil::CommandBufferBase::record_push_descriptor_set<BindingElementType>(Anvil::PipelineBindPoint, \
+                                                                                           Anvil::PipelineLayout*,   \
+                                                                                           uint32_t,                 \
+                                                                                           BindingIndex,             \
+                                                                                           BindingElementArrayRange, \
+                                                                                           const BindingElementType*);
+
+ANVIL_INSTANTIATE_RECORD_PUSH_DESCRIPTOR_SET(Anvil::DescriptorSet::CombinedImageSamplerBindingElement)
+ANVIL_INSTANTIATE_RECORD_PUSH_DESCRIPTOR_SET(Anvil::DescriptorSet::InputAttachmentBindingElement)
+ANVIL_INSTANTIATE_RECORD_PUSH_DESCRIPTOR_SET(Anvil::DescriptorSet::SampledImageBindingElement)
+ANVIL_INSTANTIATE_RECORD_PUSH_DESCRIPTOR_SET(Anvil::DescriptorSet::SamplerBindingElement)
+ANVIL_INSTANTIATE_RECORD_PUSH_DESCRIPTOR_SET(Anvil::DescriptorSet::StorageBufferBindingElement)
+ANVIL_INSTANTIATE_RECORD_PUSH_DESCRIPTOR_SET(Anvil::DescriptorSet::StorageImageBindingElement)
+ANVIL_INSTANTIATE_RECORD_PUSH_DESCRIPTOR_SET(Anvil::DescriptorSet::StorageTexelBufferBindingElement)
+ANVIL_INSTANTIATE_RECORD_PUSH_DESCRIPTOR_SET(Anvil::DescriptorSet::UniformBufferBindingElement)
+ANVIL_INSTANTIATE_RECORD_PUSH_DESCRIPTOR_SET(Anvil::DescriptorSet::UniformTexelBufferBindingElement)
+
+#undef ANVIL_INSTANTIATE_RECORD_PUSH_DESCRIPTOR_SET
+
+/** Issues a vkCmdPushDescriptorSetKHR() call for descriptors gathered by record_push_descriptor_set(). **/
+bool Anvil::CommandBufferBase::record_push_descriptor_set_internal(Anvil::PipelineBindPoint in_pipeline_bind_point,
+                                                                   Anvil::PipelineLayout*   in_layout_ptr,
+                                                                   uint32_t                 in_set,
+                                                                   BindingIndex             in_binding_index,
+                                                                   BindingElementArrayRange in_element_range,
+                                                                   Anvil::DescriptorType    in_descriptor_type)
+{
+    /* NOTE: The command can be executed both inside and outside a renderpass */
+    ExtensionKHRPushDescriptorEntrypoints entrypoints;
+    bool                                  result      = false;
+    VkWriteDescriptorSet                  write_vk;
+
+    if (!m_recording_in_progress)
+    {
+        anvil_assert(m_recording_in_progress);
+
+        goto end;
+    }
+
+    if (!m_device_ptr->get_extension_info()->khr_push_descriptor() )
+    {
+        anvil_assert(m_device_ptr->get_extension_info()->khr_push_descriptor() );
+
+        goto end;
+    }
+
+    if (in_descriptor_type == Anvil::DescriptorType::STORAGE_BUFFER_DYNAMIC ||
+        in_descriptor_type == Anvil::DescriptorType::UNIFORM_BUFFER_DYNAMIC)
+    {
+        /* Dynamic buffer descriptors cannot be pushed */
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    anvil_assert(m_push_descriptor_buffer_info_items_vk.size      () +
+                 m_push_descriptor_image_info_items_vk.size       () +
+                 m_push_descriptor_texel_buffer_view_items_vk.size() == in_element_range.second);
+
+    #ifdef STORE_COMMAND_BUFFER_COMMANDS
+    {
+        if (!m_command_stashing_disabled)
+        {
+            m_commands.push_back(PushDescriptorSetKHRCommand(in_pipeline_bind_point,
+                                                             in_layout_ptr,
+                                                             in_set,
+                                                             in_binding_index,
+                                                             in_element_range,
+                                                             in_descriptor_type) );
+        }
+    }
+    #endif
+
+    write_vk.descriptorCount  = in_element_range.second;
+    write_vk.descriptorType   = static_cast<VkDescriptorType>(in_descriptor_type);
+    write_vk.dstArrayElement  = in_element_range.first;
+    write_vk.dstBinding       = in_binding_index;
+    write_vk.dstSet           = VK_NULL_HANDLE;
+    write_vk.pBufferInfo      = (m_push_descriptor_buffer_info_items_vk.size()       > 0) ? &m_push_descriptor_buffer_info_items_vk.at      (0) : nullptr;
+    write_vk.pImageInfo       = (m_push_descriptor_image_info_items_vk.size()        > 0) ? &m_push_descriptor_image_info_items_vk.at       (0) : nullptr;
+    write_vk.pNext            = nullptr;
+    write_vk.pTexelBufferView = (m_push_descriptor_texel_buffer_view_items_vk.size() > 0) ? &m_push_descriptor_texel_buffer_view_items_vk.at(0) : nullptr;
+    write_vk.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+
+    entrypoints = m_device_ptr->get_extension_khr_push_descriptor_entrypoints();
+
+    m_parent_command_pool_ptr->lock();
+    lock();
+    {
+        entrypoints.vkCmdPushDescriptorSetKHR(m_command_buffer,
+                                              static_cast<VkPipelineBindPoint>(in_pipeline_bind_point),
+                                              in_layout_ptr->get_pipeline_layout(),
+                                              in_set,
+                                              1, /* descriptorWriteCount */
+                                              &write_vk);
+    }
+    unlock();
+    m_parent_command_pool_ptr->unlock();
+
+    result = true;
+end:
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::CommandBufferBase::record_reset_event(Anvil::Event*             in_event_ptr,
                                                   Anvil::PipelineStageFlags in_stage_mask)
@@ -3361,6 +3898,8 @@ bool Anvil::CommandBufferBase::record_reset_event(Anvil::Event*             in_e
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -3408,6 +3947,8 @@ bool Anvil::CommandBufferBase::record_reset_query_pool(Anvil::QueryPool* in_quer
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -3462,6 +4003,8 @@ bool Anvil::CommandBufferBase::record_resolve_image(Anvil::Image*              i
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -3637,6 +4180,8 @@ bool Anvil::CommandBufferBase::record_set_device_mask_KHR(uint32_t in_device_mas
         }
     }
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -3692,6 +4237,8 @@ bool Anvil::CommandBufferBase::record_set_event(Anvil::Event*             in_eve
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -4019,6 +4566,8 @@ bool Anvil::CommandBufferBase::record_update_buffer(Anvil::Buffer* in_dst_buffer
     #endif
 
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -4112,6 +4661,8 @@ bool Anvil::CommandBufferBase::record_wait_events(uint32_t                   in_
         memory_barriers_vk.at(n_memory_barrier) = in_memory_barriers_ptr[n_memory_barrier].get_barrier_vk();
     }
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -4164,6 +4715,8 @@ bool Anvil::CommandBufferBase::record_write_buffer_marker_AMD(const Anvil::Pipel
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -4207,6 +4760,8 @@ bool Anvil::CommandBufferBase::record_write_timestamp(Anvil::PipelineStageFlagBi
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -4258,11 +4813,25 @@ bool Anvil::CommandBufferBase::reset(bool in_should_release_resources)
     }
     #endif
 
+    discard_pending_pipeline_barriers();
+
     result = true;
 end:
     return result;
 }
 
+/* Please see header for specification */
+void Anvil::CommandBufferBase::set_pipeline_barrier_batching_enabled(bool in_enable)
+{
+    if (!in_enable                                &&
+         m_pending_barrier_src_stage_mask_vk != 0)
+    {
+        flush_pending_pipeline_barriers_internal();
+    }
+
+    m_pipeline_barrier_batching_enabled = in_enable;
+}
+
 /* Please see header for specification */
 bool Anvil::CommandBufferBase::stop_recording()
 {
@@ -4276,6 +4845,8 @@ bool Anvil::CommandBufferBase::stop_recording()
         goto end;
     }
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -4578,6 +5149,8 @@ bool Anvil::PrimaryCommandBuffer::record_begin_render_pass_internal(const bool&
         render_pass_begin_info_chain.append_struct(sl_begin_info);
     }
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -4661,6 +5234,8 @@ bool Anvil::PrimaryCommandBuffer::record_end_render_pass_internal(const bool& in
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -4721,6 +5296,8 @@ bool Anvil::PrimaryCommandBuffer::record_execute_commands(uint32_t
         cmd_buffers.at(n_cmd_buffer) = in_cmd_buffer_ptrs[n_cmd_buffer]->get_command_buffer();
     }
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -4788,6 +5365,8 @@ bool Anvil::PrimaryCommandBuffer::record_next_subpass_internal(const bool&
     }
     #endif
 
+    flush_pending_pipeline_barriers();
+
     m_parent_command_pool_ptr->lock();
     lock();
     {
@@ -4899,6 +5478,8 @@ bool Anvil::PrimaryCommandBuffer::start_recording(bool
     }
     #endif
 
+    discard_pending_pipeline_barriers();
+
     m_device_mask           = in_opt_device_mask;
     m_recording_in_progress = true;
     result                  = true;
@@ -5035,6 +5616,8 @@ bool Anvil::SecondaryCommandBuffer::start_recording(bool
     }
     #endif
 
+    discard_pending_pipeline_barriers();
+
     m_is_renderpass_active  = in_renderpass_usage_only;
     m_recording_in_progress = true;
     result                  = true;
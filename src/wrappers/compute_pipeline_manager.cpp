@@ -23,6 +23,7 @@
 #include "misc/compute_pipeline_create_info.h"
 #include "misc/debug.h"
 #include "misc/object_tracker.h"
+#include "misc/tracer.h"
 #include "wrappers/compute_pipeline_manager.h"
 #include "wrappers/device.h"
 #include "wrappers/pipeline_cache.h"
@@ -49,6 +50,8 @@ Anvil::ComputePipelineManager::ComputePipelineManager(Anvil::BaseDevice*    in_d
 /* Stub destructor */
 Anvil::ComputePipelineManager::~ComputePipelineManager()
 {
+    stop_async_bake_thread();
+
     /* Unregister the object */
     Anvil::ObjectTracker::get()->unregister_object(Anvil::ObjectType::ANVIL_COMPUTE_PIPELINE_MANAGER,
                                                     this);
@@ -57,60 +60,30 @@ Anvil::ComputePipelineManager::~ComputePipelineManager()
     m_outstanding_pipelines.clear();
 }
 
-/** Re-creates Vulkan compute pipeline objects for all added non-proxy pipelines marked
- *  as dirty. A new compute pipeline layout object may, but does not have to, be also
- *  created implicitly by calling this function.
+/** Creates Vulkan compute pipeline objects for the specified bake items. May be called from
+ *  the manager's background thread.
  *
  *  @return true if the function was successful, false otherwise.
  **/
-bool Anvil::ComputePipelineManager::bake()
+bool Anvil::ComputePipelineManager::compile_pipelines(const std::vector<BakeItem>&  in_bake_items,
+                                                      const std::vector<BakeGroup>& in_bake_groups,
+                                                      std::vector<VkPipeline>*      out_pipelines_ptr)
 {
-    typedef struct BakeItem
-    {
-        VkComputePipelineCreateInfo create_info;
-        PipelineID                  pipeline_id;
-        Pipeline*                   pipeline_ptr;
-
-        BakeItem(const VkComputePipelineCreateInfo& in_create_info,
-                 PipelineID                         in_pipeline_id,
-                 Pipeline*                          in_pipeline_ptr)
-        {
-            create_info  = in_create_info;
-            pipeline_id  = in_pipeline_id;
-            pipeline_ptr = in_pipeline_ptr;
-        }
+    ANVIL_TRACE_CPU_SPAN("ComputePipelineManager::compile_pipelines");
 
-        bool operator==(const PipelineID& in_pipeline_id) const
-        {
-            return pipeline_id == in_pipeline_id;
-        }
-    } BakeItem;
-
-    std::map<VkPipelineLayout, std::vector<BakeItem> > layout_to_bake_item_map;
-    std::unique_lock<std::recursive_mutex>             mutex_lock;
-    auto                                               mutex_ptr                    (get_mutex() );
-    uint32_t                                           n_current_pipeline           (0);
-    std::vector<VkComputePipelineCreateInfo>           pipeline_create_info_items_vk;
-    bool                                               result                       (false);
-    std::vector<VkPipeline>                            result_pipeline_items_vk;
-    VkResult                                           result_vk;
-
-    if (mutex_ptr != nullptr)
-    {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
-    }
+    uint32_t                                            n_current_pipeline           (0);
+    std::vector<VkComputePipelineCreateInfo>            pipeline_create_info_items_vk;
+    bool                                                result                       (false);
+    std::vector<std::vector<VkSpecializationMapEntry> > specialization_map_entries_vk(in_bake_items.size() );
+    std::vector<VkSpecializationInfo>                   specialization_info_vk       (in_bake_items.size() );
 
-    std::vector<std::vector<VkSpecializationMapEntry> > specialization_map_entries_vk(m_outstanding_pipelines.size() );
-    std::vector<VkSpecializationInfo>                   specialization_info_vk       (m_outstanding_pipelines.size());
+    pipeline_create_info_items_vk.reserve(in_bake_items.size() );
 
-    for (auto pipeline_iterator  = m_outstanding_pipelines.begin();
-              pipeline_iterator != m_outstanding_pipelines.end();
-            ++pipeline_iterator, ++n_current_pipeline)
+    for (auto bake_item_iterator  = in_bake_items.begin();
+              bake_item_iterator != in_bake_items.end();
+            ++bake_item_iterator, ++n_current_pipeline)
     {
-        auto                                      current_pipeline_id                      = pipeline_iterator->first;
-        Pipeline*                                 current_pipeline_ptr                     = pipeline_iterator->second.get();
+        Pipeline*                                 current_pipeline_ptr                     = bake_item_iterator->pipeline_ptr;
         const auto                                current_pipeline_create_info_ptr         = current_pipeline_ptr->pipeline_create_info_ptr.get();
         VkComputePipelineCreateInfo               pipeline_create_info;
         const Anvil::ShaderModuleStageEntryPoint* shader_stage_entry_point_ptr             = nullptr;
@@ -118,13 +91,7 @@ bool Anvil::ComputePipelineManager::bake()
         const SpecializationConstants*            specialization_constants_ptr             = nullptr;
 
         anvil_assert(current_pipeline_ptr->baked_pipeline == VK_NULL_HANDLE);
-
-        if (current_pipeline_ptr->layout_ptr == nullptr)
-        {
-            get_pipeline_layout(pipeline_iterator->first);
-
-            anvil_assert(current_pipeline_ptr->layout_ptr != nullptr);
-        }
+        anvil_assert(current_pipeline_ptr->layout_ptr     != nullptr);
 
         current_pipeline_create_info_ptr->get_specialization_constants(Anvil::ShaderStage::COMPUTE,
                                                                       &specialization_constants_ptr,
@@ -138,49 +105,32 @@ bool Anvil::ComputePipelineManager::bake()
                                         &specialization_info_vk       [n_current_pipeline]);
         }
 
-        /* Prepare the Vulkan create info descriptor & store it in the map for later baking */
+        /* Prepare the Vulkan create info descriptor */
         const auto current_pipeline_base_pipeline_id = current_pipeline_create_info_ptr->get_base_pipeline_id();
 
         if (current_pipeline_base_pipeline_id != UINT32_MAX)
         {
-            /* There are three cases we need to handle separately here:
+            /* There are two cases we need to handle separately here:
              *
-             * 1. The base pipeline is to be baked in the call we're preparing for. Determine
-             *    its index in the create info descriptor array and use it.
+             * 1. The base pipeline is to be baked in the call we're preparing for. Its index, relative
+             *    to the start of the bake group, has already been determined by get_bake_items().
              * 2. The pipeline has been baked earlier. We should be able to work around this
-             *    by providing a handle to the pipeline, instead of the index.
-             * 3. The pipeline under specified index uses a different layout. This indicates
-             *    a bug in the app or the manager.
+             *    by providing a handle to the pipeline, instead of the index. If the handle is not
+             *    available, the base pipeline is still being baked asynchronously and the pipeline
+             *    is created as a regular one.
              *
-             * NOTE: A slightly adjusted version of this code is re-used in GraphicsPipelineManager::bake() */
-            auto& pipeline_vector        = layout_to_bake_item_map[pipeline_create_info.layout];
-            auto  base_pipeline_id       = current_pipeline_ptr->pipeline_create_info_ptr->get_base_pipeline_id();
-            auto  base_pipeline_iterator = std::find(pipeline_vector.begin(),
-                                                     pipeline_vector.end(),
-                                                     base_pipeline_id);
-
-            if (base_pipeline_iterator != pipeline_vector.end() )
+             * NOTE: A slightly adjusted version of this code is re-used in GraphicsPipelineManager::compile_pipelines() */
+            if (bake_item_iterator->base_pipeline_index != static_cast<int32_t>(UINT32_MAX) )
             {
                 /* Case 1 */
                 pipeline_create_info.basePipelineHandle = VK_NULL_HANDLE;
-                pipeline_create_info.basePipelineIndex  = static_cast<int32_t>(base_pipeline_iterator - pipeline_vector.begin() );
+                pipeline_create_info.basePipelineIndex  = bake_item_iterator->base_pipeline_index;
             }
             else
             {
-                auto baked_pipeline_iterator = m_baked_pipelines.find(base_pipeline_id);
-
-                if (baked_pipeline_iterator                         != m_baked_pipelines.end() &&
-                    baked_pipeline_iterator->second->baked_pipeline != VK_NULL_HANDLE)
-                {
-                    /* Case 2 */
-                    pipeline_create_info.basePipelineHandle = baked_pipeline_iterator->second->baked_pipeline;
-                    pipeline_create_info.basePipelineIndex  = UINT32_MAX;
-                }
-                else
-                {
-                    /* Case 3 */
-                    anvil_assert_fail();
-                }
+                /* Case 2 */
+                pipeline_create_info.basePipelineHandle = bake_item_iterator->base_pipeline_handle;
+                pipeline_create_info.basePipelineIndex  = UINT32_MAX;
             }
         }
         else
@@ -190,8 +140,6 @@ bool Anvil::ComputePipelineManager::bake()
             pipeline_create_info.basePipelineIndex  = UINT32_MAX;
         }
 
-        anvil_assert(current_pipeline_ptr->layout_ptr != nullptr);
-
         current_pipeline_create_info_ptr->get_shader_stage_properties(Anvil::ShaderStage::COMPUTE,
                                                                      &shader_stage_entry_point_ptr);
 
@@ -225,69 +173,30 @@ bool Anvil::ComputePipelineManager::bake()
             pipeline_create_info.flags |= VK_PIPELINE_CREATE_DISPATCH_BASE_KHR;
         }
 
-        layout_to_bake_item_map[pipeline_create_info.layout].push_back(BakeItem(pipeline_create_info,
-                                                                                current_pipeline_id,
-                                                                                current_pipeline_ptr) );
+        pipeline_create_info_items_vk.push_back(pipeline_create_info);
     }
 
-    /* We can finally bake the pipeline objects. */
-    for (auto map_iterator  = layout_to_bake_item_map.begin();
-              map_iterator != layout_to_bake_item_map.end();
-            ++map_iterator)
+    /* We can finally bake the pipeline objects. Each bake group is handled by a separate vkCreateComputePipelines() call,
+     * which may be issued from a worker thread if parallel baking has been enabled. */
+    out_pipelines_ptr->clear ();
+    out_pipelines_ptr->resize(pipeline_create_info_items_vk.size(),
+                              VK_NULL_HANDLE);
+
+    if (!create_pipelines(in_bake_groups,
+                          [&](const BakeGroup& in_bake_group,
+                              VkPipelineCache  in_pipeline_cache)
+                          {
+                              return Anvil::Vulkan::vkCreateComputePipelines(m_device_ptr->get_device_vk(),
+                                                                             in_pipeline_cache,
+                                                                             in_bake_group.n_bake_items,
+                                                                            &pipeline_create_info_items_vk.at(in_bake_group.n_first_bake_item),
+                                                                             nullptr, /* pAllocator */
+                                                                            &out_pipelines_ptr->at           (in_bake_group.n_first_bake_item) );
+                          }) )
     {
-        uint32_t n_current_item = 0;
-
-        pipeline_create_info_items_vk.clear();
-
-        for (auto item_iterator  = map_iterator->second.begin();
-                  item_iterator != map_iterator->second.end();
-                ++item_iterator)
-        {
-            const BakeItem& current_bake_item = *item_iterator;
-
-            pipeline_create_info_items_vk.push_back(current_bake_item.create_info);
-        }
-
-        result_pipeline_items_vk.resize(pipeline_create_info_items_vk.size() );
-
-        m_pipeline_cache_ptr->lock();
-        {
-            result_vk = Anvil::Vulkan::vkCreateComputePipelines(m_device_ptr->get_device_vk(),
-                                                                m_pipeline_cache_ptr->get_pipeline_cache(),
-                                                                static_cast<uint32_t>(pipeline_create_info_items_vk.size() ),
-                                                               &pipeline_create_info_items_vk[0],
-                                                                nullptr, /* pAllocator */
-                                                               &result_pipeline_items_vk[0]);
-        }
-        m_pipeline_cache_ptr->unlock();
-
-        if (!is_vk_call_successful(result_vk))
-        {
-            anvil_assert_vk_call_succeeded(result_vk);
-
-            goto end;
-        }
-
-        for (auto item_iterator  = map_iterator->second.begin();
-                  item_iterator != map_iterator->second.end();
-                ++item_iterator, ++n_current_item)
-        {
-            const BakeItem& current_bake_item = *item_iterator;
-
-            anvil_assert(m_baked_pipelines.find(current_bake_item.pipeline_id) == m_baked_pipelines.end() );
-            anvil_assert(result_pipeline_items_vk[n_current_item]    != VK_NULL_HANDLE);
-
-            current_bake_item.pipeline_ptr->baked_pipeline  = result_pipeline_items_vk[n_current_item];
-        }
+        goto end;
     }
 
-    for (auto& current_baked_pipeline : m_outstanding_pipelines)
-    {
-        m_baked_pipelines[current_baked_pipeline.first] = std::move(current_baked_pipeline.second);
-    }
-
-    m_outstanding_pipelines.clear();
-
     /* All done */
     result = true;
 end:
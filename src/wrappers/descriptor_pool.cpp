@@ -144,6 +144,15 @@ bool Anvil::DescriptorPool::alloc_descriptor_sets(uint32_t
             {
                 auto ds_create_info_ptr = in_ds_allocations_ptr[n_set].ds_layout_ptr->get_create_info();
 
+                if ((ds_create_info_ptr->get_create_flags() & Anvil::DescriptorSetLayoutCreateFlagBits::PUSH_DESCRIPTOR_BIT_KHR) != 0)
+                {
+                    /* Push descriptor layouts cannot be used to allocate descriptor sets. */
+                    anvil_assert_fail();
+
+                    result = false;
+                    goto end;
+                }
+
                 if (ds_create_info_ptr->contains_variable_descriptor_count_binding() )
                 {
                     if ((dp_create_flags & Anvil::DescriptorPoolCreateFlagBits::UPDATE_AFTER_BIND_BIT) != 0)
@@ -242,6 +251,62 @@ Anvil::DescriptorPoolUniquePtr Anvil::DescriptorPool::create(Anvil::DescriptorPo
     return result_ptr;
 }
 
+/* Please see header for specification */
+bool Anvil::DescriptorPool::free_descriptor_sets(uint32_t                in_n_sets,
+                                                 DescriptorSetUniquePtr* inout_descriptor_sets_ptr)
+{
+    bool     result    = false;
+    VkResult result_vk = VK_ERROR_INITIALIZATION_FAILED;
+
+    anvil_assert(inout_descriptor_sets_ptr != nullptr);
+
+    if ((m_create_info_ptr->get_create_flags() & Anvil::DescriptorPoolCreateFlagBits::FREE_DESCRIPTOR_SET_BIT) == 0)
+    {
+        anvil_assert_fail();
+
+        goto end;
+    }
+
+    if (in_n_sets == 0)
+    {
+        result = true;
+
+        goto end;
+    }
+
+    lock();
+    {
+        m_ds_cache.resize(in_n_sets);
+
+        for (uint32_t n_set = 0;
+                      n_set < in_n_sets;
+                    ++n_set)
+        {
+            auto& current_ds_ptr = inout_descriptor_sets_ptr[n_set];
+
+            anvil_assert(current_ds_ptr                    != nullptr);
+            anvil_assert(current_ds_ptr->m_parent_pool_ptr == this);
+
+            m_ds_cache.at(n_set) = current_ds_ptr->m_descriptor_set;
+        }
+
+        result_vk = Anvil::Vulkan::vkFreeDescriptorSets(m_device_ptr->get_device_vk(),
+                                                        m_pool,
+                                                        in_n_sets,
+                                                       &m_ds_cache.at(0) );
+    }
+    unlock();
+
+    anvil_assert_vk_call_succeeded(result_vk);
+
+    release_descriptor_set_wrappers(in_n_sets,
+                                    inout_descriptor_sets_ptr);
+
+    result = is_vk_call_successful(result_vk);
+end:
+    return result;
+}
+
 /* Please see header for specification */
 bool Anvil::DescriptorPool::init()
 {
@@ -386,4 +451,44 @@ bool Anvil::DescriptorPool::reset()
     }
 
     return is_vk_call_successful(result_vk); 
-}
\ No newline at end of file
+}
+
+/* Please see header for specification */
+bool Anvil::DescriptorPool::reset(uint32_t                in_n_sets,
+                                  DescriptorSetUniquePtr* inout_descriptor_sets_ptr)
+{
+    const bool result = reset();
+
+    release_descriptor_set_wrappers(in_n_sets,
+                                    inout_descriptor_sets_ptr);
+
+    return result;
+}
+
+/** Releases user-specified descriptor set wrappers, after unsubscribing them from pool reset notifications.
+ *  The wrappers must have been allocated from this pool.
+ **/
+void Anvil::DescriptorPool::release_descriptor_set_wrappers(uint32_t                in_n_sets,
+                                                            DescriptorSetUniquePtr* inout_descriptor_sets_ptr)
+{
+    for (uint32_t n_set = 0;
+                  n_set < in_n_sets;
+                ++n_set)
+    {
+        auto& current_ds_ptr = inout_descriptor_sets_ptr[n_set];
+
+        if (current_ds_ptr == nullptr)
+        {
+            continue;
+        }
+
+        anvil_assert(current_ds_ptr->m_parent_pool_ptr == this);
+
+        unregister_from_callbacks(Anvil::DESCRIPTOR_POOL_CALLBACK_ID_POOL_RESET,
+                                  std::bind(&DescriptorSet::on_parent_pool_reset,
+                                            current_ds_ptr.get() ),
+                                  current_ds_ptr.get() );
+
+        current_ds_ptr.reset();
+    }
+}
@@ -33,11 +33,89 @@
 #include "wrappers/device.h"
 #include "wrappers/image_view.h"
 #include "wrappers/sampler.h"
+#include <algorithm>
+#include <functional>
 
 #ifdef max
     #undef max
 #endif
 
+/* Maximum number of descriptor update template objects cached per descriptor set. Each distinct pattern of
+ * modified array items needs a separate template, so the least recently used ones are released past this limit.
+ */
+static const uint32_t g_max_cached_update_templates = 16;
+
+
+/** Returns the number of bytes a single descriptor of type @param in_descriptor_type takes in
+ *  descriptor update template raw data, or 0 for inline uniform blocks.
+ */
+static size_t get_template_raw_data_element_size(const Anvil::DescriptorType& in_descriptor_type)
+{
+    size_t result = 0;
+
+    switch (in_descriptor_type)
+    {
+        case Anvil::DescriptorType::COMBINED_IMAGE_SAMPLER:
+        case Anvil::DescriptorType::INPUT_ATTACHMENT:
+        case Anvil::DescriptorType::SAMPLED_IMAGE:
+        case Anvil::DescriptorType::SAMPLER:
+        case Anvil::DescriptorType::STORAGE_IMAGE:
+        {
+            result = sizeof(VkDescriptorImageInfo);
+
+            break;
+        }
+
+        case Anvil::DescriptorType::STORAGE_BUFFER:
+        case Anvil::DescriptorType::STORAGE_BUFFER_DYNAMIC:
+        case Anvil::DescriptorType::UNIFORM_BUFFER:
+        case Anvil::DescriptorType::UNIFORM_BUFFER_DYNAMIC:
+        {
+            result = sizeof(VkDescriptorBufferInfo);
+
+            break;
+        }
+
+        case Anvil::DescriptorType::STORAGE_TEXEL_BUFFER:
+        case Anvil::DescriptorType::UNIFORM_TEXEL_BUFFER:
+        {
+            result = sizeof(VkBufferView);
+
+            break;
+        }
+
+        default:
+        {
+            /* Inline uniform block updates are stored separately */
+            break;
+        }
+    }
+
+    return result;
+}
+
+namespace
+{
+    /* Descriptor info and write items gathered by DescriptorSet::update_using_core_method() and DescriptorSet::update_many().
+     * Storage is retained between updates issued by the same thread, so that steady-state updates do not allocate.
+     */
+    typedef struct CoreUpdateScratchData
+    {
+        std::vector<VkDescriptorBufferInfo>       buffer_info_items_vk;
+        std::vector<const Anvil::DescriptorSet*> ds_ptrs;
+        std::vector<VkDescriptorImageInfo>        image_info_items_vk;
+        std::vector<VkBufferView>                 texel_buffer_view_items_vk;
+        std::vector<VkWriteDescriptorSet>         write_items_vk;
+    } CoreUpdateScratchData;
+
+    CoreUpdateScratchData& get_core_update_scratch_data()
+    {
+        static thread_local CoreUpdateScratchData scratch_data;
+
+        return scratch_data;
+    }
+};
+
 /** Please see header for specification */
 Anvil::DescriptorSet::BindingItem& Anvil::DescriptorSet::BindingItem::operator=(const BufferBindingElement& in_element)
 {
@@ -118,12 +196,6 @@ Anvil::DescriptorSet::BindingItem& Anvil::DescriptorSet::BindingItem::operator=(
     return *this;
 }
 
-/** Please see header for specification */
-Anvil::DescriptorSet::BindingItem::~BindingItem()
-{
-    buffer_ptr = nullptr;
-}
-
 /** Please see header for specification */
 Anvil::DescriptorSet::BufferBindingElement::BufferBindingElement(Anvil::Buffer* in_buffer_ptr)
 {
@@ -261,15 +333,17 @@ Anvil::DescriptorSet::DescriptorSet(const Anvil::BaseDevice*          in_device_
                                     const Anvil::DescriptorSetLayout* in_layout_ptr,
                                     VkDescriptorSet                   in_descriptor_set,
                                     bool                              in_mt_safe)
-    :DebugMarkerSupportProvider(in_device_ptr,
-                                Anvil::ObjectType::DESCRIPTOR_SET),
-     MTSafetySupportProvider   (in_mt_safe),
-     m_descriptor_set          (in_descriptor_set),
-     m_device_ptr              (in_device_ptr),
-     m_dirty                   (true),
-     m_layout_ptr              (in_layout_ptr),
-     m_parent_pool_ptr         (in_parent_pool_ptr),
-     m_unusable                (false)
+    :DebugMarkerSupportProvider     (in_device_ptr,
+                                     Anvil::ObjectType::DESCRIPTOR_SET),
+     MTSafetySupportProvider        (in_mt_safe),
+     m_descriptor_set               (in_descriptor_set),
+     m_device_ptr                   (in_device_ptr),
+     m_dirty                        (true),
+     m_layout_ptr                   (in_layout_ptr),
+     m_parent_pool_ptr              (in_parent_pool_ptr),
+     m_n_template_updates           (0),
+     m_template_raw_data_fixed_size (0),
+     m_unusable                     (false)
 {
     alloc_bindings();
 
@@ -296,16 +370,18 @@ Anvil::DescriptorSet::~DescriptorSet()
                                                    this);
 }
 
-/** TODO */
+/** Builds m_bindings and m_binding_items for the layout the descriptor set has been created with. */
 void Anvil::DescriptorSet::alloc_bindings()
 {
     const auto     layout_info_ptr                         = m_layout_ptr->get_create_info();
     bool           has_variable_descriptor_count_binding   = false;
     const uint32_t n_bindings                              = layout_info_ptr->get_n_bindings();
+    uint32_t       n_items                                 = 0;
     uint32_t       variable_descriptor_count_binding_index = UINT32_MAX;
     uint32_t       variable_descriptor_count_binding_size  = 0;
 
-    m_cached_ds_write_items_vk.resize(n_bindings);
+    /* NOTE: Neither BindingData nor BindingItem is copyable, so the vectors are constructed at their final size instead of being resized. */
+    m_bindings = std::vector<BindingData>(n_bindings);
 
     has_variable_descriptor_count_binding = layout_info_ptr->contains_variable_descriptor_count_binding(&variable_descriptor_count_binding_index,
                                                                                                         &variable_descriptor_count_binding_size);
@@ -314,37 +390,35 @@ void Anvil::DescriptorSet::alloc_bindings()
                   n_binding < n_bindings;
                 ++n_binding)
     {
-        uint32_t              array_size      = 0;
-        uint32_t              binding_index   = UINT32_MAX;
-        Anvil::DescriptorType descriptor_type = Anvil::DescriptorType::UNKNOWN;
+        uint32_t     array_size   = 0;
+        BindingData& binding_data = m_bindings.at(n_binding);
 
         layout_info_ptr->get_binding_properties_by_index_number(n_binding,
-                                                               &binding_index,
-                                                               &descriptor_type,
+                                                               &binding_data.binding_index,
+                                                               &binding_data.descriptor_type,
                                                                &array_size,
-                                                                nullptr,  /* out_opt_stage_flags_ptr                */
-                                                                nullptr,  /* out_opt_immutable_samplers_enabled_ptr */
-                                                                nullptr); /* out_opt_flags_ptr                      */
+                                                                nullptr, /* out_opt_stage_flags_ptr */
+                                                               &binding_data.immutable_samplers_enabled,
+                                                               &binding_data.flags);
 
-        if (has_variable_descriptor_count_binding                                            &&
-            binding_index                         == variable_descriptor_count_binding_index)
+        if (has_variable_descriptor_count_binding                                      &&
+            binding_data.binding_index            == variable_descriptor_count_binding_index)
         {
             array_size = variable_descriptor_count_binding_size;
         }
 
-        auto binding_iterator = m_binding_ptrs.find(binding_index);
+        binding_data.template_raw_data_offset = m_template_raw_data_fixed_size;
+        m_template_raw_data_fixed_size       += array_size * get_template_raw_data_element_size(binding_data.descriptor_type);
 
-        if (binding_iterator                == m_binding_ptrs.end() ||
-            binding_iterator->second.size() != array_size)
+        if (binding_data.descriptor_type != Anvil::DescriptorType::INLINE_UNIFORM_BLOCK)
         {
-            m_binding_ptrs[binding_index] = BindingItemUniquePtrs();
-
-            if (descriptor_type != Anvil::DescriptorType::INLINE_UNIFORM_BLOCK)
-            {
-                m_binding_ptrs[binding_index].resize(array_size);
-            }
+            binding_data.n_first_item = n_items;
+            binding_data.n_items      = array_size;
+            n_items                  += array_size;
         }
     }
+
+    m_binding_items = std::vector<BindingItem>(n_items);
 }
 
 /* Please see header for specification */
@@ -416,50 +490,341 @@ void Anvil::DescriptorSet::fill_iub_vk_descriptor(const Anvil::DescriptorSet::Bi
 }
 
 /* Please see header for specification */
-bool Anvil::DescriptorSet::get_combined_image_sampler_binding_properties(uint32_t            in_n_binding,
-                                                                         uint32_t            in_n_binding_array_item,
-                                                                         Anvil::ImageLayout* out_opt_image_layout_ptr,
-                                                                         Anvil::ImageView**  out_opt_image_view_ptr_ptr,
-                                                                         Anvil::Sampler**    out_opt_sampler_ptr_ptr)
+bool Anvil::DescriptorSet::fill_template_raw_data(const Anvil::DescriptorSet::BindingItem& in_binding_item,
+                                                  const bool&                              in_immutable_samplers_enabled,
+                                                  uint8_t*                                 out_raw_data_ptr) const
 {
-    decltype(m_binding_ptrs)::const_iterator binding_ptr_iterator = m_binding_ptrs.find(in_n_binding);
-    bool                                     result               = true;
+    bool result = true;
 
-    if (binding_ptr_iterator == m_binding_ptrs.end() )
+    if (in_binding_item.buffer_ptr != nullptr)
     {
-        anvil_assert(binding_ptr_iterator != m_binding_ptrs.end());
-
-        result = false;
-        goto end;
+        fill_buffer_info_vk_descriptor(in_binding_item,
+                                       reinterpret_cast<VkDescriptorBufferInfo*>(out_raw_data_ptr) );
     }
-
-    if (binding_ptr_iterator->second.size() <= in_n_binding_array_item)
+    else
+    if (in_binding_item.buffer_view_ptr != nullptr)
     {
-        anvil_assert(binding_ptr_iterator->second.size() > in_n_binding_array_item);
-
-        result = false;
-        goto end;
+        *reinterpret_cast<VkBufferView*>(out_raw_data_ptr) = in_binding_item.buffer_view_ptr->get_buffer_view();
+    }
+    else
+    if (in_binding_item.image_view_ptr != nullptr ||
+        in_binding_item.sampler_ptr    != nullptr)
+    {
+        fill_image_info_vk_descriptor(in_binding_item,
+                                      in_immutable_samplers_enabled,
+                                      reinterpret_cast<VkDescriptorImageInfo*>(out_raw_data_ptr) );
+    }
+    else
+    if (in_binding_item.type_vk == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK)
+    {
+        fill_iub_vk_descriptor(in_binding_item,
+                               reinterpret_cast<VkWriteDescriptorSetInlineUniformBlockEXT*>(out_raw_data_ptr) );
     }
     else
     {
-        auto binding_item_iterator = binding_ptr_iterator->second.begin() + in_n_binding_array_item;
+        anvil_assert_fail();
+
+        result = false;
+    }
 
-        if (out_opt_image_layout_ptr != nullptr)
+    return result;
+}
+
+/** Appends VkWriteDescriptorSet items for all modified array items of the descriptor set to @param inout_write_items_vk_ptr.
+ *  Descriptor info referred to by the write items is appended to the remaining vectors, which must have enough capacity
+ *  reserved to hold m_binding_items.size() extra items each, so that previously gathered write items stay valid.
+ *
+ *  Inline uniform block data referred to by the write items is owned by the descriptor set. release_issued_iub_updates()
+ *  must be called once the write items have been passed to vkUpdateDescriptorSets().
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::DescriptorSet::gather_core_write_items(std::vector<VkDescriptorBufferInfo>* inout_buffer_info_items_vk_ptr,
+                                                   std::vector<VkDescriptorImageInfo>*  inout_image_info_items_vk_ptr,
+                                                   std::vector<VkBufferView>*           inout_texel_buffer_view_items_vk_ptr,
+                                                   std::vector<VkWriteDescriptorSet>*   inout_write_items_vk_ptr) const
+{
+    uint32_t       cached_ds_buffer_info_items_array_offset       = static_cast<uint32_t>(inout_buffer_info_items_vk_ptr->size      () );
+    uint32_t       cached_ds_image_info_items_array_offset        = static_cast<uint32_t>(inout_image_info_items_vk_ptr->size       () );
+    uint32_t       cached_ds_iub_array_offset                     = 0;
+    uint32_t       cached_ds_texel_buffer_info_items_array_offset = static_cast<uint32_t>(inout_texel_buffer_view_items_vk_ptr->size() );
+    const uint32_t n_bindings                                     = static_cast<uint32_t>(m_bindings.size() );
+
+    anvil_assert(!m_unusable);
+
+    anvil_assert(inout_buffer_info_items_vk_ptr->capacity      () - inout_buffer_info_items_vk_ptr->size      () >= m_binding_items.size() );
+    anvil_assert(inout_image_info_items_vk_ptr->capacity       () - inout_image_info_items_vk_ptr->size       () >= m_binding_items.size() );
+    anvil_assert(inout_texel_buffer_view_items_vk_ptr->capacity() - inout_texel_buffer_view_items_vk_ptr->size() >= m_binding_items.size() );
+
+    for (uint32_t n_binding = 0;
+                  n_binding < n_bindings;
+                ++n_binding)
+    {
+        BindingData&                  current_binding_data                          = m_bindings[n_binding];
+        const Anvil::DescriptorType   descriptor_type                               = current_binding_data.descriptor_type;
+        const bool                    is_iub_binding                                = (descriptor_type == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK);
+        uint32_t                      start_ds_buffer_info_items_array_offset       = cached_ds_buffer_info_items_array_offset;
+        uint32_t                      start_ds_image_info_items_array_offset        = cached_ds_image_info_items_array_offset;
+        uint32_t                      start_ds_iub_array_offset                     = cached_ds_iub_array_offset;
+        uint32_t                      start_ds_texel_buffer_info_items_array_offset = cached_ds_texel_buffer_info_items_array_offset;
+        VkWriteDescriptorSet          write_ds_vk;
+
+        if (!current_binding_data.dirty)
         {
-            *out_opt_image_layout_ptr = (*binding_item_iterator)->image_layout;
+            /* None of the binding's array items have changed since the last update. */
+            continue;
         }
 
-        if (out_opt_image_view_ptr_ptr != nullptr)
+        /* For each modified array item, initialize a descriptor info item.. */
+        uint32_t n_current_binding_items = (is_iub_binding) ? static_cast<uint32_t>(current_binding_data.iub_update_ptrs.size() )
+                                                            : current_binding_data.n_items;
+        int32_t  n_last_binding_item     = -1;
+
+        for (uint32_t n_current_binding_item = 0;
+                      n_current_binding_item < n_current_binding_items;
+                    ++n_current_binding_item)
         {
-            *out_opt_image_view_ptr_ptr = (*binding_item_iterator)->image_view_ptr;
+            BindingItem* current_binding_item_ptr = (is_iub_binding) ? current_binding_data.iub_update_ptrs[n_current_binding_item].get()
+                                                                     : &m_binding_items[current_binding_data.n_first_item + n_current_binding_item];
+            bool         needs_write_item         = ((n_current_binding_item + 1) == n_current_binding_items);
+
+            if (is_iub_binding)
+            {
+                /* Binding items for this descriptor type correspond internally to consecutive update requests which have been scheduled for
+                 * the same IUB binding. As per API restrictions, only one such update can be carried out using a single VkWriteDescriptorSet struct.
+                 */
+                n_last_binding_item = static_cast<uint32_t>(current_binding_item_ptr->start_offset) - 1; //< write_ds_vk.dstArrayElement corresponds to start offset for inline uniform blocks
+            }
+
+            if (current_binding_item_ptr->type_vk == Anvil::DescriptorType::UNKNOWN)
+            {
+                /* Arrayed bindings are only permitted if the binding has been created with the PARTIALLY_BOUND flag */
+                if ((current_binding_data.flags & Anvil::DescriptorBindingFlagBits::PARTIALLY_BOUND_BIT) == 0)
+                {
+                    anvil_assert_fail();
+
+                    return false;
+                }
+
+                /* Need to cache a write item at this point since current binding has not been assigned a descriptor */
+                needs_write_item = true;
+            }
+            else
+            if (!current_binding_item_ptr->dirty)
+            {
+                /* The array item is up to date. Write out the run of modified items preceding it, if any, and skip it. */
+                needs_write_item = true;
+            }
+            else
+            if (current_binding_item_ptr->buffer_ptr != nullptr)
+            {
+                VkDescriptorBufferInfo buffer_info;
+
+                fill_buffer_info_vk_descriptor(*current_binding_item_ptr,
+                                              &buffer_info);
+
+                inout_buffer_info_items_vk_ptr->push_back(buffer_info);
+
+                ++cached_ds_buffer_info_items_array_offset;
+            }
+            else
+            if (current_binding_item_ptr->buffer_view_ptr != nullptr)
+            {
+                inout_texel_buffer_view_items_vk_ptr->push_back(current_binding_item_ptr->buffer_view_ptr->get_buffer_view() );
+
+                ++cached_ds_texel_buffer_info_items_array_offset;
+            }
+            else
+            if (current_binding_item_ptr->image_view_ptr != nullptr ||
+                current_binding_item_ptr->sampler_ptr    != nullptr)
+            {
+                VkDescriptorImageInfo image_info;
+
+                fill_image_info_vk_descriptor(*current_binding_item_ptr,
+                                              current_binding_data.immutable_samplers_enabled,
+                                             &image_info);
+
+                inout_image_info_items_vk_ptr->push_back(image_info);
+
+                ++cached_ds_image_info_items_array_offset;
+            }
+            else
+            {
+                VkWriteDescriptorSetInlineUniformBlockEXT iub_info;
+
+                anvil_assert(is_iub_binding);
+
+                fill_iub_vk_descriptor(*current_binding_item_ptr,
+                                      &iub_info);
+
+                m_cached_ds_write_iub_items_vk.at(start_ds_iub_array_offset) = iub_info;
+
+                needs_write_item           =  true;
+                cached_ds_iub_array_offset ++;
+            }
+
+            if (needs_write_item)
+            {
+                uint32_t n_descriptors = 0;
+
+                if (is_iub_binding)
+                {
+                    anvil_assert((cached_ds_buffer_info_items_array_offset       - start_ds_buffer_info_items_array_offset)       +
+                                 (cached_ds_image_info_items_array_offset        - start_ds_image_info_items_array_offset)        +
+                                 (cached_ds_texel_buffer_info_items_array_offset - start_ds_texel_buffer_info_items_array_offset) == 0);
+
+                    n_descriptors = m_cached_ds_write_iub_items_vk.at(start_ds_iub_array_offset).dataSize;
+
+                    anvil_assert(n_descriptors != 0);
+                }
+                else
+                {
+                    anvil_assert(cached_ds_iub_array_offset == start_ds_iub_array_offset);
+
+                    n_descriptors = (cached_ds_buffer_info_items_array_offset       - start_ds_buffer_info_items_array_offset)       +
+                                    (cached_ds_image_info_items_array_offset        - start_ds_image_info_items_array_offset)        +
+                                    (cached_ds_texel_buffer_info_items_array_offset - start_ds_texel_buffer_info_items_array_offset);
+                }
+
+                if (n_descriptors > 0)
+                {
+                    write_ds_vk.descriptorCount  = n_descriptors;
+                    write_ds_vk.descriptorType   = static_cast<VkDescriptorType>(descriptor_type);
+                    write_ds_vk.dstArrayElement  = n_last_binding_item + 1;
+                    write_ds_vk.dstBinding       = current_binding_data.binding_index;
+                    write_ds_vk.dstSet           = m_descriptor_set;
+                    write_ds_vk.pBufferInfo      = (start_ds_buffer_info_items_array_offset != cached_ds_buffer_info_items_array_offset)             ? &inout_buffer_info_items_vk_ptr->at(start_ds_buffer_info_items_array_offset)
+                                                                                                                                                     : nullptr;
+                    write_ds_vk.pImageInfo       = (start_ds_image_info_items_array_offset  != cached_ds_image_info_items_array_offset)              ? &inout_image_info_items_vk_ptr->at(start_ds_image_info_items_array_offset)
+                                                                                                                                                     : nullptr;
+                    write_ds_vk.pNext            = nullptr;
+                    write_ds_vk.pTexelBufferView = (start_ds_texel_buffer_info_items_array_offset != cached_ds_texel_buffer_info_items_array_offset) ? &inout_texel_buffer_view_items_vk_ptr->at(start_ds_texel_buffer_info_items_array_offset)
+                                                                                                                                                     : nullptr;
+                    write_ds_vk.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+
+                    anvil_assert(write_ds_vk.descriptorCount != 0);
+
+                    inout_write_items_vk_ptr->push_back(write_ds_vk);
+                }
+
+                if (start_ds_iub_array_offset - cached_ds_iub_array_offset)
+                {
+                    /* TODO: This is ugly but will always work, as you can't use vkUpdateDescriptorSets() for any other updates if inline uniform block's contents is
+                     *       being refreshed. Still, we should be using struct chains instead here.
+                     */
+                    anvil_assert((cached_ds_iub_array_offset - start_ds_iub_array_offset) == 1);
+
+                    inout_write_items_vk_ptr->back().pNext = &m_cached_ds_write_iub_items_vk.at(start_ds_iub_array_offset);
+                }
+
+                n_last_binding_item                           = n_current_binding_item;
+                start_ds_buffer_info_items_array_offset       = cached_ds_buffer_info_items_array_offset;
+                start_ds_image_info_items_array_offset        = cached_ds_image_info_items_array_offset;
+                start_ds_iub_array_offset                     = cached_ds_iub_array_offset;
+                start_ds_texel_buffer_info_items_array_offset = cached_ds_texel_buffer_info_items_array_offset;
+            }
+
+            current_binding_item_ptr->dirty = false;
         }
 
-        if (out_opt_sampler_ptr_ptr != nullptr)
+        current_binding_data.dirty = false;
+    }
+
+    m_dirty = false;
+
+    return true;
+}
+
+/** Returns data of the binding at index @param in_binding_index, or nullptr if the layout does not define such a binding. */
+Anvil::DescriptorSet::BindingData* Anvil::DescriptorSet::get_binding_data(BindingIndex in_binding_index) const
+{
+    BindingData* result_ptr = nullptr;
+
+    /* Bindings usually use consecutive indices starting at zero, in which case no search is needed. */
+    if (in_binding_index                           < m_bindings.size() &&
+        m_bindings[in_binding_index].binding_index == in_binding_index)
+    {
+        result_ptr = &m_bindings[in_binding_index];
+    }
+    else
+    {
+        auto binding_iterator = std::lower_bound(m_bindings.begin(),
+                                                 m_bindings.end  (),
+                                                 in_binding_index,
+                                                 [](const BindingData& in_binding_data,
+                                                    BindingIndex       in_binding_index)
+                                                 {
+                                                     return in_binding_data.binding_index < in_binding_index;
+                                                 });
+
+        if (binding_iterator                != m_bindings.end() &&
+            binding_iterator->binding_index == in_binding_index)
         {
-            *out_opt_sampler_ptr_ptr = (*binding_item_iterator)->sampler_ptr;
+            result_ptr = &(*binding_iterator);
         }
     }
 
+    anvil_assert(result_ptr != nullptr);
+
+    return result_ptr;
+}
+
+/** Returns array item @param in_n_item of the binding at index @param in_binding_index, or nullptr if either index is invalid. */
+const Anvil::DescriptorSet::BindingItem* Anvil::DescriptorSet::get_binding_item(BindingIndex in_binding_index,
+                                                                                uint32_t     in_n_item) const
+{
+    const BindingData* binding_data_ptr = get_binding_data(in_binding_index);
+    const BindingItem* result_ptr       = nullptr;
+
+    if (binding_data_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    if (binding_data_ptr->n_items <= in_n_item)
+    {
+        anvil_assert(binding_data_ptr->n_items > in_n_item);
+
+        goto end;
+    }
+
+    result_ptr = &m_binding_items.at(binding_data_ptr->n_first_item + in_n_item);
+end:
+    return result_ptr;
+}
+
+/* Please see header for specification */
+bool Anvil::DescriptorSet::get_combined_image_sampler_binding_properties(uint32_t            in_n_binding,
+                                                                         uint32_t            in_n_binding_array_item,
+                                                                         Anvil::ImageLayout* out_opt_image_layout_ptr,
+                                                                         Anvil::ImageView**  out_opt_image_view_ptr_ptr,
+                                                                         Anvil::Sampler**    out_opt_sampler_ptr_ptr)
+{
+    const BindingItem* binding_item_ptr = get_binding_item(in_n_binding,
+                                                           in_n_binding_array_item);
+    bool               result           = false;
+
+    if (binding_item_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    if (out_opt_image_layout_ptr != nullptr)
+    {
+        *out_opt_image_layout_ptr = binding_item_ptr->image_layout;
+    }
+
+    if (out_opt_image_view_ptr_ptr != nullptr)
+    {
+        *out_opt_image_view_ptr_ptr = binding_item_ptr->image_view_ptr;
+    }
+
+    if (out_opt_sampler_ptr_ptr != nullptr)
+    {
+        *out_opt_sampler_ptr_ptr = binding_item_ptr->sampler_ptr;
+    }
+
+    result = true;
 end:
     return result;
 }
@@ -470,39 +835,26 @@ bool Anvil::DescriptorSet::get_input_attachment_binding_properties(uint32_t
                                                                    Anvil::ImageLayout* out_opt_image_layout_ptr,
                                                                    Anvil::ImageView**  out_opt_image_view_ptr_ptr) const
 {
-    decltype(m_binding_ptrs)::const_iterator binding_iterator = m_binding_ptrs.find(in_n_binding);
-    bool                                     result           = true;
+    const BindingItem* binding_item_ptr = get_binding_item(in_n_binding,
+                                                           in_n_binding_array_item);
+    bool               result           = false;
 
-    if (binding_iterator == m_binding_ptrs.end() )
+    if (binding_item_ptr == nullptr)
     {
-        anvil_assert(binding_iterator != m_binding_ptrs.end());
-
-        result = false;
         goto end;
     }
 
-    if (binding_iterator->second.size() <= in_n_binding_array_item)
+    if (out_opt_image_layout_ptr != nullptr)
     {
-        anvil_assert(binding_iterator->second.size() > in_n_binding_array_item);
-
-        result = false;
-        goto end;
+        *out_opt_image_layout_ptr = binding_item_ptr->image_layout;
     }
-    else
-    {
-        auto binding_item_iterator = binding_iterator->second.begin() + in_n_binding_array_item;
 
-        if (out_opt_image_layout_ptr != nullptr)
-        {
-            *out_opt_image_layout_ptr = (*binding_item_iterator)->image_layout;
-        }
-
-        if (out_opt_image_view_ptr_ptr != nullptr)
-        {
-            *out_opt_image_view_ptr_ptr = (*binding_item_iterator)->image_view_ptr;
-        }
+    if (out_opt_image_view_ptr_ptr != nullptr)
+    {
+        *out_opt_image_view_ptr_ptr = binding_item_ptr->image_view_ptr;
     }
 
+    result = true;
 end:
     return result;
 }
@@ -512,34 +864,21 @@ bool Anvil::DescriptorSet::get_sampler_binding_properties(uint32_t         in_n_
                                                           uint32_t         in_n_binding_array_item,
                                                           Anvil::Sampler** out_sampler_ptr_ptr) const
 {
-    decltype(m_binding_ptrs)::const_iterator binding_iterator = m_binding_ptrs.find(in_n_binding);
-    bool                                     result           = true;
+    const BindingItem* binding_item_ptr = get_binding_item(in_n_binding,
+                                                           in_n_binding_array_item);
+    bool               result           = false;
 
-    if (binding_iterator == m_binding_ptrs.end() )
+    if (binding_item_ptr == nullptr)
     {
-        anvil_assert(binding_iterator != m_binding_ptrs.end());
-
-        result = false;
         goto end;
     }
 
-    if (binding_iterator->second.size() <= in_n_binding_array_item)
+    if (out_sampler_ptr_ptr != nullptr)
     {
-        anvil_assert(binding_iterator->second.size() > in_n_binding_array_item);
-
-        result = false;
-        goto end;
-    }
-    else
-    {
-        auto binding_item_iterator = binding_iterator->second.begin() + in_n_binding_array_item;
-
-        if (out_sampler_ptr_ptr != nullptr)
-        {
-            *out_sampler_ptr_ptr = (*binding_item_iterator)->sampler_ptr;
-        }
+        *out_sampler_ptr_ptr = binding_item_ptr->sampler_ptr;
     }
 
+    result = true;
 end:
     return result;
 }
@@ -551,44 +890,31 @@ bool Anvil::DescriptorSet::get_storage_buffer_binding_properties(uint32_t
                                                                  VkDeviceSize*   out_opt_size_ptr,
                                                                  VkDeviceSize*   out_opt_start_offset_ptr) const
 {
-    decltype(m_binding_ptrs)::const_iterator binding_iterator = m_binding_ptrs.find(in_n_binding);
-    bool                                     result           = true;
+    const BindingItem* binding_item_ptr = get_binding_item(in_n_binding,
+                                                           in_n_binding_array_item);
+    bool               result           = false;
 
-    if (binding_iterator == m_binding_ptrs.end() )
+    if (binding_item_ptr == nullptr)
     {
-        anvil_assert(binding_iterator != m_binding_ptrs.end());
-
-        result = false;
         goto end;
     }
 
-    if (binding_iterator->second.size() <= in_n_binding_array_item)
+    if (out_opt_buffer_ptr_ptr != nullptr)
     {
-        anvil_assert(binding_iterator->second.size() > in_n_binding_array_item);
-
-        result = false;
-        goto end;
+        *out_opt_buffer_ptr_ptr = binding_item_ptr->buffer_ptr;
     }
-    else
-    {
-        auto binding_item_iterator = binding_iterator->second.begin() + in_n_binding_array_item;
-
-        if (out_opt_buffer_ptr_ptr != nullptr)
-        {
-            *out_opt_buffer_ptr_ptr = (*binding_item_iterator)->buffer_ptr;
-        }
 
-        if (out_opt_size_ptr != nullptr)
-        {
-            *out_opt_size_ptr = (*binding_item_iterator)->size;
-        }
+    if (out_opt_size_ptr != nullptr)
+    {
+        *out_opt_size_ptr = binding_item_ptr->size;
+    }
 
-        if (out_opt_start_offset_ptr != nullptr)
-        {
-            *out_opt_start_offset_ptr = (*binding_item_iterator)->start_offset;
-        }
+    if (out_opt_start_offset_ptr != nullptr)
+    {
+        *out_opt_start_offset_ptr = binding_item_ptr->start_offset;
     }
 
+    result = true;
 end:
     return result;
 }
@@ -598,34 +924,21 @@ bool Anvil::DescriptorSet::get_storage_texel_buffer_binding_properties(uint32_t
                                                                        uint32_t            in_n_binding_array_item,
                                                                        Anvil::BufferView** out_opt_buffer_view_ptr_ptr) const
 {
-    decltype(m_binding_ptrs)::const_iterator binding_iterator = m_binding_ptrs.find(in_n_binding);
-    bool                                     result           = true;
+    const BindingItem* binding_item_ptr = get_binding_item(in_n_binding,
+                                                           in_n_binding_array_item);
+    bool               result           = false;
 
-    if (binding_iterator == m_binding_ptrs.end() )
+    if (binding_item_ptr == nullptr)
     {
-        anvil_assert(binding_iterator != m_binding_ptrs.end());
-
-        result = false;
         goto end;
     }
 
-    if (binding_iterator->second.size() <= in_n_binding_array_item)
+    if (out_opt_buffer_view_ptr_ptr != nullptr)
     {
-        anvil_assert(binding_iterator->second.size() > in_n_binding_array_item);
-
-        result = false;
-        goto end;
-    }
-    else
-    {
-        auto binding_item_iterator = binding_iterator->second.begin() + in_n_binding_array_item;
-
-        if (out_opt_buffer_view_ptr_ptr != nullptr)
-        {
-            *out_opt_buffer_view_ptr_ptr = (*binding_item_iterator)->buffer_view_ptr;
-        }
+        *out_opt_buffer_view_ptr_ptr = binding_item_ptr->buffer_view_ptr;
     }
 
+    result = true;
 end:
     return result;
 }
@@ -642,6 +955,50 @@ void Anvil::DescriptorSet::on_parent_pool_reset()
     m_unusable       = true;
 }
 
+/** Re-targets the wrapper at @param in_descriptor_set, a new descriptor set allocated from the same pool with the same
+ *  layout, after the parent pool has been reset.
+ *
+ *  All bindings are cleared, as for a newly created wrapper. Binding storage and descriptor update templates created
+ *  for the layout are retained, so that wrappers of transient descriptor sets can be reused frame after frame without
+ *  allocating memory or registering new objects.
+ **/
+void Anvil::DescriptorSet::recycle(VkDescriptorSet in_descriptor_set)
+{
+    anvil_assert(m_unusable);
+
+    for (auto& current_binding_data : m_bindings)
+    {
+        current_binding_data.dirty = true;
+
+        current_binding_data.iub_update_ptrs.clear();
+    }
+
+    for (auto& current_binding_item : m_binding_items)
+    {
+        current_binding_item = BindingItem();
+    }
+
+    m_template_raw_data.clear();
+
+    m_descriptor_set = in_descriptor_set;
+    m_dirty          = true;
+    m_unusable       = false;
+}
+
+/** Drops inline uniform block update requests, after write items gathered for them by gather_core_write_items()
+ *  have been passed to vkUpdateDescriptorSets().
+ **/
+void Anvil::DescriptorSet::release_issued_iub_updates() const
+{
+    for (auto& current_binding_data : m_bindings)
+    {
+        if (current_binding_data.descriptor_type == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK)
+        {
+            current_binding_data.iub_update_ptrs.clear();
+        }
+    }
+}
+
 /* Please see header for specification */
 bool Anvil::DescriptorSet::set_inline_uniform_block_binding_data(const BindingIndex& in_binding_index,
                                                                  const uint32_t&     in_start_offset,
@@ -649,11 +1006,18 @@ bool Anvil::DescriptorSet::set_inline_uniform_block_binding_data(const BindingIn
                                                                  const void*         in_raw_data_ptr,
                                                                  const bool&         in_should_cache_raw_data)
 {
-    BindingItemUniquePtrs& iub_binding_item_ptrs    = m_binding_ptrs[in_binding_index];
-    auto                   new_iub_binding_item_ptr = BindingItemUniquePtr(new BindingItem() );
-    bool                   result                   = false;
+    BindingData* binding_data_ptr         = get_binding_data(in_binding_index);
+    auto         new_iub_binding_item_ptr = BindingItemUniquePtr(new BindingItem() );
+    bool         result                   = false;
 
     anvil_assert(!m_unusable);
+
+    if (binding_data_ptr == nullptr)
+    {
+        goto end;
+    }
+
+    anvil_assert(binding_data_ptr->descriptor_type == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK);
     anvil_assert((in_start_offset % 4) == 0);
     anvil_assert((in_size         % 4) == 0);
 
@@ -677,13 +1041,14 @@ bool Anvil::DescriptorSet::set_inline_uniform_block_binding_data(const BindingIn
     new_iub_binding_item_ptr->start_offset = in_start_offset;
     new_iub_binding_item_ptr->type_vk      = Anvil::DescriptorType::INLINE_UNIFORM_BLOCK;
 
-    iub_binding_item_ptrs.push_back(
+    binding_data_ptr->iub_update_ptrs.push_back(
         std::move(new_iub_binding_item_ptr)
     );
 
-    m_dirty = true;
-    result  = true;
-
+    binding_data_ptr->dirty = true;
+    m_dirty                 = true;
+    result                  = true;
+end:
     return result;
 }
 
@@ -723,267 +1088,151 @@ bool Anvil::DescriptorSet::update(const DescriptorSetUpdateMethod& in_update_met
 }
 
 /* Please see header for specification */
-bool Anvil::DescriptorSet::update_using_core_method() const
+bool Anvil::DescriptorSet::update_many(uint32_t                    in_n_descriptor_sets,
+                                       const DescriptorSet* const* in_descriptor_set_ptrs)
 {
-    std::vector<uint32_t> iub_binding_indices;
-    const auto            layout_info_ptr     = m_layout_ptr->get_create_info();
-    bool                  result              = false;
-
-    anvil_assert(!m_unusable);
+    const Anvil::BaseDevice* device_ptr                   = nullptr;
+    size_t                   n_max_ds_info_items_to_cache = 0;
+    bool                     result                       = true;
+    auto&                    scratch_data                 = get_core_update_scratch_data();
 
-    if (m_dirty)
+    if (in_n_descriptor_sets == 0)
     {
-        uint32_t       cached_ds_buffer_info_items_array_offset       = 0;
-        uint32_t       cached_ds_image_info_items_array_offset        = 0;
-        uint32_t       cached_ds_iub_array_offset                     = 0;
-        uint32_t       cached_ds_texel_buffer_info_items_array_offset = 0;
-        const uint32_t n_bindings                                     = static_cast<uint32_t>(m_binding_ptrs.size() );
-
-        m_cached_ds_info_buffer_info_items_vk.clear      ();
-        m_cached_ds_info_image_info_items_vk.clear       ();
-        m_cached_ds_info_texel_buffer_info_items_vk.clear();
-        m_cached_ds_write_items_vk.clear                 ();
-
-        {
-            uint32_t n_max_ds_info_items_to_cache  = 0;
-
-            for (auto& binding_map_item : m_binding_ptrs)
-            {
-                const uint32_t n_current_binding_items = static_cast<uint32_t>(binding_map_item.second.size() );
-
-                n_max_ds_info_items_to_cache += n_current_binding_items;
-            }
-
-            m_cached_ds_info_buffer_info_items_vk.reserve      (n_max_ds_info_items_to_cache);
-            m_cached_ds_info_image_info_items_vk.reserve       (n_max_ds_info_items_to_cache);
-            m_cached_ds_info_texel_buffer_info_items_vk.reserve(n_max_ds_info_items_to_cache);
-        }
-
-        for (uint32_t n_binding = 0;
-                      n_binding < n_bindings;
-                    ++n_binding)
-        {
-            Anvil::DescriptorBindingFlags current_binding_flags;
-            uint32_t                      current_binding_index;
-            uint32_t                      descriptor_array_size                         = 0;
-            Anvil::DescriptorType         descriptor_type;
-            bool                          immutable_samplers_enabled                    = false;
-            uint32_t                      start_ds_buffer_info_items_array_offset       = cached_ds_buffer_info_items_array_offset;
-            uint32_t                      start_ds_image_info_items_array_offset        = cached_ds_image_info_items_array_offset;
-            uint32_t                      start_ds_iub_array_offset                     = cached_ds_iub_array_offset;
-            uint32_t                      start_ds_texel_buffer_info_items_array_offset = cached_ds_texel_buffer_info_items_array_offset;
-            VkWriteDescriptorSet          write_ds_vk;
-
-            if (!layout_info_ptr->get_binding_properties_by_index_number(n_binding,
-                                                                        &current_binding_index,
-                                                                        &descriptor_type,
-                                                                        &descriptor_array_size,
-                                                                         nullptr, /* out_opt_stage_flags_ptr */
-                                                                        &immutable_samplers_enabled,
-                                                                        &current_binding_flags) )
-            {
-                anvil_assert_fail();
-            }
-
-            /* For each array item, initialize a descriptor info item.. */
-            BindingItemUniquePtrs& current_binding_item_ptrs = m_binding_ptrs.at(current_binding_index);
-            uint32_t               n_current_binding_items   = static_cast<uint32_t>(current_binding_item_ptrs.size() );
-            int32_t                n_last_binding_item       = -1;
-
-            for (uint32_t n_current_binding_item = 0;
-                          n_current_binding_item < n_current_binding_items;
-                        ++n_current_binding_item)
-            {
-                auto& current_binding_item_ptr = current_binding_item_ptrs.at(n_current_binding_item);
-                bool  needs_write_item         = ((n_current_binding_item + 1) == n_current_binding_items);
-
-                if (descriptor_type == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK)
-                {
-                    /* Binding items for this descriptor type correspond internally to consecutive update requests which have been scheduled for
-                     * the same IUB binding. As per API restrictions, only one such update can be carried out using a single VkWriteDescriptorSet struct.
-                     */
-                    n_last_binding_item = static_cast<uint32_t>(current_binding_item_ptr->start_offset) - 1; //< write_ds_vk.dstArrayElement corresponds to start offset for inline uniform blocks
-
-                    if (n_current_binding_item == 0)
-                    {
-                        iub_binding_indices.push_back(n_binding);
-                    }
-                }
-
-                /* TODO: For arrayed binding items, avoid updating all binding items every time baking is triggered. */
-                if ( current_binding_item_ptr        != nullptr &&
-                    !current_binding_item_ptr->dirty            &&
-                     n_current_binding_item          == 0       &&
-                     n_current_binding_items         == 1)
-                {
-                    continue;
-                }
-
-                if (current_binding_item_ptr             != nullptr &&
-                    current_binding_item_ptr->buffer_ptr != nullptr)
-                {
-                    VkDescriptorBufferInfo buffer_info;
+        goto end;
+    }
 
-                    fill_buffer_info_vk_descriptor(*current_binding_item_ptr,
-                                                  &buffer_info);
+    anvil_assert(in_descriptor_set_ptrs != nullptr);
 
-                    m_cached_ds_info_buffer_info_items_vk.push_back(buffer_info);
+    device_ptr = in_descriptor_set_ptrs[0]->m_device_ptr;
 
-                    ++cached_ds_buffer_info_items_array_offset;
-                }
-                else
-                if (current_binding_item_ptr                  != nullptr &&
-                    current_binding_item_ptr->buffer_view_ptr != nullptr)
-                {
-                    m_cached_ds_info_texel_buffer_info_items_vk.push_back(current_binding_item_ptr->buffer_view_ptr->get_buffer_view() );
+    /* Sort the sets by address and drop duplicates. This way, sets are always locked in the same order, so two threads
+     * updating overlapping sets listed in different orders cannot deadlock, and each set is processed only once.
+     */
+    scratch_data.ds_ptrs.assign(in_descriptor_set_ptrs,
+                                in_descriptor_set_ptrs + in_n_descriptor_sets);
 
-                    ++cached_ds_texel_buffer_info_items_array_offset;
-                }
-                else
-                if ( current_binding_item_ptr                 != nullptr  &&
-                    (current_binding_item_ptr->image_view_ptr != nullptr  ||
-                     current_binding_item_ptr->sampler_ptr    != nullptr) )
-                {
-                    VkDescriptorImageInfo image_info;
+    std::sort(scratch_data.ds_ptrs.begin(),
+              scratch_data.ds_ptrs.end  (),
+              std::less<const Anvil::DescriptorSet*>() );
 
-                    fill_image_info_vk_descriptor(*current_binding_item_ptr,
-                                                  immutable_samplers_enabled,
-                                                 &image_info);
+    scratch_data.ds_ptrs.erase(std::unique(scratch_data.ds_ptrs.begin(),
+                                           scratch_data.ds_ptrs.end  () ),
+                               scratch_data.ds_ptrs.end() );
 
-                    m_cached_ds_info_image_info_items_vk.push_back(image_info);
+    /* Descriptor sets stay locked until the batched update has been issued, since write items refer to inline uniform block
+     * data owned by the sets.
+     */
+    for (const auto current_ds_ptr : scratch_data.ds_ptrs)
+    {
+        anvil_assert(current_ds_ptr->m_device_ptr == device_ptr);
 
-                    ++cached_ds_image_info_items_array_offset;
-                }
-                else
-                if (descriptor_type == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK)
-                {
-                    VkWriteDescriptorSetInlineUniformBlockEXT iub_info;
+        current_ds_ptr->lock();
 
-                    fill_iub_vk_descriptor(*current_binding_item_ptr,
-                                          &iub_info);
+        if (current_ds_ptr->m_dirty)
+        {
+            n_max_ds_info_items_to_cache += current_ds_ptr->m_binding_items.size();
+        }
+    }
 
-                    m_cached_ds_write_iub_items_vk.at(start_ds_iub_array_offset) = iub_info;
+    scratch_data.buffer_info_items_vk.clear      ();
+    scratch_data.image_info_items_vk.clear       ();
+    scratch_data.texel_buffer_view_items_vk.clear();
+    scratch_data.write_items_vk.clear            ();
 
-                    needs_write_item           =  true;
-                    cached_ds_iub_array_offset ++;
-                }
-                else
-                {
-                    /* Arrayed bindings are only permitted if the binding has been created with the PARTIALLY_BOUND flag */
-                    if ((current_binding_flags & Anvil::DescriptorBindingFlagBits::PARTIALLY_BOUND_BIT) == 0)
-                    {
-                        anvil_assert_fail();
+    scratch_data.buffer_info_items_vk.reserve      (n_max_ds_info_items_to_cache);
+    scratch_data.image_info_items_vk.reserve       (n_max_ds_info_items_to_cache);
+    scratch_data.texel_buffer_view_items_vk.reserve(n_max_ds_info_items_to_cache);
 
-                        goto end;
-                    }
+    for (const auto current_ds_ptr : scratch_data.ds_ptrs)
+    {
+        anvil_assert(!current_ds_ptr->m_unusable);
 
-                    /* Need to cache a write item at this point since current binding has not been assigned a descriptor */
-                    needs_write_item = true;
-                }
+        if (!current_ds_ptr->m_dirty)
+        {
+            continue;
+        }
 
-                if (needs_write_item)
-                {
-                    uint32_t n_descriptors = 0;
+        if (!current_ds_ptr->gather_core_write_items(&scratch_data.buffer_info_items_vk,
+                                                     &scratch_data.image_info_items_vk,
+                                                     &scratch_data.texel_buffer_view_items_vk,
+                                                     &scratch_data.write_items_vk) )
+        {
+            /* Write items gathered for other bindings & sets are still valid, so carry on. */
+            result = false;
+        }
+    }
 
-                    if (descriptor_type == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK)
-                    {
-                        anvil_assert((cached_ds_buffer_info_items_array_offset       - start_ds_buffer_info_items_array_offset)       +
-                                     (cached_ds_image_info_items_array_offset        - start_ds_image_info_items_array_offset)        +
-                                     (cached_ds_texel_buffer_info_items_array_offset - start_ds_texel_buffer_info_items_array_offset) == 0);
+    if (scratch_data.write_items_vk.size() > 0)
+    {
+        Anvil::Vulkan::vkUpdateDescriptorSets(device_ptr->get_device_vk(),
+                                              static_cast<uint32_t>(scratch_data.write_items_vk.size() ),
+                                             &scratch_data.write_items_vk.at(0),
+                                              0,        /* copyCount         */
+                                              nullptr); /* pDescriptorCopies */
+    }
 
-                        n_descriptors = m_cached_ds_write_iub_items_vk.at(start_ds_iub_array_offset).dataSize;
+    for (const auto current_ds_ptr : scratch_data.ds_ptrs)
+    {
+        current_ds_ptr->release_issued_iub_updates();
+        current_ds_ptr->unlock                    ();
+    }
 
-                        anvil_assert(n_descriptors != 0);
-                    }
-                    else
-                    {
-                        anvil_assert(cached_ds_iub_array_offset == start_ds_iub_array_offset);
+end:
+    return result;
+}
 
-                        n_descriptors = (cached_ds_buffer_info_items_array_offset       - start_ds_buffer_info_items_array_offset)       +
-                                        (cached_ds_image_info_items_array_offset        - start_ds_image_info_items_array_offset)        +
-                                        (cached_ds_texel_buffer_info_items_array_offset - start_ds_texel_buffer_info_items_array_offset);
-                    }
+/* Please see header for specification */
+bool Anvil::DescriptorSet::update_using_core_method() const
+{
+    auto& scratch_data = get_core_update_scratch_data();
+    bool  result       = false;
 
-                    if (n_descriptors > 0)
-                    {
-                        write_ds_vk.descriptorCount  = n_descriptors;
-                        write_ds_vk.descriptorType   = static_cast<VkDescriptorType>(descriptor_type);
-                        write_ds_vk.dstArrayElement  = n_last_binding_item + 1;
-                        write_ds_vk.dstBinding       = current_binding_index;
-                        write_ds_vk.dstSet           = m_descriptor_set;
-                        write_ds_vk.pBufferInfo      = (start_ds_buffer_info_items_array_offset != cached_ds_buffer_info_items_array_offset)             ? &m_cached_ds_info_buffer_info_items_vk[start_ds_buffer_info_items_array_offset]
-                                                                                                                                                         : nullptr;
-                        write_ds_vk.pImageInfo       = (start_ds_image_info_items_array_offset  != cached_ds_image_info_items_array_offset)              ? &m_cached_ds_info_image_info_items_vk[start_ds_image_info_items_array_offset]
-                                                                                                                                                         : nullptr;
-                        write_ds_vk.pNext            = nullptr;
-                        write_ds_vk.pTexelBufferView = (start_ds_texel_buffer_info_items_array_offset != cached_ds_texel_buffer_info_items_array_offset) ? &m_cached_ds_info_texel_buffer_info_items_vk[start_ds_texel_buffer_info_items_array_offset]
-                                                                                                                                                         : nullptr;
-                        write_ds_vk.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-
-                        anvil_assert(write_ds_vk.descriptorCount != 0);
-
-                        m_cached_ds_write_items_vk.push_back(write_ds_vk);
-                    }
+    anvil_assert(!m_unusable);
 
-                    if (start_ds_iub_array_offset - cached_ds_iub_array_offset)
-                    {
-                        /* TODO: This is ugly but will always work, as you can't use vkUpdateDescriptorSets() for any other updates if inline uniform block's contents is
-                         *       being refreshed. Still, we should be using struct chains instead here.
-                         */
-                        anvil_assert((cached_ds_iub_array_offset - start_ds_iub_array_offset) == 1);
+    if (m_dirty)
+    {
+        const size_t n_max_ds_info_items_to_cache = m_binding_items.size();
 
-                        m_cached_ds_write_items_vk.back().pNext = &m_cached_ds_write_iub_items_vk.at(start_ds_iub_array_offset);
-                    }
+        scratch_data.buffer_info_items_vk.clear      ();
+        scratch_data.image_info_items_vk.clear       ();
+        scratch_data.texel_buffer_view_items_vk.clear();
+        scratch_data.write_items_vk.clear            ();
 
-                    n_last_binding_item                           = n_current_binding_item;
-                    start_ds_buffer_info_items_array_offset       = cached_ds_buffer_info_items_array_offset;
-                    start_ds_image_info_items_array_offset        = cached_ds_image_info_items_array_offset;
-                    start_ds_iub_array_offset                     = cached_ds_iub_array_offset;
-                    start_ds_texel_buffer_info_items_array_offset = cached_ds_texel_buffer_info_items_array_offset;
-                }
+        scratch_data.buffer_info_items_vk.reserve      (n_max_ds_info_items_to_cache);
+        scratch_data.image_info_items_vk.reserve       (n_max_ds_info_items_to_cache);
+        scratch_data.texel_buffer_view_items_vk.reserve(n_max_ds_info_items_to_cache);
 
-                if (current_binding_item_ptr != nullptr)
-                {
-                    current_binding_item_ptr->dirty = false;
-                }
-            }
+        if (!gather_core_write_items(&scratch_data.buffer_info_items_vk,
+                                     &scratch_data.image_info_items_vk,
+                                     &scratch_data.texel_buffer_view_items_vk,
+                                     &scratch_data.write_items_vk) )
+        {
+            goto end;
         }
 
         /* Issue the Vulkan call */
-        if (m_cached_ds_write_items_vk.size() > 0)
+        if (scratch_data.write_items_vk.size() > 0)
         {
             Anvil::Vulkan::vkUpdateDescriptorSets(m_device_ptr->get_device_vk(),
-                                                  static_cast<uint32_t>(m_cached_ds_write_items_vk.size() ),
-                                                 &m_cached_ds_write_items_vk[0],
+                                                  static_cast<uint32_t>(scratch_data.write_items_vk.size() ),
+                                                 &scratch_data.write_items_vk.at(0),
                                                   0,        /* copyCount         */
                                                   nullptr); /* pDescriptorCopies */
-
-            /* If any IUB bindings have been processed, wipe out binding items associated with these, as the corresponding updates have already
-             * been performed.
-             */
-            for (const auto& current_iub_binding_index : iub_binding_indices)
-            {
-                auto& current_iub_binding = m_binding_ptrs.at(current_iub_binding_index);
-
-                current_iub_binding.clear();
-            }
         }
 
-        m_dirty = false;
+        release_issued_iub_updates();
     }
 
     result = true;
 
 end:
-
     return result;
 }
 
 bool Anvil::DescriptorSet::update_using_template_method() const
 {
     std::vector<uint8_t> data_vector;
-    const auto           layout_info_ptr = m_layout_ptr->get_create_info();
-    bool                 result          = false;
+    bool                 result = false;
 
     if (!m_device_ptr->get_extension_info()->khr_descriptor_update_template() )
     {
@@ -996,110 +1245,134 @@ bool Anvil::DescriptorSet::update_using_template_method() const
 
     if (m_dirty)
     {
-        /* First build up a vector of template entries we need the template to encapsulate. While on it,
-         * also construct an array of descriptors we're going to pass along the template.
+        /* First build up a vector of template entries we need the template to encapsulate. Each run of consecutive modified
+         * array items is described by a single entry. Descriptors of non-IUB bindings are patched in place within the regions
+         * of m_template_raw_data assigned to them at construction time. Pending IUB updates are appended past that area.
          */
-        const uint32_t                                  n_bindings               = static_cast<uint32_t>(m_binding_ptrs.size() );
-        decltype(m_template_object_map)::const_iterator template_object_iterator;
+        const uint32_t                                  n_bindings               = static_cast<uint32_t>(m_bindings.size() );
+        decltype(m_template_object_map)::iterator       template_object_iterator;
 
         m_template_entries.clear ();
-        m_template_raw_data.clear();
+        m_template_raw_data.resize(m_template_raw_data_fixed_size);
 
         for (uint32_t n_binding = 0;
                       n_binding < n_bindings;
                     ++n_binding)
         {
-            const std::vector<BindingItemUniquePtr>* binding_element_ptr_vec_ptr = nullptr;
-            uint32_t                                 current_binding_index       = UINT32_MAX;
-            Anvil::DescriptorType                    descriptor_type             = Anvil::DescriptorType::UNKNOWN;
-            bool                                     immutable_samplers_enabled  = false;
-            uint32_t                                 n_binding_elements          = 0;
-
-            if (!layout_info_ptr->get_binding_properties_by_index_number(n_binding,
-                                                                        &current_binding_index,
-                                                                        &descriptor_type,
-                                                                         nullptr,                     /* out_opt_descriptor_array_size_ptr */
-                                                                         nullptr,                     /* out_opt_stage_flags_ptr           */
-                                                                        &immutable_samplers_enabled,
-                                                                         nullptr) )                   /* out_opt_flags_ptr                 */
+            BindingData&                current_binding_data       = m_bindings[n_binding];
+            const size_t                binding_raw_data_offset    = current_binding_data.template_raw_data_offset;
+            const uint32_t              current_binding_index      = current_binding_data.binding_index;
+            const Anvil::DescriptorType descriptor_type            = current_binding_data.descriptor_type;
+            size_t                      element_raw_data_size      = 0;
+            const bool                  immutable_samplers_enabled = current_binding_data.immutable_samplers_enabled;
+            uint32_t                    n_binding_elements         = 0;
+            uint32_t                    n_run_start_element        = UINT32_MAX;
+
+            if (!current_binding_data.dirty)
             {
-                anvil_assert_fail();
-
-                result = false;
-                goto end;
+                /* None of the binding's array items have changed since the last update. */
+                continue;
             }
 
-            binding_element_ptr_vec_ptr = &m_binding_ptrs.at(current_binding_index);
-            n_binding_elements          = static_cast<uint32_t>(binding_element_ptr_vec_ptr->size() );
+            current_binding_data.dirty = false;
 
-            for (uint32_t n_binding_element = 0;
-                          n_binding_element < n_binding_elements;
-                        ++n_binding_element)
+            if (descriptor_type == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK)
             {
-                const auto&    current_binding_element        = *binding_element_ptr_vec_ptr->at(n_binding_element);
-                const uint32_t current_template_raw_data_size = static_cast<uint32_t>(m_template_raw_data.size() );
+                n_binding_elements = static_cast<uint32_t>(current_binding_data.iub_update_ptrs.size() );
 
-                if (!current_binding_element.dirty)
+                for (uint32_t n_binding_element = 0;
+                              n_binding_element < n_binding_elements;
+                            ++n_binding_element)
                 {
-                    continue;
-                }
+                    auto&          current_binding_element        = *current_binding_data.iub_update_ptrs.at(n_binding_element);
+                    const uint32_t current_template_raw_data_size = static_cast<uint32_t>(m_template_raw_data.size() );
 
-                /* Append the new descriptor to the raw data vector.
-                 *
-                 * TODO: Consecutive dirty binding elements could be merged into a single item here.
-                 */
-                if (current_binding_element.buffer_ptr != nullptr)
-                {
-                    m_template_raw_data.resize(current_template_raw_data_size + sizeof(VkDescriptorBufferInfo) );
+                    if (!current_binding_element.dirty)
+                    {
+                        continue;
+                    }
 
-                    fill_buffer_info_vk_descriptor(current_binding_element,
-                                                   reinterpret_cast<VkDescriptorBufferInfo*>(&m_template_raw_data.at(current_template_raw_data_size) ));
-                }
-                else
-                if (current_binding_element.buffer_view_ptr != nullptr)
-                {
-                    m_template_raw_data.resize(current_template_raw_data_size + sizeof(VkBufferView) );
+                    m_template_raw_data.resize(current_template_raw_data_size + sizeof(VkWriteDescriptorSetInlineUniformBlockEXT) );
 
-                    *reinterpret_cast<VkBufferView*>(&m_template_raw_data.at(current_template_raw_data_size) ) = current_binding_element.buffer_view_ptr->get_buffer_view();
-                }
-                else
-                if (current_binding_element.image_view_ptr != nullptr)
-                {
-                    m_template_raw_data.resize(current_template_raw_data_size + sizeof(VkDescriptorImageInfo) );
+                    if (!fill_template_raw_data(current_binding_element,
+                                                immutable_samplers_enabled,
+                                               &m_template_raw_data.at(current_template_raw_data_size) ))
+                    {
+                        result = false;
+                        goto end;
+                    }
+
+                    m_template_entries.push_back(
+                        DescriptorUpdateTemplateEntry(descriptor_type,
+                                                      n_binding_element,
+                                                      current_binding_index,
+                                                      1,                              /* in_n_descriptors */
+                                                      current_template_raw_data_size,
+                                                      0)                              /* in_stride */
+                    );
 
-                    fill_image_info_vk_descriptor(current_binding_element,
-                                                  immutable_samplers_enabled,
-                                                  reinterpret_cast<VkDescriptorImageInfo*>(&m_template_raw_data.at(current_template_raw_data_size) ));
+                    current_binding_element.dirty = false;
                 }
-                else
-                if (current_binding_element.type_vk == Anvil::DescriptorType::INLINE_UNIFORM_BLOCK)
+
+                continue;
+            }
+
+            element_raw_data_size = get_template_raw_data_element_size(descriptor_type);
+            n_binding_elements    = current_binding_data.n_items;
+
+            anvil_assert(element_raw_data_size != 0);
+
+            /* NOTE: The extra iteration flushes a run of modified items which reaches the end of the array. */
+            for (uint32_t n_binding_element = 0;
+                          n_binding_element < n_binding_elements + 1;
+                        ++n_binding_element)
+            {
+                BindingItem* current_binding_element_ptr = (n_binding_element < n_binding_elements) ? &m_binding_items[current_binding_data.n_first_item + n_binding_element]
+                                                                                                    : nullptr;
+
+                if (current_binding_element_ptr        != nullptr &&
+                    current_binding_element_ptr->dirty)
                 {
-                    m_template_raw_data.resize(current_template_raw_data_size + sizeof(VkWriteDescriptorSetInlineUniformBlockEXT) );
+                    const size_t element_raw_data_offset = binding_raw_data_offset + n_binding_element * element_raw_data_size;
 
-                    fill_iub_vk_descriptor(current_binding_element,
-                                           reinterpret_cast<VkWriteDescriptorSetInlineUniformBlockEXT*>(&m_template_raw_data.at(current_template_raw_data_size) ));
+                    if (!fill_template_raw_data(*current_binding_element_ptr,
+                                                 immutable_samplers_enabled,
+                                                &m_template_raw_data.at(element_raw_data_offset) ))
+                    {
+                        result = false;
+                        goto end;
+                    }
+
+                    current_binding_element_ptr->dirty = false;
+
+                    if (n_run_start_element == UINT32_MAX)
+                    {
+                        n_run_start_element = n_binding_element;
+                    }
                 }
                 else
+                if (n_run_start_element != UINT32_MAX)
                 {
-                    anvil_assert_fail();
-
-                    result = false;
-                    goto end;
+                    m_template_entries.push_back(
+                        DescriptorUpdateTemplateEntry(descriptor_type,
+                                                      n_run_start_element,
+                                                      current_binding_index,
+                                                      n_binding_element - n_run_start_element,                    /* in_n_descriptors */
+                                                      binding_raw_data_offset + n_run_start_element * element_raw_data_size,
+                                                      element_raw_data_size)                                      /* in_stride        */
+                    );
+
+                    n_run_start_element = UINT32_MAX;
                 }
-
-                m_template_entries.push_back(
-                    DescriptorUpdateTemplateEntry(descriptor_type,
-                                                  n_binding_element,
-                                                  current_binding_index,
-                                                  1,                              /* in_n_descriptors */
-                                                  current_template_raw_data_size,
-                                                  0)                              /* in_stride */
-                );
             }
         }
 
         if (m_template_entries.size() == 0)
         {
+            /* Nothing has changed since the last update. */
+            m_dirty = false;
+            result  = true;
+
             goto end;
         }
         else
@@ -1112,26 +1385,47 @@ bool Anvil::DescriptorSet::update_using_template_method() const
 
         if (template_object_iterator == m_template_object_map.end() )
         {
-            /* Need to create a new template object.. */
-            m_template_object_map[m_template_entries] = std::move(
-                Anvil::DescriptorUpdateTemplate::create_for_descriptor_set_updates(m_device_ptr,
-                                                                                   m_layout_ptr,
-                                                                                   m_template_entries,
-                                                                                   Anvil::MTSafety::DISABLED) );
+            /* Sets whose modified array items vary between updates would otherwise accumulate template objects
+             * indefinitely. Release the least recently used one if the cache is full. */
+            if (m_template_object_map.size() >= g_max_cached_update_templates)
+            {
+                auto lru_template_object_iterator = m_template_object_map.begin();
 
-            /* Update the iterator */
-            template_object_iterator = m_template_object_map.find(m_template_entries);
-            anvil_assert(template_object_iterator != m_template_object_map.end() );
+                for (auto current_template_object_iterator  = m_template_object_map.begin();
+                          current_template_object_iterator != m_template_object_map.end();
+                        ++current_template_object_iterator)
+                {
+                    if (current_template_object_iterator->second.last_used_update_index < lru_template_object_iterator->second.last_used_update_index)
+                    {
+                        lru_template_object_iterator = current_template_object_iterator;
+                    }
+                }
+
+                m_template_object_map.erase(lru_template_object_iterator);
+            }
 
-            if (template_object_iterator->second == nullptr)
+            /* Need to create a new template object.. */
+            template_object_iterator = m_template_object_map.insert(
+                std::make_pair(m_template_entries,
+                               TemplateObject(Anvil::DescriptorUpdateTemplate::create_for_descriptor_set_updates(m_device_ptr,
+                                                                                                                 m_layout_ptr,
+                                                                                                                 m_template_entries,
+                                                                                                                 Anvil::MTSafety::DISABLED) ))
+            ).first;
+
+            if (template_object_iterator->second.template_ptr == nullptr)
             {
-                anvil_assert(template_object_iterator->second != nullptr);
+                anvil_assert(template_object_iterator->second.template_ptr != nullptr);
+
+                m_template_object_map.erase(template_object_iterator);
 
                 result = false;
                 goto end;
             }
         }
 
+        template_object_iterator->second.last_used_update_index = ++m_n_template_updates;
+
         /* Issue the Vulkan call.
          *
          * NOTE: The order MUST be reversed, since update_descriptor_set() calls DescriptorSet::get_descriptor_set_vk() which would invoke update()
@@ -1139,8 +1433,8 @@ bool Anvil::DescriptorSet::update_using_template_method() const
          */
         m_dirty = false;
 
-        template_object_iterator->second->update_descriptor_set(this,
-                                                               &m_template_raw_data.at(0) );
+        template_object_iterator->second.template_ptr->update_descriptor_set(this,
+                                                                            &m_template_raw_data.at(0) );
     }
 
     result = true;
@@ -23,6 +23,7 @@
 #include "misc/debug.h"
 #include "misc/descriptor_pool_create_info.h"
 #include "misc/object_tracker.h"
+#include "misc/tracer.h"
 #include "wrappers/descriptor_pool.h"
 #include "wrappers/descriptor_set.h"
 #include "wrappers/descriptor_set_group.h"
@@ -180,8 +181,10 @@ Anvil::DescriptorSetGroup::~DescriptorSetGroup()
 /** Re-creates internally-maintained descriptor pool. **/
 bool Anvil::DescriptorSetGroup::bake_descriptor_pool()
 {
+    ANVIL_TRACE_CPU_SPAN("DescriptorSetGroup::bake_descriptor_pool");
+
     Anvil::DescriptorPoolCreateFlags                                                                    flags                    = m_descriptor_pool_create_flags;
-    std::unique_lock<std::recursive_mutex>                                                              mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex>                                                              mutex_lock;
     auto                                                                                                mutex_ptr                = get_mutex();
     std::unordered_map<Anvil::DescriptorType, uint32_t, Anvil::EnumClassHasher<Anvil::DescriptorType> > n_descriptors_needed_map;
     bool                                                                                                result                   = false;
@@ -189,7 +192,7 @@ bool Anvil::DescriptorSetGroup::bake_descriptor_pool()
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -298,18 +301,20 @@ end:
 /* Please see header for specification */
 bool Anvil::DescriptorSetGroup::bake_descriptor_sets()
 {
+    ANVIL_TRACE_CPU_SPAN("DescriptorSetGroup::bake_descriptor_sets");
+
     std::vector<Anvil::DescriptorSetAllocation> allocations;
     std::vector<DescriptorSetUniquePtr>         dses;
     const Anvil::DescriptorSetGroup*            layout_vk_owner_ptr = (m_parent_dsg_ptr != nullptr) ? m_parent_dsg_ptr
                                                                                                     : this;
-    std::unique_lock<std::recursive_mutex>      mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex>      mutex_lock;
     auto                                        mutex_ptr           = get_mutex();
     bool                                        result              = false;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -396,6 +401,22 @@ Anvil::DescriptorSetGroupUniquePtr Anvil::DescriptorSetGroup::create(const Anvil
     Anvil::DescriptorSetGroupUniquePtr result_ptr(nullptr,
                                                   std::default_delete<Anvil::DescriptorSetGroup>() );
 
+    for (const auto& current_ds_create_info_ptr : in_ds_create_info_ptrs)
+    {
+        if (current_ds_create_info_ptr == nullptr)
+        {
+            continue;
+        }
+
+        if ((current_ds_create_info_ptr->get_create_flags() & Anvil::DescriptorSetLayoutCreateFlagBits::PUSH_DESCRIPTOR_BIT_KHR) != 0)
+        {
+            /* Push descriptor layouts cannot be used to allocate descriptor sets. */
+            anvil_assert_fail();
+
+            goto end;
+        }
+    }
+
     result_ptr.reset(
         new Anvil::DescriptorSetGroup(in_device_ptr,
                                       std::move(in_ds_create_info_ptrs),
@@ -414,6 +435,7 @@ Anvil::DescriptorSetGroupUniquePtr Anvil::DescriptorSetGroup::create(const Anvil
         }
     }
 
+end:
     return result_ptr;
 }
 
@@ -444,13 +466,13 @@ Anvil::DescriptorSetGroupUniquePtr Anvil::DescriptorSetGroup::create(const Anvil
 Anvil::DescriptorSet* Anvil::DescriptorSetGroup::get_descriptor_set(uint32_t in_n_set)
 {
     decltype(m_descriptor_sets)::const_iterator ds_iterator;
-    std::unique_lock<std::recursive_mutex>      mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex>      mutex_lock;
     auto                                        mutex_ptr    = get_mutex();
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -462,14 +484,14 @@ Anvil::DescriptorSet* Anvil::DescriptorSetGroup::get_descriptor_set(uint32_t in_
 
 const std::vector<const Anvil::DescriptorSetCreateInfo*>* Anvil::DescriptorSetGroup::get_descriptor_set_create_info() const
 {
-    std::unique_lock<std::recursive_mutex>                    mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex>                    mutex_lock;
     auto                                                      mutex_ptr  = get_mutex();
     const std::vector<const Anvil::DescriptorSetCreateInfo*>* result_ptr = nullptr;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -481,14 +503,14 @@ const std::vector<const Anvil::DescriptorSetCreateInfo*>* Anvil::DescriptorSetGr
 /* Please see header for specification */
 const Anvil::DescriptorSetCreateInfo* Anvil::DescriptorSetGroup::get_descriptor_set_create_info(uint32_t in_n_set) const
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr   = get_mutex();
     const Anvil::DescriptorSetCreateInfo*  result_ptr  = nullptr;
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -508,13 +530,13 @@ end:
 /* Please see header for specification */
 Anvil::DescriptorSetLayout* Anvil::DescriptorSetGroup::get_descriptor_set_layout(uint32_t in_n_set) const
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr    = get_mutex();
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -69,7 +69,7 @@ Anvil::DescriptorSetLayoutManagerUniquePtr Anvil::DescriptorSetLayoutManager::cr
 bool Anvil::DescriptorSetLayoutManager::get_layout(const DescriptorSetCreateInfo*       in_ds_create_info_ptr,
                                                    Anvil::DescriptorSetLayoutUniquePtr* out_ds_layout_ptr_ptr)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr            = get_mutex();
     bool                                   result               = false;
     Anvil::DescriptorSetLayout*            result_ds_layout_ptr = nullptr;
@@ -79,7 +79,7 @@ bool Anvil::DescriptorSetLayoutManager::get_layout(const DescriptorSetCreateInfo
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -137,13 +137,13 @@ bool Anvil::DescriptorSetLayoutManager::get_layout(const DescriptorSetCreateInfo
 void Anvil::DescriptorSetLayoutManager::on_descriptor_set_layout_dereferenced(Anvil::DescriptorSetLayout* in_layout_ptr)
 {
     bool                                   has_found  = false;
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr  = get_mutex();
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -21,6 +21,7 @@
 //
 
 #include "misc/debug.h"
+#include "misc/fence_reactor.h"
 #include "misc/object_tracker.h"
 #include "misc/shader_module_cache.h"
 #include "misc/struct_chainer.h"
@@ -71,13 +72,20 @@ Anvil::BaseDevice::~BaseDevice()
         wait_idle();
     }
 
+    /* Tear down the fence reactor first. This dispatches callbacks of all finished work, which may still
+     * hold fences retrieved from the pool, or other device-owned objects.
+     */
+    m_fence_reactor_ptr.reset();
+
     m_command_pool_ptr_per_vk_queue_fam.clear();
     m_compute_pipeline_manager_ptr.reset     ();
     m_dummy_dsg_ptr.reset                    ();
+    m_fence_pool_ptr.reset                   ();
     m_graphics_pipeline_manager_ptr.reset    ();
     m_descriptor_set_layout_manager_ptr.reset();
     m_pipeline_cache_ptr.reset               ();
     m_pipeline_layout_manager_ptr.reset      ();
+    m_semaphore_pool_ptr.reset               ();
     m_owned_queues.clear                     ();
 
     if (m_device != VK_NULL_HANDLE)
@@ -320,6 +328,19 @@ void Anvil::BaseDevice::create_device(const std::vector<const char*>& in_extensi
                                                  out_queue_families_ptr);
 }
 
+/** Please see header for specification */
+Anvil::FenceReactor* Anvil::BaseDevice::get_fence_reactor() const
+{
+    std::unique_lock<std::mutex> lock(m_fence_reactor_mutex);
+
+    if (m_fence_reactor_ptr == nullptr)
+    {
+        m_fence_reactor_ptr = Anvil::FenceReactor::create(this);
+    }
+
+    return m_fence_reactor_ptr.get();
+}
+
 /** Please see header for specification */
 const Anvil::DescriptorSet* Anvil::BaseDevice::get_dummy_descriptor_set() const
 {
@@ -571,6 +592,11 @@ void Anvil::BaseDevice::add_physical_device_features_to_chainer(Anvil::StructCha
         in_struct_chainer_ptr->append_struct(features.khr_variable_pointer_features_ptr->get_vk_physical_device_variable_pointer_features() );
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_timeline_semaphore() )
+    {
+        in_struct_chainer_ptr->append_struct(features.khr_timeline_semaphore_features_ptr->get_vk_physical_device_timeline_semaphore_features() );
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_vulkan_memory_model() )
     {
         in_struct_chainer_ptr->append_struct(features.khr_vulkan_memory_model_features_ptr->get_vk_physical_device_vulkan_memory_model_features() );
@@ -1182,6 +1208,12 @@ bool Anvil::BaseDevice::init()
         }
     }
 
+    /* Set up fence & semaphore pools */
+    m_fence_pool_ptr     = Anvil::FencePool::create    (this,
+                                                        0); /* in_n_preallocated_items */
+    m_semaphore_pool_ptr = Anvil::SemaphorePool::create(this,
+                                                        0); /* in_n_preallocated_items */
+
     /* Set up shader module cache, if one was requested. */
     if (m_create_info_ptr->should_enable_shader_module_cache() )
     {
@@ -1194,8 +1226,19 @@ bool Anvil::BaseDevice::init()
 
         if (pipeline_cache_ptr == nullptr)
         {
-            m_pipeline_cache_ptr = Anvil::PipelineCache::create(this,
-                                                                is_mt_safe() );
+            const auto& persistent_pipeline_cache_directory = m_create_info_ptr->get_persistent_pipeline_cache_directory();
+
+            if (persistent_pipeline_cache_directory.size() > 0)
+            {
+                m_pipeline_cache_ptr = Anvil::PipelineCache::create_persistent(this,
+                                                                               is_mt_safe(),
+                                                                               persistent_pipeline_cache_directory);
+            }
+            else
+            {
+                m_pipeline_cache_ptr = Anvil::PipelineCache::create(this,
+                                                                    is_mt_safe() );
+            }
         }
         else
         {
@@ -1544,6 +1587,13 @@ bool Anvil::BaseDevice::init_extension_func_ptrs()
         anvil_assert(m_khr_maintenance3_extension_entrypoints.vkGetDescriptorSetLayoutSupportKHR != nullptr);
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_push_descriptor() )
+    {
+        m_khr_push_descriptor_extension_entrypoints.vkCmdPushDescriptorSetKHR = reinterpret_cast<PFN_vkCmdPushDescriptorSetKHR>(get_proc_address("vkCmdPushDescriptorSetKHR") );
+
+        anvil_assert(m_khr_push_descriptor_extension_entrypoints.vkCmdPushDescriptorSetKHR != nullptr);
+    }
+
     if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_sampler_ycbcr_conversion() ||
         is_core_vk11_device)
     {
@@ -1574,6 +1624,17 @@ bool Anvil::BaseDevice::init_extension_func_ptrs()
         anvil_assert(m_khr_swapchain_extension_entrypoints.vkQueuePresentKHR       != nullptr);
     }
 
+    if (m_extension_enabled_info_ptr->get_device_extension_info()->khr_timeline_semaphore() )
+    {
+        m_khr_timeline_semaphore_extension_entrypoints.vkGetSemaphoreCounterValueKHR = reinterpret_cast<PFN_vkGetSemaphoreCounterValueKHR>(get_proc_address("vkGetSemaphoreCounterValueKHR") );
+        m_khr_timeline_semaphore_extension_entrypoints.vkSignalSemaphoreKHR          = reinterpret_cast<PFN_vkSignalSemaphoreKHR>         (get_proc_address("vkSignalSemaphoreKHR") );
+        m_khr_timeline_semaphore_extension_entrypoints.vkWaitSemaphoresKHR           = reinterpret_cast<PFN_vkWaitSemaphoresKHR>          (get_proc_address("vkWaitSemaphoresKHR") );
+
+        anvil_assert(m_khr_timeline_semaphore_extension_entrypoints.vkGetSemaphoreCounterValueKHR != nullptr);
+        anvil_assert(m_khr_timeline_semaphore_extension_entrypoints.vkSignalSemaphoreKHR          != nullptr);
+        anvil_assert(m_khr_timeline_semaphore_extension_entrypoints.vkWaitSemaphoresKHR           != nullptr);
+    }
+
     return true;
 }
 
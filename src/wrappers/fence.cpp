@@ -398,12 +398,12 @@ bool Anvil::Fence::reset()
 }
 
 /* Please see header for specification */
-bool Anvil::Fence::reset_fences(const uint32_t in_n_fences,
-                                Fence*         in_fences)
+bool Anvil::Fence::reset_fences(const uint32_t       in_n_fences,
+                                Anvil::Fence* const* in_fence_ptrs)
 {
     const Anvil::BaseDevice* device_ptr           = nullptr;
-    auto                     fence_cache          = std::vector<VkFence>(in_n_fences);
-    static const uint32_t    fence_cache_capacity = sizeof(fence_cache) / sizeof(fence_cache[0]);
+    static const uint32_t    fence_cache_capacity = 32;
+    VkFence                  fence_cache[fence_cache_capacity];
     bool                     result               = true;
     VkResult                 result_vk;
 
@@ -412,38 +412,37 @@ bool Anvil::Fence::reset_fences(const uint32_t in_n_fences,
         goto end;
     }
 
-    for (uint32_t n_fence_batch = 0;
-                  n_fence_batch < 1 + in_n_fences / fence_cache_capacity;
-                ++n_fence_batch)
+    for (uint32_t n_first_batch_fence = 0;
+                  n_first_batch_fence < in_n_fences;
+                  n_first_batch_fence += fence_cache_capacity)
     {
-        const uint32_t n_fences_remaining = in_n_fences - n_fence_batch * fence_cache_capacity;
+        const uint32_t n_batch_fences = std::min(in_n_fences - n_first_batch_fence,
+                                                 fence_cache_capacity);
 
         for (uint32_t n_fence = 0;
-                      n_fence < n_fences_remaining;
+                      n_fence < n_batch_fences;
                     ++n_fence)
         {
-            Anvil::Fence& current_fence = in_fences[n_fence_batch * fence_cache_capacity + n_fence];
+            Anvil::Fence* current_fence_ptr = in_fence_ptrs[n_first_batch_fence + n_fence];
 
-            anvil_assert((device_ptr == nullptr)                                          ||
-                         (device_ptr != nullptr && current_fence.m_device_ptr != nullptr) );
+            anvil_assert(device_ptr == nullptr                          ||
+                         device_ptr == current_fence_ptr->m_device_ptr);
 
-            device_ptr           = current_fence.m_device_ptr;
-            fence_cache[n_fence] = current_fence.m_fence;
+            device_ptr           = current_fence_ptr->m_device_ptr;
+            fence_cache[n_fence] = current_fence_ptr->m_fence;
 
-            current_fence.lock();
+            current_fence_ptr->lock();
         }
         {
             result_vk = Anvil::Vulkan::vkResetFences(device_ptr->get_device_vk(),
-                                                     n_fences_remaining,
-                                                     (n_fences_remaining > 0) ? &fence_cache.at(0) : nullptr);
+                                                     n_batch_fences,
+                                                     fence_cache);
         }
         for (uint32_t n_fence = 0;
-                      n_fence < n_fences_remaining;
+                      n_fence < n_batch_fences;
                     ++n_fence)
         {
-            Anvil::Fence& current_fence = in_fences[n_fence_batch * fence_cache_capacity + n_fence];
-
-            current_fence.unlock();
+            in_fence_ptrs[n_first_batch_fence + n_fence]->unlock();
         }
 
         anvil_assert_vk_call_succeeded(result_vk);
@@ -24,6 +24,7 @@
 #include "misc/framebuffer_create_info.h"
 #include "misc/object_tracker.h"
 #include "misc/render_pass_create_info.h"
+#include "misc/tracer.h"
 #include "wrappers/device.h"
 #include "wrappers/framebuffer.h"
 #include "wrappers/image.h"
@@ -87,6 +88,8 @@ Anvil::Framebuffer::~Framebuffer()
 /* Please see header for specification */
 bool Anvil::Framebuffer::bake(Anvil::RenderPass* in_render_pass_ptr)
 {
+    ANVIL_TRACE_CPU_SPAN("Framebuffer::bake");
+
     BakedFramebufferMap::iterator baked_fb_iterator;
     VkFramebufferCreateInfo       fb_create_info;
     std::vector<VkImageView>      image_view_attachments;
@@ -26,6 +26,7 @@
 #include "misc/debug.h"
 #include "misc/object_tracker.h"
 #include "misc/render_pass_create_info.h"
+#include "misc/tracer.h"
 #include "wrappers/device.h"
 #include "wrappers/graphics_pipeline_manager.h"
 #include "wrappers/pipeline_cache.h"
@@ -57,6 +58,8 @@ Anvil::GraphicsPipelineManager::GraphicsPipelineManager(const Anvil::BaseDevice*
 /* Please see header for specification */
 Anvil::GraphicsPipelineManager::~GraphicsPipelineManager()
 {
+    stop_async_bake_thread();
+
     m_baked_pipelines.clear      ();
     m_outstanding_pipelines.clear();
 
@@ -65,80 +68,32 @@ Anvil::GraphicsPipelineManager::~GraphicsPipelineManager()
                                                     this);
 }
 
-/* Please see header for specification */
-bool Anvil::GraphicsPipelineManager::bake()
+/** Creates Vulkan graphics pipeline objects for the specified bake items. May be called from
+ *  the manager's background thread.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::GraphicsPipelineManager::compile_pipelines(const std::vector<BakeItem>&  in_bake_items,
+                                                       const std::vector<BakeGroup>& in_bake_groups,
+                                                       std::vector<VkPipeline>*      out_pipelines_ptr)
 {
-    typedef struct BakeItem
-    {
-        PipelineID pipeline_id;
-        Pipeline*  pipeline_ptr;
-
-        BakeItem(PipelineID in_pipeline_id,
-                 Pipeline*  in_pipeline_ptr)
-        {
-            pipeline_id  = in_pipeline_id;
-            pipeline_ptr = in_pipeline_ptr;
-        }
-
-        bool operator==(PipelineID in_pipeline_id)
-        {
-            return pipeline_id == in_pipeline_id;
-        }
-    } BakeItem;
-
-    std::vector<BakeItem>                  bake_items;
-    auto                                   color_blend_state_create_info_chain_cache          = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineColorBlendStateCreateInfo> > >   ();
-    auto                                   depth_stencil_state_create_info_chain_cache        = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineDepthStencilStateCreateInfo> > > ();
-    auto                                   dynamic_state_create_info_chain_cache              = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineDynamicStateCreateInfo> > >      ();
-    auto                                   graphics_pipeline_create_info_chains               = Anvil::StructChainVector<VkGraphicsPipelineCreateInfo>                                    ();
-    auto                                   input_assembly_state_create_info_chain_cache       = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineInputAssemblyStateCreateInfo> > >();
-    auto                                   multisample_state_create_info_chain_cache          = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineMultisampleStateCreateInfo> > >  ();
-    std::unique_lock<std::recursive_mutex> mutex_lock;
-    auto                                   mutex_ptr                                          = get_mutex();
-    uint32_t                               n_consumed_graphics_pipelines                      = 0;
-    auto                                   raster_state_create_info_chain_cache               = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineRasterizationStateCreateInfo> > >();
-    bool                                   result                                             = false;
-    std::vector<VkPipeline>                result_graphics_pipelines;
-    VkResult                               result_vk;
-    auto                                   shader_stage_create_info_chain_ptrs                = std::vector<std::unique_ptr<Anvil::StructChainVector<VkPipelineShaderStageCreateInfo> > >();
-    auto                                   tessellation_state_create_info_chain_cache         = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineTessellationStateCreateInfo> > >();
-    auto                                   vertex_input_state_create_info_chain_cache         = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineVertexInputStateCreateInfo> > > ();
-    auto                                   viewport_state_create_info_chain_cache             = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineViewportStateCreateInfo> > >    ();
-
-
-    if (mutex_ptr != nullptr)
-    {
-        mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
-        );
-    }
-
-    for (auto pipeline_iterator  = m_outstanding_pipelines.begin();
-              pipeline_iterator != m_outstanding_pipelines.end();
-            ++pipeline_iterator)
-    {
-        if (pipeline_iterator->second->layout_ptr == nullptr)
-        {
-            get_pipeline_layout(pipeline_iterator->first);
-
-            anvil_assert(pipeline_iterator->second->layout_ptr != nullptr);
-        }
-
-        bake_items.push_back(
-            BakeItem(pipeline_iterator->first,
-                     pipeline_iterator->second.get() )
-        );
-    }
-
-    if (bake_items.size() == 0)
-    {
-        result = true;
-
-        goto end;
-    }
-
-    for (auto bake_item_iterator  = bake_items.begin();
-              bake_item_iterator != bake_items.end();
+    ANVIL_TRACE_CPU_SPAN("GraphicsPipelineManager::compile_pipelines");
+
+    auto color_blend_state_create_info_chain_cache          = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineColorBlendStateCreateInfo> > >   ();
+    auto depth_stencil_state_create_info_chain_cache        = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineDepthStencilStateCreateInfo> > > ();
+    auto dynamic_state_create_info_chain_cache              = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineDynamicStateCreateInfo> > >      ();
+    auto graphics_pipeline_create_info_chains               = Anvil::StructChainVector<VkGraphicsPipelineCreateInfo>                                    ();
+    auto input_assembly_state_create_info_chain_cache       = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineInputAssemblyStateCreateInfo> > >();
+    auto multisample_state_create_info_chain_cache          = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineMultisampleStateCreateInfo> > >  ();
+    auto raster_state_create_info_chain_cache               = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineRasterizationStateCreateInfo> > >();
+    bool result                                             = false;
+    auto shader_stage_create_info_chain_ptrs                = std::vector<std::unique_ptr<Anvil::StructChainVector<VkPipelineShaderStageCreateInfo> > >();
+    auto tessellation_state_create_info_chain_cache         = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineTessellationStateCreateInfo> > >();
+    auto vertex_input_state_create_info_chain_cache         = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineVertexInputStateCreateInfo> > > ();
+    auto viewport_state_create_info_chain_cache             = std::vector<std::unique_ptr<Anvil::StructChain<VkPipelineViewportStateCreateInfo> > >    ();
+
+    for (auto bake_item_iterator  = in_bake_items.begin();
+              bake_item_iterator != in_bake_items.end();
             ++bake_item_iterator)
     {
         bool                                               color_blend_state_used                = false;
@@ -346,40 +301,25 @@ bool Anvil::GraphicsPipelineManager::bake()
 
             if (current_pipeline_base_pipeline_id != UINT32_MAX)
             {
-                /* There are three cases we need to handle separately here:
+                /* There are two cases we need to handle separately here:
                  *
-                 * 1. The base pipeline is to be baked in the call we're preparing for. Determine
-                 *    its index in the create info descriptor array and use it.
-                 * 2. The pipeline has been baked earlier. Pass the baked pipeline's handle.
-                 * 3. The pipeline under specified index uses a different layout. This indicates
-                 *    a bug in the app or the manager.
+                 * 1. The base pipeline is to be baked in the call we're preparing for. Its index, relative
+                 *    to the start of the bake group, has already been determined by get_bake_items().
+                 * 2. The pipeline has been baked earlier. Pass the baked pipeline's handle. If the handle
+                 *    is not available, the base pipeline is still being baked asynchronously and the
+                 *    pipeline is created as a regular one.
                  *
-                 * NOTE: A slightly adjusted version of this code is re-used in ComputePipelineManager::bake()
+                 * NOTE: A slightly adjusted version of this code is re-used in ComputePipelineManager::compile_pipelines()
                  */
-                auto base_bake_item_iterator = std::find(bake_items.begin(),
-                                                         bake_items.end(),
-                                                         current_pipeline_base_pipeline_id);
-
-                if (base_bake_item_iterator != bake_items.end() )
+                if (bake_item_iterator->base_pipeline_index != static_cast<int32_t>(UINT32_MAX) )
                 {
                     /* Case 1 */
-                    base_pipeline_index = static_cast<int32_t>(base_bake_item_iterator - bake_items.begin() );
+                    base_pipeline_index = bake_item_iterator->base_pipeline_index;
                 }
                 else
                 {
-                    auto baked_pipeline_iterator = m_baked_pipelines.find(current_pipeline_base_pipeline_id);
-
-                    if (baked_pipeline_iterator                         != m_baked_pipelines.end() &&
-                        baked_pipeline_iterator->second->baked_pipeline != VK_NULL_HANDLE)
-                    {
-                        /* Case 2 */
-                        base_pipeline_handle = baked_pipeline_iterator->second->baked_pipeline;
-                    }
-                    else
-                    {
-                        /* Case 3 */
-                        anvil_assert_fail();
-                    }
+                    /* Case 2 */
+                    base_pipeline_handle = bake_item_iterator->base_pipeline_handle;
                 }
             }
             else
@@ -410,50 +350,33 @@ bool Anvil::GraphicsPipelineManager::bake()
                                                                  (viewport_state_used)       ? viewport_state_create_info_chain_cache.back()->get_root_struct()
                                                                                              : nullptr);
 
-            /* Stash the descriptor for now. We will issue one expensive vkCreateGraphicsPipelines() call after all pipeline objects
-             * are iterated over. */
+            /* Stash the descriptor for now. We will issue one expensive vkCreateGraphicsPipelines() call per bake group after all
+             * pipeline objects are iterated over. */
             graphics_pipeline_create_info_chains.append_struct_chain(std::move(result_ptr) );
         }
     }
 
-    /* All right. Try to bake all pipeline objects at once */
-    result_graphics_pipelines.resize(bake_items.size() );
-
-    m_pipeline_cache_ptr->lock();
-    {
-        result_vk = Anvil::Vulkan::vkCreateGraphicsPipelines(m_device_ptr->get_device_vk(),
-                                                             m_pipeline_cache_ptr->get_pipeline_cache(),
-                                                             graphics_pipeline_create_info_chains.get_n_structs   (),
-                                                             graphics_pipeline_create_info_chains.get_root_structs(),
-                                                             nullptr, /* pAllocator */
-                                                            &result_graphics_pipelines[0]);
-    }
-    m_pipeline_cache_ptr->unlock();
-
-    if (!is_vk_call_successful(result_vk) )
+    /* All right. Try to bake all pipeline objects. Each bake group is handled by a separate vkCreateGraphicsPipelines() call,
+     * which may be issued from a worker thread if parallel baking has been enabled. */
+    out_pipelines_ptr->clear ();
+    out_pipelines_ptr->resize(in_bake_items.size(),
+                              VK_NULL_HANDLE);
+
+    if (!create_pipelines(in_bake_groups,
+                          [&](const BakeGroup& in_bake_group,
+                              VkPipelineCache  in_pipeline_cache)
+                          {
+                              return Anvil::Vulkan::vkCreateGraphicsPipelines(m_device_ptr->get_device_vk(),
+                                                                              in_pipeline_cache,
+                                                                              in_bake_group.n_bake_items,
+                                                                              graphics_pipeline_create_info_chains.get_root_structs() + in_bake_group.n_first_bake_item,
+                                                                              nullptr, /* pAllocator */
+                                                                             &out_pipelines_ptr->at(in_bake_group.n_first_bake_item) );
+                          }) )
     {
-        anvil_assert_vk_call_succeeded(result_vk);
-
         goto end;
     }
 
-    /* Distribute the result pipeline objects to pipeline configuration descriptors */
-    for (auto pipeline_iterator  = m_outstanding_pipelines.begin();
-              pipeline_iterator != m_outstanding_pipelines.end();
-            ++pipeline_iterator)
-    {
-        const PipelineID& current_pipeline_id = pipeline_iterator->first;
-
-        anvil_assert(m_baked_pipelines.find(current_pipeline_id) == m_baked_pipelines.end() );
-
-        pipeline_iterator->second->baked_pipeline = result_graphics_pipelines[n_consumed_graphics_pipelines++];
-        m_baked_pipelines[current_pipeline_id]    = std::move(pipeline_iterator->second);
-    }
-
-    anvil_assert(n_consumed_graphics_pipelines == static_cast<uint32_t>(result_graphics_pipelines.size() ));
-
-    m_outstanding_pipelines.clear();
-
     /* All done */
     result = true;
 end:
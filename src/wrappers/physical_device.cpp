@@ -151,6 +151,7 @@ bool Anvil::PhysicalDevice::init()
             Anvil::StructID                                           storage_features8_struct_id;
             Anvil::StructChainUniquePtr<VkPhysicalDeviceFeatures2KHR> struct_chain_ptr;
             Anvil::StructChainer<VkPhysicalDeviceFeatures2KHR>        struct_chainer;
+            Anvil::StructID                                           timeline_semaphore_features_struct_id;
             Anvil::StructID                                           transform_feedback_features_struct_id;
             Anvil::StructID                                           variable_pointer_features_struct_id;
             Anvil::StructID                                           vulkan_memory_model_features_struct_id;
@@ -299,6 +300,16 @@ bool Anvil::PhysicalDevice::init()
                 variable_pointer_features_struct_id = struct_chainer.append_struct(vp_features);
             }
 
+            if (m_extension_info_ptr->get_device_extension_info()->khr_timeline_semaphore() )
+            {
+                VkPhysicalDeviceTimelineSemaphoreFeaturesKHR ts_features;
+
+                ts_features.pNext = nullptr;
+                ts_features.sType = static_cast<VkStructureType>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR);
+
+                timeline_semaphore_features_struct_id = struct_chainer.append_struct(ts_features);
+            }
+
             if (m_extension_info_ptr->get_device_extension_info()->khr_vulkan_memory_model() )
             {
                 VkPhysicalDeviceVulkanMemoryModelFeaturesKHR vmm_features;
@@ -522,6 +533,21 @@ bool Anvil::PhysicalDevice::init()
                 }
             }
 
+            if (timeline_semaphore_features_struct_id.is_valid() )
+            {
+                m_khr_timeline_semaphore_features_ptr.reset(
+                    new KHRTimelineSemaphoreFeatures(*struct_chain_ptr->get_struct_with_id<VkPhysicalDeviceTimelineSemaphoreFeaturesKHR>(timeline_semaphore_features_struct_id) )
+                );
+
+                if (m_khr_timeline_semaphore_features_ptr == nullptr)
+                {
+                    anvil_assert(m_khr_timeline_semaphore_features_ptr != nullptr);
+
+                    result = false;
+                    goto end;
+                }
+            }
+
             if (vulkan_memory_model_features_struct_id.is_valid() )
             {
                 m_khr_vulkan_memory_model_features_ptr.reset(
@@ -581,6 +607,7 @@ bool Anvil::PhysicalDevice::init()
                                                    m_khr_multiview_features_ptr.get               (),
                                                    m_khr_sampler_ycbcr_conversion_features_ptr.get(),
                                                    m_khr_shader_atomic_int64_features_ptr.get     (),
+                                                   m_khr_timeline_semaphore_features_ptr.get      (),
                                                    m_khr_variable_pointer_features_ptr.get        (),
                                                    m_khr_vulkan_memory_model_features_ptr.get     () );
     }
@@ -21,9 +21,27 @@
 //
 
 #include "misc/debug.h"
+#include "misc/io.h"
 #include "misc/object_tracker.h"
 #include "wrappers/device.h"
 #include "wrappers/pipeline_cache.h"
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string.h>
+#include <thread>
+
+#ifdef _WIN32
+    #include <process.h>
+#else
+    #include <unistd.h>
+#endif
+
+/* Magic & version stored in headers of files backing persistent pipeline caches. Bump the version
+ * whenever PersistentFileHeader layout changes, so that older files are rejected at load time.
+ */
+static const uint32_t g_persistent_file_magic   = 0x4C564E41; /* "ANVL" */
+static const uint32_t g_persistent_file_version = 1;
 
 
 /** Please see header for specification */
@@ -42,6 +60,10 @@ Anvil::PipelineCache::PipelineCache(const Anvil::BaseDevice* in_device_ptr,
 
     ANVIL_REDUNDANT_VARIABLE(result_vk);
 
+    memset(&m_persistent_file_header,
+           0,
+           sizeof(m_persistent_file_header) );
+
     cache_create_info.flags           = 0;
     cache_create_info.initialDataSize = in_initial_data_size;
     cache_create_info.pInitialData    = in_initial_data;
@@ -73,6 +95,14 @@ Anvil::PipelineCache::~PipelineCache()
     Anvil::ObjectTracker::get()->unregister_object(Anvil::ObjectType::PIPELINE_CACHE,
                                                     this);
 
+    /* Persistent caches are written back to disk at destruction time. The data needs to be retrieved
+     * before the Vulkan object is released, but the file can be written while we tear down the rest. */
+    if (is_persistent()                    &&
+        m_pipeline_cache != VK_NULL_HANDLE)
+    {
+        save_async();
+    }
+
     if (m_pipeline_cache != VK_NULL_HANDLE)
     {
         lock();
@@ -85,6 +115,12 @@ Anvil::PipelineCache::~PipelineCache()
 
         m_pipeline_cache = VK_NULL_HANDLE;
     }
+
+    {
+        std::unique_lock<std::mutex> save_thread_lock(m_save_thread_mutex);
+
+        wait_for_pending_save();
+    }
 }
 
 /** Please see header for specification */
@@ -106,6 +142,48 @@ Anvil::PipelineCacheUniquePtr Anvil::PipelineCache::create(const Anvil::BaseDevi
     return result_ptr;
 }
 
+/** Please see header for specification */
+Anvil::PipelineCacheUniquePtr Anvil::PipelineCache::create_persistent(const Anvil::BaseDevice* in_device_ptr,
+                                                                      bool                     in_mt_safe,
+                                                                      const std::string&       in_directory)
+{
+    const std::string      filename    (get_persistent_filename(in_device_ptr,
+                                                                in_directory) );
+    PersistentFileHeader   file_header;
+    std::vector<uint8_t>   initial_data;
+    PipelineCacheUniquePtr result_ptr  (nullptr,
+                                        std::default_delete<PipelineCache>() );
+
+    init_persistent_file_header(in_device_ptr,
+                               &file_header);
+
+    /* If the file is missing, stale or corrupt, start with an empty cache. It is going to be
+     * overwritten with valid data next time the cache is saved.
+     */
+    if (!read_persistent_file(file_header,
+                              filename,
+                             &initial_data) )
+    {
+        initial_data.clear();
+    }
+
+    result_ptr.reset(
+        new Anvil::PipelineCache(in_device_ptr,
+                                 in_mt_safe,
+                                 initial_data.size(),
+                                 (initial_data.size() > 0) ? initial_data.data()
+                                                           : nullptr)
+    );
+
+    if (result_ptr != nullptr)
+    {
+        result_ptr->m_persistent_file_header = file_header;
+        result_ptr->m_persistent_filename    = filename;
+    }
+
+    return result_ptr;
+}
+
 /** Please see header for specification */
 bool Anvil::PipelineCache::get_data(size_t* out_n_data_bytes_ptr,
                                     void*   out_data_ptr)
@@ -127,8 +205,7 @@ bool Anvil::PipelineCache::merge(uint32_t                           in_n_pipelin
     VkResult                     result_vk;
     std::vector<VkPipelineCache> src_pipeline_caches(in_n_pipeline_caches);
 
-    anvil_assert(in_n_pipeline_caches < sizeof(src_pipeline_caches) / sizeof(src_pipeline_caches[0]) );
-
+    anvil_assert(in_n_pipeline_caches > 0);
 
     for (uint32_t n_pipeline_cache = 0;
                   n_pipeline_cache < in_n_pipeline_caches;
@@ -146,7 +223,356 @@ bool Anvil::PipelineCache::merge(uint32_t                           in_n_pipelin
     }
     unlock();
 
-    anvil_assert(result_vk);
+    anvil_assert_vk_call_succeeded(result_vk);
 
     return is_vk_call_successful(result_vk);
 }
+
+/** Calculates a 64-bit FNV-1a hash of user-specified data. Used to detect corrupt pipeline cache files.
+ *
+ *  @param in_data_ptr  Data to hash. May be nullptr if @param in_data_size is 0.
+ *  @param in_data_size Number of bytes available under @param in_data_ptr.
+ *
+ *  @return Hash value.
+ **/
+uint64_t Anvil::PipelineCache::get_data_hash(const uint8_t* in_data_ptr,
+                                             size_t         in_data_size)
+{
+    uint64_t result = 0xCBF29CE484222325ull;
+
+    for (size_t n_byte = 0;
+                n_byte < in_data_size;
+              ++n_byte)
+    {
+        result ^= in_data_ptr[n_byte];
+        result *= 0x100000001B3ull;
+    }
+
+    return result;
+}
+
+/** Forms name of the file which backs persistent pipeline caches created for @param in_device_ptr.
+ *
+ *  The name encodes all properties which determine whether pipeline cache data can be reused, so that
+ *  caches for different devices or driver versions can co-exist in the same directory.
+ *
+ *  @param in_device_ptr Device to form the file name for. Must not be nullptr.
+ *  @param in_directory  Directory the file should be located in.
+ *
+ *  @return Requested file name.
+ **/
+std::string Anvil::PipelineCache::get_persistent_filename(const Anvil::BaseDevice* in_device_ptr,
+                                                          const std::string&       in_directory)
+{
+    const auto         device_props_ptr = in_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr;
+    std::stringstream  result_sstream;
+
+    result_sstream << in_directory;
+
+    if (in_directory.size()  > 0    &&
+        in_directory.back() != '/'  &&
+        in_directory.back() != '\\')
+    {
+        result_sstream << "/";
+    }
+
+    result_sstream << "anvil_pipeline_cache_"
+                   << std::hex
+                   << std::setfill('0')
+                   << std::setw(8) << device_props_ptr->vendor_id      << "_"
+                   << std::setw(8) << device_props_ptr->device_id      << "_"
+                   << std::setw(8) << device_props_ptr->driver_version << "_";
+
+    for (uint32_t n_uuid_byte = 0;
+                  n_uuid_byte < VK_UUID_SIZE;
+                ++n_uuid_byte)
+    {
+        result_sstream << std::setw(2) << static_cast<uint32_t>(device_props_ptr->pipeline_cache_uuid[n_uuid_byte]);
+    }
+
+    result_sstream << ".bin";
+
+    return result_sstream.str();
+}
+
+/** Fills all fields of a persistent pipeline cache file header, except for data size and hash, with values
+ *  which are valid for @param in_device_ptr.
+ *
+ *  @param in_device_ptr  Device to use. Must not be nullptr.
+ *  @param out_header_ptr Deref will be filled with the header data. Must not be nullptr.
+ **/
+void Anvil::PipelineCache::init_persistent_file_header(const Anvil::BaseDevice* in_device_ptr,
+                                                       PersistentFileHeader*    out_header_ptr)
+{
+    const auto device_props_ptr = in_device_ptr->get_physical_device_properties().core_vk1_0_properties_ptr;
+
+    memset(out_header_ptr,
+           0,
+           sizeof(*out_header_ptr) );
+
+    out_header_ptr->device_id      = device_props_ptr->device_id;
+    out_header_ptr->driver_version = device_props_ptr->driver_version;
+    out_header_ptr->magic          = g_persistent_file_magic;
+    out_header_ptr->vendor_id      = device_props_ptr->vendor_id;
+    out_header_ptr->version        = g_persistent_file_version;
+
+    memcpy(out_header_ptr->pipeline_cache_uuid,
+           device_props_ptr->pipeline_cache_uuid,
+           sizeof(out_header_ptr->pipeline_cache_uuid) );
+}
+
+/** Reads pipeline cache data from a file backing a persistent pipeline cache.
+ *
+ *  The file is rejected if it was written for a different device, driver version or pipeline cache UUID,
+ *  or if its contents do not match the size and hash stored in the header.
+ *
+ *  @param in_expected_header Header, as returned by init_persistent_file_header() for the device the pipeline
+ *                            cache is going to be created for.
+ *  @param in_filename        Name of the file to read.
+ *  @param out_data_ptr       Deref will be set to the pipeline cache data stored in the file. Must not be nullptr.
+ *
+ *  @return true if the file exists and holds valid data, false otherwise.
+ **/
+bool Anvil::PipelineCache::read_persistent_file(const PersistentFileHeader& in_expected_header,
+                                                const std::string&          in_filename,
+                                                std::vector<uint8_t>*       out_data_ptr)
+{
+    const uint8_t*       data_ptr       = nullptr;
+    char*                file_data_ptr  = nullptr;
+    size_t               file_data_size = 0;
+    PersistentFileHeader file_header;
+    bool                 result         = false;
+
+    if (!Anvil::IO::read_file(in_filename,
+                              false, /* in_is_text_file */
+                             &file_data_ptr,
+                             &file_data_size) )
+    {
+        goto end;
+    }
+
+    if (file_data_size < sizeof(PersistentFileHeader) )
+    {
+        goto end;
+    }
+
+    memcpy(&file_header,
+           file_data_ptr,
+           sizeof(file_header) );
+
+    /* Reject files written for other devices or drivers .. */
+    if (file_header.magic          != in_expected_header.magic          ||
+        file_header.version        != in_expected_header.version        ||
+        file_header.vendor_id      != in_expected_header.vendor_id      ||
+        file_header.device_id      != in_expected_header.device_id      ||
+        file_header.driver_version != in_expected_header.driver_version ||
+        memcmp(file_header.pipeline_cache_uuid,
+               in_expected_header.pipeline_cache_uuid,
+               sizeof(file_header.pipeline_cache_uuid) ) != 0)
+    {
+        goto end;
+    }
+
+    /* .. as well as truncated or corrupt ones. */
+    if (file_header.data_size != static_cast<uint64_t>(file_data_size - sizeof(PersistentFileHeader) ) )
+    {
+        goto end;
+    }
+
+    data_ptr = reinterpret_cast<const uint8_t*>(file_data_ptr) + sizeof(PersistentFileHeader);
+
+    if (get_data_hash(data_ptr,
+                      static_cast<size_t>(file_header.data_size) ) != file_header.data_hash)
+    {
+        goto end;
+    }
+
+    out_data_ptr->assign(data_ptr,
+                         data_ptr + file_header.data_size);
+
+    result = true;
+end:
+    if (file_data_ptr != nullptr)
+    {
+        delete [] file_data_ptr;
+    }
+
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::PipelineCache::save()
+{
+    std::vector<uint8_t> file_data;
+    bool                 result    = false;
+
+    anvil_assert(is_persistent() );
+
+    if (!is_persistent() )
+    {
+        goto end;
+    }
+
+    if (!serialize_persistent_data(&file_data) )
+    {
+        goto end;
+    }
+
+    {
+        std::unique_lock<std::mutex> save_thread_lock(m_save_thread_mutex);
+
+        wait_for_pending_save();
+
+        result = write_persistent_file(m_persistent_filename,
+                                       file_data);
+    }
+
+end:
+    return result;
+}
+
+/** Please see header for specification */
+bool Anvil::PipelineCache::save_async()
+{
+    std::vector<uint8_t> file_data;
+    bool                 result    = false;
+
+    anvil_assert(is_persistent() );
+
+    if (!is_persistent() )
+    {
+        goto end;
+    }
+
+    /* Pipeline cache data must be retrieved on the calling thread, so that the cache can be safely
+     * destroyed or modified while the file is being written. */
+    if (!serialize_persistent_data(&file_data) )
+    {
+        goto end;
+    }
+
+    {
+        std::unique_lock<std::mutex> save_thread_lock(m_save_thread_mutex);
+
+        wait_for_pending_save();
+
+        m_save_thread = std::thread(&Anvil::PipelineCache::write_persistent_file,
+                                    m_persistent_filename,
+                                    std::move(file_data) );
+    }
+
+    result = true;
+end:
+    return result;
+}
+
+/** Retrieves pipeline cache data and prefixes it with a persistent pipeline cache file header.
+ *
+ *  @param out_file_data_ptr Deref will be set to the contents of the file to write. Must not be nullptr.
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::PipelineCache::serialize_persistent_data(std::vector<uint8_t>* out_file_data_ptr)
+{
+    PersistentFileHeader header       = m_persistent_file_header;
+    size_t               n_data_bytes = 0;
+    bool                 result       = false;
+
+    lock();
+    {
+        if (get_data(&n_data_bytes,
+                      nullptr) )
+        {
+            out_file_data_ptr->resize(sizeof(PersistentFileHeader) + n_data_bytes);
+
+            result = (n_data_bytes == 0) || get_data(&n_data_bytes,
+                                                     out_file_data_ptr->data() + sizeof(PersistentFileHeader) );
+        }
+    }
+    unlock();
+
+    if (!result)
+    {
+        goto end;
+    }
+
+    out_file_data_ptr->resize(sizeof(PersistentFileHeader) + n_data_bytes);
+
+    header.data_size = n_data_bytes;
+    header.data_hash = get_data_hash(out_file_data_ptr->data() + sizeof(PersistentFileHeader),
+                                     n_data_bytes);
+
+    memcpy(out_file_data_ptr->data(),
+          &header,
+           sizeof(header) );
+
+end:
+    return result;
+}
+
+/** Blocks until the pending asynchronous save operation, if any, finishes.
+ *
+ *  m_save_thread_mutex must be locked by the caller.
+ **/
+void Anvil::PipelineCache::wait_for_pending_save()
+{
+    if (m_save_thread.joinable() )
+    {
+        m_save_thread.join();
+    }
+}
+
+/** Writes user-specified data to a temporary file, and then replaces the file backing a persistent
+ *  pipeline cache with it. This guarantees other processes never see a partially written file.
+ *
+ *  The temporary file name includes the process ID and a hash of the thread ID, so that processes
+ *  and threads which save caches backed by the same file at the same time do not overwrite each
+ *  other's temporary files. Whichever write finishes last wins.
+ *
+ *  @param in_filename  Name of the file backing the pipeline cache.
+ *  @param in_file_data Data to write, as returned by serialize_persistent_data().
+ *
+ *  @return true if successful, false otherwise.
+ **/
+bool Anvil::PipelineCache::write_persistent_file(const std::string&          in_filename,
+                                                 const std::vector<uint8_t>& in_file_data)
+{
+    bool              result        = false;
+    std::stringstream temp_filename_sstream;
+    std::string       temp_filename;
+
+    #ifdef _WIN32
+    {
+        temp_filename_sstream << in_filename << "." << _getpid();
+    }
+    #else
+    {
+        temp_filename_sstream << in_filename << "." << getpid();
+    }
+    #endif
+
+    temp_filename_sstream << "." << std::hex << std::hash<std::thread::id>()(std::this_thread::get_id() )
+                          << ".tmp";
+
+    temp_filename = temp_filename_sstream.str();
+
+    if (!Anvil::IO::write_binary_file(temp_filename,
+                                      in_file_data.data(),
+                                      static_cast<unsigned int>(in_file_data.size() ),
+                                      false) ) /* in_should_append */
+    {
+        goto end;
+    }
+
+    if (!Anvil::IO::move_file(temp_filename,
+                              in_filename) )
+    {
+        Anvil::IO::delete_file(temp_filename);
+
+        goto end;
+    }
+
+    result = true;
+end:
+    return result;
+}
@@ -22,6 +22,7 @@
 
 #include "misc/debug.h"
 #include "misc/object_tracker.h"
+#include "misc/tracer.h"
 #include "wrappers/descriptor_set_group.h"
 #include "wrappers/descriptor_set_layout.h"
 #include "wrappers/descriptor_set_layout_manager.h"
@@ -65,6 +66,8 @@ Anvil::PipelineLayout::~PipelineLayout()
 /** Please see header for specification */
 bool Anvil::PipelineLayout::bake(const std::vector<DescriptorSetCreateInfoUniquePtr>* in_ds_create_info_items_ptr)
 {
+    ANVIL_TRACE_CPU_SPAN("PipelineLayout::bake");
+
     auto                               ds_layout_manager_ptr        = m_device_ptr->get_descriptor_set_layout_manager();
     std::vector<VkDescriptorSetLayout> ds_layouts_vk;
     VkPipelineLayoutCreateInfo         pipeline_layout_create_info;
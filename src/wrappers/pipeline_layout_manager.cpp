@@ -71,7 +71,7 @@ bool Anvil::PipelineLayoutManager::get_layout(const std::vector<DescriptorSetCre
                                               const PushConstantRanges&                            in_push_constant_ranges,
                                               Anvil::PipelineLayoutUniquePtr*                      out_pipeline_layout_ptr_ptr)
 {
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr                   = get_mutex();
     const uint32_t                         n_descriptor_sets_in_in_dsg = static_cast<uint32_t>(in_ds_create_info_items_ptr->size() );
     bool                                   result                      = false;
@@ -80,7 +80,7 @@ bool Anvil::PipelineLayoutManager::get_layout(const std::vector<DescriptorSetCre
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -180,13 +180,13 @@ bool Anvil::PipelineLayoutManager::get_layout(const std::vector<DescriptorSetCre
 void Anvil::PipelineLayoutManager::on_pipeline_layout_dereferenced(Anvil::PipelineLayout* in_layout_ptr)
 {
     bool                                   has_found  = false;
-    std::unique_lock<std::recursive_mutex> mutex_lock;
+    std::unique_lock<Anvil::MTSafetyMutex> mutex_lock;
     auto                                   mutex_ptr  = get_mutex();
 
     if (mutex_ptr != nullptr)
     {
         mutex_lock = std::move(
-            std::unique_lock<std::recursive_mutex>(*mutex_ptr)
+            std::unique_lock<Anvil::MTSafetyMutex>(*mutex_ptr)
         );
     }
 
@@ -25,6 +25,7 @@
 #include "misc/object_tracker.h"
 #include "misc/struct_chainer.h"
 #include "misc/swapchain_create_info.h"
+#include "misc/tracer.h"
 #include "misc/window.h"
 #include "wrappers/buffer.h"
 #include "wrappers/command_buffer.h"
@@ -40,6 +41,40 @@
 #define MAX_SWAPCHAINS (32)
 
 
+namespace
+{
+    /* Per-thread storage reused by Queue::submit(). Once the vectors have grown to the sizes required by the
+     * application's submissions, no heap allocations are needed to prepare a vkQueueSubmit() call.
+     */
+    typedef struct SubmitScratchData
+    {
+        std::vector<uint32_t>                         cmd_buffer_device_masks;
+        std::vector<VkCommandBuffer>                  cmd_buffers_vk;
+        std::vector<VkDeviceGroupSubmitInfoKHR>       device_group_submit_infos_vk;
+        std::vector<VkProtectedSubmitInfo>            protected_submit_infos_vk;
+        std::vector<uint32_t>                         signal_semaphore_device_indices;
+        std::vector<VkSemaphore>                      signal_semaphores_vk;
+        std::vector<VkSubmitInfo>                     submit_infos_vk;
+        std::vector<VkTimelineSemaphoreSubmitInfoKHR> timeline_submit_infos_vk;
+        std::vector<uint32_t>                         wait_semaphore_device_indices;
+        std::vector<VkSemaphore>                      wait_semaphores_vk;
+
+        #if defined(_WIN32)
+            std::vector<VkD3D12FenceSubmitInfoKHR>              d3d12_fence_submit_infos_vk;
+            std::vector<VkDeviceMemory>                         keyed_mutex_device_memory_vk;
+            std::vector<VkWin32KeyedMutexAcquireReleaseInfoKHR> keyed_mutex_submit_infos_vk;
+        #endif
+    } SubmitScratchData;
+
+    SubmitScratchData& get_submit_scratch_data()
+    {
+        static thread_local SubmitScratchData scratch_data;
+
+        return scratch_data;
+    }
+};
+
+
 /** Please see header for specification */
 Anvil::Queue::Queue(const Anvil::BaseDevice*          in_device_ptr,
                     uint32_t                          in_queue_family_index,
@@ -826,6 +861,8 @@ bool Anvil::Queue::present_internal(DeviceGroupPresentModeFlagBits      in_prese
                                     Anvil::Semaphore* const*            in_wait_semaphore_ptrs,
                                     Anvil::SwapchainOperationErrorCode* out_present_results_ptr)
 {
+    ANVIL_TRACE_CPU_SPAN("Queue::present");
+
     const Anvil::DeviceType                 device_type              (m_device_ptr->get_type() );
     VkResult                                presentation_results     [MAX_SWAPCHAINS];
     bool                                    result                   (false);
@@ -1019,359 +1056,457 @@ void Anvil::Queue::present_lock_unlock(uint32_t                       in_n_swapc
 /** Please see header for specification */
 bool Anvil::Queue::submit(const Anvil::SubmitInfo& in_submit_info)
 {
-    Anvil::Fence*                      fence_ptr        (in_submit_info.get_fence() );
-    bool                               needs_fence_reset(false);
-    VkResult                           result           (VK_ERROR_INITIALIZATION_FAILED);
-    Anvil::StructChainer<VkSubmitInfo> struct_chainer;
-
-    std::vector<VkCommandBuffer> cmd_buffers_vk         (in_submit_info.get_n_command_buffers  () );
-    std::vector<VkDeviceMemory>  device_memory_block_vec(0);
-    std::vector<VkSemaphore>     signal_semaphores_vk   (in_submit_info.get_n_signal_semaphores() );
-    std::vector<VkSemaphore>     wait_semaphores_vk     (in_submit_info.get_n_wait_semaphores  () );
+    return submit(1, /* in_n_submit_infos */
+                 &in_submit_info);
+}
 
-    std::vector<uint32_t> cmd_buffer_device_masks         = std::vector<uint32_t>(in_submit_info.get_n_command_buffers() );
-    std::vector<uint32_t> signal_semaphore_device_indices = std::vector<uint32_t>(in_submit_info.get_n_signal_semaphores() );
-    std::vector<uint32_t> wait_semaphore_device_indices   = std::vector<uint32_t>(in_submit_info.get_n_wait_semaphores  () );
+/** Please see header for specification */
+bool Anvil::Queue::submit(uint32_t                 in_n_submit_infos,
+                          const Anvil::SubmitInfo* in_submit_infos_ptr)
+{
+    ANVIL_TRACE_CPU_SPAN("Queue::submit");
+
+    Anvil::Fence*      fence_ptr                (nullptr);
+    uint32_t           n_cmd_buffers_used       (0);
+    uint32_t           n_cmd_buffers_total      (0);
+    uint32_t           n_signal_semaphores_used (0);
+    uint32_t           n_signal_semaphores_total(0);
+    uint32_t           n_wait_semaphores_used   (0);
+    uint32_t           n_wait_semaphores_total  (0);
+    bool               needs_fence_reset        (false);
+    VkResult           result                   (VK_ERROR_INITIALIZATION_FAILED);
+    SubmitScratchData& scratch_data             (get_submit_scratch_data() );
+    bool               should_block             (false);
+    uint64_t           timeout                  (UINT64_MAX);
 
+    #if defined(_WIN32)
+        uint32_t n_keyed_mutex_syncs_used (0);
+        uint32_t n_keyed_mutex_syncs_total(0);
+    #endif
 
     ANVIL_REDUNDANT_VARIABLE(result);
 
-    /* Prepare for the submission */
-    switch (in_submit_info.get_type() )
+    if (in_n_submit_infos   == 0       ||
+        in_submit_infos_ptr == nullptr)
+    {
+        anvil_assert(in_n_submit_infos   != 0);
+        anvil_assert(in_submit_infos_ptr != nullptr);
+
+        goto end;
+    }
+
+    /* Size the scratch storage up-front, so that pointers to its contents remain valid while the submit info structs
+     * are being filled. Once the vectors have grown large enough, no further heap allocations occur. */
+    for (uint32_t n_submit_info = 0;
+                  n_submit_info < in_n_submit_infos;
+                ++n_submit_info)
     {
-        case SubmissionType::MGPU:
+        const auto& current_submit_info = in_submit_infos_ptr[n_submit_info];
+
+        n_cmd_buffers_total       += current_submit_info.get_n_command_buffers ();
+        n_signal_semaphores_total += current_submit_info.get_n_signal_semaphores();
+        n_wait_semaphores_total   += current_submit_info.get_n_wait_semaphores  ();
+
+        /* vkQueueSubmit() only takes a single fence, so all batched submissions need to share it. */
+        if (current_submit_info.get_fence() != nullptr)
+        {
+            anvil_assert(fence_ptr == nullptr                     ||
+                         fence_ptr == current_submit_info.get_fence() );
+
+            fence_ptr = current_submit_info.get_fence();
+        }
+
+        if (current_submit_info.get_should_block() )
         {
-            uint32_t n_cmd_buffers = 0;
+            should_block = true;
+            timeout      = current_submit_info.get_timeout();
+        }
 
-            if (in_submit_info.is_protected_submission() )
+        #if defined(_WIN32)
+        {
+            const Anvil::MemoryBlock** acquire_d3d11_memory_block_ptrs = nullptr;
+            const uint64_t*            acquire_mutex_key_value_ptrs    = nullptr;
+            const uint32_t*            acquire_timeout_ptrs            = nullptr;
+            uint32_t                   n_acquire_keys                  = 0;
+            uint32_t                   n_release_keys                  = 0;
+            const Anvil::MemoryBlock** release_d3d11_memory_block_ptrs = nullptr;
+            const uint64_t*            release_mutex_key_value_ptrs    = nullptr;
+
+            if (current_submit_info.get_keyed_mutex_acquire_release_info(&n_acquire_keys,
+                                                                         &acquire_d3d11_memory_block_ptrs,
+                                                                         &acquire_mutex_key_value_ptrs,
+                                                                         &acquire_timeout_ptrs,
+                                                                         &n_release_keys,
+                                                                         &release_d3d11_memory_block_ptrs,
+                                                                         &release_mutex_key_value_ptrs) )
             {
-                anvil_assert(reinterpret_cast<const MGPUDevice*>(m_device_ptr)->get_physical_device(0)->supports_core_vk1_1() );
+                n_keyed_mutex_syncs_total += n_acquire_keys + n_release_keys;
             }
+        }
+        #endif
+    }
+
+    scratch_data.cmd_buffer_device_masks.resize        (n_cmd_buffers_total);
+    scratch_data.cmd_buffers_vk.resize                 (n_cmd_buffers_total);
+    scratch_data.device_group_submit_infos_vk.resize   (in_n_submit_infos);
+    scratch_data.protected_submit_infos_vk.resize      (in_n_submit_infos);
+    scratch_data.signal_semaphore_device_indices.resize(n_signal_semaphores_total);
+    scratch_data.signal_semaphores_vk.resize           (n_signal_semaphores_total);
+    scratch_data.submit_infos_vk.resize                (in_n_submit_infos);
+    scratch_data.timeline_submit_infos_vk.resize       (in_n_submit_infos);
+    scratch_data.wait_semaphore_device_indices.resize  (n_wait_semaphores_total);
+    scratch_data.wait_semaphores_vk.resize             (n_wait_semaphores_total);
 
-            for (uint32_t n_command_buffer_submission = 0;
-                          n_command_buffer_submission < in_submit_info.get_n_command_buffers();
-                        ++n_command_buffer_submission)
+    #if defined(_WIN32)
+    {
+        scratch_data.d3d12_fence_submit_infos_vk.resize (in_n_submit_infos);
+        scratch_data.keyed_mutex_device_memory_vk.resize(n_keyed_mutex_syncs_total);
+        scratch_data.keyed_mutex_submit_infos_vk.resize (in_n_submit_infos);
+    }
+    #endif
+
+    /* Prepare for the submission */
+    for (uint32_t n_submit_info = 0;
+                  n_submit_info < in_n_submit_infos;
+                ++n_submit_info)
+    {
+        const auto&      current_submit_info       = in_submit_infos_ptr[n_submit_info];
+        uint32_t*        cmd_buffer_device_masks   = scratch_data.cmd_buffer_device_masks.data        () + n_cmd_buffers_used;
+        VkCommandBuffer* cmd_buffers_vk            = scratch_data.cmd_buffers_vk.data                 () + n_cmd_buffers_used;
+        const void*      next_struct_ptr           = nullptr;
+        uint32_t         n_cmd_buffers             = 0;
+        const uint32_t   n_signal_semaphores       = current_submit_info.get_n_signal_semaphores();
+        const uint32_t   n_wait_semaphores         = current_submit_info.get_n_wait_semaphores  ();
+        uint32_t*        signal_semaphore_dev_inds = scratch_data.signal_semaphore_device_indices.data() + n_signal_semaphores_used;
+        VkSemaphore*     signal_semaphores_vk      = scratch_data.signal_semaphores_vk.data           () + n_signal_semaphores_used;
+        VkSubmitInfo&    submit_info               = scratch_data.submit_infos_vk.at                  (n_submit_info);
+        uint32_t*        wait_semaphore_dev_inds   = scratch_data.wait_semaphore_device_indices.data  () + n_wait_semaphores_used;
+        VkSemaphore*     wait_semaphores_vk        = scratch_data.wait_semaphores_vk.data             () + n_wait_semaphores_used;
+
+        switch (current_submit_info.get_type() )
+        {
+            case SubmissionType::MGPU:
             {
-                const auto& current_submission = in_submit_info.get_command_buffers_mgpu()[n_command_buffer_submission];
+                VkDeviceGroupSubmitInfoKHR& submit_info_device_group = scratch_data.device_group_submit_infos_vk.at(n_submit_info);
 
-                if (current_submission.cmd_buffer_ptr != nullptr)
+                if (current_submit_info.is_protected_submission() )
                 {
-                    cmd_buffers_vk.at         (n_cmd_buffers) = current_submission.cmd_buffer_ptr->get_command_buffer();
-                    cmd_buffer_device_masks.at(n_cmd_buffers) = current_submission.device_mask;
-
-                    ++n_cmd_buffers;
+                    anvil_assert(reinterpret_cast<const MGPUDevice*>(m_device_ptr)->get_physical_device(0)->supports_core_vk1_1() );
                 }
-            }
 
-            for (uint32_t n_signal_semaphore_submission = 0;
-                          n_signal_semaphore_submission < in_submit_info.get_n_signal_semaphores();
-                        ++n_signal_semaphore_submission)
-            {
-                const auto& current_submission = in_submit_info.get_signal_semaphores_mgpu()[n_signal_semaphore_submission];
+                for (uint32_t n_command_buffer_submission = 0;
+                              n_command_buffer_submission < current_submit_info.get_n_command_buffers();
+                            ++n_command_buffer_submission)
+                {
+                    const auto& current_submission = current_submit_info.get_command_buffers_mgpu()[n_command_buffer_submission];
 
-                anvil_assert(current_submission.device_index < reinterpret_cast<const Anvil::MGPUDevice*>(m_device_ptr)->get_n_physical_devices() );
+                    if (current_submission.cmd_buffer_ptr != nullptr)
+                    {
+                        cmd_buffers_vk         [n_cmd_buffers] = current_submission.cmd_buffer_ptr->get_command_buffer();
+                        cmd_buffer_device_masks[n_cmd_buffers] = current_submission.device_mask;
 
-                signal_semaphore_device_indices.at(n_signal_semaphore_submission) = current_submission.device_index;
-                signal_semaphores_vk.at           (n_signal_semaphore_submission) = current_submission.semaphore_ptr->get_semaphore();
-            }
+                        ++n_cmd_buffers;
+                    }
+                }
 
-            for (uint32_t n_wait_semaphore_submission = 0;
-                          n_wait_semaphore_submission < in_submit_info.get_n_wait_semaphores();
-                        ++n_wait_semaphore_submission)
-            {
-                const auto& current_submission = in_submit_info.get_wait_semaphores_mgpu()[n_wait_semaphore_submission];
+                for (uint32_t n_signal_semaphore_submission = 0;
+                              n_signal_semaphore_submission < n_signal_semaphores;
+                            ++n_signal_semaphore_submission)
+                {
+                    const auto& current_submission = current_submit_info.get_signal_semaphores_mgpu()[n_signal_semaphore_submission];
 
-                anvil_assert(current_submission.device_index < reinterpret_cast<const Anvil::MGPUDevice*>(m_device_ptr)->get_n_physical_devices() );
+                    anvil_assert(current_submission.device_index < reinterpret_cast<const Anvil::MGPUDevice*>(m_device_ptr)->get_n_physical_devices() );
 
-                wait_semaphore_device_indices.at(n_wait_semaphore_submission) = current_submission.device_index;
-                wait_semaphores_vk.at           (n_wait_semaphore_submission) = current_submission.semaphore_ptr->get_semaphore();
-            }
+                    signal_semaphore_dev_inds[n_signal_semaphore_submission] = current_submission.device_index;
+                    signal_semaphores_vk     [n_signal_semaphore_submission] = current_submission.semaphore_ptr->get_semaphore();
+                }
 
-            {
-                VkSubmitInfo submit_info;
-
-                submit_info.commandBufferCount   = in_submit_info.get_n_command_buffers();
-                submit_info.pCommandBuffers      = (submit_info.commandBufferCount           != 0) ? &cmd_buffers_vk.at(0)       : nullptr;
-                submit_info.pNext                = nullptr;
-                submit_info.pSignalSemaphores    = (in_submit_info.get_n_signal_semaphores() != 0) ? &signal_semaphores_vk.at(0) : nullptr;
-                submit_info.pWaitDstStageMask    = in_submit_info.get_destination_stage_wait_masks();
-                submit_info.pWaitSemaphores      = (in_submit_info.get_n_wait_semaphores()   != 0) ? &wait_semaphores_vk.at(0)   : nullptr;
-                submit_info.signalSemaphoreCount = in_submit_info.get_n_signal_semaphores();
-                submit_info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-                submit_info.waitSemaphoreCount   = in_submit_info.get_n_wait_semaphores();
-
-                struct_chainer.append_struct(submit_info);
-            }
+                for (uint32_t n_wait_semaphore_submission = 0;
+                              n_wait_semaphore_submission < n_wait_semaphores;
+                            ++n_wait_semaphore_submission)
+                {
+                    const auto& current_submission = current_submit_info.get_wait_semaphores_mgpu()[n_wait_semaphore_submission];
 
-            {
-                VkDeviceGroupSubmitInfoKHR submit_info_device_group;
+                    anvil_assert(current_submission.device_index < reinterpret_cast<const Anvil::MGPUDevice*>(m_device_ptr)->get_n_physical_devices() );
+
+                    wait_semaphore_dev_inds[n_wait_semaphore_submission] = current_submission.device_index;
+                    wait_semaphores_vk     [n_wait_semaphore_submission] = current_submission.semaphore_ptr->get_semaphore();
+                }
 
                 submit_info_device_group.commandBufferCount            = n_cmd_buffers;
-                submit_info_device_group.pCommandBufferDeviceMasks     = (n_cmd_buffers != 0) ? &cmd_buffer_device_masks.at(0) : nullptr;
-                submit_info_device_group.pNext                         = nullptr;
-                submit_info_device_group.pSignalSemaphoreDeviceIndices = (in_submit_info.get_n_signal_semaphores() != 0) ? &signal_semaphore_device_indices.at(0) : nullptr;
-                submit_info_device_group.pWaitSemaphoreDeviceIndices   = (in_submit_info.get_n_wait_semaphores  () != 0) ? &wait_semaphore_device_indices.at  (0) : nullptr;
-                submit_info_device_group.signalSemaphoreCount          = in_submit_info.get_n_signal_semaphores();
+                submit_info_device_group.pCommandBufferDeviceMasks     = (n_cmd_buffers       != 0) ? cmd_buffer_device_masks   : nullptr;
+                submit_info_device_group.pNext                         = next_struct_ptr;
+                submit_info_device_group.pSignalSemaphoreDeviceIndices = (n_signal_semaphores != 0) ? signal_semaphore_dev_inds : nullptr;
+                submit_info_device_group.pWaitSemaphoreDeviceIndices   = (n_wait_semaphores   != 0) ? wait_semaphore_dev_inds   : nullptr;
+                submit_info_device_group.signalSemaphoreCount          = n_signal_semaphores;
                 submit_info_device_group.sType                         = VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO_KHR;
-                submit_info_device_group.waitSemaphoreCount            = in_submit_info.get_n_wait_semaphores();
+                submit_info_device_group.waitSemaphoreCount            = n_wait_semaphores;
+
+                next_struct_ptr = &submit_info_device_group;
 
-                struct_chainer.append_struct(submit_info_device_group);
+                break;
             }
 
-            break;
-        }
+            case SubmissionType::SGPU:
+            {
+                if (current_submit_info.is_protected_submission() )
+                {
+                    anvil_assert(reinterpret_cast<const SGPUDevice*>(m_device_ptr)->get_physical_device()->supports_core_vk1_1() );
+                }
 
-        case SubmissionType::SGPU:
-        {
-            VkSubmitInfo submit_info;
+                for (n_cmd_buffers = 0;
+                     n_cmd_buffers < current_submit_info.get_n_command_buffers();
+                   ++n_cmd_buffers)
+                {
+                    cmd_buffers_vk[n_cmd_buffers] = current_submit_info.get_command_buffers_sgpu()[n_cmd_buffers]->get_command_buffer();
+                }
 
-            if (in_submit_info.is_protected_submission() )
-            {
-                anvil_assert(reinterpret_cast<const SGPUDevice*>(m_device_ptr)->get_physical_device()->supports_core_vk1_1() );
-            }
+                for (uint32_t n_signal_semaphore = 0;
+                              n_signal_semaphore < n_signal_semaphores;
+                            ++n_signal_semaphore)
+                {
+                    signal_semaphores_vk[n_signal_semaphore] = current_submit_info.get_signal_semaphores_sgpu()[n_signal_semaphore]->get_semaphore();
+                }
 
-            for (uint32_t n_command_buffer = 0;
-                          n_command_buffer < in_submit_info.get_n_command_buffers();
-                        ++n_command_buffer)
-            {
-                cmd_buffers_vk.at(n_command_buffer) = in_submit_info.get_command_buffers_sgpu()[n_command_buffer]->get_command_buffer();
+                for (uint32_t n_wait_semaphore = 0;
+                              n_wait_semaphore < n_wait_semaphores;
+                            ++n_wait_semaphore)
+                {
+                    wait_semaphores_vk[n_wait_semaphore] = current_submit_info.get_wait_semaphores_sgpu()[n_wait_semaphore]->get_semaphore();
+                }
+
+                break;
             }
 
-            for (uint32_t n_signal_semaphore = 0;
-                          n_signal_semaphore < in_submit_info.get_n_signal_semaphores();
-                        ++n_signal_semaphore)
+            default:
             {
-                auto sem_ptr = in_submit_info.get_signal_semaphores_sgpu()[n_signal_semaphore];
-
-                signal_semaphores_vk.at(n_signal_semaphore) = sem_ptr->get_semaphore();
+                anvil_assert_fail();
             }
+        }
+
+        /* Any additional structs to chain? */
+        {
+            const uint64_t* timeline_signal_semaphore_values_ptr = nullptr;
+            const uint64_t* timeline_wait_semaphore_values_ptr   = nullptr;
 
-            for (uint32_t n_wait_semaphore = 0;
-                          n_wait_semaphore < in_submit_info.get_n_wait_semaphores();
-                        ++n_wait_semaphore)
+            if (current_submit_info.get_timeline_semaphore_values(&timeline_signal_semaphore_values_ptr,
+                                                                  &timeline_wait_semaphore_values_ptr) )
             {
-                wait_semaphores_vk.at(n_wait_semaphore) = in_submit_info.get_wait_semaphores_sgpu()[n_wait_semaphore]->get_semaphore();
-            }
+                VkTimelineSemaphoreSubmitInfoKHR& timeline_info = scratch_data.timeline_submit_infos_vk.at(n_submit_info);
 
-            submit_info.commandBufferCount   = in_submit_info.get_n_command_buffers ();
-            submit_info.pCommandBuffers      = (in_submit_info.get_n_command_buffers()   != 0) ? &cmd_buffers_vk.at(0)       : nullptr;
-            submit_info.pNext                = nullptr;
-            submit_info.pSignalSemaphores    = (in_submit_info.get_n_signal_semaphores() != 0) ? &signal_semaphores_vk.at(0) : nullptr;
-            submit_info.pWaitDstStageMask    = in_submit_info.get_destination_stage_wait_masks();
-            submit_info.pWaitSemaphores      = (in_submit_info.get_n_wait_semaphores()   != 0) ? &wait_semaphores_vk.at(0)   : nullptr;
-            submit_info.signalSemaphoreCount = in_submit_info.get_n_signal_semaphores();
-            submit_info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-            submit_info.waitSemaphoreCount   = in_submit_info.get_n_wait_semaphores();
+                anvil_assert(m_device_ptr->get_extension_info()->khr_timeline_semaphore() );
 
-            struct_chainer.append_struct(submit_info);
+                timeline_info.pNext                     = next_struct_ptr;
+                timeline_info.pSignalSemaphoreValues    = (n_signal_semaphores != 0) ? timeline_signal_semaphore_values_ptr : nullptr;
+                timeline_info.pWaitSemaphoreValues      = (n_wait_semaphores   != 0) ? timeline_wait_semaphore_values_ptr   : nullptr;
+                timeline_info.signalSemaphoreValueCount = n_signal_semaphores;
+                timeline_info.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+                timeline_info.waitSemaphoreValueCount   = n_wait_semaphores;
 
-            break;
+                next_struct_ptr = &timeline_info;
+            }
         }
 
-        default:
+        #if defined(_WIN32)
         {
-            anvil_assert_fail();
-        }
-    }
+            const uint64_t* d3d12_fence_signal_semaphore_values_ptr = nullptr;
+            const uint64_t* d3d12_fence_wait_semaphore_values_ptr   = nullptr;
 
-    /* Any additional structs to chain? */
-    #if defined(_WIN32)
-    {
-        const uint64_t* d3d12_fence_signal_semaphore_values_ptr = nullptr;
-        const uint64_t* d3d12_fence_wait_semaphore_values_ptr   = nullptr;
-
-        if (in_submit_info.get_d3d12_fence_semaphore_values(&d3d12_fence_signal_semaphore_values_ptr,
-                                                            &d3d12_fence_wait_semaphore_values_ptr) )
-        {
-            VkD3D12FenceSubmitInfoKHR fence_info;
+            if (current_submit_info.get_d3d12_fence_semaphore_values(&d3d12_fence_signal_semaphore_values_ptr,
+                                                                     &d3d12_fence_wait_semaphore_values_ptr) )
+            {
+                VkD3D12FenceSubmitInfoKHR& fence_info = scratch_data.d3d12_fence_submit_infos_vk.at(n_submit_info);
 
-            fence_info.pNext                      = nullptr;
-            fence_info.pSignalSemaphoreValues     = d3d12_fence_signal_semaphore_values_ptr;
-            fence_info.pWaitSemaphoreValues       = d3d12_fence_wait_semaphore_values_ptr;
-            fence_info.signalSemaphoreValuesCount = in_submit_info.get_n_signal_semaphores();
-            fence_info.sType                      = VK_STRUCTURE_TYPE_D3D12_FENCE_SUBMIT_INFO_KHR;
-            fence_info.waitSemaphoreValuesCount   = in_submit_info.get_n_wait_semaphores();
+                fence_info.pNext                      = next_struct_ptr;
+                fence_info.pSignalSemaphoreValues     = d3d12_fence_signal_semaphore_values_ptr;
+                fence_info.pWaitSemaphoreValues       = d3d12_fence_wait_semaphore_values_ptr;
+                fence_info.signalSemaphoreValuesCount = n_signal_semaphores;
+                fence_info.sType                      = VK_STRUCTURE_TYPE_D3D12_FENCE_SUBMIT_INFO_KHR;
+                fence_info.waitSemaphoreValuesCount   = n_wait_semaphores;
 
-            struct_chainer.append_struct(fence_info);
+                next_struct_ptr = &fence_info;
+            }
         }
-    }
-    #endif
+        #endif
 
-    #if defined(_WIN32)
-    {
-        const Anvil::MemoryBlock** acquire_d3d11_memory_block_ptrs = nullptr;
-        const uint64_t*            acquire_mutex_key_value_ptrs    = nullptr;
-        const uint32_t*            acquire_timeout_ptrs            = nullptr;
-        uint32_t                   n_acquire_keys                  = 0;
-        uint32_t                   n_release_keys                  = 0;
-        const Anvil::MemoryBlock** release_d3d11_memory_block_ptrs = nullptr;
-        const uint64_t*            release_mutex_key_value_ptrs    = nullptr;
-
-        if (in_submit_info.get_keyed_mutex_acquire_release_info(&n_acquire_keys,
-                                                                &acquire_d3d11_memory_block_ptrs,
-                                                                &acquire_mutex_key_value_ptrs,
-                                                                &acquire_timeout_ptrs,
-                                                                &n_release_keys,
-                                                                &release_d3d11_memory_block_ptrs,
-                                                                &release_mutex_key_value_ptrs) )
+        #if defined(_WIN32)
         {
-            VkWin32KeyedMutexAcquireReleaseInfoKHR info;
+            const Anvil::MemoryBlock** acquire_d3d11_memory_block_ptrs = nullptr;
+            const uint64_t*            acquire_mutex_key_value_ptrs    = nullptr;
+            const uint32_t*            acquire_timeout_ptrs            = nullptr;
+            uint32_t                   n_acquire_keys                  = 0;
+            uint32_t                   n_release_keys                  = 0;
+            const Anvil::MemoryBlock** release_d3d11_memory_block_ptrs = nullptr;
+            const uint64_t*            release_mutex_key_value_ptrs    = nullptr;
+
+            if (current_submit_info.get_keyed_mutex_acquire_release_info(&n_acquire_keys,
+                                                                         &acquire_d3d11_memory_block_ptrs,
+                                                                         &acquire_mutex_key_value_ptrs,
+                                                                         &acquire_timeout_ptrs,
+                                                                         &n_release_keys,
+                                                                         &release_d3d11_memory_block_ptrs,
+                                                                         &release_mutex_key_value_ptrs) )
+            {
+                VkWin32KeyedMutexAcquireReleaseInfoKHR& info = scratch_data.keyed_mutex_submit_infos_vk.at(n_submit_info);
 
-            anvil_assert(n_acquire_keys + n_release_keys > 0);
+                anvil_assert(n_acquire_keys + n_release_keys > 0);
 
-            device_memory_block_vec.resize(n_acquire_keys + n_release_keys);
+                VkDeviceMemory* acquire_sync_ptr = (n_acquire_keys > 0) ? scratch_data.keyed_mutex_device_memory_vk.data() + n_keyed_mutex_syncs_used
+                                                                        : nullptr;
+                VkDeviceMemory* release_sync_ptr = (n_release_keys > 0) ? scratch_data.keyed_mutex_device_memory_vk.data() + n_keyed_mutex_syncs_used + n_acquire_keys
+                                                                        : nullptr;
 
-            VkDeviceMemory* acquire_sync_ptr = (n_acquire_keys > 0) ? &device_memory_block_vec.at(0)
-                                                                    : nullptr;
-            VkDeviceMemory* release_sync_ptr = (n_release_keys > 0) ? &device_memory_block_vec.at(n_acquire_keys)
-                                                                    : nullptr;
+                for (uint32_t n_acquire_sync = 0;
+                              n_acquire_sync < n_acquire_keys;
+                            ++n_acquire_sync)
+                {
+                    acquire_sync_ptr[n_acquire_sync] = acquire_d3d11_memory_block_ptrs[n_acquire_sync]->get_memory();
+                }
 
-            for (uint32_t n_acquire_sync = 0;
-                          n_acquire_sync < n_acquire_keys;
-                        ++n_acquire_sync)
-            {
-                acquire_sync_ptr[n_acquire_sync] = acquire_d3d11_memory_block_ptrs[n_acquire_sync]->get_memory();
-            }
+                for (uint32_t n_release_sync = 0;
+                              n_release_sync < n_release_keys;
+                            ++n_release_sync)
+                {
+                    release_sync_ptr[n_release_sync] = release_d3d11_memory_block_ptrs[n_release_sync]->get_memory();
+                }
 
-            for (uint32_t n_release_sync = 0;
-                          n_release_sync < n_release_keys;
-                        ++n_release_sync)
-            {
-                release_sync_ptr[n_release_sync] = release_d3d11_memory_block_ptrs[n_release_sync]->get_memory();
+                info.acquireCount     = n_acquire_keys;
+                info.pAcquireKeys     = acquire_mutex_key_value_ptrs;
+                info.pAcquireSyncs    = acquire_sync_ptr;
+                info.pAcquireTimeouts = acquire_timeout_ptrs;
+                info.pNext            = next_struct_ptr;
+                info.pReleaseKeys     = release_mutex_key_value_ptrs;
+                info.pReleaseSyncs    = release_sync_ptr;
+                info.releaseCount     = n_release_keys;
+                info.sType            = VK_STRUCTURE_TYPE_WIN32_KEYED_MUTEX_ACQUIRE_RELEASE_INFO_KHR;
+
+                next_struct_ptr           = &info;
+                n_keyed_mutex_syncs_used += n_acquire_keys + n_release_keys;
             }
-
-            info.acquireCount     = n_acquire_keys;
-            info.pAcquireKeys     = acquire_mutex_key_value_ptrs;
-            info.pAcquireSyncs    = acquire_sync_ptr;
-            info.pAcquireTimeouts = acquire_timeout_ptrs;
-            info.pNext            = nullptr;
-            info.pReleaseKeys     = release_mutex_key_value_ptrs;
-            info.pReleaseSyncs    = release_sync_ptr;
-            info.releaseCount     = n_release_keys;
-            info.sType            = VK_STRUCTURE_TYPE_WIN32_KEYED_MUTEX_ACQUIRE_RELEASE_INFO_KHR;
-
-            struct_chainer.append_struct(info);
         }
-    }
-    #endif
+        #endif
 
-    if (in_submit_info.is_protected_submission() )
-    {
-        VkProtectedSubmitInfo submit_info;
+        if (current_submit_info.is_protected_submission() )
+        {
+            VkProtectedSubmitInfo& protected_submit_info = scratch_data.protected_submit_infos_vk.at(n_submit_info);
 
-        submit_info.pNext           = nullptr;
-        submit_info.protectedSubmit = VK_TRUE;
-        submit_info.sType           = VK_STRUCTURE_TYPE_PROTECTED_SUBMIT_INFO;
+            protected_submit_info.pNext           = next_struct_ptr;
+            protected_submit_info.protectedSubmit = VK_TRUE;
+            protected_submit_info.sType           = VK_STRUCTURE_TYPE_PROTECTED_SUBMIT_INFO;
 
-        struct_chainer.append_struct(submit_info);
+            next_struct_ptr = &protected_submit_info;
+        }
+
+        submit_info.commandBufferCount   = n_cmd_buffers;
+        submit_info.pCommandBuffers      = (n_cmd_buffers       != 0) ? cmd_buffers_vk       : nullptr;
+        submit_info.pNext                = next_struct_ptr;
+        submit_info.pSignalSemaphores    = (n_signal_semaphores != 0) ? signal_semaphores_vk : nullptr;
+        submit_info.pWaitDstStageMask    = current_submit_info.get_destination_stage_wait_masks();
+        submit_info.pWaitSemaphores      = (n_wait_semaphores   != 0) ? wait_semaphores_vk   : nullptr;
+        submit_info.signalSemaphoreCount = n_signal_semaphores;
+        submit_info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit_info.waitSemaphoreCount   = n_wait_semaphores;
+
+        n_cmd_buffers_used       += current_submit_info.get_n_command_buffers();
+        n_signal_semaphores_used += n_signal_semaphores;
+        n_wait_semaphores_used   += n_wait_semaphores;
     }
 
     /* Go for it */
-    if (fence_ptr                         == nullptr &&
-        in_submit_info.get_should_block() )
+    if (fence_ptr    == nullptr &&
+        should_block)
     {
         fence_ptr         = m_submit_fence_ptr.get();
         needs_fence_reset = true;
     }
 
-    switch (in_submit_info.get_type() )
+    submit_lock_unlock(in_n_submit_infos,
+                       in_submit_infos_ptr,
+                       fence_ptr,
+                       true); /* in_should_lock */
     {
-        case SubmissionType::MGPU:
-        {
-            submit_command_buffers_lock_unlock(in_submit_info.get_n_command_buffers     (),
-                                               in_submit_info.get_command_buffers_mgpu  (),
-                                               in_submit_info.get_n_signal_semaphores   (),
-                                               in_submit_info.get_signal_semaphores_mgpu(),
-                                               in_submit_info.get_n_wait_semaphores     (),
-                                               in_submit_info.get_wait_semaphores_mgpu  (),
-                                               fence_ptr,
-                                               true);
-
-            break;
-        }
-
-        case SubmissionType::SGPU:
-        {
-             submit_command_buffers_lock_unlock(in_submit_info.get_n_command_buffers     (),
-                                                in_submit_info.get_command_buffers_sgpu  (),
-                                                in_submit_info.get_n_signal_semaphores   (),
-                                                in_submit_info.get_signal_semaphores_sgpu(),
-                                                in_submit_info.get_n_wait_semaphores     (),
-                                                in_submit_info.get_wait_semaphores_sgpu  (),
-                                                fence_ptr,
-                                                true); /* in_should_lock */
-
-             break;
-        }
-
-        default:
-        {
-            anvil_assert_fail();
-        }
-     }
-
-     {
-        auto chain_ptr = struct_chainer.create_chain();
-
         if (needs_fence_reset)
         {
             m_submit_fence_ptr->reset();
         }
 
-         result = Anvil::Vulkan::vkQueueSubmit(m_queue,
-                                               1, /* submitCount */
-                                               chain_ptr->get_root_struct(),
-                                              (fence_ptr != nullptr) ? fence_ptr->get_fence()
-                                                                     : VK_NULL_HANDLE);
+        result = Anvil::Vulkan::vkQueueSubmit(m_queue,
+                                              in_n_submit_infos,
+                                              scratch_data.submit_infos_vk.data(),
+                                             (fence_ptr != nullptr) ? fence_ptr->get_fence()
+                                                                    : VK_NULL_HANDLE);
 
-        if (in_submit_info.get_should_block() )
+        if (should_block)
         {
             /* Wait till initialization finishes GPU-side */
             result = Anvil::Vulkan::vkWaitForFences(m_device_ptr->get_device_vk(),
                                                     1, /* fenceCount */
                                                     fence_ptr->get_fence_ptr(),
                                                     VK_TRUE,     /* waitAll */
-                                                    in_submit_info.get_timeout() );
+                                                    timeout);
         }
-     }
-
-     switch (in_submit_info.get_type() )
-     {
-         case SubmissionType::MGPU:
-         {
-             submit_command_buffers_lock_unlock(in_submit_info.get_n_command_buffers     (),
-                                                in_submit_info.get_command_buffers_mgpu  (),
-                                                in_submit_info.get_n_signal_semaphores   (),
-                                                in_submit_info.get_signal_semaphores_mgpu(),
-                                                in_submit_info.get_n_wait_semaphores     (),
-                                                in_submit_info.get_wait_semaphores_mgpu  (),
-                                                fence_ptr,
-                                                false); /* in_should_lock */
-
-             break;
-         }
-
-         case SubmissionType::SGPU:
-         {
-             submit_command_buffers_lock_unlock(in_submit_info.get_n_command_buffers     (),
-                                                in_submit_info.get_command_buffers_sgpu  (),
-                                                in_submit_info.get_n_signal_semaphores   (),
-                                                in_submit_info.get_signal_semaphores_sgpu(),
-                                                in_submit_info.get_n_wait_semaphores     (),
-                                                in_submit_info.get_wait_semaphores_sgpu  (),
-                                                fence_ptr,
-                                                false); /* in_should_lock */
-
-             break;
-         }
-
-         default:
-         {
-             anvil_assert_fail();
-         }
-     }
-
-     return (result == VK_SUCCESS);
+    }
+    submit_lock_unlock(in_n_submit_infos,
+                       in_submit_infos_ptr,
+                       fence_ptr,
+                       false); /* in_should_lock */
+
+end:
+    return (result == VK_SUCCESS);
+}
+
+/** Locks or unlocks the queue and all objects referred to by the specified submissions.
+ *
+ *  The fence is only locked or unlocked once, as it is shared by all the submissions.
+ **/
+void Anvil::Queue::submit_lock_unlock(uint32_t                 in_n_submit_infos,
+                                      const Anvil::SubmitInfo* in_submit_infos_ptr,
+                                      Anvil::Fence*            in_opt_fence_ptr,
+                                      bool                     in_should_lock)
+{
+    for (uint32_t n_submit_info = 0;
+                  n_submit_info < in_n_submit_infos;
+                ++n_submit_info)
+    {
+        const auto&   current_submit_info = in_submit_infos_ptr[n_submit_info];
+        Anvil::Fence* fence_ptr           = (n_submit_info == 0) ? in_opt_fence_ptr : nullptr;
+
+        switch (current_submit_info.get_type() )
+        {
+            case SubmissionType::MGPU:
+            {
+                submit_command_buffers_lock_unlock(current_submit_info.get_n_command_buffers     (),
+                                                   current_submit_info.get_command_buffers_mgpu  (),
+                                                   current_submit_info.get_n_signal_semaphores   (),
+                                                   current_submit_info.get_signal_semaphores_mgpu(),
+                                                   current_submit_info.get_n_wait_semaphores     (),
+                                                   current_submit_info.get_wait_semaphores_mgpu  (),
+                                                   fence_ptr,
+                                                   in_should_lock);
+
+                break;
+            }
+
+            case SubmissionType::SGPU:
+            {
+                submit_command_buffers_lock_unlock(current_submit_info.get_n_command_buffers     (),
+                                                   current_submit_info.get_command_buffers_sgpu  (),
+                                                   current_submit_info.get_n_signal_semaphores   (),
+                                                   current_submit_info.get_signal_semaphores_sgpu(),
+                                                   current_submit_info.get_n_wait_semaphores     (),
+                                                   current_submit_info.get_wait_semaphores_sgpu  (),
+                                                   fence_ptr,
+                                                   in_should_lock);
+
+                break;
+            }
+
+            default:
+            {
+                anvil_assert_fail();
+            }
+        }
+    }
 }
 
 void Anvil::Queue::submit_command_buffers_lock_unlock(uint32_t                         in_n_command_buffers,
@@ -304,6 +304,16 @@ bool Anvil::Semaphore::reset()
         }
     }
 
+    if (m_create_info_ptr->get_semaphore_type() == Anvil::SemaphoreType::TIMELINE_KHR)
+    {
+        if (!m_device_ptr->get_extension_info()->khr_timeline_semaphore() )
+        {
+            anvil_assert(m_device_ptr->get_extension_info()->khr_timeline_semaphore() );
+
+            goto end;
+        }
+    }
+
     /* Spawn a new semaphore */
     {
         VkSemaphoreCreateInfo semaphore_create_info;
@@ -315,6 +325,18 @@ bool Anvil::Semaphore::reset()
         struct_chainer.append_struct(semaphore_create_info);
     }
 
+    if (m_create_info_ptr->get_semaphore_type() != Anvil::SemaphoreType::BINARY)
+    {
+        VkSemaphoreTypeCreateInfoKHR type_create_info;
+
+        type_create_info.initialValue  = m_create_info_ptr->get_initial_value();
+        type_create_info.pNext         = nullptr;
+        type_create_info.semaphoreType = static_cast<VkSemaphoreTypeKHR>(m_create_info_ptr->get_semaphore_type() );
+        type_create_info.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+
+        struct_chainer.append_struct(type_create_info);
+    }
+
     if (m_create_info_ptr->get_exportable_external_semaphore_handle_types() != Anvil::ExternalSemaphoreHandleTypeFlagBits::NONE)
     {
         VkExportSemaphoreCreateInfo create_info;
@@ -372,3 +394,117 @@ bool Anvil::Semaphore::reset()
 end:
     return is_vk_call_successful(result);
 }
+
+/* Please see header for specification */
+bool Anvil::Semaphore::get_counter_value(uint64_t* out_value_ptr) const
+{
+    VkResult result;
+
+    anvil_assert(is_timeline() );
+
+    result = m_device_ptr->get_extension_khr_timeline_semaphore_entrypoints().vkGetSemaphoreCounterValueKHR(m_device_ptr->get_device_vk(),
+                                                                                                            m_semaphore,
+                                                                                                            out_value_ptr);
+
+    anvil_assert_vk_call_succeeded(result);
+
+    return is_vk_call_successful(result);
+}
+
+/* Please see header for specification */
+bool Anvil::Semaphore::is_timeline() const
+{
+    return (m_create_info_ptr->get_semaphore_type() == Anvil::SemaphoreType::TIMELINE_KHR);
+}
+
+/* Please see header for specification */
+bool Anvil::Semaphore::signal(uint64_t in_value)
+{
+    VkResult                 result;
+    VkSemaphoreSignalInfoKHR signal_info;
+
+    anvil_assert(is_timeline() );
+
+    signal_info.pNext     = nullptr;
+    signal_info.semaphore = m_semaphore;
+    signal_info.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO_KHR;
+    signal_info.value     = in_value;
+
+    lock();
+    {
+        result = m_device_ptr->get_extension_khr_timeline_semaphore_entrypoints().vkSignalSemaphoreKHR(m_device_ptr->get_device_vk(),
+                                                                                                       &signal_info);
+    }
+    unlock();
+
+    anvil_assert_vk_call_succeeded(result);
+
+    return is_vk_call_successful(result);
+}
+
+/* Please see header for specification */
+bool Anvil::Semaphore::wait(uint64_t in_value,
+                            uint64_t in_timeout) const
+{
+    Anvil::Semaphore* this_ptr = const_cast<Anvil::Semaphore*>(this);
+
+    return wait_semaphores(1, /* in_n_semaphores */
+                          &this_ptr,
+                          &in_value,
+                           true, /* in_wait_for_all */
+                           in_timeout);
+}
+
+/* Please see header for specification */
+bool Anvil::Semaphore::wait_semaphores(uint32_t                 in_n_semaphores,
+                                       Anvil::Semaphore* const* in_semaphore_ptrs,
+                                       const uint64_t*          in_values_ptr,
+                                       bool                     in_wait_for_all,
+                                       uint64_t                 in_timeout)
+{
+    static const uint32_t    n_max_semaphores_per_wait = 32;
+    const Anvil::BaseDevice* device_ptr                = nullptr;
+    VkResult                 result                    = VK_ERROR_INITIALIZATION_FAILED;
+    VkSemaphore              semaphores_vk[n_max_semaphores_per_wait];
+    VkSemaphoreWaitInfoKHR   wait_info;
+
+    if (in_n_semaphores == 0                         ||
+        in_n_semaphores >  n_max_semaphores_per_wait)
+    {
+        anvil_assert(in_n_semaphores >  0);
+        anvil_assert(in_n_semaphores <= n_max_semaphores_per_wait);
+
+        goto end;
+    }
+
+    for (uint32_t n_semaphore = 0;
+                  n_semaphore < in_n_semaphores;
+                ++n_semaphore)
+    {
+        const Anvil::Semaphore* current_semaphore_ptr = in_semaphore_ptrs[n_semaphore];
+
+        anvil_assert(current_semaphore_ptr->is_timeline() );
+        anvil_assert(device_ptr == nullptr                              ||
+                     device_ptr == current_semaphore_ptr->m_device_ptr);
+
+        device_ptr                 = current_semaphore_ptr->m_device_ptr;
+        semaphores_vk[n_semaphore] = current_semaphore_ptr->m_semaphore;
+    }
+
+    wait_info.flags          = (in_wait_for_all) ? 0 : VK_SEMAPHORE_WAIT_ANY_BIT_KHR;
+    wait_info.pNext          = nullptr;
+    wait_info.pSemaphores    = semaphores_vk;
+    wait_info.pValues        = in_values_ptr;
+    wait_info.semaphoreCount = in_n_semaphores;
+    wait_info.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+
+    result = device_ptr->get_extension_khr_timeline_semaphore_entrypoints().vkWaitSemaphoresKHR(device_ptr->get_device_vk(),
+                                                                                               &wait_info,
+                                                                                                in_timeout);
+
+    anvil_assert(result == VK_SUCCESS ||
+                 result == VK_TIMEOUT);
+
+end:
+    return (result == VK_SUCCESS);
+}
@@ -28,6 +28,7 @@
 #include "misc/object_tracker.h"
 #include "misc/struct_chainer.h"
 #include "misc/swapchain_create_info.h"
+#include "misc/tracer.h"
 #include "misc/window.h"
 #include "wrappers/command_buffer.h"
 #include "wrappers/command_pool.h"
@@ -162,6 +163,8 @@ Anvil::SwapchainOperationErrorCode Anvil::Swapchain::acquire_image(Anvil::Semaph
                                                                    uint32_t*                           out_result_index_ptr,
                                                                    bool                                in_should_block)
 {
+    ANVIL_TRACE_CPU_SPAN("Swapchain::acquire_image");
+
     const Anvil::DeviceType device_type                    = m_device_ptr->get_type();
 
     uint32_t                           result                         = UINT32_MAX;